@@ -491,6 +491,7 @@ _opendds_feature(SAFETY_PROFILE OFF CONFIG MPC_INVERTED_NAME no_opendds_safety_p
   DOC "Build using Safety Profile (Not for CMake-built OpenDDS)")
 _opendds_feature(COVERAGE OFF MPC_INVERTED_NAME dds_non_coverage)
 _opendds_feature(BOOTTIME_TIMERS OFF CONFIG DOC "Use CLOCK_BOOTTIME for timers")
+_opendds_feature(TRACEPOINTS OFF CONFIG DOC "Record hot path tracepoints for Chrome trace output")
 if(OPENDDS_CXX_STD_YEAR LESS 2017)
   set(_opendds_cxx17 OFF)
 else()
@@ -0,0 +1,190 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "AsyncObserver.h"
+
+#include "Time_Helper.h"
+#include "transport/framework/TransportClient.h"
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  GUID_t entity_guid(DDS::Entity_ptr entity)
+  {
+    // Both DataWriterImpl and DataReaderImpl are TransportClients, which have
+    // the GUID without taking a lock.
+    const TransportClient* const client = dynamic_cast<TransportClient*>(entity);
+    return client ? client->get_guid() : GUID_UNKNOWN;
+  }
+}
+
+AsyncObserver::Record::Record()
+  : event(e_NONE)
+  , entity(GUID_UNKNOWN)
+  , is_writer(false)
+  , instance(DDS::HANDLE_NIL)
+  , instance_state(0)
+  , source_timestamp(make_time_t(0, 0))
+{}
+
+AsyncObserver::AsyncObserver(const Handler_rch& handler,
+                             size_t capacity,
+                             const TimeDuration& max_latency)
+  : handler_(handler)
+  , max_latency_(max_latency)
+  , wake_threshold_(std::max(capacity / 2, size_t(1)))
+  , queue_(capacity)
+  , queued_(0)
+  , dropped_(0)
+  , cv_(mutex_)
+  , flush_requested_(0)
+  , flush_done_(0)
+  , shutdown_(false)
+{
+  thread_.reset(new ThreadPool(1, run, this));
+}
+
+AsyncObserver::~AsyncObserver()
+{
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    shutdown_ = true;
+    cv_.notify_all();
+  }
+  // Joins the thread once it has handled everything
+  thread_.reset();
+}
+
+void AsyncObserver::flush()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  const ACE_UINT64 request = ++flush_requested_;
+  cv_.notify_all();
+  while (flush_done_ < request && !shutdown_) {
+    cv_.wait(thread_status_manager_);
+  }
+}
+
+size_t AsyncObserver::dropped() const
+{
+  return dropped_.load();
+}
+
+void AsyncObserver::on_sample_sent(DDS::DataWriter_ptr writer, const Sample& sample)
+{
+  record(e_SAMPLE_SENT, writer, true, sample);
+}
+
+void AsyncObserver::on_sample_received(DDS::DataReader_ptr reader, const Sample& sample)
+{
+  record(e_SAMPLE_RECEIVED, reader, false, sample);
+}
+
+void AsyncObserver::on_sample_read(DDS::DataReader_ptr reader, const Sample& sample)
+{
+  record(e_SAMPLE_READ, reader, false, sample);
+}
+
+void AsyncObserver::on_sample_taken(DDS::DataReader_ptr reader, const Sample& sample)
+{
+  record(e_SAMPLE_TAKEN, reader, false, sample);
+}
+
+void AsyncObserver::on_disposed(DDS::DataWriter_ptr writer, const Sample& sample)
+{
+  record(e_DISPOSED, writer, true, sample);
+}
+
+void AsyncObserver::on_disposed(DDS::DataReader_ptr reader, const Sample& sample)
+{
+  record(e_DISPOSED, reader, false, sample);
+}
+
+void AsyncObserver::on_unregistered(DDS::DataWriter_ptr writer, const Sample& sample)
+{
+  record(e_UNREGISTERED, writer, true, sample);
+}
+
+void AsyncObserver::on_unregistered(DDS::DataReader_ptr reader, const Sample& sample)
+{
+  record(e_UNREGISTERED, reader, false, sample);
+}
+
+void AsyncObserver::record(Event event, DDS::Entity_ptr entity, bool is_writer, const Sample& sample)
+{
+  Record record;
+  record.event = event;
+  record.entity = entity_guid(entity);
+  record.is_writer = is_writer;
+  record.instance = sample.instance;
+  record.instance_state = sample.instance_state;
+  record.source_timestamp = sample.timestamp;
+  record.sequence_number = sample.sequence_number;
+  record.observed = MonotonicTimePoint::now();
+
+  if (!queue_.push(record)) {
+    ++dropped_;
+    return;
+  }
+  // Don't wait for max_latency_ if the queue is filling up.
+  if (++queued_ == wake_threshold_) {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    cv_.notify_all();
+  }
+}
+
+ACE_THR_FUNC_RETURN AsyncObserver::run(void* arg)
+{
+  static_cast<AsyncObserver*>(arg)->handle_records();
+  return 0;
+}
+
+void AsyncObserver::handle_records()
+{
+  RecordBatch batch;
+  batch.reserve(queue_.capacity());
+  Record record;
+
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  for (;;) {
+    // Everything queued before these were read is handled in this pass.
+    const bool stopping = shutdown_;
+    const ACE_UINT64 flush_request = flush_requested_;
+    guard.release();
+
+    queued_ = 0;
+    while (queue_.pop(record)) {
+      batch.push_back(record);
+    }
+    if (!batch.empty()) {
+      handler_->on_records(batch);
+      batch.clear();
+    }
+
+    guard.acquire();
+    if (flush_done_ != flush_request) {
+      flush_done_ = flush_request;
+      cv_.notify_all();
+    }
+    if (stopping) {
+      break;
+    }
+    if (!shutdown_ && flush_requested_ == flush_done_) {
+      cv_.wait_until(MonotonicTimePoint::now() + max_latency_, thread_status_manager_);
+    }
+  }
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
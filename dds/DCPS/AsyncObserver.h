@@ -0,0 +1,134 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_ASYNC_OBSERVER_H
+#define OPENDDS_DCPS_ASYNC_OBSERVER_H
+
+#include "Observer.h"
+#include "ConditionVariable.h"
+#include "GuidUtils.h"
+#include "MpscQueue.h"
+#include "ThreadPool.h"
+#include "TimeTypes.h"
+#include "unique_ptr.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class AsyncObserver
+ *
+ * @brief Observer that reports sample events in batches on its own thread
+ *
+ * The sample events (sent, received, read, taken, disposed, and unregistered)
+ * are recorded into a lock-free queue on the thread that causes them, without
+ * locking or calling out to the handler, so observing doesn't slow down
+ * writing and reading.  A dedicated thread gives the records to the Handler in
+ * batches.  Records are dropped if the handler falls behind and the queue
+ * fills up.
+ *
+ * Only what identifies the sample is recorded.  The data of the sample is not
+ * available to the handler since it may be gone by the time the record is
+ * handled.
+ */
+class OpenDDS_Dcps_Export AsyncObserver : public Observer {
+public:
+  struct Record {
+    Record();
+
+    /// One of the sample events, for example e_SAMPLE_SENT
+    Event event;
+    /// GUID of the writer or reader.  Getting its instance handle takes a
+    /// lock, so the handler can look it up with
+    /// DomainParticipantImpl::lookup_handle if it needs it.
+    GUID_t entity;
+    bool is_writer;
+    DDS::InstanceHandle_t instance;
+    DDS::InstanceStateKind instance_state;
+    DDS::Time_t source_timestamp;
+    SequenceNumber sequence_number;
+    /// When the event happened
+    MonotonicTimePoint observed;
+  };
+  typedef OPENDDS_VECTOR(Record) RecordBatch;
+
+  class Handler : public virtual RcObject {
+  public:
+    /// Called on the AsyncObserver's thread with the records in the order
+    /// they were queued.
+    virtual void on_records(const RecordBatch& batch) = 0;
+  };
+  typedef RcHandle<Handler> Handler_rch;
+
+  static const size_t default_capacity = 8192;
+
+  /**
+   * @param capacity how many records can be waiting to be handled
+   * @param max_latency how long a record can wait before the batch it's in is
+   * handed off when the queue isn't filling up
+   */
+  explicit AsyncObserver(const Handler_rch& handler,
+                         size_t capacity = default_capacity,
+                         const TimeDuration& max_latency = TimeDuration::from_msec(10));
+
+  /// Handles the remaining records and stops the thread.
+  virtual ~AsyncObserver();
+
+  /// Block until everything queued so far has been handled.
+  void flush();
+
+  /// Number of records that were dropped because the queue was full.
+  size_t dropped() const;
+
+  virtual void on_sample_sent(DDS::DataWriter_ptr, const Sample&);
+  virtual void on_sample_received(DDS::DataReader_ptr, const Sample&);
+  virtual void on_sample_read(DDS::DataReader_ptr, const Sample&);
+  virtual void on_sample_taken(DDS::DataReader_ptr, const Sample&);
+  virtual void on_disposed(DDS::DataWriter_ptr, const Sample&);
+  virtual void on_disposed(DDS::DataReader_ptr, const Sample&);
+  virtual void on_unregistered(DDS::DataWriter_ptr, const Sample&);
+  virtual void on_unregistered(DDS::DataReader_ptr, const Sample&);
+
+private:
+  void record(Event event, DDS::Entity_ptr entity, bool is_writer, const Sample& sample);
+
+  static ACE_THR_FUNC_RETURN run(void* arg);
+  void handle_records();
+
+  const Handler_rch handler_;
+  const TimeDuration max_latency_;
+  /// Half the capacity; the thread is woken up when this many are queued.
+  const size_t wake_threshold_;
+  MpscQueue<Record> queue_;
+  /// Records pushed since the thread last woke up, used to wake it early.
+  Atomic<size_t> queued_;
+  Atomic<size_t> dropped_;
+
+  mutable ACE_Thread_Mutex mutex_;
+  ConditionVariable<ACE_Thread_Mutex> cv_;
+  ThreadStatusManager thread_status_manager_;
+  /// Incremented each time flush() is called
+  ACE_UINT64 flush_requested_;
+  /// The last flush request the thread has finished
+  ACE_UINT64 flush_done_;
+  bool shutdown_;
+
+  unique_ptr<ThreadPool> thread_;
+};
+
+typedef RcHandle<AsyncObserver> AsyncObserver_rch;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_ASYNC_OBSERVER_H */
@@ -71,7 +71,8 @@ public:
                   list_index_type index,
                   ACE_Allocator* allocator,
                   const OPENDDS_VECTOR(OpenDDS::DCPS::String)& path,
-                  const OpenDDS::DCPS::String& data_dir)
+                  const OpenDDS::DCPS::String& data_dir,
+                  OpenDDS::DCPS::DurabilityLog* log)
   : sample_list_(sample_list)
   , index_(index)
   , allocator_(allocator)
@@ -79,6 +80,7 @@ public:
   , timer_ids_(0)
   , path_(path)
   , data_dir_(data_dir)
+  , log_(log)
   {
   }
 
@@ -99,6 +101,10 @@ public:
 
     // Cleanup all data samples corresponding to the cleanup delay.
     data_queue_type *& queue = this->sample_list_[this->index_];
+    if (this->log_ && queue) {
+      this->log_->drop(queue->log_id_);
+      this->log_->commit();
+    }
     ACE_DES_FREE(queue,
                  this->allocator_->free,
                  data_queue_type);
@@ -161,6 +167,75 @@ private:
   OPENDDS_VECTOR(OpenDDS::DCPS::String) path_;
 
   OpenDDS::DCPS::String data_dir_;
+
+  OpenDDS::DCPS::DurabilityLog* const log_;
+};
+
+/**
+ * @class Log_Replayer
+ *
+ * @brief Rebuilds the cache from the samples in a @c DurabilityLog,
+ *        with a queue for each queue in the log.
+ */
+class Log_Replayer : public OpenDDS::DCPS::DurabilityLog::Replayer {
+public:
+
+  typedef OpenDDS::DCPS::DataDurabilityCache cache_type;
+  typedef OpenDDS::DCPS::DurabilityQueue<cache_type::sample_data_type>
+  data_queue_type;
+
+  Log_Replayer(cache_type::sample_map_type& samples,
+               ACE_Allocator* allocator)
+  : samples_(samples)
+  , allocator_(allocator)
+  {
+  }
+
+  virtual void on_sample(const OpenDDS::DCPS::DurabilityLog::Sample& sample)
+  {
+    data_queue_type*& queue = this->queues_[sample.queue_id];
+
+    if (!queue) {
+      cache_type::key_type key(sample.domain_id,
+                               sample.topic_name.c_str(),
+                               sample.type_name.c_str(),
+                               this->allocator_);
+      cache_type::sample_list_type* sample_list = 0;
+
+      if (this->samples_.find(key, sample_list, this->allocator_) != 0) {
+        ACE_NEW_MALLOC(sample_list,
+                       static_cast<cache_type::sample_list_type*>(
+                         this->allocator_->malloc(sizeof(cache_type::sample_list_type))),
+                       cache_type::sample_list_type(0, static_cast<data_queue_type*>(0),
+                                                    this->allocator_));
+        this->samples_.bind(key, sample_list, this->allocator_);
+      }
+
+      ACE_NEW_MALLOC(queue,
+                     static_cast<data_queue_type*>(
+                       this->allocator_->malloc(sizeof(data_queue_type))),
+                     data_queue_type(this->allocator_));
+      queue->log_id_ = sample.queue_id;
+
+      size_t const old_len = sample_list->size();
+      sample_list->size(old_len + 1);
+      (*sample_list)[old_len] = queue;
+    }
+
+    ACE_Message_Block mb(sample.data, sample.length);
+    mb.wr_ptr(sample.length);
+    queue->enqueue_tail(
+      cache_type::sample_data_type(sample.timestamp, mb, this->allocator_));
+  }
+
+private:
+
+  cache_type::sample_map_type& samples_;
+
+  ACE_Allocator* const allocator_;
+
+  /// Queues created so far, by their ID in the log.
+  OPENDDS_MAP(OpenDDS::DCPS::DurabilityLog::QueueId, data_queue_type*) queues_;
 };
 
 } // namespace
@@ -295,10 +370,12 @@ OpenDDS::DCPS::DataDurabilityCache::DataDurabilityCache(
 }
 
 OpenDDS::DCPS::DataDurabilityCache::DataDurabilityCache(DDS::DurabilityQosPolicyKind kind,
-                                                        const String& data_dir)
+                                                        const String& data_dir,
+                                                        bool use_log)
   : allocator_(new ACE_New_Allocator)
   , kind_(kind)
   , data_dir_(data_dir)
+  , log_(use_log && kind == DDS::PERSISTENT_DURABILITY_QOS ? new DurabilityLog(data_dir) : 0)
   , samples_(0)
   , cleanup_timer_ids_()
   , lock_()
@@ -318,7 +395,11 @@ void OpenDDS::DCPS::DataDurabilityCache::init()
 
   typedef DurabilityQueue<sample_data_type> data_queue_type;
 
-  if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS) {
+  if (this->log_) {
+    Log_Replayer replayer(*this->samples_, allocator);
+    this->log_->replay(replayer);
+
+  } else if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS) {
     // Read data from the filesystem and create the in-memory data structures
     // as if we had called insert() once for each "datawriter" directory.
     using OpenDDS::FileSystemStorage::Directory;
@@ -536,7 +617,7 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
 
     ACE_GUARD_RETURN(ACE_SYNCH_MUTEX, guard, this->lock_, false);
 
-    if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS) {
+    if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS && !this->log_) {
       try {
         dir = Directory::create(this->data_dir_.c_str());
 
@@ -611,6 +692,10 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
       samples->fs_path_ = path;
     }
 
+    if (this->log_) {
+      samples->log_id_ = this->log_->next_queue_id();
+    }
+
     for (SendStateDataSampleList::iterator i(element); i != the_end; ++i) {
       DataSampleElement& elem = *i;
 
@@ -655,6 +740,23 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
           }
         }
       }
+
+      if (this->log_) {
+        DDS::Time_t timestamp;
+        const char * data;
+        size_t len;
+        sample.get_sample(data, len, timestamp);
+        this->log_->append(samples->log_id_, domain_id, topic_name, type_name,
+                           timestamp, data, len);
+      }
+    }
+
+    if (this->log_) {
+      // All of the DataWriter's samples are synced together.
+      this->log_->commit();
+
+      if (this->log_->needs_compaction())
+        this->compact_log();
     }
   }
 
@@ -681,7 +783,8 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
                           static_cast<size_t>(slot - &(*sample_list)[0]),
                           this->allocator_.get(),
                           path,
-                          this->data_dir_);
+                          this->data_dir_,
+                          this->log_.get());
     ACE_Event_Handler_var safe_cleanup(cleanup);   // Transfer ownership
     long const tid =
       this->reactor_->schedule_timer(cleanup,
@@ -690,6 +793,11 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
     if (tid == -1) {
       ACE_GUARD_RETURN(ACE_SYNCH_MUTEX, guard, this->lock_, false);
 
+      if (this->log_) {
+        this->log_->drop(samples->log_id_);
+        this->log_->commit();
+      }
+
       ACE_DES_FREE(samples,
                    this->allocator_->free,
                    DurabilityQueue<sample_data_type>);
@@ -847,6 +955,9 @@ OpenDDS::DCPS::DataDurabilityCache::get_data(
      *       data since the data retrieved from the cache will be
      *       reinserted.
      */
+    if (this->log_ && !q->is_empty())
+      this->log_->drop(q->log_id_);
+
     q->reset();
 
     try {
@@ -861,7 +972,62 @@ OpenDDS::DCPS::DataDurabilityCache::get_data(
       }
     }
   }
+
+  if (this->log_) {
+    this->log_->commit();
+
+    if (this->log_->needs_compaction())
+      this->compact_log();
+  }
+
   return true;
 }
 
+void
+OpenDDS::DCPS::DataDurabilityCache::compact_log()
+{
+  if (!this->log_->begin_compaction())
+    return;
+
+  typedef DurabilityQueue<sample_data_type> data_queue_type;
+  sample_map_type::iterator const map_end = this->samples_->end();
+
+  for (sample_map_type::iterator s = this->samples_->begin();
+       s != map_end;
+       ++s) {
+    key_type const & key = (*s).ext_id_;
+    sample_list_type * const list = (*s).int_id_;
+    size_t const len = list->size();
+
+    for (size_t l = 0; l != len; ++l) {
+      data_queue_type * const q = (*list)[l];
+
+      if (!q)
+        continue;
+
+      for (data_queue_type::ITERATOR j = q->begin();
+           !j.done();
+           j.advance()) {
+        sample_data_type * data = 0;
+        j.next(data);
+
+        char const * sample = 0;
+        size_t sample_length = 0;
+        DDS::Time_t source_timestamp;
+        data->get_sample(sample, sample_length, source_timestamp);
+
+        this->log_->append(q->log_id_, key.domain_id(), key.topic_name(),
+                           key.type_name(), source_timestamp, sample,
+                           sample_length);
+      }
+    }
+  }
+
+  if (!this->log_->end_compaction() && DCPS_debug_level > 0) {
+    ACE_ERROR((LM_ERROR,
+               ACE_TEXT("(%P|%t) DataDurabilityCache::compact_log ")
+               ACE_TEXT("couldn't compact log for PERSISTENT data\n")));
+  }
+}
+
 #endif // OPENDDS_NO_PERSISTENCE_PROFILE
@@ -15,6 +15,7 @@
 #endif
 
 #include "DurabilityArray.h"
+#include "DurabilityLog.h"
 #include "DurabilityQueue.h"
 #include "FileSystemStorage.h"
 #include "PoolAllocator.h"
@@ -129,6 +130,10 @@ public:
         + this->type_name_.hash();
     }
 
+    DDS::DomainId_t domain_id() const { return this->domain_id_; }
+    char const * topic_name() const { return this->topic_name_.c_str(); }
+    char const * type_name() const { return this->type_name_.c_str(); }
+
   private:
 
     DDS::DomainId_t domain_id_;
@@ -187,8 +192,11 @@ public:
 
   DataDurabilityCache(DDS::DurabilityQosPolicyKind kind);
 
+  /// If @a use_log is true, @c PERSISTENT data is stored in a
+  /// DurabilityLog in @a data_dir instead of a file per sample.
   DataDurabilityCache(DDS::DurabilityQosPolicyKind kind,
-                      const String& data_dir);
+                      const String& data_dir,
+                      bool use_log = false);
 
   ~DataDurabilityCache();
 
@@ -219,6 +227,10 @@ private:
 
   void init();
 
+  /// Rewrite the live samples to the log so the old segments can be
+  /// removed.  The lock must be held.
+  void compact_log();
+
 private:
   /// Allocator used to allocate memory for sample map and lists.
   unique_ptr<ACE_Allocator> const allocator_;
@@ -227,6 +239,9 @@ private:
 
   String data_dir_;
 
+  /// Storage for PERSISTENT data if DCPSPersistentDataLog is enabled.
+  unique_ptr<DurabilityLog> log_;
+
   /// Map of all data samples.
   sample_map_type * samples_;
 
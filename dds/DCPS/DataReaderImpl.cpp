@@ -22,6 +22,7 @@
 #include "SubscriberImpl.h"
 #include "SubscriptionInstance.h"
 #include "TopicImpl.h"
+#include "Tracepoints.h"
 #include "Transient_Kludge.h"
 #include "TypeSupportImpl.h"
 #include "Util.h"
@@ -45,6 +46,7 @@
 #include <ace/Reactor.h>
 #include <ace/OS_NS_sys_time.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <stdexcept>
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
@@ -79,6 +81,8 @@ DataReaderImpl::DataReaderImpl()
   , last_deadline_missed_total_count_(0)
   , deadline_queue_enabled_(false)
   , deadline_task_(make_rch<DRISporadicTask>(TheServiceParticipant->time_source(), TheServiceParticipant->reactor_task(), rchandle_from(this), &DataReaderImpl::deadline_task))
+  , delivery_task_pending_(false)
+  , delivery_task_(make_rch<DRISporadicTask>(TheServiceParticipant->time_source(), TheServiceParticipant->reactor_task(), rchandle_from(this), &DataReaderImpl::delivery_task))
   , is_bit_(false)
   , always_get_history_(false)
   , statistics_enabled_(false)
@@ -135,7 +139,10 @@ DataReaderImpl::~DataReaderImpl()
 {
   DBG_ENTRY_LVL("DataReaderImpl", "~DataReaderImpl", 6);
 
+  // Stop periodic reports before any of the reader goes away
+  periodic_monitor_.reset();
   deadline_task_->cancel();
+  delivery_task_->cancel();
 
 #ifndef OPENDDS_SAFETY_PROFILE
   RcHandle<DomainParticipantImpl> participant = participant_servant_.lock();
@@ -180,6 +187,12 @@ DataReaderImpl::cleanup()
   multi_topic_ = 0;
 #endif
 
+  if (delivery_queue_) {
+    delivery_task_->cancel();
+    // Release the transport's buffers now instead of when the reader is destroyed.
+    QueuedSample discard;
+    while (delivery_queue_->pop(discard)) {}
+  }
 }
 
 void DataReaderImpl::init(
@@ -1144,6 +1157,16 @@ DataReaderImpl::enable()
     depth_ = qos_.history.depth;
   }
 
+  const size_t delivery_queue_size = TheServiceParticipant->reader_delivery_queue_size();
+  if (delivery_queue_size && !is_bit_ && qos_.history.kind == DDS::KEEP_LAST_HISTORY_QOS
+#ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
+      && !subqos_.presentation.ordered_access
+      && subqos_.presentation.access_scope != DDS::GROUP_PRESENTATION_QOS
+#endif
+      ) {
+    delivery_queue_.reset(new DeliveryQueue(delivery_queue_size));
+  }
+
   if (depth_ == DDS::LENGTH_UNLIMITED) {
     // DDS::LENGTH_UNLIMITED is negative so make it a positive
     // value that is, for all intents and purposes, unlimited
@@ -1292,7 +1315,7 @@ DataReaderImpl::enable()
   return return_value;
 }
 
-void
+WriterInfo_rch
 DataReaderImpl::writer_activity(const DataSampleHeader& header)
 {
   // caller should have the sample_lock_ !!!
@@ -1338,12 +1361,14 @@ DataReaderImpl::writer_activity(const DataSampleHeader& header)
 #endif
     }
   }
+  return writer;
 }
 
 void
 DataReaderImpl::data_received(const ReceivedDataSample& sample)
 {
   DBG_ENTRY_LVL("DataReaderImpl","data_received",6);
+  OPENDDS_TRACE_SCOPE(DATA_RECEIVED, sample.header_.sequence_.getValue());
 
   DDS::InstanceHandle_t publication_handle = DDS::HANDLE_NIL;
   {
@@ -1354,12 +1379,20 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
     }
   }
 
+  if (delivery_queue_ && sample.header_.message_id_ == SAMPLE_DATA) {
+    enqueue_delivery(sample, publication_handle);
+    return;
+  }
+
   // ensure some other thread is not changing the sample container
   // or statuses related to samples.
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->sample_lock_);
 
   if (get_deleted()) return;
 
+  // Queued samples were received before this one.
+  drain_delivery_queue();
+
   if (DCPS_debug_level > 9) {
     ACE_DEBUG((LM_DEBUG,
         ACE_TEXT("(%P|%t) DataReaderImpl::data_received: ")
@@ -1370,52 +1403,9 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
 
   switch (sample.header_.message_id_) {
   case SAMPLE_DATA:
-  case INSTANCE_REGISTRATION: {
-    SubscriptionInstance_rch instance;
-    if (!check_historic(sample)) break;
-
-    DataSampleHeader const & header = sample.header_;
-
-    this->writer_activity(header);
-
-    // Verify data has not exceeded its lifespan.
-    if (this->filter_sample(header)) break;
-
-    // This adds the reader to the set/list of readers with data.
-    RcHandle<SubscriberImpl> subscriber = get_subscriber_servant();
-    if (subscriber) {
-      subscriber->data_received(this);
-    }
-
-    // Only gather statistics about real samples, not registration data, etc.
-    if (header.message_id_ == SAMPLE_DATA) {
-      this->process_latency(sample);
-    }
-
-    // This also adds to the sample container and makes any callbacks
-    // and condition modifications.
-
-    bool is_new_instance = false;
-    bool filtered = false;
-    dds_demarshal(sample, publication_handle, instance, is_new_instance, filtered,
-                  sample.header_.key_fields_only_ ? KEY_ONLY_MARSHALING : FULL_MARSHALING);
-
-    // Per sample logging
-    if (DCPS_debug_level >= 8) {
-      ACE_DEBUG((LM_DEBUG,
-          ACE_TEXT("(%P|%t) DataReaderImpl::data_received: reader %C writer %C ")
-          ACE_TEXT("instance %d is_new_instance %d filtered %d\n"),
-          LogGuid(get_guid()).c_str(),
-          LogGuid(header.publication_id_).c_str(),
-          instance ? instance->instance_handle_ : 0,
-          is_new_instance, filtered));
-    }
-
-    if (filtered) break; // sample filtered from instance
-
-    if (instance) accept_sample_processing(instance, header, is_new_instance);
-  }
-  break;
+  case INSTANCE_REGISTRATION:
+    sample_data_received(sample, publication_handle);
+    break;
 
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
   case END_COHERENT_CHANGES: {
@@ -2118,17 +2108,15 @@ void DataReaderImpl::dispose_unregister(const ReceivedDataSample&,
   }
 }
 
-void DataReaderImpl::process_latency(const ReceivedDataSample& sample)
+void DataReaderImpl::process_latency(const ReceivedDataSample& sample, const WriterInfo_rch& writer)
 {
-  ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
-  StatsMapType::iterator location = this->statistics_.find(sample.header_.publication_id_);
-
-  if (location != this->statistics_.end()) {
+  if (!writer.is_nil()) {
     const DDS::Duration_t zero = { DDS::DURATION_ZERO_SEC, DDS::DURATION_ZERO_NSEC };
 
     // Only when the user has specified a latency budget or statistics
     // are enabled we need to calculate our latency
-    if ((this->statistics_enabled()) ||
+    const bool statistics_enabled = this->statistics_enabled();
+    if (statistics_enabled ||
         (this->qos_.latency_budget.duration > zero)) {
       const DDS::Time_t timestamp = {
         sample.header_.source_timestamp_sec_,
@@ -2136,8 +2124,14 @@ void DataReaderImpl::process_latency(const ReceivedDataSample& sample)
       };
       const TimeDuration latency = SystemTimePoint::now() - SystemTimePoint(timestamp);
 
-      if (this->statistics_enabled()) {
-        location->second.add_stat(latency);
+      if (statistics_enabled) {
+        writer->latency_histogram().record(latency);
+
+        ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
+        const StatsMapType::iterator location = this->statistics_.find(sample.header_.publication_id_);
+        if (location != this->statistics_.end()) {
+          location->second.add_stat(latency);
+        }
       }
 
       if (DCPS_debug_level > 9) {
@@ -2221,11 +2215,23 @@ DataReaderImpl::get_latency_stats(
 void
 DataReaderImpl::reset_latency_stats()
 {
-  ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
-  for (StatsMapType::iterator current = this->statistics_.begin();
-      current != this->statistics_.end();
-      ++current) {
-    current->second.reset_stats();
+  {
+    ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
+    for (StatsMapType::iterator current = this->statistics_.begin();
+        current != this->statistics_.end();
+        ++current) {
+      current->second.reset_stats();
+    }
+  }
+
+  ACE_READ_GUARD(ACE_RW_Thread_Mutex, read_guard, this->writers_lock_);
+  for (WriterMapType::iterator iter = writers_.begin();
+      iter != writers_.end();
+      ++iter) {
+    LatencyHistogram* const histogram = iter->second->latency_histogram_if_allocated();
+    if (histogram) {
+      histogram->reset();
+    }
   }
 }
 
@@ -2681,6 +2687,21 @@ DataReaderImpl::get_writer_states(WriterStatePairVec& writer_states)
   }
 }
 
+void
+DataReaderImpl::get_latency_summaries(LatencySummaryPairVec& summaries)
+{
+  ACE_READ_GUARD(ACE_RW_Thread_Mutex,
+      read_guard,
+      this->writers_lock_);
+  for (WriterMapType::iterator iter = writers_.begin();
+      iter != writers_.end();
+      ++iter) {
+    const LatencyHistogram* const histogram = iter->second->latency_histogram_if_allocated();
+    summaries.push_back(LatencySummaryPair(iter->first,
+        histogram ? histogram->summary() : LatencyHistogram::Summary()));
+  }
+}
+
 #ifndef OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE
 void
 DataReaderImpl::update_ownership_strength(const GUID_t& pub_id,
@@ -2883,6 +2904,7 @@ DataReaderImpl::coherent_changes_completed(DataReaderImpl* reader)
       if (!is_bit()) {
         set_status_changed_flag(::DDS::DATA_AVAILABLE_STATUS, false);
         subscriber->set_status_changed_flag(::DDS::DATA_ON_READERS_STATUS, false);
+        OPENDDS_TRACE_SCOPE(LISTENER_UPCALL, get_instance_handle());
         if (reader == this) {
           // Release the sample_lock before listener callback.
           ACE_GUARD(Reverse_Lock_t, unlock_guard, reverse_sample_lock_);
@@ -3183,6 +3205,99 @@ DDS::ReturnCode_t DataReaderImpl::setup_deserialization()
   return DDS::RETCODE_OK;
 }
 
+void
+DataReaderImpl::sample_data_received(const ReceivedDataSample& sample,
+                                     DDS::InstanceHandle_t publication_handle)
+{
+  SubscriptionInstance_rch instance;
+  if (!check_historic(sample)) return;
+
+  DataSampleHeader const & header = sample.header_;
+
+  const WriterInfo_rch writer = this->writer_activity(header);
+
+  // Verify data has not exceeded its lifespan.
+  if (this->filter_sample(header)) return;
+
+  // This adds the reader to the set/list of readers with data.
+  RcHandle<SubscriberImpl> subscriber = get_subscriber_servant();
+  if (subscriber) {
+    subscriber->data_received(this);
+  }
+
+  // Only gather statistics about real samples, not registration data, etc.
+  if (header.message_id_ == SAMPLE_DATA) {
+    this->process_latency(sample, writer);
+  }
+
+  // This also adds to the sample container and makes any callbacks
+  // and condition modifications.
+
+  bool is_new_instance = false;
+  bool filtered = false;
+  dds_demarshal(sample, publication_handle, instance, is_new_instance, filtered,
+                sample.header_.key_fields_only_ ? KEY_ONLY_MARSHALING : FULL_MARSHALING);
+
+  // Per sample logging
+  if (DCPS_debug_level >= 8) {
+    ACE_DEBUG((LM_DEBUG,
+        ACE_TEXT("(%P|%t) DataReaderImpl::data_received: reader %C writer %C ")
+        ACE_TEXT("instance %d is_new_instance %d filtered %d\n"),
+        LogGuid(get_guid()).c_str(),
+        LogGuid(header.publication_id_).c_str(),
+        instance ? instance->instance_handle_ : 0,
+        is_new_instance, filtered));
+  }
+
+  if (filtered) return; // sample filtered from instance
+
+  if (instance) accept_sample_processing(instance, header, is_new_instance);
+}
+
+void
+DataReaderImpl::enqueue_delivery(const ReceivedDataSample& sample,
+                                 DDS::InstanceHandle_t publication_handle)
+{
+  // Only one thread may push at a time.  This is only contended when more
+  // than one transport thread delivers to this reader.
+  ACE_GUARD(ACE_Thread_Mutex, push_guard, delivery_push_lock_);
+
+  if (delivery_queue_->push(QueuedSample(sample, publication_handle))) {
+    // The task clears the flag before it drains, so either it will see this
+    // sample or it will be scheduled again.
+    if (!delivery_task_pending_.exchange(true)) {
+      delivery_task_->schedule(TimeDuration::zero_value);
+    }
+    return;
+  }
+
+  // The queue is full, so deliver the queued samples and then this one.
+  // Nothing can be queued in between since delivery_push_lock_ is held.
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
+  if (get_deleted()) return;
+  drain_delivery_queue();
+  sample_data_received(sample, publication_handle);
+}
+
+void
+DataReaderImpl::drain_delivery_queue_i()
+{
+  QueuedSample queued;
+  while (delivery_queue_->pop(queued)) {
+    sample_data_received(queued.sample, queued.publication_handle);
+  }
+}
+
+void
+DataReaderImpl::delivery_task(const MonotonicTimePoint& /*now*/)
+{
+  delivery_task_pending_ = false;
+
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
+  if (get_deleted()) return;
+  drain_delivery_queue();
+}
+
 void DataReaderImpl::accept_sample_processing(const SubscriptionInstance_rch& instance,
                                               const DataSampleHeader& header,
                                               bool is_new_instance)
@@ -3296,6 +3411,7 @@ void DataReaderImpl::OnDataAvailable::execute()
   }
 
   if (call_ && data_reader) {
+    OPENDDS_TRACE_SCOPE(LISTENER_UPCALL, data_reader->get_instance_handle());
     listener_->on_data_available(data_reader.in());
   }
 }
@@ -3349,13 +3465,12 @@ void DataReaderImpl::schedule_deadline(SubscriptionInstance_rch instance,
 {
   // Should be called with sample_lock_.
   if (instance->deadline_ == MonotonicTimePoint::zero_value) {
-    instance->deadline_ = MonotonicTimePoint::now() + deadline_period_;
     const bool schedule = deadline_queue_.empty();
-    deadline_queue_.insert(std::make_pair(instance->deadline_, instance));
+    deadline_queue_.insert(*instance, MonotonicTimePoint::now() + deadline_period_);
     if (!timer_called) {
       if (schedule) {
         deadline_task_->schedule(deadline_period_);
-      } else if (deadline_queue_.begin()->second == instance) {
+      } else if (deadline_queue_.front() == instance) {
         // Moved to front.
         deadline_task_->cancel();
         deadline_task_->schedule(deadline_period_);
@@ -3368,12 +3483,7 @@ void DataReaderImpl::cancel_deadline(SubscriptionInstance_rch instance)
 {
   // Should be called with sample_lock_.
   if (instance->deadline_ != MonotonicTimePoint::zero_value) {
-    for (DeadlineQueue::iterator pos = deadline_queue_.lower_bound(instance->deadline_), limit = deadline_queue_.upper_bound(instance->deadline_); pos != limit; ++pos) {
-      if (pos->second == instance) {
-        deadline_queue_.erase(pos);
-        break;
-      }
-    }
+    deadline_queue_.remove(*instance);
     instance->deadline_ = MonotonicTimePoint::zero_value;
   }
 }
@@ -3457,6 +3567,17 @@ void DataReaderImpl::cancel_all_deadlines()
   deadline_task_->cancel();
 }
 
+namespace {
+  typedef std::pair<MonotonicTimePoint, SubscriptionInstance_rch> RescheduledDeadline;
+
+  struct DeadlineLess {
+    bool operator()(const RescheduledDeadline& a, const RescheduledDeadline& b) const
+    {
+      return a.first < b.first;
+    }
+  };
+}
+
 void DataReaderImpl::reset_deadline_period(const TimeDuration& deadline_period)
 {
   if (deadline_period_ != deadline_period) {
@@ -3464,44 +3585,32 @@ void DataReaderImpl::reset_deadline_period(const TimeDuration& deadline_period)
 
     if (deadline_queue_enabled_) {
       ACE_GUARD(ACE_Recursive_Thread_Mutex, instance_guard, this->instances_lock_);
+      ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
       const MonotonicTimePoint now = MonotonicTimePoint::now();
+
+      // The new deadlines aren't in the same order as the old ones, so sort
+      // them instead of moving each instance within the queue.
+      typedef OPENDDS_VECTOR(RescheduledDeadline) Rescheduled;
+      Rescheduled rescheduled;
       for (SubscriptionInstanceMapType::iterator iter = this->instances_.begin();
            iter != this->instances_.end();
            ++iter) {
-        if (iter->second->deadline_ != MonotonicTimePoint::zero_value) {
-          reschedule_deadline(iter->second, now);
+        const SubscriptionInstance_rch& instance = iter->second;
+        if (instance->deadline_ != MonotonicTimePoint::zero_value) {
+          rescheduled.push_back(std::make_pair(now + (deadline_period_ - (instance->deadline_ - now)), instance));
         }
       }
-    }
-  }
-}
-
-void DataReaderImpl::reschedule_deadline(SubscriptionInstance_rch instance,
-                                         const MonotonicTimePoint& now)
-{
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
+      std::stable_sort(rescheduled.begin(), rescheduled.end(), DeadlineLess());
 
-  // So the datareader can call back into us.
-  if (instance->deadline_ != MonotonicTimePoint::zero_value) {
-
-    // Remove.
-    for (DeadlineQueue::iterator pos = deadline_queue_.lower_bound(instance->deadline_), limit = deadline_queue_.upper_bound(instance->deadline_); pos != limit; ++pos) {
-      if (pos->second == instance) {
-        deadline_queue_.erase(pos);
-        break;
+      deadline_queue_.clear();
+      for (Rescheduled::const_iterator it = rescheduled.begin(); it != rescheduled.end(); ++it) {
+        deadline_queue_.insert(*it->second, it->first);
       }
-    }
 
-    instance->deadline_ = now + (deadline_period_ - (instance->deadline_ - now));
-
-    const bool schedule = deadline_queue_.empty();
-    deadline_queue_.insert(std::make_pair(instance->deadline_, instance));
-    if (schedule) {
-      deadline_task_->schedule(deadline_period_);
-    } else if (deadline_queue_.begin()->second == instance) {
-      // Moved to front.
       deadline_task_->cancel();
-      deadline_task_->schedule(deadline_period_);
+      if (!deadline_queue_.empty()) {
+        deadline_task_->schedule(deadline_queue_.front()->deadline_ - now);
+      }
     }
   }
 }
@@ -3511,15 +3620,14 @@ void DataReaderImpl::deadline_task(const MonotonicTimePoint& now)
   ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
 
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
-  for (DeadlineQueue::iterator pos = deadline_queue_.begin(), limit = deadline_queue_.end(); pos != limit && pos->first <= now;) {
-    SubscriptionInstance_rch instance = pos->second;
-    deadline_queue_.erase(pos++);
-    // pos is no longer valid.
+  while (!deadline_queue_.empty() && deadline_queue_.front()->deadline_ <= now) {
+    SubscriptionInstance_rch instance = deadline_queue_.front();
+    deadline_queue_.remove(*instance);
     process_deadline(instance, now, true);
   }
 
   if (!deadline_queue_.empty()) {
-    deadline_task_->schedule(deadline_queue_.begin()->first - now);
+    deadline_task_->schedule(deadline_queue_.front()->deadline_ - now);
   }
 }
 
@@ -14,6 +14,7 @@
 #include "CoherentChangeControl.h"
 #include "ContentFilteredTopicImpl.h"
 #include "DataReaderCallbacks.h"
+#include "DeadlineList.h"
 #include "Definitions.h"
 #include "DisjointSequence.h"
 #include "DomainParticipantImpl.h"
@@ -27,6 +28,7 @@
 #include "RcHandle_T.h"
 #include "RcObject.h"
 #include "Service_Participant.h"
+#include "SpscQueue.h"
 #include "Stats_T.h"
 #include "SubscriptionInstance.h"
 #include "TimeTypes.h"
@@ -121,6 +123,20 @@ public:
 
 #endif
 
+/**
+ * Per-sample information returned by DataReaderImpl_T::take_batch. It's the
+ * part of DDS::SampleInfo that doesn't need a second pass over the samples or
+ * a lookup per sample to compute.
+ */
+struct BatchSampleInfo {
+  DDS::InstanceHandle_t instance_handle;
+  DDS::InstanceStateKind instance_state;
+  DDS::Time_t source_timestamp;
+  /// GUID of the DataWriter, rather than its instance handle
+  GUID_t publication;
+  bool valid_data;
+};
+
 /**
 * @class DataReaderImpl
 *
@@ -302,7 +318,7 @@ public:
   /// @}
 
   /// update liveliness info for this writer.
-  void writer_activity(const DataSampleHeader& header);
+  WriterInfo_rch writer_activity(const DataSampleHeader& header);
 
   /// process a message that has been received - could be control or a data sample.
   virtual void data_received(const ReceivedDataSample& sample);
@@ -337,7 +353,7 @@ public:
                                   DDS::InstanceHandle_t publication_handle,
                                   SubscriptionInstance_rch& instance);
 
-  void process_latency(const ReceivedDataSample& sample);
+  void process_latency(const ReceivedDataSample& sample, const WriterInfo_rch& writer);
   void notify_latency(GUID_t writer);
 
   size_t get_depth() const
@@ -389,6 +405,12 @@ public:
   typedef OPENDDS_VECTOR(WriterStatePair) WriterStatePairVec;
   void get_writer_states(WriterStatePairVec& writer_states);
 
+  typedef std::pair<GUID_t, LatencyHistogram::Summary> LatencySummaryPair;
+  typedef OPENDDS_VECTOR(LatencySummaryPair) LatencySummaryPairVec;
+  /// Latency percentiles for each associated writer.  These are only
+  /// recorded while statistics are enabled.
+  void get_latency_summaries(LatencySummaryPairVec& summaries);
+
 #ifndef OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE
   void update_ownership_strength (const GUID_t& pub_id,
                                   const CORBA::Long& ownership_strength);
@@ -839,7 +861,7 @@ private:
   /// Watchdog responsible for reporting missed offered
   /// deadlines.
   TimeDuration deadline_period_;
-  typedef OPENDDS_MULTIMAP(MonotonicTimePoint, SubscriptionInstance_rch) DeadlineQueue;
+  typedef DeadlineList<SubscriptionInstance> DeadlineQueue;
   DeadlineQueue deadline_queue_;
   bool deadline_queue_enabled_;
   typedef PmfSporadicTask<DataReaderImpl> DRISporadicTask;
@@ -848,8 +870,6 @@ private:
   void schedule_deadline(SubscriptionInstance_rch instance,
                          bool timer_called);
   void reset_deadline_period(const TimeDuration& deadline_period);
-  void reschedule_deadline(SubscriptionInstance_rch instance,
-                           const MonotonicTimePoint& now);
   void cancel_deadline(SubscriptionInstance_rch instance);
   void cancel_all_deadlines();
   void deadline_task(const MonotonicTimePoint& now);
@@ -857,6 +877,50 @@ private:
                         const MonotonicTimePoint& now,
                         bool timer_called);
 
+  /// Handle a SAMPLE_DATA or INSTANCE_REGISTRATION message,
+  /// sample_lock_ must be held.
+  void sample_data_received(const ReceivedDataSample& sample,
+                            DDS::InstanceHandle_t publication_handle);
+
+  /// Optional hand off of SAMPLE_DATA from the transport thread to
+  /// delivery_task_, see DCPSReaderDeliveryQueueSize.  Producers are
+  /// serialized by delivery_push_lock_ and consumers by sample_lock_.  Only
+  /// delivery_task_ and the transport thread consume, never read or take,
+  /// so listeners aren't called from inside them.
+  struct QueuedSample {
+    QueuedSample()
+      : publication_handle(DDS::HANDLE_NIL)
+    {}
+
+    QueuedSample(const ReceivedDataSample& s, DDS::InstanceHandle_t ph)
+      : sample(s)
+      , publication_handle(ph)
+    {}
+
+    ReceivedDataSample sample;
+    DDS::InstanceHandle_t publication_handle;
+  };
+  typedef SpscQueue<QueuedSample> DeliveryQueue;
+  unique_ptr<DeliveryQueue> delivery_queue_;
+  /// Held while pushing, and while delivering in order when the queue is full.
+  ACE_Thread_Mutex delivery_push_lock_;
+  /// Set when delivery_task_ was scheduled and hasn't started to drain yet.
+  Atomic<bool> delivery_task_pending_;
+  RcHandle<DRISporadicTask> delivery_task_;
+
+  void enqueue_delivery(const ReceivedDataSample& sample,
+                        DDS::InstanceHandle_t publication_handle);
+
+  /// Add the queued samples to the instances, sample_lock_ must be held.
+  void drain_delivery_queue()
+  {
+    if (delivery_queue_) {
+      drain_delivery_queue_i();
+    }
+  }
+  void drain_delivery_queue_i();
+  void delivery_task(const MonotonicTimePoint& now);
+
   /// Flag indicates that this datareader is a builtin topic
   /// datareader.
   bool is_bit_;
@@ -13,6 +13,7 @@
 #include "MultiTopicImpl.h"
 #include "RakeResults_T.h"
 #include "SubscriberImpl.h"
+#include "Tracepoints.h"
 #include "TypeSupportImpl.h"
 #include "Util.h"
 #include "dcps_export.h"
@@ -99,6 +100,10 @@ namespace OpenDDS {
       void operator delete(void* memory, ACE_New_Allocator& pool);
       void operator delete(void* memory);
 
+      /// Give the sample back to the pool it came from if there's room for
+      /// it, otherwise delete it.
+      static void release(MessageTypeWithAllocator* sample);
+
       MessageTypeWithAllocator(){}
       MessageTypeWithAllocator(const MessageType& other)
         : MessageType(other)
@@ -106,6 +111,7 @@ namespace OpenDDS {
       }
 
       const MessageType* message() const { return this; }
+      MessageType* message() { return this; }
 
 #ifndef OPENDDS_HAS_STD_UNIQUE_PTR
       using EnableContainerSupportedUniquePtr<MessageTypeWithAllocator>::_remove_ref;
@@ -114,16 +120,76 @@ namespace OpenDDS {
 #endif
     };
 
+    class SamplePool;
+
     struct MessageTypeMemoryBlock {
       MessageTypeWithAllocator element_;
       ACE_New_Allocator* allocator_;
+      SamplePool* pool_;
     };
 
     typedef OpenDDS::DCPS::Cached_Allocator_With_Overflow<MessageTypeMemoryBlock, ACE_Thread_Mutex>  DataAllocator;
 
+    /**
+     * Samples that are no longer needed are kept here, along with the
+     * buffers of their sequences, so later samples can be deserialized into
+     * them without allocating. Strings are still allocated by the Serializer.
+     * See DCPSReaderSamplePoolSize.
+     */
+    class SamplePool {
+    public:
+      explicit SamplePool(size_t max_samples)
+        : max_samples_(max_samples)
+      {
+        samples_.reserve(max_samples);
+      }
+
+      ~SamplePool()
+      {
+        for (typename SampleVec::iterator it = samples_.begin(); it != samples_.end(); ++it) {
+          delete *it;
+        }
+      }
+
+      /// Returns a sample from the pool, or if it's empty a new one from
+      /// the allocator that will be given back to the pool when released.
+      MessageTypeWithAllocator* get(DataAllocator& allocator)
+      {
+        {
+          ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, 0);
+          if (!samples_.empty()) {
+            MessageTypeWithAllocator* const sample = samples_.back();
+            samples_.pop_back();
+            return sample;
+          }
+        }
+        MessageTypeWithAllocator* const sample = new (allocator) MessageTypeWithAllocator;
+        static_cast<MessageTypeMemoryBlock*>(static_cast<void*>(sample))->pool_ = this;
+        return sample;
+      }
+
+      /// Returns false if the pool is full.
+      bool put(MessageTypeWithAllocator* sample)
+      {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+        if (samples_.size() >= max_samples_) {
+          return false;
+        }
+        samples_.push_back(sample);
+        return true;
+      }
+
+    private:
+      typedef OPENDDS_VECTOR(MessageTypeWithAllocator*) SampleVec;
+      ACE_Thread_Mutex mutex_;
+      const size_t max_samples_;
+      SampleVec samples_;
+    };
+
     DataReaderImpl_T()
       : filter_delayed_sample_task_(make_rch<DRISporadicTask>(TheServiceParticipant->time_source(), TheServiceParticipant->reactor_task(), rchandle_from(this), &DataReaderImpl_T::filter_delayed))
       , marshal_skip_serialize_(false)
+      , lazy_deserialization_(false)
     {
       initialize_lookup_maps();
     }
@@ -148,7 +214,12 @@ namespace OpenDDS {
      */
     virtual DDS::ReturnCode_t enable_specific ()
     {
+      lazy_deserialization_ = TraitsType::key_count() == 0 && TheServiceParticipant->lazy_deserialization();
       data_allocator().reset(new DataAllocator(get_n_chunks ()));
+      const size_t sample_pool_size = TheServiceParticipant->reader_sample_pool_size();
+      if (sample_pool_size) {
+        sample_pool_.reset(new SamplePool(sample_pool_size));
+      }
       if (OpenDDS::DCPS::DCPS_debug_level >= 2)
         ACE_DEBUG((LM_DEBUG,
                    ACE_TEXT("(%P|%t) %CDataReaderImpl::")
@@ -294,7 +365,7 @@ namespace OpenDDS {
       bool most_recent_generation = false;
       for (ReceivedDataElement* item = inst->rcvd_samples_.get_next_match(sample_states, 0);
            !found_data && item; item = inst->rcvd_samples_.get_next_match(sample_states, item)) {
-        if (item->registered_data_) {
+        if (item->registered_data_ && item->complete_data()) {
           received_data = *static_cast<MessageType*>(item->registered_data_);
         }
         inst->instance_state_->sample_info(sample_info_ref, item);
@@ -348,7 +419,7 @@ namespace OpenDDS {
       bool most_recent_generation = false;
       ReceivedDataElement* item = inst->rcvd_samples_.get_next_match(sample_states, 0);
       if (item) {
-        if (item->registered_data_) {
+        if (item->registered_data_ && item->complete_data()) {
           received_data = *static_cast<MessageType*>(item->registered_data_);
         }
         inst->instance_state_->sample_info(sample_info_ref, item);
@@ -386,6 +457,83 @@ namespace OpenDDS {
     return found_data ? DDS::RETCODE_OK : DDS::RETCODE_NO_DATA;
   }
 
+  /**
+   * Take up to max_samples samples of any state, copying them into data and
+   * info, which must each have room for max_samples elements. The sample lock
+   * is held once for the whole batch and there's no sorting or ZeroCopy
+   * bookkeeping, so it's meant for consumers that drain large amounts of
+   * samples. Samples are in instance order, so this isn't available with
+   * ordered or group presentation where take has to be used instead.
+   */
+  DDS::ReturnCode_t take_batch(MessageType* data, BatchSampleInfo* info,
+                               CORBA::ULong max_samples, CORBA::ULong& count)
+  {
+    count = 0;
+    if (!data || !info || max_samples == 0) {
+      return DDS::RETCODE_BAD_PARAMETER;
+    }
+#ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
+    if (subqos_.presentation.ordered_access ||
+        subqos_.presentation.access_scope == DDS::GROUP_PRESENTATION_QOS) {
+      return DDS::RETCODE_PRECONDITION_NOT_MET;
+    }
+#endif
+
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, sample_lock_, DDS::RETCODE_ERROR);
+
+    const Observer_rch observer = get_observer(Observer::e_SAMPLE_TAKEN);
+    const ValueDispatcher* const vd = get_value_dispatcher();
+
+    const CORBA::ULong sample_states = DDS::ANY_SAMPLE_STATE;
+    const HandleSet& matches = lookup_matching_instances(sample_states, DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
+    for (HandleSet::const_iterator it = matches.begin(), next = it;
+         it != matches.end() && count < max_samples; it = next) {
+      ++next; // pre-increment iterator, in case updates cause changes to match set
+      const DDS::InstanceHandle_t handle = *it;
+      const SubscriptionInstance_rch inst = get_handle_instance(handle);
+      if (!inst) continue;
+
+      bool most_recent_generation = false;
+      ReceivedDataElement* item = inst->rcvd_samples_.get_next_match(sample_states, 0);
+      while (item && count < max_samples) {
+        ReceivedDataElement* const next_item = inst->rcvd_samples_.get_next_match(sample_states, item);
+        // Like take, samples without valid data only have their key fields
+        // set, so nothing is left over from what the caller passed in.
+        if (item->registered_data_ && item->complete_data()) {
+          data[count] = *static_cast<MessageType*>(item->registered_data_);
+        } else {
+          data[count] = MessageType();
+        }
+        BatchSampleInfo& bsi = info[count];
+        bsi.instance_handle = handle;
+        bsi.instance_state = inst->instance_state_->instance_state();
+        bsi.source_timestamp = item->source_timestamp_;
+        bsi.publication = item->pub_;
+        bsi.valid_data = item->valid_data_;
+        ++count;
+
+        inst->rcvd_samples_.mark_read(item);
+        if (observer && item->registered_data_ && vd) {
+          Observer::Sample s(handle, bsi.instance_state, *item, *vd);
+          observer->on_sample_taken(this, s);
+        }
+        if (!most_recent_generation) {
+          most_recent_generation = inst->instance_state_->most_recent_generation(item);
+          if (most_recent_generation) {
+            inst->instance_state_->accessed();
+          }
+        }
+
+        inst->rcvd_samples_.remove(item);
+        item->dec_ref();
+        item = next_item;
+      }
+    }
+
+    post_read_or_take();
+    return count ? DDS::RETCODE_OK : DDS::RETCODE_NO_DATA;
+  }
+
   virtual DDS::ReturnCode_t read_instance (
                                              MessageSequenceType & received_data,
                                              DDS::SampleInfoSeq & info_seq,
@@ -725,7 +873,8 @@ namespace OpenDDS {
 
       for (ReceivedDataElement* item = inst->rcvd_samples_.get_next_match(sample_states, 0); item;
            item = inst->rcvd_samples_.get_next_match(sample_states, item)) {
-        if (!item->registered_data_ || (!item->valid_data_ && filter_has_non_key_fields)) {
+        if (!item->registered_data_ || !item->complete_data() ||
+            (!item->valid_data_ && filter_has_non_key_fields)) {
           continue;
         }
         if (evaluator.eval(*static_cast<MessageType*>(item->registered_data_), params)) {
@@ -1082,7 +1231,11 @@ protected:
                              bool& filtered,
                              OpenDDS::DCPS::MarshalingType marshaling_type)
   {
-    unique_ptr<MessageTypeWithAllocator> data(new (*data_allocator()) MessageTypeWithAllocator);
+    // Key-only samples are left as default-constructed apart from the key, so
+    // they can't reuse an old sample.
+    unique_ptr<MessageTypeWithAllocator> data(
+      marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING ?
+      new (*data_allocator()) MessageTypeWithAllocator : new_sample());
     dynamic_hook(*data);
 
     Message_Block_Ptr payload(sample.data(&mb_alloc_));
@@ -1152,6 +1305,16 @@ protected:
     const bool key_only_marshaling =
       marshaling_type == OpenDDS::DCPS::KEY_ONLY_MARSHALING;
 
+    if (defer_deserialization(sample.header_, key_only_marshaling)) {
+      // The type has no keys, so the instance doesn't depend on the sample and
+      // deserializing it can wait until it's read or taken.
+      deferred_payload_.reset(payload->duplicate());
+      deferred_encoding_ = ser.encoding();
+      store_instance_data(OPENDDS_MOVE_NS::move(data), publication_handle, sample.header_, instance, just_registered, filtered);
+      deferred_payload_.reset();
+      return;
+    }
+
     bool ser_ret = true;
     if (key_only_marshaling) {
       ser_ret = ser >> OpenDDS::DCPS::KeyOnly<MessageType>(*data);
@@ -1208,6 +1371,29 @@ protected:
     store_instance_data(OPENDDS_MOVE_NS::move(data), publication_handle, sample.header_, instance, just_registered, filtered);
   }
 
+  bool defer_deserialization(const DataSampleHeader& header, bool key_only_marshaling)
+  {
+    if (!lazy_deserialization_ || key_only_marshaling ||
+        header.message_id_ != SAMPLE_DATA || !header.valid_data()) {
+      return false;
+    }
+
+    // These need the sample when it arrives
+    if (!TimeDuration(qos_.time_based_filter.minimum_separation).is_zero() ||
+        get_observer(Observer::e_SAMPLE_RECEIVED)) {
+      return false;
+    }
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    if (!header.content_filter_) {
+      ACE_Guard<ACE_Thread_Mutex> guard(content_filtered_topic_mutex_);
+      if (content_filtered_topic_) {
+        return false;
+      }
+    }
+#endif
+    return true;
+  }
+
   virtual void dispose_unregister(const OpenDDS::DCPS::ReceivedDataSample& sample,
                                   DDS::InstanceHandle_t publication_handle,
                                   OpenDDS::DCPS::SubscriptionInstance_rch& instance)
@@ -1362,7 +1548,6 @@ private:
     int)
 #endif
 {
-
   typename DDSTraits<MessageType>::MessageSequenceAdapterType received_data_p(received_data);
 
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
@@ -1404,7 +1589,7 @@ private:
         results.insert_sample(item, &inst->rcvd_samples_, inst, ++i);
 
         const ValueDispatcher* vd = get_value_dispatcher();
-        if (observer && item->registered_data_ && vd) {
+        if (observer && item->registered_data_ && vd && item->complete_data()) {
           Observer::Sample s(handle, inst->instance_state_->instance_state(), *item, *vd);
           observer->on_sample_read(this, s);
         }
@@ -1415,7 +1600,7 @@ private:
     const RakeData item = group_coherent_ordered_data_.get_data();
     results.insert_sample(item.rde_, item.rdel_, item.si_, item.index_in_instance_);
     const ValueDispatcher* vd = get_value_dispatcher();
-    if (observer && item.rde_->registered_data_ && vd) {
+    if (observer && item.rde_->registered_data_ && vd && item.rde_->complete_data()) {
       typename InstanceMap::iterator i = instance_map_.begin();
       const DDS::InstanceHandle_t handle = (i != instance_map_.end()) ? i->second : DDS::HANDLE_NIL;
       Observer::Sample s(handle, item.si_->instance_state_->instance_state(), *item.rde_, *vd);
@@ -1491,7 +1676,7 @@ DDS::ReturnCode_t take_i(MessageSequenceType& received_data,
         results.insert_sample(item, &inst->rcvd_samples_, inst, ++i);
 
         const ValueDispatcher* vd = get_value_dispatcher();
-        if (observer && item->registered_data_ && vd) {
+        if (observer && item->registered_data_ && vd && item->complete_data()) {
           Observer::Sample s(handle, inst->instance_state_->instance_state(), *item, *vd);
           observer->on_sample_taken(this, s);
         }
@@ -1550,7 +1735,7 @@ DDS::ReturnCode_t read_instance_i(MessageSequenceType& received_data,
          item = inst->rcvd_samples_.get_next_match(sample_states, item)) {
       results.insert_sample(item, &inst->rcvd_samples_, inst, ++i);
       const ValueDispatcher* vd = get_value_dispatcher();
-      if (observer && item->registered_data_ && vd) {
+      if (observer && item->registered_data_ && vd && item->complete_data()) {
         Observer::Sample s(a_handle, inst->instance_state_->instance_state(), *item, *vd);
         observer->on_sample_read(this, s);
       }
@@ -1617,7 +1802,7 @@ DDS::ReturnCode_t take_instance_i(MessageSequenceType& received_data,
          item = inst->rcvd_samples_.get_next_match(sample_states, item)) {
       results.insert_sample(item, &inst->rcvd_samples_, inst, ++i);
       const ValueDispatcher* vd = get_value_dispatcher();
-      if (observer && item->registered_data_ && vd) {
+      if (observer && item->registered_data_ && vd && item->complete_data()) {
         Observer::Sample s(a_handle, inst->instance_state_->instance_state(), *item, *vd);
         observer->on_sample_taken(this, s);
       }
@@ -2117,6 +2302,11 @@ void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_da
     new (*rd_allocator_.get()) ReceivedDataElementWithType<MessageTypeWithAllocator>(
       header, instance_data.release(), &sample_lock_);
 
+  if (deferred_payload_) {
+    ptr->deferred_payload_.reset(deferred_payload_.release());
+    ptr->deferred_encoding_ = deferred_encoding_;
+  }
+
   ptr->disposed_generation_count_ =
     instance_ptr->instance_state_->disposed_generation_count();
   ptr->no_writers_generation_count_ =
@@ -2190,6 +2380,7 @@ void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_da
           sub->set_status_changed_flag(DDS::DATA_ON_READERS_STATUS, false);
           sub.reset();
           ACE_GUARD(typename DataReaderImpl::Reverse_Lock_t, unlock_guard, reverse_sample_lock_);
+          OPENDDS_TRACE_SCOPE(LISTENER_UPCALL, get_instance_handle());
           listener->on_data_available(this);
         } else {
           TheServiceParticipant->job_queue()->enqueue(make_rch<OnDataAvailable>(listener, rchandle_from(static_cast<DataReaderImpl*>(this)), true, true, true));
@@ -2462,7 +2653,18 @@ void filter_delayed(const MonotonicTimePoint& now)
 
 unique_ptr<DataAllocator>& data_allocator() { return data_allocator_; }
 
+/// Reuse a sample from sample_pool_ if there is one.
+MessageTypeWithAllocator* new_sample()
+{
+  if (sample_pool_) {
+    return sample_pool_->get(*data_allocator());
+  }
+  return new (*data_allocator()) MessageTypeWithAllocator;
+}
+
 unique_ptr<DataAllocator> data_allocator_;
+/// Declared after data_allocator_ because the samples it holds are freed to it.
+unique_ptr<SamplePool> sample_pool_;
 
 InstanceMap instance_map_;
 ReverseInstanceMap reverse_instance_map_;
@@ -2493,6 +2695,13 @@ FilterDelayedSampleQueue filter_delayed_sample_queue_;
 
 bool marshal_skip_serialize_;
 
+/// See DCPSLazyDeserialization
+bool lazy_deserialization_;
+/// Serialized sample passed from dds_demarshal to finish_store_instance_data
+/// when deserializing it is deferred.
+Message_Block_Ptr deferred_payload_;
+Encoding deferred_encoding_;
+
 };
 
 template <typename MessageType>
@@ -2502,6 +2711,7 @@ void* DataReaderImpl_T<MessageType>::MessageTypeWithAllocator::operator new(size
   MessageTypeMemoryBlock* block =
     static_cast<MessageTypeMemoryBlock*>(pool.malloc(sizeof(MessageTypeMemoryBlock)));
   block->allocator_ = &pool;
+  block->pool_ = 0;
   return block;
 }
 
@@ -2520,6 +2730,17 @@ void DataReaderImpl_T<MessageType>::MessageTypeWithAllocator::operator delete(vo
   operator delete(memory);
 }
 
+template <typename MessageType>
+void DataReaderImpl_T<MessageType>::MessageTypeWithAllocator::release(MessageTypeWithAllocator* sample)
+{
+  if (sample) {
+    SamplePool* const pool = static_cast<MessageTypeMemoryBlock*>(static_cast<void*>(sample))->pool_;
+    if (!pool || !pool->put(sample)) {
+      delete sample;
+    }
+  }
+}
+
 }
 }
 
@@ -20,6 +20,7 @@
 #include "Serializer.h"
 #include "Service_Participant.h"
 #include "TopicImpl.h"
+#include "Tracepoints.h"
 #include "Transient_Kludge.h"
 #include "TypeSupportImpl.h"
 #include "Util.h"
@@ -114,6 +115,8 @@ DataWriterImpl::~DataWriterImpl()
 {
   DBG_ENTRY_LVL("DataWriterImpl", "~DataWriterImpl", 6);
 
+  // Stop periodic reports before any of the writer goes away
+  periodic_monitor_.reset();
   liveliness_send_task_->cancel();
   liveliness_lost_task_->cancel();
 
@@ -1869,6 +1872,7 @@ DataWriterImpl::write(Message_Block_Ptr data,
                       const void* real_data)
 {
   DBG_ENTRY_LVL("DataWriterImpl","write",6);
+  OPENDDS_TRACE_SCOPE(WRITE, handle);
 
   ACE_Guard<ACE_Recursive_Thread_Mutex> guard(lock_);
 
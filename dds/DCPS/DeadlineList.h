@@ -0,0 +1,159 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_DEADLINE_LIST_H
+#define OPENDDS_DCPS_DEADLINE_LIST_H
+
+#include "RcHandle_T.h"
+#include "TimeTypes.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/// Links an instance into a DeadlineList.
+template <typename Instance>
+struct DeadlineLink {
+  DeadlineLink()
+    : prev_(0)
+    , next_(0)
+    , linked_(false)
+  {}
+
+  Instance* prev_;
+  Instance* next_;
+  bool linked_;
+};
+
+/**
+ * @class DeadlineList
+ *
+ * @brief Instances in order of their deadline_
+ *
+ * All the instances of a reader or writer share a deadline period, so a new
+ * deadline is almost always the latest one.  Insertion searches from the end
+ * of the list and is constant time unless the period was just changed.
+ * Instances are linked through their deadline_link_ member, so nothing is
+ * allocated and an instance is moved in constant time each time a sample for
+ * it is written or received.
+ *
+ * The list holds a reference to each instance in it.
+ */
+template <typename Instance>
+class DeadlineList {
+public:
+  typedef RcHandle<Instance> Instance_rch;
+
+  DeadlineList()
+    : head_(0)
+    , tail_(0)
+    , size_(0)
+  {}
+
+  ~DeadlineList()
+  {
+    clear();
+  }
+
+  bool empty() const { return head_ == 0; }
+  size_t size() const { return size_; }
+
+  /// Instance with the earliest deadline.  The list must not be empty.
+  Instance_rch front() const
+  {
+    return Instance_rch(head_, inc_count());
+  }
+
+  static bool contains(const Instance& instance)
+  {
+    return instance.deadline_link_.linked_;
+  }
+
+  /// Set the deadline of the instance, moving it if it's already in the list.
+  void insert(Instance& instance, const MonotonicTimePoint& deadline)
+  {
+    if (instance.deadline_link_.linked_) {
+      unlink(instance);
+    } else {
+      instance._add_ref();
+      instance.deadline_link_.linked_ = true;
+      ++size_;
+    }
+    instance.deadline_ = deadline;
+
+    Instance* after = tail_;
+    while (after && deadline < after->deadline_) {
+      after = after->deadline_link_.prev_;
+    }
+    instance.deadline_link_.prev_ = after;
+    instance.deadline_link_.next_ = after ? after->deadline_link_.next_ : head_;
+    if (instance.deadline_link_.next_) {
+      instance.deadline_link_.next_->deadline_link_.prev_ = &instance;
+    } else {
+      tail_ = &instance;
+    }
+    if (after) {
+      after->deadline_link_.next_ = &instance;
+    } else {
+      head_ = &instance;
+    }
+  }
+
+  /// Remove the instance if it's in the list.  Its deadline_ is unchanged.
+  bool remove(Instance& instance)
+  {
+    if (!instance.deadline_link_.linked_) {
+      return false;
+    }
+    unlink(instance);
+    instance.deadline_link_.linked_ = false;
+    --size_;
+    instance._remove_ref();
+    return true;
+  }
+
+  void clear()
+  {
+    while (head_) {
+      remove(*head_);
+    }
+  }
+
+private:
+  DeadlineList(const DeadlineList&);
+  DeadlineList& operator=(const DeadlineList&);
+
+  void unlink(Instance& instance)
+  {
+    DeadlineLink<Instance>& link = instance.deadline_link_;
+    if (link.prev_) {
+      link.prev_->deadline_link_.next_ = link.next_;
+    } else {
+      head_ = link.next_;
+    }
+    if (link.next_) {
+      link.next_->deadline_link_.prev_ = link.prev_;
+    } else {
+      tail_ = link.prev_;
+    }
+    link.prev_ = link.next_ = 0;
+  }
+
+  Instance* head_;
+  Instance* tail_;
+  size_t size_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_DEADLINE_LIST_H */
@@ -113,6 +113,10 @@
 #  define OPENDDS_CONFIG_BOOTTIME_TIMERS 0
 #endif
 
+#ifndef OPENDDS_CONFIG_TRACEPOINTS
+#  define OPENDDS_CONFIG_TRACEPOINTS 0
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
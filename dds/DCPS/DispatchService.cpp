@@ -12,19 +12,36 @@
 #include "Service_Participant.h"
 #include "TimeDuration.h"
 
-#include <ace/Reverse_Lock_T.h>
+#include <algorithm>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  ACE_UINT64 to_usec(const MonotonicTimePoint& time)
+  {
+    if (time.is_max()) {
+      return ACE_UINT64(-1);
+    }
+    ACE_UINT64 usec;
+    time.value().to_usec(usec);
+    return usec;
+  }
+}
+
 DispatchService::DispatchService(size_t count)
  : cv_(mutex_)
  , allow_dispatch_(true)
  , stop_when_empty_(false)
  , running_(true)
  , running_threads_(0)
+ , sleeping_threads_(0)
+ , queues_(make_queues(count))
+ , next_queue_(0)
+ , next_worker_(0)
+ , next_timer_usec_(ACE_UINT64(-1))
  , max_timer_id_(LONG_MAX)
  , pool_(count, run, this)
 {
@@ -35,12 +52,25 @@ DispatchService::~DispatchService()
   shutdown();
 }
 
+DispatchService::WorkerQueues DispatchService::make_queues(size_t count)
+{
+  WorkerQueues queues;
+  for (size_t i = 0; i < std::max(count, size_t(1)); ++i) {
+    queues.push_back(make_rch<WorkerQueue>());
+  }
+  return queues;
+}
+
 void DispatchService::shutdown(bool immediate, EventQueue* const pending)
 {
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
   allow_dispatch_ = false;
   stop_when_empty_ = true;
   running_ = running_ && !immediate; // && with existing state in case shutdown has already been called
+  // Let any dispatch that saw allow_dispatch_ before it was cleared finish
+  for (WorkerQueues::const_iterator it = queues_.begin(); it != queues_.end(); ++it) {
+    ACE_Guard<ACE_Thread_Mutex> queue_guard((*it)->mutex_);
+  }
   cv_.notify_all();
 
   if (pool_.contains(ACE_Thread::self())) {
@@ -59,16 +89,10 @@ void DispatchService::shutdown(bool immediate, EventQueue* const pending)
 
   if (pending) {
     pending->clear();
-    pending->swap(event_queue_);
-    const TimerQueueMap& cmap = timer_queue_map_;
-    for (TimerQueueMap::const_iterator it = cmap.begin(), limit = cmap.end(); it != limit; ++it) {
-      pending->push_back(it->second.first);
-    }
-  } else {
-    event_queue_.clear();
   }
-  timer_queue_map_.clear();
-  timer_id_map_.clear();
+  take_events(pending);
+  timer_wheel_.clear(pending);
+  next_timer_usec_ = ACE_UINT64(-1);
 }
 
 DispatchService::DispatchStatus DispatchService::dispatch(FunPtr fun, void* arg)
@@ -77,13 +101,22 @@ DispatchService::DispatchStatus DispatchService::dispatch(FunPtr fun, void* arg)
     return DS_ERROR;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  if (allow_dispatch_) {
-    event_queue_.push_back(std::make_pair(fun, arg));
+  {
+    WorkerQueue& queue = next_queue();
+    ACE_Guard<ACE_Thread_Mutex> guard(queue.mutex_);
+    if (!allow_dispatch_) {
+      return DS_ERROR;
+    }
+    queue.events_.push_back(std::make_pair(fun, arg));
+  }
+
+  // A thread increments sleeping_threads_ before checking the queues for the
+  // last time, so either it sees this event or this sees it sleeping.
+  if (sleeping_threads_) {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     cv_.notify_one();
-    return DS_SUCCESS;
   }
-  return DS_ERROR;
+  return DS_SUCCESS;
 }
 
 DispatchService::TimerId DispatchService::schedule(FunPtr fun, void* arg, const MonotonicTimePoint& expiration)
@@ -95,7 +128,6 @@ DispatchService::TimerId DispatchService::schedule(FunPtr fun, void* arg, const
   TimerId id = 0;
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
   if (allow_dispatch_) {
-    TimerQueueMap::iterator pos = timer_queue_map_.insert(std::make_pair(expiration, std::make_pair(std::make_pair(fun, arg), 0)));
     // Make it a loop in case we ever recycle timer ids
     const TimerId starting_id = max_timer_id_;
     do {
@@ -103,9 +135,12 @@ DispatchService::TimerId DispatchService::schedule(FunPtr fun, void* arg, const
       if (id == starting_id) {
         return TI_FAILURE; // all ids in use ?!
       }
-      pos->second.second = id;
-    } while (timer_id_map_.insert(std::make_pair(id, pos)).second == false);
-    cv_.notify_one();
+    } while (!timer_wheel_.insert(id, std::make_pair(fun, arg), expiration));
+    const ACE_UINT64 usec = to_usec(expiration);
+    if (usec < next_timer_usec_) {
+      next_timer_usec_ = usec;
+      cv_.notify_one();
+    }
     return id;
   }
   return TI_FAILURE;
@@ -114,16 +149,12 @@ DispatchService::TimerId DispatchService::schedule(FunPtr fun, void* arg, const
 size_t DispatchService::cancel(DispatchService::TimerId id, void** arg)
 {
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  TimerIdMap::iterator pos = timer_id_map_.find(id);
-  if (pos != timer_id_map_.end()) {
-    if (pos->second == timer_queue_map_.begin()) {
-      cv_.notify_all();
-    }
+  // next_timer_usec_ is left alone, since being early is harmless
+  FunArgPair pair;
+  if (timer_wheel_.erase(id, &pair)) {
     if (arg) {
-      *arg = pos->second->second.first.second;
+      *arg = pair.second;
     }
-    timer_queue_map_.erase(pos->second);
-    timer_id_map_.erase(pos);
     return 1;
   }
   return 0;
@@ -132,21 +163,8 @@ size_t DispatchService::cancel(DispatchService::TimerId id, void** arg)
 size_t DispatchService::cancel(FunPtr fun, void* arg)
 {
   OPENDDS_ASSERT(fun);
-  size_t count = 0;
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  for (TimerQueueMap::iterator it = timer_queue_map_.begin(); it != timer_queue_map_.end();) {
-    if (it->second.first.first == fun && it->second.first.second == arg) {
-      if (it == timer_queue_map_.begin()) {
-        cv_.notify_all();
-      }
-      timer_id_map_.erase(it->second.second);
-      timer_queue_map_.erase(it++);
-      ++count;
-    } else {
-      ++it;
-    }
-  }
-  return count;
+  return timer_wheel_.erase(std::make_pair(fun, arg));
 }
 
 ACE_THR_FUNC_RETURN DispatchService::run(void* arg)
@@ -156,54 +174,110 @@ ACE_THR_FUNC_RETURN DispatchService::run(void* arg)
   return 0;
 }
 
+DispatchService::WorkerQueue& DispatchService::next_queue()
+{
+  return *queues_[next_queue_++ % queues_.size()];
+}
+
+bool DispatchService::pop_event(size_t worker, FunArgPair& pair)
+{
+  // Start with this thread's queue and then take from the others, oldest
+  // first so taken events aren't delayed any further.
+  const size_t count = queues_.size();
+  for (size_t i = 0; i < count; ++i) {
+    WorkerQueue& queue = *queues_[(worker + i) % count];
+    ACE_Guard<ACE_Thread_Mutex> guard(queue.mutex_);
+    if (!queue.events_.empty()) {
+      pair = queue.events_.front();
+      queue.events_.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DispatchService::has_events() const
+{
+  for (WorkerQueues::const_iterator it = queues_.begin(); it != queues_.end(); ++it) {
+    ACE_Guard<ACE_Thread_Mutex> guard((*it)->mutex_);
+    if (!(*it)->events_.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DispatchService::take_events(EventQueue* pending)
+{
+  for (WorkerQueues::const_iterator it = queues_.begin(); it != queues_.end(); ++it) {
+    ACE_Guard<ACE_Thread_Mutex> guard((*it)->mutex_);
+    if (pending) {
+      pending->insert(pending->end(), (*it)->events_.begin(), (*it)->events_.end());
+    }
+    (*it)->events_.clear();
+  }
+}
+
+void DispatchService::expire_timers()
+{
+  EventQueue expired;
+  timer_wheel_.expire(MonotonicTimePoint::now(), expired);
+  next_timer_usec_ = to_usec(timer_wheel_.next_expiration());
+  for (EventQueue::const_iterator it = expired.begin(); it != expired.end(); ++it) {
+    WorkerQueue& queue = next_queue();
+    ACE_Guard<ACE_Thread_Mutex> guard(queue.mutex_);
+    queue.events_.push_back(*it);
+  }
+  if (expired.size() > 1) {
+    cv_.notify_all();
+  }
+}
+
 void DispatchService::run_event_loop()
 {
   ThreadStatusManager& thread_status_manager = TheServiceParticipant->get_thread_status_manager();
-  ACE_Reverse_Lock<ACE_Thread_Mutex> rev_lock(mutex_);
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  ++running_threads_;
+  const size_t worker = next_worker_++ % queues_.size();
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    ++running_threads_;
+  }
   while (running_) {
 
     // Logical Order:
-    // - Move expired timer events into normal event queue
-    // - Wait appropriate length if there's nothing to do
-    // - Check for early exit before execution
-    // - Run first task from event queue
-
-    if (allow_dispatch_ && !timer_queue_map_.empty()) {
-      const MonotonicTimePoint now = MonotonicTimePoint::now();
-
-      TimerQueueMap::iterator last = timer_queue_map_.upper_bound(now), pos = last;
-      while (pos != timer_queue_map_.begin()) {
-        --pos;
-        event_queue_.push_back(pos->second.first);
-        timer_id_map_.erase(pos->second.second);
-      }
-      if (last != timer_queue_map_.begin()) {
-        timer_queue_map_.erase(timer_queue_map_.begin(), last);
-      }
+    // - Move expired timer events into the event queues
+    // - Run the first event from this thread's queue or another's
+    // - Otherwise wait appropriate length, unless shutting down
+
+    if (allow_dispatch_ && next_timer_usec_ <= to_usec(MonotonicTimePoint::now())) {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+      expire_timers();
+    }
+
+    FunArgPair pair;
+    if (running_ && pop_event(worker, pair)) {
+      ThreadStatusManager::Event ev(thread_status_manager);
+      pair.first(pair.second);
+      continue;
     }
 
-    if (event_queue_.empty()) {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    ++sleeping_threads_;
+    if (running_ && !has_events()) {
+      // Make schedule wake this thread for any timer before it would wake
+      const MonotonicTimePoint deadline = timer_wheel_.next_expiration();
+      next_timer_usec_ = to_usec(deadline);
       if (stop_when_empty_) {
         running_ = false;
         cv_.notify_all();
-      } else if (allow_dispatch_ && timer_queue_map_.size()) {
-        MonotonicTimePoint deadline(timer_queue_map_.begin()->first);
+      } else if (allow_dispatch_ && !timer_wheel_.empty()) {
         cv_.wait_until(deadline, thread_status_manager);
       } else {
         cv_.wait(thread_status_manager);
       }
     }
-
-    if (!running_ || event_queue_.empty()) continue;
-
-    FunArgPair pair = event_queue_.front();
-    event_queue_.pop_front();
-    ACE_Guard<ACE_Reverse_Lock<ACE_Thread_Mutex> > rev_guard(rev_lock);
-    ThreadStatusManager::Event ev(thread_status_manager);
-    pair.first(pair.second);
+    --sleeping_threads_;
   }
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
   --running_threads_;
   cv_.notify_all();
 }
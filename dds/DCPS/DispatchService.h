@@ -8,11 +8,13 @@
 #ifndef OPENDDS_DCPS_DISPATCH_SERVICE_H
 #define OPENDDS_DCPS_DISPATCH_SERVICE_H
 
+#include "Atomic.h"
 #include "ConditionVariable.h"
 #include "Definitions.h"
 #include "RcObject.h"
 #include "ThreadPool.h"
 #include "TimePoint_T.h"
+#include "TimerWheel.h"
 
 #include <ace/Thread_Mutex.h>
 
@@ -53,7 +55,8 @@ public:
 
   /**
    * Create a DispatchService
-   * @param count the requested size of the internal thread pool
+   * @param count the requested size of the internal thread pool.  Each thread
+   * has its own event queue and takes events from the others when it is empty.
    */
   explicit DispatchService(size_t count = 1);
 
@@ -126,19 +129,39 @@ private:
   static ACE_THR_FUNC_RETURN run(void* arg);
   void run_event_loop();
 
-  typedef std::pair<FunArgPair, TimerId> TimerPair;
-  typedef OPENDDS_MULTIMAP(MonotonicTimePoint, TimerPair) TimerQueueMap;
-  typedef OPENDDS_MAP(TimerId, TimerQueueMap::iterator) TimerIdMap;
-
+  struct WorkerQueue : public RcObject {
+    ACE_Thread_Mutex mutex_;
+    EventQueue events_;
+  };
+  typedef RcHandle<WorkerQueue> WorkerQueue_rch;
+  typedef OPENDDS_VECTOR(WorkerQueue_rch) WorkerQueues;
+
+  static WorkerQueues make_queues(size_t count);
+  WorkerQueue& next_queue();
+  bool pop_event(size_t worker, FunArgPair& pair);
+  bool has_events() const;
+  void take_events(EventQueue* pending);
+  /// Requires mutex_
+  void expire_timers();
+
+  /// Guards the timers and the state below that isn't atomic, and is the
+  /// mutex threads wait on when there are no events.  Worker queues are
+  /// locked after this one when both are needed.
   mutable ACE_Thread_Mutex mutex_;
   mutable ConditionVariable<ACE_Thread_Mutex> cv_;
-  bool allow_dispatch_;
+  Atomic<bool> allow_dispatch_;
   bool stop_when_empty_;
-  bool running_;
+  Atomic<bool> running_;
   size_t running_threads_;
-  EventQueue event_queue_;
-  TimerQueueMap timer_queue_map_;
-  TimerIdMap timer_id_map_;
+  /// dispatch only takes mutex_ to wake threads when this isn't 0
+  Atomic<size_t> sleeping_threads_;
+  const WorkerQueues queues_;
+  Atomic<size_t> next_queue_;
+  Atomic<size_t> next_worker_;
+  TimerWheel timer_wheel_;
+  /// No later than the next timer expiration, in microseconds, so threads
+  /// don't need mutex_ to see that no timers have expired.
+  Atomic<ACE_UINT64> next_timer_usec_;
   TimerId max_timer_id_;
   ThreadPool pool_;
 };
@@ -131,6 +131,7 @@ DomainParticipantImpl::DomainParticipantImpl(
   (void) this->set_listener(a_listener, mask);
   monitor_.reset(TheServiceParticipant->monitor_factory_->create_dp_monitor(this));
   type_lookup_service_ = make_rch<XTypes::TypeLookupService>();
+  type_lookup_service_->type_object_cache(TheServiceParticipant->type_object_cache());
 }
 
 DomainParticipantImpl::~DomainParticipantImpl()
@@ -0,0 +1,475 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#ifndef OPENDDS_NO_PERSISTENCE_PROFILE
+
+#include "DurabilityLog.h"
+
+#include "DirentWrapper.h"
+#include "Serializer.h"
+#include "debug.h"
+
+#include <ace/ACE.h>
+#include <ace/Mem_Map.h>
+#include <ace/OS_NS_errno.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  const char segment_prefix[] = "durability-";
+  const char segment_suffix[] = ".log";
+  const char segment_magic[] = "ODDSDLG1";
+  const size_t magic_size = sizeof segment_magic - 1;
+  /// Body length and CRC of the body
+  const size_t record_header_size = 8;
+
+  const Encoding encoding(Encoding::KIND_UNALIGNED_CDR, ENDIAN_LITTLE);
+
+  bool parse_segment_name(const char* name, unsigned int& segment)
+  {
+    const size_t prefix_len = sizeof segment_prefix - 1;
+    const size_t suffix_len = sizeof segment_suffix - 1;
+    const size_t len = ACE_OS::strlen(name);
+    if (len <= prefix_len + suffix_len ||
+        ACE_OS::strncmp(name, segment_prefix, prefix_len) != 0 ||
+        ACE_OS::strcmp(name + len - suffix_len, segment_suffix) != 0) {
+      return false;
+    }
+    char* end = 0;
+    const unsigned long value = ACE_OS::strtoul(name + prefix_len, &end, 10);
+    if (end != name + len - suffix_len) {
+      return false;
+    }
+    segment = static_cast<unsigned int>(value);
+    return true;
+  }
+}
+
+DurabilityLog::DurabilityLog(const String& directory, size_t segment_size)
+  : directory_(directory)
+  , segment_size_(segment_size)
+  , handle_(ACE_INVALID_HANDLE)
+  , segment_bytes_(0)
+  , compaction_start_(0)
+  , compacting_(false)
+  , next_queue_id_(0)
+  , live_bytes_(0)
+  , total_bytes_(0)
+{
+  if (ACE_OS::mkdir(ACE_TEXT_CHAR_TO_TCHAR(directory_.c_str())) == -1 && errno != EEXIST) {
+    throw std::runtime_error("DurabilityLog: could not create directory " + directory_);
+  }
+
+  ACE_Dirent dir;
+  if (dir.open(ACE_TEXT_CHAR_TO_TCHAR(directory_.c_str())) == -1) {
+    throw std::runtime_error("DurabilityLog: could not open directory " + directory_);
+  }
+  for (ACE_DIRENT* ent = dir.read(); ent; ent = dir.read()) {
+    unsigned int segment;
+    if (parse_segment_name(ACE_TEXT_ALWAYS_CHAR(ent->d_name), segment)) {
+      segments_.push_back(segment);
+    }
+  }
+  std::sort(segments_.begin(), segments_.end());
+}
+
+DurabilityLog::~DurabilityLog()
+{
+  commit();
+  close_segment();
+}
+
+String DurabilityLog::segment_path(unsigned int segment) const
+{
+  char name[32];
+  ACE_OS::snprintf(name, sizeof name, "%s%08u%s", segment_prefix, segment, segment_suffix);
+  return directory_ + '/' + name;
+}
+
+void DurabilityLog::replay(Replayer& replayer)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, mutex_);
+
+  // The first pass finds which segments were written by compactions and
+  // which of those compactions finished.
+  Compactions compactions;
+  for (Segments::const_iterator it = segments_.begin(); it != segments_.end(); ++it) {
+    read_segment(*it, PASS_MARKERS, 0, compactions);
+  }
+
+  // Everything before the last compaction that finished was rewritten by it,
+  // so these segments are only here if the process stopped before
+  // end_compaction() removed them.
+  if (!compactions.finished.empty()) {
+    const Segments::iterator first_live =
+      std::lower_bound(segments_.begin(), segments_.end(), *compactions.finished.rbegin());
+    for (Segments::iterator it = segments_.begin(); it != first_live; ++it) {
+      ACE_OS::unlink(ACE_TEXT_CHAR_TO_TCHAR(segment_path(*it).c_str()));
+    }
+    segments_.erase(segments_.begin(), first_live);
+  }
+
+  // The second pass finds the dropped queues so the third can skip them.
+  queue_bytes_.clear();
+  dropped_.clear();
+  live_bytes_ = total_bytes_ = 0;
+  for (Segments::const_iterator it = segments_.begin(); it != segments_.end(); ++it) {
+    read_segment(*it, PASS_DROPS, 0, compactions);
+  }
+  for (Segments::const_iterator it = segments_.begin(); it != segments_.end(); ++it) {
+    read_segment(*it, PASS_SAMPLES, &replayer, compactions);
+  }
+  dropped_.clear();
+}
+
+bool DurabilityLog::read_segment(unsigned int segment, ReadPass pass, Replayer* replayer,
+                                 Compactions& compactions)
+{
+  const String path = segment_path(segment);
+  ACE_Mem_Map map;
+  if (map.map(ACE_TEXT_CHAR_TO_TCHAR(path.c_str()), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS,
+              PROT_READ, ACE_MAP_PRIVATE) == -1) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: DurabilityLog::read_segment: "
+                 "could not map %C: %p\n", path.c_str(), ACE_TEXT("mmap")));
+    }
+    return false;
+  }
+
+  const char* const begin = static_cast<const char*>(map.addr());
+  const size_t size = map.size();
+  if (size < magic_size || ACE_OS::memcmp(begin, segment_magic, magic_size) != 0) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: DurabilityLog::read_segment: "
+                 "%C is not a durability log segment\n", path.c_str()));
+    }
+    return false;
+  }
+
+  // The samples in a segment of a compaction that didn't finish are copies
+  // of ones in the segments before it, but the drops there still count.
+  const OPENDDS_MAP(unsigned int, unsigned int)::const_iterator written_by =
+    compactions.written_by.find(segment);
+  const bool copies = written_by != compactions.written_by.end() &&
+    !compactions.finished.count(written_by->second);
+
+  size_t pos = magic_size;
+  while (pos + record_header_size <= size) {
+    ACE_Message_Block header_mb(begin + pos, record_header_size);
+    header_mb.wr_ptr(record_header_size);
+    Serializer header_ser(&header_mb, encoding);
+    ACE_CDR::ULong body_length, crc;
+    if (!(header_ser >> body_length) || !(header_ser >> crc) ||
+        body_length > size - pos - record_header_size) {
+      break;
+    }
+    const char* const body = begin + pos + record_header_size;
+    if (ACE::crc32(body, body_length) != crc) {
+      break;
+    }
+    const size_t record_size = record_header_size + body_length;
+    pos += record_size;
+
+    ACE_Message_Block body_mb(body, body_length);
+    body_mb.wr_ptr(body_length);
+    Serializer ser(&body_mb, encoding);
+    ACE_CDR::Octet kind;
+    QueueId queue_id;
+    if (!(ser >> ACE_InputCDR::to_octet(kind)) || !(ser >> queue_id)) {
+      break;
+    }
+
+    if (kind == RECORD_COMPACTION || kind == RECORD_COMPACTED) {
+      if (pass == PASS_MARKERS) {
+        const unsigned int start = static_cast<unsigned int>(queue_id);
+        if (kind == RECORD_COMPACTION) {
+          compactions.written_by[segment] = start;
+        } else {
+          compactions.finished.insert(start);
+        }
+      }
+      continue;
+    }
+    if (pass == PASS_MARKERS) {
+      continue;
+    }
+
+    if (queue_id >= next_queue_id_) {
+      next_queue_id_ = queue_id + 1;
+    }
+
+    if (kind == RECORD_DROP) {
+      if (pass == PASS_DROPS) {
+        dropped_.insert(queue_id);
+        const QueueBytes::iterator qb = queue_bytes_.find(queue_id);
+        if (qb != queue_bytes_.end()) {
+          live_bytes_ -= qb->second;
+          queue_bytes_.erase(qb);
+        }
+        total_bytes_ += record_size;
+      }
+      continue;
+    }
+
+    if (pass == PASS_DROPS) {
+      if (!copies && !dropped_.count(queue_id)) {
+        queue_bytes_[queue_id] += record_size;
+        live_bytes_ += record_size;
+      }
+      total_bytes_ += record_size;
+      continue;
+    }
+    if (copies || dropped_.count(queue_id)) {
+      continue;
+    }
+
+    Sample sample;
+    sample.queue_id = queue_id;
+    ACE_CDR::ULong length;
+    if (!(ser >> sample.domain_id) || !(ser >> sample.topic_name) || !(ser >> sample.type_name) ||
+        !(ser >> sample.timestamp.sec) || !(ser >> sample.timestamp.nanosec) ||
+        !(ser >> length) || length != body_mb.length()) {
+      break;
+    }
+    sample.data = body_mb.rd_ptr();
+    sample.length = length;
+    replayer->on_sample(sample);
+  }
+
+  if (pos != size && pass == PASS_SAMPLES && log_level >= LogLevel::Notice) {
+    ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DurabilityLog::read_segment: "
+               "ignoring %B bytes at the end of %C\n", size - pos, path.c_str()));
+  }
+  return true;
+}
+
+DurabilityLog::QueueId DurabilityLog::next_queue_id()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, 0);
+  return next_queue_id_++;
+}
+
+bool DurabilityLog::append(QueueId queue_id, DDS::DomainId_t domain_id,
+                           const char* topic_name, const char* type_name,
+                           const DDS::Time_t& timestamp, const char* data, size_t length)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+  if (dropped_.count(queue_id)) {
+    return true;
+  }
+
+  const ACE_CDR::ULong topic_len = static_cast<ACE_CDR::ULong>(ACE_OS::strlen(topic_name) + 1);
+  const ACE_CDR::ULong type_len = static_cast<ACE_CDR::ULong>(ACE_OS::strlen(type_name) + 1);
+  const size_t body_length = 1 + 8 + 4 + 4 + topic_len + 4 + type_len + 4 + 4 + 4 + length;
+  ACE_Message_Block mb(record_header_size + body_length);
+  mb.wr_ptr(record_header_size);
+  Serializer ser(&mb, encoding);
+  if (!(ser << ACE_OutputCDR::from_octet(RECORD_SAMPLE)) || !(ser << queue_id) ||
+      !(ser << domain_id) || !(ser << topic_name) || !(ser << type_name) ||
+      !(ser << timestamp.sec) || !(ser << timestamp.nanosec) ||
+      !(ser << static_cast<ACE_CDR::ULong>(length)) || !ser.write_octet_array(
+        reinterpret_cast<const ACE_CDR::Octet*>(data), static_cast<ACE_CDR::ULong>(length))) {
+    return false;
+  }
+  buffer_record(mb.rd_ptr(), mb.length());
+  queue_bytes_[queue_id] += record_header_size + body_length;
+  live_bytes_ += record_header_size + body_length;
+  return true;
+}
+
+bool DurabilityLog::drop(QueueId queue_id)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+  const QueueBytes::iterator qb = queue_bytes_.find(queue_id);
+  if (qb != queue_bytes_.end()) {
+    live_bytes_ -= qb->second;
+    queue_bytes_.erase(qb);
+  }
+  if (compacting_) {
+    dropped_.insert(queue_id);
+  }
+
+  const size_t before = buffer_.size();
+  if (!id_record(RECORD_DROP, queue_id, buffer_)) {
+    return false;
+  }
+  total_bytes_ += buffer_.size() - before;
+  return true;
+}
+
+void DurabilityLog::frame_record(const char* record, size_t length, OPENDDS_VECTOR(char)& out)
+{
+  // The body starts after the header, which is filled in here.
+  const char* const body = record + record_header_size;
+  const ACE_CDR::ULong body_length = static_cast<ACE_CDR::ULong>(length - record_header_size);
+  ACE_Message_Block header_mb(record_header_size);
+  Serializer ser(&header_mb, encoding);
+  ser << body_length;
+  ser << ACE::crc32(body, body_length);
+
+  out.insert(out.end(), header_mb.rd_ptr(), header_mb.wr_ptr());
+  out.insert(out.end(), body, body + body_length);
+}
+
+bool DurabilityLog::id_record(RecordKind kind, QueueId id, OPENDDS_VECTOR(char)& out)
+{
+  ACE_Message_Block mb(record_header_size + 1 + 8);
+  mb.wr_ptr(record_header_size);
+  Serializer ser(&mb, encoding);
+  if (!(ser << ACE_OutputCDR::from_octet(static_cast<ACE_CDR::Octet>(kind))) || !(ser << id)) {
+    return false;
+  }
+  frame_record(mb.rd_ptr(), mb.length(), out);
+  return true;
+}
+
+void DurabilityLog::buffer_record(const char* record, size_t length)
+{
+  frame_record(record, length, buffer_);
+  total_bytes_ += length;
+}
+
+bool DurabilityLog::commit()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+  if (buffer_.empty()) {
+    return true;
+  }
+
+  if (handle_ == ACE_INVALID_HANDLE &&
+      !open_segment(segments_.empty() ? 0 : segments_.back() + 1)) {
+    return false;
+  }
+
+  const ssize_t written = ACE_OS::write(handle_, &buffer_[0], buffer_.size());
+  if (written != static_cast<ssize_t>(buffer_.size()) || ACE_OS::fsync(handle_) == -1) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: DurabilityLog::commit: "
+                 "could not write %C: %p\n",
+                 segment_path(segments_.back()).c_str(), ACE_TEXT("write")));
+    }
+    // Whatever was partially written will be ignored by replay, but nothing
+    // more can be appended after it.
+    buffer_.clear();
+    close_segment();
+    return false;
+  }
+
+  segment_bytes_ += buffer_.size();
+  buffer_.clear();
+  if (segment_bytes_ >= segment_size_) {
+    close_segment();
+  }
+  return true;
+}
+
+bool DurabilityLog::open_segment(unsigned int segment)
+{
+  // A segment written by a compaction starts with a record saying which one,
+  // so replay() can tell its samples apart from the originals.
+  OPENDDS_VECTOR(char) start(segment_magic, segment_magic + magic_size);
+  if (compacting_) {
+    id_record(RECORD_COMPACTION, compaction_start_, start);
+  }
+
+  const String path = segment_path(segment);
+  handle_ = ACE_OS::open(ACE_TEXT_CHAR_TO_TCHAR(path.c_str()),
+                         O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, ACE_DEFAULT_FILE_PERMS);
+  if (handle_ == ACE_INVALID_HANDLE ||
+      ACE_OS::write(handle_, &start[0], start.size()) != static_cast<ssize_t>(start.size())) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: DurabilityLog::open_segment: "
+                 "could not create %C: %p\n", path.c_str(), ACE_TEXT("open")));
+    }
+    close_segment();
+    return false;
+  }
+  segments_.push_back(segment);
+  segment_bytes_ = start.size();
+  return true;
+}
+
+void DurabilityLog::close_segment()
+{
+  if (handle_ != ACE_INVALID_HANDLE) {
+    ACE_OS::close(handle_);
+    handle_ = ACE_INVALID_HANDLE;
+  }
+}
+
+bool DurabilityLog::needs_compaction() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+  return !compacting_ && total_bytes_ > segment_size_ && total_bytes_ > 2 * live_bytes_;
+}
+
+bool DurabilityLog::begin_compaction()
+{
+  if (!commit()) {
+    return false;
+  }
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+  close_segment();
+  compaction_start_ = segments_.empty() ? 0 : segments_.back() + 1;
+  compacting_ = true;
+  if (!open_segment(compaction_start_)) {
+    compacting_ = false;
+    return false;
+  }
+  queue_bytes_.clear();
+  live_bytes_ = total_bytes_ = 0;
+  return true;
+}
+
+bool DurabilityLog::end_compaction()
+{
+  {
+    // Until this is on disk replay() uses the old segments, and after that
+    // it uses the new ones, so a crash at any point doesn't leave both.
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+    id_record(RECORD_COMPACTED, compaction_start_, buffer_);
+  }
+  const bool committed = commit();
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+  compacting_ = false;
+  dropped_.clear();
+
+  // If the live samples didn't make it to disk the old segments still have
+  // them, so remove the new segments instead.
+  const Segments::iterator first_new =
+    std::lower_bound(segments_.begin(), segments_.end(), compaction_start_);
+  const Segments::iterator begin = committed ? segments_.begin() : first_new;
+  const Segments::iterator end = committed ? first_new : segments_.end();
+  if (!committed) {
+    close_segment();
+  }
+  for (Segments::iterator it = begin; it != end; ++it) {
+    ACE_OS::unlink(ACE_TEXT_CHAR_TO_TCHAR(segment_path(*it).c_str()));
+  }
+  segments_.erase(begin, end);
+  return committed;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_NO_PERSISTENCE_PROFILE
@@ -0,0 +1,171 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_DURABILITYLOG_H
+#define OPENDDS_DCPS_DURABILITYLOG_H
+
+#ifndef OPENDDS_NO_PERSISTENCE_PROFILE
+
+#include "Definitions.h"
+#include "PoolAllocator.h"
+#include "dcps_export.h"
+
+#include <dds/DdsDcpsInfrastructureC.h>
+
+#include <ace/Thread_Mutex.h>
+
+#ifndef ACE_LACKS_PRAGMA_ONCE
+#  pragma once
+#endif
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class DurabilityLog
+ *
+ * @brief Append-only storage for @c PERSISTENT durable data.
+ *
+ * Samples are appended to numbered segment files in a single directory
+ * instead of being written to a file each.  Samples are grouped in queues,
+ * which correspond to the queues of DataDurabilityCache, and a queue is
+ * removed by appending a record that drops it.  Appended records are
+ * buffered until commit(), which writes them with a single write and sync.
+ *
+ * Dropped queues leave garbage in the segments.  When there is more
+ * garbage than live data the owner rewrites what is still live between
+ * begin_compaction() and end_compaction(), after which the older segments
+ * are removed.  Segments written by a compaction are marked as such, and
+ * the compaction only takes effect once a record saying it finished is
+ * committed.  replay() ignores the samples of a compaction that didn't
+ * finish, and the segments before one that did, so a crash at any point
+ * doesn't replay a sample twice.
+ */
+class OpenDDS_Dcps_Export DurabilityLog {
+public:
+  typedef ACE_UINT64 QueueId;
+
+  /// A sample read back by replay().  The data points into a mapped
+  /// segment and is only valid during the call to on_sample().
+  struct Sample {
+    QueueId queue_id;
+    DDS::DomainId_t domain_id;
+    String topic_name;
+    String type_name;
+    DDS::Time_t timestamp;
+    const char* data;
+    size_t length;
+  };
+
+  class Replayer {
+  public:
+    virtual ~Replayer() {}
+    virtual void on_sample(const Sample& sample) = 0;
+  };
+
+  /// Throws std::runtime_error if the directory can't be created.
+  explicit DurabilityLog(const String& directory,
+                         size_t segment_size = default_segment_size);
+  ~DurabilityLog();
+
+  /// Pass each sample of a queue that wasn't dropped to the replayer, in
+  /// the order they were appended.  Segments are mapped instead of read.
+  /// A segment ends at the first incomplete or corrupt record, which is
+  /// what a crash during commit() leaves behind.  Segments that a crash
+  /// kept a finished compaction from removing are removed.
+  void replay(Replayer& replayer);
+
+  QueueId next_queue_id();
+
+  bool append(QueueId queue_id, DDS::DomainId_t domain_id,
+              const char* topic_name, const char* type_name,
+              const DDS::Time_t& timestamp, const char* data, size_t length);
+  bool drop(QueueId queue_id);
+
+  /// Write and sync everything appended since the last commit.
+  bool commit();
+
+  bool needs_compaction() const;
+  /// Start a new segment for the live samples the caller appends.
+  bool begin_compaction();
+  /// Commit the live samples and remove the segments before them.
+  bool end_compaction();
+
+  static const size_t default_segment_size = 64 * 1024 * 1024;
+
+private:
+  DurabilityLog(const DurabilityLog&);
+  DurabilityLog& operator=(const DurabilityLog&);
+
+  enum RecordKind {
+    RECORD_SAMPLE = 1,
+    RECORD_DROP = 2,
+    /// First record of a segment written by a compaction, has the first
+    /// segment of the compaction instead of a queue id
+    RECORD_COMPACTION = 3,
+    /// The compaction that started with the segment in place of the queue id
+    /// finished, so the segments before it are garbage
+    RECORD_COMPACTED = 4
+  };
+
+  enum ReadPass {
+    PASS_MARKERS,
+    PASS_DROPS,
+    PASS_SAMPLES
+  };
+
+  /// What replay() learns from the compaction records
+  struct Compactions {
+    /// Segments written by a compaction and the first segment of it
+    OPENDDS_MAP(unsigned int, unsigned int) written_by;
+    /// The first segments of the compactions that finished
+    OPENDDS_SET(unsigned int) finished;
+  };
+
+  String segment_path(unsigned int segment) const;
+  bool open_segment(unsigned int segment);
+  void close_segment();
+  static void frame_record(const char* record, size_t length, OPENDDS_VECTOR(char)& out);
+  static bool id_record(RecordKind kind, QueueId id, OPENDDS_VECTOR(char)& out);
+  void buffer_record(const char* record, size_t length);
+  bool read_segment(unsigned int segment, ReadPass pass, Replayer* replayer,
+                    Compactions& compactions);
+
+  mutable ACE_Thread_Mutex mutex_;
+  const String directory_;
+  const size_t segment_size_;
+
+  typedef OPENDDS_VECTOR(unsigned int) Segments;
+  /// Segments on disk, oldest first. The last one is being appended to.
+  Segments segments_;
+  ACE_HANDLE handle_;
+  size_t segment_bytes_;
+  OPENDDS_VECTOR(char) buffer_;
+  /// First segment written by the current compaction, if there is one.
+  unsigned int compaction_start_;
+  bool compacting_;
+
+  QueueId next_queue_id_;
+  typedef OPENDDS_MAP(QueueId, size_t) QueueBytes;
+  /// Bytes appended for each live queue.
+  QueueBytes queue_bytes_;
+  typedef OPENDDS_SET(QueueId) QueueIdSet;
+  /// Queues dropped since the last compaction, so compaction doesn't bring
+  /// them back.
+  QueueIdSet dropped_;
+  size_t live_bytes_;
+  size_t total_bytes_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_NO_PERSISTENCE_PROFILE
+
+#endif // OPENDDS_DCPS_DURABILITYLOG_H
@@ -0,0 +1,172 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "LatencyHistogram.h"
+
+#include <ace/Guard_T.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  const ACE_UINT64 max_trackable = (ACE_UINT64(1) << LatencyHistogram::max_bits) - 1;
+
+  TimeDuration from_usec(ACE_UINT64 usec)
+  {
+    return TimeDuration(static_cast<time_t>(usec / 1000000),
+                        static_cast<suseconds_t>(usec % 1000000));
+  }
+}
+
+LatencyHistogram::Summary::Summary()
+  : count(0)
+{}
+
+LatencyHistogram::LatencyHistogram()
+{
+  reset();
+}
+
+size_t LatencyHistogram::bucket_index(ACE_UINT64 microseconds)
+{
+  if (microseconds < sub_bucket_count) {
+    return static_cast<size_t>(microseconds);
+  }
+  if (microseconds > max_trackable) {
+    microseconds = max_trackable;
+  }
+
+  // Position of the highest bit set
+  unsigned int high = 0;
+  for (unsigned int step = 32; step; step >>= 1) {
+    if (microseconds >> (high + step)) {
+      high += step;
+    }
+  }
+  const unsigned int shift = high - sub_bucket_bits;
+  return (shift + 1) * sub_bucket_count +
+    static_cast<size_t>((microseconds >> shift) - sub_bucket_count);
+}
+
+ACE_UINT64 LatencyHistogram::bucket_upper_bound(size_t index)
+{
+  if (index < sub_bucket_count) {
+    return index;
+  }
+  const unsigned int shift = static_cast<unsigned int>(index / sub_bucket_count - 1);
+  const ACE_UINT64 sub_bucket = index % sub_bucket_count + sub_bucket_count;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(const TimeDuration& latency)
+{
+  ACE_UINT64 usec = 0;
+  if (latency.value() > ACE_Time_Value::zero) {
+    latency.value().to_usec(usec);
+  }
+  ++counts_[bucket_index(usec)];
+
+#ifdef ACE_HAS_CPP11
+  ACE_UINT64 maximum = maximum_.load(std::memory_order_relaxed);
+  while (usec > maximum &&
+         !maximum_.compare_exchange_weak(maximum, usec, std::memory_order_relaxed)) {}
+#else
+  ACE_Guard<ACE_Thread_Mutex> guard(maximum_mutex_);
+  if (usec > maximum_.load()) {
+    maximum_ = usec;
+  }
+#endif
+}
+
+ACE_UINT64 LatencyHistogram::load_counts(ACE_UINT64* counts) const
+{
+  ACE_UINT64 total = 0;
+  for (size_t i = 0; i < bucket_count; ++i) {
+    counts[i] = counts_[i].load();
+    total += counts[i];
+  }
+  return total;
+}
+
+ACE_UINT64 LatencyHistogram::count() const
+{
+  ACE_UINT64 total = 0;
+  for (size_t i = 0; i < bucket_count; ++i) {
+    total += counts_[i].load();
+  }
+  return total;
+}
+
+TimeDuration LatencyHistogram::percentile(double fraction) const
+{
+  ACE_UINT64 counts[bucket_count];
+  const ACE_UINT64 total = load_counts(counts);
+  return percentile(fraction, counts, total);
+}
+
+TimeDuration LatencyHistogram::percentile(double fraction, const ACE_UINT64* counts,
+                                          ACE_UINT64 total) const
+{
+  if (total == 0) {
+    return TimeDuration::zero_value;
+  }
+
+  const double exact_rank = fraction * static_cast<double>(total);
+  ACE_UINT64 rank = static_cast<ACE_UINT64>(exact_rank);
+  if (rank < exact_rank) {
+    ++rank;
+  }
+  if (rank == 0) {
+    rank = 1;
+  } else if (rank > total) {
+    rank = total;
+  }
+
+  // Report the top of the bucket, but not more than what was actually seen.
+  const ACE_UINT64 maximum = maximum_.load();
+  ACE_UINT64 seen = 0;
+  for (size_t i = 0; i < bucket_count; ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      const ACE_UINT64 upper = bucket_upper_bound(i);
+      return from_usec(upper < maximum ? upper : maximum);
+    }
+  }
+  return from_usec(maximum);
+}
+
+TimeDuration LatencyHistogram::maximum() const
+{
+  return from_usec(maximum_.load());
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary() const
+{
+  ACE_UINT64 counts[bucket_count];
+  Summary summary;
+  summary.count = load_counts(counts);
+  summary.p50 = percentile(0.5, counts, summary.count);
+  summary.p99 = percentile(0.99, counts, summary.count);
+  summary.p999 = percentile(0.999, counts, summary.count);
+  summary.maximum = maximum();
+  return summary;
+}
+
+void LatencyHistogram::reset()
+{
+  for (size_t i = 0; i < bucket_count; ++i) {
+    counts_[i] = 0;
+  }
+  maximum_ = 0;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,100 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_LATENCY_HISTOGRAM_H
+#define OPENDDS_DCPS_LATENCY_HISTOGRAM_H
+
+#include "dcps_export.h"
+#include "Atomic.h"
+#include "TimeDuration.h"
+
+#ifndef ACE_HAS_CPP11
+#  include <ace/Thread_Mutex.h>
+#endif
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class LatencyHistogram
+ *
+ * @brief Distribution of latencies in logarithmic buckets
+ *
+ * Each power of two microseconds is split into sub_bucket_count linear
+ * buckets like an HDR histogram, so percentiles are reported within 1/16 of
+ * the actual value using a fixed amount of memory.  Latencies are counted
+ * with atomic increments so recording doesn't take a lock.  Latencies longer
+ * than about 71 minutes are counted in the last bucket, but the maximum is
+ * still exact.  Negative latencies, from clocks that aren't synchronized, are
+ * counted as zero.
+ */
+class OpenDDS_Dcps_Export LatencyHistogram {
+public:
+  static const unsigned int sub_bucket_bits = 4;
+  static const size_t sub_bucket_count = size_t(1) << sub_bucket_bits;
+  /// Latencies are tracked in buckets up to 2^max_bits microseconds.
+  static const unsigned int max_bits = 32;
+  static const size_t bucket_count = (max_bits - sub_bucket_bits + 1) * sub_bucket_count;
+
+  struct Summary {
+    Summary();
+
+    ACE_UINT64 count;
+    TimeDuration p50;
+    TimeDuration p99;
+    TimeDuration p999;
+    TimeDuration maximum;
+  };
+
+  LatencyHistogram();
+
+  void record(const TimeDuration& latency);
+
+  ACE_UINT64 count() const;
+
+  /// The latency that fraction of the recorded latencies are at or below,
+  /// for example 0.99 for the 99th percentile.
+  TimeDuration percentile(double fraction) const;
+
+  TimeDuration maximum() const;
+
+  Summary summary() const;
+
+  /// Not atomic with respect to record; latencies recorded while resetting
+  /// may be partially kept.
+  void reset();
+
+  static size_t bucket_index(ACE_UINT64 microseconds);
+  /// The largest latency in microseconds that is counted in the bucket.
+  static ACE_UINT64 bucket_upper_bound(size_t index);
+
+private:
+  LatencyHistogram(const LatencyHistogram&);
+  LatencyHistogram& operator=(const LatencyHistogram&);
+
+  TimeDuration percentile(double fraction, const ACE_UINT64* counts, ACE_UINT64 total) const;
+  ACE_UINT64 load_counts(ACE_UINT64* counts) const;
+
+  Atomic<ACE_UINT64> counts_[bucket_count];
+  /// Largest latency recorded in microseconds
+  Atomic<ACE_UINT64> maximum_;
+#ifndef ACE_HAS_CPP11
+  /// Without C++11 atomics there's no compare and exchange to update maximum_.
+  ACE_Thread_Mutex maximum_mutex_;
+#endif
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_LATENCY_HISTOGRAM_H */
@@ -0,0 +1,150 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_MPSC_QUEUE_H
+#define OPENDDS_DCPS_MPSC_QUEUE_H
+
+#include "Atomic.h"
+#include "PoolAllocator.h"
+
+#ifndef ACE_HAS_CPP11
+#  include <ace/Guard_T.h>
+#  include <ace/Thread_Mutex.h>
+#endif
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Bounded FIFO queue for any number of producer threads and one consumer
+ * thread.  Each slot has a sequence number that says whether it's ready to be
+ * pushed to or popped from, so producers only contend on claiming a slot and
+ * never wait for each other or for the consumer.  pop may only be called by
+ * one thread at a time.
+ *
+ * The capacity is rounded up to a power of two.  Without C++11 atomics a
+ * mutex is used instead.
+ */
+template <typename T>
+class MpscQueue {
+public:
+  explicit MpscQueue(size_t capacity)
+    : mask_(round_up(capacity) - 1)
+    , slots_(mask_ + 1)
+    , push_pos_(0)
+    , pop_pos_(0)
+  {
+#ifdef ACE_HAS_CPP11
+    for (size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+#endif
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+  /// Returns false without copying value if the queue is full.
+  bool push(const T& value)
+  {
+#ifdef ACE_HAS_CPP11
+    size_t pos = push_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence == pos) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (sequence < pos) {
+        // The consumer hasn't popped this slot from the last time around.
+        return false;
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+#else
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (push_pos_ - pop_pos_ > mask_) {
+      return false;
+    }
+    slots_[push_pos_ & mask_].value = value;
+    ++push_pos_;
+    return true;
+#endif
+  }
+
+  /// Returns false if the queue is empty.
+  bool pop(T& value)
+  {
+#ifdef ACE_HAS_CPP11
+    Slot& slot = slots_[pop_pos_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != pop_pos_ + 1) {
+      return false;
+    }
+    value = slot.value;
+    slot.value = T();
+    slot.sequence.store(pop_pos_ + mask_ + 1, std::memory_order_release);
+    ++pop_pos_;
+    return true;
+#else
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (pop_pos_ == push_pos_) {
+      return false;
+    }
+    Slot& slot = slots_[pop_pos_ & mask_];
+    value = slot.value;
+    slot.value = T();
+    ++pop_pos_;
+    return true;
+#endif
+  }
+
+private:
+  MpscQueue(const MpscQueue&);
+  MpscQueue& operator=(const MpscQueue&);
+
+  static size_t round_up(size_t capacity)
+  {
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  struct Slot {
+#ifdef ACE_HAS_CPP11
+    Atomic<size_t> sequence;
+#endif
+    T value;
+  };
+
+  const size_t mask_;
+  OPENDDS_VECTOR(Slot) slots_;
+#ifdef ACE_HAS_CPP11
+  /// Next position to push, claimed by producers
+  Atomic<size_t> push_pos_;
+#else
+  ACE_Thread_Mutex mutex_;
+  size_t push_pos_;
+#endif
+  /// Next position to pop, only used by the consumer
+  size_t pop_pos_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_MPSC_QUEUE_H */
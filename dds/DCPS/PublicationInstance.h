@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_PUBLICATION_INSTANCE_H
 
 #include "dcps_export.h"
+#include "DeadlineList.h"
 #include "InstanceDataSampleList.h"
 #include "DataSampleElement.h"
 #include "PoolAllocationBase.h"
@@ -72,6 +73,9 @@ struct OpenDDS_Dcps_Export PublicationInstance : public RcObject {
 
   /// Deadline for Deadline QoS.
   MonotonicTimePoint deadline_;
+
+  /// Position in WriteDataContainer's deadline list.
+  DeadlineLink<PublicationInstance> deadline_link_;
 };
 
 typedef RcHandle<PublicationInstance> PublicationInstance_rch;
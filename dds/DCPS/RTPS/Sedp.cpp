@@ -3994,17 +3994,26 @@ bool Sedp::TypeLookupReplyReader::process_type_lookup_reply(
                  "got the reply for the final request in the sequence\n"));
     }
     const DCPS::SequenceNumber key_seq_num = seq_num_it->second.seq_number;
+    const XTypes::TypeIdentifier type_id = seq_num_it->second.type_id;
+    TypeLookupKey key;
+    key.participant = seq_num_it->second.participant;
+    key.type_id = type_id;
+    key.secure = seq_num_it->second.secure;
 
     // Cleanup data
-    cleanup(sample.header_.publication_id_, seq_num_it->second.type_id);
+    cleanup(sample.header_.publication_id_, type_id);
     sedp_.orig_seq_numbers_.erase(seq_num);
+    sedp_.end_type_lookup(key, key_seq_num);
 
     if (success) {
-      MatchingDataIter it;
-      for (it = sedp_.matching_data_buffer_.begin(); it != sedp_.matching_data_buffer_.end(); ++it) {
+      // Every endpoint that joined this lookup is waiting on the same sequence number.
+      bool found = false;
+      OPENDDS_VECTOR(MatchingPair) ready;
+      for (MatchingDataIter it = sedp_.matching_data_buffer_.begin(); it != sedp_.matching_data_buffer_.end();) {
         const DCPS::SequenceNumber& seqnum_minimal = it->second.rpc_seqnum_minimal;
         const DCPS::SequenceNumber& seqnum_complete = it->second.rpc_seqnum_complete;
         if (seqnum_minimal == key_seq_num || seqnum_complete == key_seq_num) {
+          found = true;
           if (seqnum_minimal == key_seq_num) {
             it->second.got_minimal = true;
           } else {
@@ -4013,22 +4022,24 @@ bool Sedp::TypeLookupReplyReader::process_type_lookup_reply(
 
           if (it->first.type_obj_req_cond) {
             it->first.type_obj_req_cond->done(DDS::RETCODE_OK);
-            sedp_.matching_data_buffer_.erase(it);
-            return true;
+            sedp_.matching_data_buffer_.erase(it++);
+            continue;
           } else if (it->second.got_minimal && it->second.got_complete) {
             // All remote type objects are obtained, continue the matching process
-            const GUID_t writer = it->first.writer();
-            const GUID_t reader = it->first.reader();
-            sedp_.matching_data_buffer_.erase(it);
-            UsedEndpoints ue;
-            sedp_.match_continue(ue, writer, reader);
-            return true;
+            ready.push_back(it->first);
+            sedp_.matching_data_buffer_.erase(it++);
+            continue;
           }
-          break;
         }
+        ++it;
       }
 
-      if (it == sedp_.matching_data_buffer_.end()) {
+      for (size_t i = 0; i < ready.size(); ++i) {
+        UsedEndpoints ue;
+        sedp_.match_continue(ue, ready[i].writer(), ready[i].reader());
+      }
+
+      if (!found) {
         if (DCPS::log_level >= DCPS::LogLevel::Warning) {
           ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: Sedp::TypeLookupReplyReader::process_type_lookup_reply: "
                      "RPC sequence number %q: No data found in matching data buffer\n",
@@ -7347,6 +7358,11 @@ void Sedp::remove_expired_endpoints(const MonotonicTimePoint& /*now*/)
           LogGuid(it->second.participant).c_str()));
       }
       cleanup_type_lookup_data(it->second.participant, it->second.type_id, it->second.secure);
+      TypeLookupKey key;
+      key.participant = it->second.participant;
+      key.type_id = it->second.type_id;
+      key.secure = it->second.secure;
+      end_type_lookup(key, it->second.seq_number);
       orig_seq_numbers_.erase(it++);
     } else {
       ++it;
@@ -7856,16 +7872,22 @@ void Sedp::request_type_objects(const XTypes::TypeInformation* type_info,
   MatchingData md;
   md.time_added_to_map = MonotonicTimePoint::now();
 
+  bool joined_minimal = false;
   if (get_minimal) {
-    md.rpc_seqnum_minimal = ++type_lookup_service_sequence_number_;
+    joined_minimal = join_type_lookup(
+      make_type_lookup_key(type_info->minimal.typeid_with_size.type_id, mp.remote, is_discovery_protected),
+      md.rpc_seqnum_minimal);
     md.got_minimal = false;
   } else {
     md.rpc_seqnum_minimal = SequenceNumber::SEQUENCENUMBER_UNKNOWN();
     md.got_minimal = true;
   }
 
+  bool joined_complete = false;
   if (get_complete) {
-    md.rpc_seqnum_complete = ++type_lookup_service_sequence_number_;
+    joined_complete = join_type_lookup(
+      make_type_lookup_key(type_info->complete.typeid_with_size.type_id, mp.remote, is_discovery_protected),
+      md.rpc_seqnum_complete);
     md.got_complete = false;
   } else {
     md.rpc_seqnum_complete = SequenceNumber::SEQUENCENUMBER_UNKNOWN();
@@ -7877,19 +7899,61 @@ void Sedp::request_type_objects(const XTypes::TypeInformation* type_info,
   // Send a sequence of requests for minimal remote TypeObjects
   if (get_minimal) {
     if (DCPS_debug_level >= 4) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) Sedp::request_type_objects: minimal remote: %C seq: %q\n",
-        LogGuid(mp.remote).c_str(), md.rpc_seqnum_minimal.getValue()));
+      ACE_DEBUG((LM_DEBUG, "(%P|%t) Sedp::request_type_objects: minimal remote: %C seq: %q%C\n",
+        LogGuid(mp.remote).c_str(), md.rpc_seqnum_minimal.getValue(),
+        joined_minimal ? " (in progress)" : ""));
+    }
+    if (!joined_minimal) {
+      get_remote_type_objects(type_info->minimal, md, true, mp.remote, is_discovery_protected);
     }
-    get_remote_type_objects(type_info->minimal, md, true, mp.remote, is_discovery_protected);
   }
 
   // Send another sequence of requests for complete remote TypeObjects
   if (get_complete) {
     if (DCPS_debug_level >= 4) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) Sedp::request_type_objects: complete remote: %C seq: %q\n",
-        LogGuid(mp.remote).c_str(), md.rpc_seqnum_complete.getValue()));
+      ACE_DEBUG((LM_DEBUG, "(%P|%t) Sedp::request_type_objects: complete remote: %C seq: %q%C\n",
+        LogGuid(mp.remote).c_str(), md.rpc_seqnum_complete.getValue(),
+        joined_complete ? " (in progress)" : ""));
+    }
+    if (!joined_complete) {
+      get_remote_type_objects(type_info->complete, md, false, mp.remote, is_discovery_protected);
     }
-    get_remote_type_objects(type_info->complete, md, false, mp.remote, is_discovery_protected);
+  }
+}
+
+Sedp::TypeLookupKey Sedp::make_type_lookup_key(const XTypes::TypeIdentifier& type_id,
+                                               const GUID_t& remote_id,
+                                               bool is_discovery_protected)
+{
+  TypeLookupKey key;
+  key.participant = make_part_guid(remote_id);
+  key.type_id = type_id;
+  key.secure = false;
+#if OPENDDS_CONFIG_SECURITY
+  key.secure = is_security_enabled() && is_discovery_protected;
+#else
+  ACE_UNUSED_ARG(is_discovery_protected);
+#endif
+  return key;
+}
+
+bool Sedp::join_type_lookup(const TypeLookupKey& key, SequenceNumber& seq_num)
+{
+  const InFlightTypeLookupMap::const_iterator pos = in_flight_type_lookups_.find(key);
+  if (pos != in_flight_type_lookups_.end()) {
+    seq_num = pos->second;
+    return true;
+  }
+  seq_num = ++type_lookup_service_sequence_number_;
+  in_flight_type_lookups_[key] = seq_num;
+  return false;
+}
+
+void Sedp::end_type_lookup(const TypeLookupKey& key, const SequenceNumber& seq_num)
+{
+  const InFlightTypeLookupMap::iterator pos = in_flight_type_lookups_.find(key);
+  if (pos != in_flight_type_lookups_.end() && pos->second == seq_num) {
+    in_flight_type_lookups_.erase(pos);
   }
 }
 
@@ -590,6 +590,33 @@ private:
   // is sent for a type, a new entry must be stored.
   typedef OPENDDS_MAP(SequenceNumber, TypeIdOrigSeqNumber) OrigSeqNumberMap;
 
+  // A type lookup that endpoints discovered later can wait for: the same remote type
+  // requested from the same remote participant over the same kind of endpoints.
+  struct TypeLookupKey {
+    GUID_t participant;
+    XTypes::TypeIdentifier type_id;
+    bool secure;
+
+    bool operator<(const TypeLookupKey& other) const
+    {
+      if (participant < other.participant) {
+        return true;
+      }
+      if (other.participant < participant) {
+        return false;
+      }
+      if (secure != other.secure) {
+        return !secure;
+      }
+      return type_id < other.type_id;
+    }
+  };
+
+  // Map from a type lookup to the sequence number of its first request. Endpoints
+  // with the same type that are discovered in the meantime wait for that lookup
+  // instead of starting their own.
+  typedef OPENDDS_MAP(TypeLookupKey, SequenceNumber) InFlightTypeLookupMap;
+
   class Endpoint : public DCPS::TransportClient {
   public:
     Endpoint(const DCPS::GUID_t& repo_id, Sedp& sedp)
@@ -1407,6 +1434,15 @@ protected:
   void get_remote_type_objects(const XTypes::TypeIdentifierWithDependencies& tid_with_deps,
                                MatchingData& md, bool get_minimal, const GUID_t& remote_id,
                                bool is_discovery_protected);
+
+  TypeLookupKey make_type_lookup_key(const XTypes::TypeIdentifier& type_id,
+                                     const GUID_t& remote_id,
+                                     bool is_discovery_protected);
+
+  /// Set seq_num to the first request of the lookup, returning true if one
+  /// is already in progress.
+  bool join_type_lookup(const TypeLookupKey& key, SequenceNumber& seq_num);
+  void end_type_lookup(const TypeLookupKey& key, const SequenceNumber& seq_num);
 #if OPENDDS_CONFIG_SECURITY
   void match_continue_security_enabled(
     const GUID_t& writer, const GUID_t& reader, bool call_writer, bool call_reader);
@@ -1518,6 +1554,7 @@ protected:
   OPENDDS_SET_CMP(GUID_t, GUID_tKeyLessThan) relay_only_readers_;
   XTypes::TypeLookupService_rch type_lookup_service_;
   OrigSeqNumberMap orig_seq_numbers_;
+  InFlightTypeLookupMap in_flight_type_lookups_;
   MatchingDataMap matching_data_buffer_;
   RcHandle<EndpointManagerSporadic> type_lookup_reply_deadline_processor_;
   TimeDuration max_type_lookup_service_reply_period_;
@@ -89,7 +89,8 @@ bool RakeResults<MessageType>::insert_sample(ReceivedDataElement* sample,
   if (do_filter_) {
     const QueryConditionImpl* qci = dynamic_cast<QueryConditionImpl*>(cond_);
     const MessageType* typed_sample = static_cast<MessageType*>(sample->registered_data_);
-    if (!qci || !typed_sample || !qci->filter(*typed_sample, !sample->valid_data_)) {
+    if (!qci || !typed_sample || !sample->complete_data() ||
+        !qci->filter(*typed_sample, !sample->valid_data_)) {
       return false;
     }
   }
@@ -100,7 +101,7 @@ bool RakeResults<MessageType>::insert_sample(ReceivedDataElement* sample,
     // N.B. Until a better heuristic is found, non-valid
     // samples are elided when sorting by QueryCondition.
 #ifndef OPENDDS_NO_QUERY_CONDITION
-    if (cond_ && !sample->registered_data_) return false;
+    if (cond_ && (!sample->registered_data_ || !sample->complete_data())) return false;
 #endif
 
     RakeData rd = {sample, rdel, instance, index_in_instance};
@@ -131,6 +132,7 @@ bool RakeResults<MessageType>::copy_into(FwdIter iter, FwdIter end,
     // 1. Populate the Received Data sequence
     ReceivedDataElement* rde = iter->rde_;
     ReceivedDataElementList* rdel = iter->rdel_;
+    rde->complete_data();
 
     if (received_data_.maximum() != 0) {
       if (rde->registered_data_ == 0) {
@@ -14,6 +14,8 @@
 #include "Definitions.h"
 #include "GuidUtils.h"
 #include "InstanceState.h"
+#include "Message_Block_Ptr.h"
+#include "Serializer.h"
 #include "Time_Helper.h"
 #include "unique_ptr.h"
 
@@ -83,6 +85,13 @@ public:
     return ref_count_;
   }
 
+  /// Finish deserializing registered_data_ if that was deferred. If it fails
+  /// the sample no longer has valid data and false is returned.
+  bool complete_data()
+  {
+    return !deferred_payload_ || complete_data_i();
+  }
+
   GUID_t pub_;
 
   /**
@@ -91,6 +100,12 @@ public:
    */
   void* const registered_data_;  // ugly, but works....
 
+  /// If set, registered_data_ hasn't been deserialized yet and this is the
+  /// serialized sample following the encapsulation header, see
+  /// DCPSLazyDeserialization.
+  Message_Block_Ptr deferred_payload_;
+  Encoding deferred_encoding_;
+
   /// Sample state for this data sample:
   /// DDS::NOT_READ_SAMPLE_STATE/DDS::READ_SAMPLE_STATE
   DDS::SampleStateKind sample_state_;
@@ -141,8 +156,12 @@ public:
   void operator delete(void* memory, ACE_New_Allocator& pool);
 
 private:
+  bool complete_data_i();
+
   Atomic<long> ref_count_;
 protected:
+  virtual bool deserialize(Serializer&) { return false; }
+
   ACE_Recursive_Thread_Mutex* mx_;
 }; // class ReceivedDataElement
 
@@ -166,7 +185,13 @@ public:
     ACE_GUARD(ACE_Recursive_Thread_Mutex,
               guard,
               *mx_)
-    delete static_cast<DataTypeWithAllocator*> (registered_data_);
+    DataTypeWithAllocator::release(static_cast<DataTypeWithAllocator*>(registered_data_));
+  }
+
+protected:
+  bool deserialize(Serializer& ser)
+  {
+    return ser >> *static_cast<DataTypeWithAllocator*>(registered_data_)->message();
   }
 };
 
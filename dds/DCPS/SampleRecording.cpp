@@ -0,0 +1,530 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "SampleRecording.h"
+
+#include "DirentWrapper.h"
+#include "Serializer.h"
+#include "debug.h"
+
+#include <dds/DdsDcpsGuidTypeSupportImpl.h>
+
+#include <ace/Mem_Map.h>
+#include <ace/OS_NS_errno.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  const char segment_prefix[] = "recording-";
+  const char data_suffix[] = ".dat";
+  const char index_suffix[] = ".idx";
+  const char segment_magic[] = "ODDSREC1";
+  const size_t magic_size = sizeof segment_magic - 1;
+
+  /// Recorded and source timestamps, publication, message id, byte order,
+  /// encoding kind, and the lengths of the header and data
+  const size_t fixed_body_size = 8 + 8 + 16 + 3 + 4 + 4;
+  /// Recorded time and offset in the segment
+  const size_t index_entry_size = 16;
+
+  /// Batches are handed to the I/O thread when they reach this size, or
+  /// after flush_interval if they don't.
+  const size_t batch_size = 1024 * 1024;
+  const TimeDuration flush_interval = TimeDuration::from_msec(100);
+  /// Minimum time between indexed samples
+  const TimeDuration index_interval = TimeDuration::from_msec(10);
+
+  const Encoding encoding(Encoding::KIND_UNALIGNED_CDR, ENDIAN_LITTLE);
+
+  String segment_path(const String& directory, unsigned int segment, const char* suffix)
+  {
+    char name[32];
+    ACE_OS::snprintf(name, sizeof name, "%s%08u%s", segment_prefix, segment, suffix);
+    return directory + '/' + name;
+  }
+
+  OPENDDS_VECTOR(unsigned int) find_segments(const String& directory)
+  {
+    ACE_Dirent dir;
+    if (dir.open(ACE_TEXT_CHAR_TO_TCHAR(directory.c_str())) == -1) {
+      throw std::runtime_error("could not open directory " + directory);
+    }
+
+    OPENDDS_VECTOR(unsigned int) segments;
+    const size_t prefix_len = sizeof segment_prefix - 1;
+    const size_t suffix_len = sizeof data_suffix - 1;
+    for (ACE_DIRENT* ent = dir.read(); ent; ent = dir.read()) {
+      const char* const name = ACE_TEXT_ALWAYS_CHAR(ent->d_name);
+      const size_t len = ACE_OS::strlen(name);
+      if (len <= prefix_len + suffix_len ||
+          ACE_OS::strncmp(name, segment_prefix, prefix_len) != 0 ||
+          ACE_OS::strcmp(name + len - suffix_len, data_suffix) != 0) {
+        continue;
+      }
+      char* end = 0;
+      const unsigned long segment = ACE_OS::strtoul(name + prefix_len, &end, 10);
+      if (end == name + len - suffix_len) {
+        segments.push_back(static_cast<unsigned int>(segment));
+      }
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+  }
+
+  /// Reads the length and recorded time at the start of a record
+  bool peek_record(const char* record, size_t available, ACE_CDR::ULong& body_size,
+                   SystemTimePoint& recorded)
+  {
+    if (available < 4 + 8) {
+      return false;
+    }
+    ACE_Message_Block mb(record, 4 + 8);
+    mb.wr_ptr(4 + 8);
+    Serializer ser(&mb, encoding);
+    DDS::Time_t time;
+    if (!(ser >> body_size) || !(ser >> time.sec) || !(ser >> time.nanosec) ||
+        body_size < fixed_body_size || body_size > available - 4) {
+      return false;
+    }
+    recorded = SystemTimePoint(time);
+    return true;
+  }
+
+  class ReplayerHandler : public RecordingPlayback::SampleHandler {
+  public:
+    explicit ReplayerHandler(Replayer& replayer)
+      : replayer_(replayer)
+    {}
+
+    DDS::ReturnCode_t on_sample(const RawDataSample& sample, const SystemTimePoint&)
+    {
+      return replayer_.write(sample);
+    }
+
+  private:
+    Replayer& replayer_;
+  };
+}
+
+RecordingListener::RecordingListener(const String& directory,
+                                     size_t segment_size,
+                                     size_t max_pending)
+  : directory_(directory)
+  , segment_size_(segment_size)
+  , max_pending_(max_pending)
+  , cv_(mutex_)
+  , pending_bytes_(0)
+  , dropped_(0)
+  , batches_queued_(0)
+  , batches_written_(0)
+  , shutdown_(false)
+  , segment_(0)
+  , data_handle_(ACE_INVALID_HANDLE)
+  , index_handle_(ACE_INVALID_HANDLE)
+  , segment_bytes_(0)
+{
+  if (ACE_OS::mkdir(ACE_TEXT_CHAR_TO_TCHAR(directory_.c_str())) == -1 && errno != EEXIST) {
+    throw std::runtime_error("RecordingListener: could not create directory " + directory_);
+  }
+  // Continue after an earlier recording in the same directory
+  const OPENDDS_VECTOR(unsigned int) segments = find_segments(directory_);
+  if (!segments.empty()) {
+    segment_ = segments.back() + 1;
+  }
+
+  filling_.reserve(batch_size);
+  thread_.reset(new ThreadPool(1, run, this));
+}
+
+RecordingListener::~RecordingListener()
+{
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    shutdown_ = true;
+    cv_.notify_all();
+  }
+  // Joins the I/O thread once it has written everything
+  thread_.reset();
+}
+
+void RecordingListener::on_sample_data_received(Recorder*, const RawDataSample& sample)
+{
+  const SystemTimePoint now = SystemTimePoint::now();
+  const size_t header_size = sample.header_.get_serialized_size();
+  const size_t data_size = sample.sample_ ? sample.sample_->total_length() : 0;
+  const size_t body_size = fixed_body_size + header_size + data_size;
+  const size_t record_size = 4 + body_size;
+
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (pending_bytes_ + filling_.size() + record_size > max_pending_) {
+    ++dropped_;
+    return;
+  }
+
+  const size_t pos = filling_.size();
+  filling_.resize(pos + record_size);
+  ACE_Message_Block mb(&filling_[pos], record_size);
+  Serializer ser(&mb, encoding);
+  const DDS::Time_t recorded = now.to_idl_struct();
+  bool ok = (ser << static_cast<ACE_CDR::ULong>(body_size)) &&
+    (ser << recorded.sec) && (ser << recorded.nanosec) &&
+    (ser << sample.source_timestamp_.sec) && (ser << sample.source_timestamp_.nanosec) &&
+    (ser << sample.publication_id_) &&
+    (ser << ACE_OutputCDR::from_octet(static_cast<ACE_CDR::Octet>(sample.message_id_))) &&
+    (ser << ACE_OutputCDR::from_boolean(sample.sample_byte_order_)) &&
+    (ser << ACE_OutputCDR::from_octet(static_cast<ACE_CDR::Octet>(sample.encoding_kind_))) &&
+    (ser << static_cast<ACE_CDR::ULong>(header_size)) &&
+    (mb << sample.header_) &&
+    (ser << static_cast<ACE_CDR::ULong>(data_size));
+  for (const ACE_Message_Block* block = sample.sample_.get(); ok && block; block = block->cont()) {
+    ok = ser.write_octet_array(reinterpret_cast<const ACE_CDR::Octet*>(block->rd_ptr()),
+                               static_cast<ACE_CDR::ULong>(block->length()));
+  }
+  if (!ok) {
+    filling_.resize(pos);
+    ++dropped_;
+    return;
+  }
+
+  if (filling_.size() >= batch_size) {
+    queue_filling();
+  }
+}
+
+void RecordingListener::on_recorder_matched(Recorder*, const DDS::SubscriptionMatchedStatus&)
+{
+}
+
+void RecordingListener::queue_filling()
+{
+  pending_bytes_ += filling_.size();
+  pending_.push_back(Batch());
+  pending_.back().swap(filling_);
+  filling_.reserve(batch_size);
+  ++batches_queued_;
+  cv_.notify_all();
+}
+
+void RecordingListener::flush()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (!filling_.empty()) {
+    queue_filling();
+  }
+  const ACE_UINT64 target = batches_queued_;
+  while (batches_written_ < target) {
+    cv_.wait(thread_status_manager_);
+  }
+}
+
+size_t RecordingListener::dropped() const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  return dropped_;
+}
+
+ACE_THR_FUNC_RETURN RecordingListener::run(void* arg)
+{
+  static_cast<RecordingListener*>(arg)->write_batches();
+  return 0;
+}
+
+void RecordingListener::write_batches()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  for (;;) {
+    while (pending_.empty() && !shutdown_) {
+      if (cv_.wait_until(MonotonicTimePoint::now() + flush_interval, thread_status_manager_) == CvStatus_Timeout &&
+          !filling_.empty()) {
+        queue_filling();
+      }
+    }
+    if (pending_.empty()) {
+      if (filling_.empty()) {
+        break;
+      }
+      queue_filling();
+    }
+
+    Batch batch;
+    batch.swap(pending_.front());
+    pending_.pop_front();
+    guard.release();
+    write_batch(batch);
+    guard.acquire();
+    pending_bytes_ -= batch.size();
+    ++batches_written_;
+    cv_.notify_all();
+  }
+  close_segment();
+}
+
+void RecordingListener::write_batch(const Batch& batch)
+{
+  Batch index;
+  size_t run_begin = 0;
+  size_t pos = 0;
+  while (pos < batch.size()) {
+    ACE_CDR::ULong body_size;
+    SystemTimePoint recorded;
+    if (!peek_record(&batch[pos], batch.size() - pos, body_size, recorded)) {
+      break;
+    }
+    const size_t record_size = 4 + body_size;
+
+    // Start a new segment if this record would overflow this one, unless it
+    // would be the first record in it anyway.
+    const size_t run_bytes = pos - run_begin;
+    if (data_handle_ != ACE_INVALID_HANDLE &&
+        segment_bytes_ + run_bytes + record_size > segment_size_ &&
+        segment_bytes_ + run_bytes > magic_size) {
+      write_run(batch, run_begin, pos, index);
+      run_begin = pos;
+      close_segment();
+    }
+    if (data_handle_ == ACE_INVALID_HANDLE && !open_segment()) {
+      return;
+    }
+
+    const size_t offset = segment_bytes_ + (pos - run_begin);
+    if (offset == magic_size || recorded - last_indexed_ >= index_interval) {
+      ACE_Message_Block mb(index_entry_size);
+      Serializer ser(&mb, encoding);
+      const DDS::Time_t time = recorded.to_idl_struct();
+      ser << time.sec;
+      ser << time.nanosec;
+      ser << static_cast<ACE_CDR::ULongLong>(offset);
+      index.insert(index.end(), mb.rd_ptr(), mb.wr_ptr());
+      last_indexed_ = recorded;
+    }
+    pos += record_size;
+  }
+  write_run(batch, run_begin, pos, index);
+}
+
+void RecordingListener::write_run(const Batch& batch, size_t begin, size_t end, Batch& index)
+{
+  if (begin == end || data_handle_ == ACE_INVALID_HANDLE) {
+    return;
+  }
+
+  const size_t length = end - begin;
+  // The data is synced before the index so the index never refers to data
+  // that isn't there.
+  if (ACE_OS::write(data_handle_, &batch[begin], length) != static_cast<ssize_t>(length) ||
+      ACE_OS::fsync(data_handle_) == -1 ||
+      (!index.empty() &&
+       (ACE_OS::write(index_handle_, &index[0], index.size()) != static_cast<ssize_t>(index.size()) ||
+        ACE_OS::fsync(index_handle_) == -1))) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RecordingListener::write_run: "
+                 "could not write to %C: %p\n",
+                 segment_path(directory_, segment_ - 1, data_suffix).c_str(), ACE_TEXT("write")));
+    }
+    // Start over in a new segment rather than after a partial write
+    close_segment();
+  } else {
+    segment_bytes_ += length;
+  }
+  index.clear();
+}
+
+bool RecordingListener::open_segment()
+{
+  const String data_path = segment_path(directory_, segment_, data_suffix);
+  const String index_path = segment_path(directory_, segment_, index_suffix);
+  ++segment_;
+  data_handle_ = ACE_OS::open(ACE_TEXT_CHAR_TO_TCHAR(data_path.c_str()),
+                              O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, ACE_DEFAULT_FILE_PERMS);
+  index_handle_ = ACE_OS::open(ACE_TEXT_CHAR_TO_TCHAR(index_path.c_str()),
+                               O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, ACE_DEFAULT_FILE_PERMS);
+  if (data_handle_ == ACE_INVALID_HANDLE || index_handle_ == ACE_INVALID_HANDLE ||
+      ACE_OS::write(data_handle_, segment_magic, magic_size) != static_cast<ssize_t>(magic_size)) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RecordingListener::open_segment: "
+                 "could not create %C: %p\n", data_path.c_str(), ACE_TEXT("open")));
+    }
+    close_segment();
+    return false;
+  }
+  segment_bytes_ = magic_size;
+  return true;
+}
+
+void RecordingListener::close_segment()
+{
+  if (data_handle_ != ACE_INVALID_HANDLE) {
+    ACE_OS::close(data_handle_);
+    data_handle_ = ACE_INVALID_HANDLE;
+  }
+  if (index_handle_ != ACE_INVALID_HANDLE) {
+    ACE_OS::close(index_handle_);
+    index_handle_ = ACE_INVALID_HANDLE;
+  }
+}
+
+RecordingPlayback::RecordingPlayback(const String& directory)
+  : directory_(directory)
+  , segments_(find_segments(directory))
+{
+  for (OPENDDS_VECTOR(unsigned int)::const_iterator it = segments_.begin(); it != segments_.end(); ++it) {
+    std::ifstream in(segment_path(directory_, *it, index_suffix).c_str(), std::ios::binary);
+    const String contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    ACE_Message_Block mb(contents.data(), contents.size());
+    mb.wr_ptr(contents.size());
+    Serializer ser(&mb, encoding);
+    for (size_t i = 0; i < contents.size() / index_entry_size; ++i) {
+      DDS::Time_t time;
+      ACE_CDR::ULongLong offset;
+      ser >> time.sec;
+      ser >> time.nanosec;
+      ser >> offset;
+      IndexEntry entry;
+      entry.time = SystemTimePoint(time);
+      entry.segment = *it;
+      entry.offset = static_cast<size_t>(offset);
+      index_.push_back(entry);
+    }
+  }
+  // Only out of order if the system clock was changed while recording
+  std::stable_sort(index_.begin(), index_.end());
+}
+
+DDS::ReturnCode_t RecordingPlayback::play(Replayer& replayer, double speed,
+                                          const SystemTimePoint& start, const SystemTimePoint& end)
+{
+  ReplayerHandler handler(replayer);
+  return play(handler, speed, start, end);
+}
+
+DDS::ReturnCode_t RecordingPlayback::play(SampleHandler& handler, double speed,
+                                          const SystemTimePoint& start, const SystemTimePoint& end)
+{
+  // Seek to the last indexed sample before start
+  size_t segment_index = 0;
+  size_t offset = magic_size;
+  if (start) {
+    IndexEntry key;
+    key.time = start;
+    OPENDDS_VECTOR(IndexEntry)::const_iterator it = std::upper_bound(index_.begin(), index_.end(), key);
+    if (it != index_.begin()) {
+      --it;
+      segment_index = std::lower_bound(segments_.begin(), segments_.end(), it->segment) - segments_.begin();
+      offset = it->offset;
+    }
+  }
+
+  bool started = false;
+  MonotonicTimePoint play_start;
+  SystemTimePoint first_recorded;
+  for (; segment_index < segments_.size(); ++segment_index, offset = magic_size) {
+    const String path = segment_path(directory_, segments_[segment_index], data_suffix);
+    ACE_Mem_Map map;
+    if (map.map(ACE_TEXT_CHAR_TO_TCHAR(path.c_str()), static_cast<size_t>(-1), O_RDONLY,
+                ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1) {
+      if (log_level >= LogLevel::Warning) {
+        ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RecordingPlayback::play: "
+                   "could not map %C: %p\n", path.c_str(), ACE_TEXT("mmap")));
+      }
+      return DDS::RETCODE_ERROR;
+    }
+    const char* const begin = static_cast<const char*>(map.addr());
+    const size_t size = map.size();
+    if (size < magic_size || ACE_OS::memcmp(begin, segment_magic, magic_size) != 0) {
+      if (log_level >= LogLevel::Warning) {
+        ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RecordingPlayback::play: "
+                   "%C is not a recording segment\n", path.c_str()));
+      }
+      return DDS::RETCODE_ERROR;
+    }
+
+    for (size_t pos = offset; pos < size;) {
+      ACE_CDR::ULong body_size;
+      SystemTimePoint recorded;
+      // A segment ends early if the recording was interrupted
+      if (!peek_record(begin + pos, size - pos, body_size, recorded)) {
+        break;
+      }
+      const char* const record = begin + pos;
+      pos += 4 + body_size;
+
+      if (start && recorded < start) {
+        continue;
+      }
+      if (end && recorded >= end) {
+        return DDS::RETCODE_OK;
+      }
+
+      ACE_Message_Block mb(record + 4 + 8, body_size - 8);
+      mb.wr_ptr(body_size - 8);
+      Serializer ser(&mb, encoding);
+      DDS::Time_t source_timestamp;
+      GUID_t publication;
+      ACE_CDR::Octet message_id, encoding_kind;
+      ACE_CDR::Boolean byte_order;
+      ACE_CDR::ULong header_size, data_size;
+      if (!(ser >> source_timestamp.sec) || !(ser >> source_timestamp.nanosec) ||
+          !(ser >> publication) || !(ser >> ACE_InputCDR::to_octet(message_id)) ||
+          !(ser >> ACE_InputCDR::to_boolean(byte_order)) ||
+          !(ser >> ACE_InputCDR::to_octet(encoding_kind)) || !(ser >> header_size) ||
+          header_size > mb.length()) {
+        break;
+      }
+      ACE_Message_Block header_mb(mb.rd_ptr(), header_size);
+      header_mb.wr_ptr(header_size);
+      const DataSampleHeader header(header_mb);
+      if (!ser.skip(header_size) || !(ser >> data_size) || data_size != mb.length()) {
+        break;
+      }
+      Message_Block_Ptr data(new ACE_Message_Block(data_size));
+      data->copy(mb.rd_ptr(), data_size);
+
+      if (speed > 0) {
+        if (!started) {
+          started = true;
+          play_start = MonotonicTimePoint::now();
+          first_recorded = recorded;
+        } else {
+          const MonotonicTimePoint due = play_start + (recorded - first_recorded) / speed;
+          const TimeDuration wait = due - MonotonicTimePoint::now();
+          if (wait > TimeDuration::zero_value) {
+            ACE_OS::sleep(wait.value());
+          }
+        }
+      }
+
+      const RawDataSample sample(header, static_cast<MessageId>(message_id),
+                                 source_timestamp.sec, source_timestamp.nanosec,
+                                 publication, byte_order, data.get(),
+                                 static_cast<Encoding::Kind>(encoding_kind));
+      const DDS::ReturnCode_t rc = handler.on_sample(sample, recorded);
+      if (rc != DDS::RETCODE_OK) {
+        return rc;
+      }
+    }
+  }
+  return DDS::RETCODE_OK;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,167 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SAMPLERECORDING_H
+#define OPENDDS_DCPS_SAMPLERECORDING_H
+
+#include "ConditionVariable.h"
+#include "PoolAllocator.h"
+#include "RawDataSample.h"
+#include "Recorder.h"
+#include "Replayer.h"
+#include "ThreadPool.h"
+#include "TimeTypes.h"
+#include "dcps_export.h"
+#include "unique_ptr.h"
+
+#include <ace/Thread_Mutex.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class RecordingListener
+ *
+ * @brief RecorderListener that stores the samples it receives in a directory
+ *
+ * Each sample is stored with its DataSampleHeader, publication, source
+ * timestamp, and the time it was recorded in segment files named
+ * recording-<n>.dat.  Samples are copied into batches on the thread that
+ * delivers them, and the batches are written by a dedicated thread.  Each
+ * segment has an index file, recording-<n>.idx, that RecordingPlayback uses
+ * to find where to start playing from a given time.
+ *
+ * Use one directory for each Recorder.
+ */
+class OpenDDS_Dcps_Export RecordingListener : public RecorderListener {
+public:
+  static const size_t default_segment_size = 256 * 1024 * 1024;
+  static const size_t default_max_pending = 256 * 1024 * 1024;
+
+  /// Throws std::runtime_error if the directory can't be created.
+  /// Samples are dropped while more than @a max_pending bytes are waiting to
+  /// be written.
+  explicit RecordingListener(const String& directory,
+                             size_t segment_size = default_segment_size,
+                             size_t max_pending = default_max_pending);
+  virtual ~RecordingListener();
+
+  virtual void on_sample_data_received(Recorder* recorder, const RawDataSample& sample);
+  virtual void on_recorder_matched(Recorder* recorder, const DDS::SubscriptionMatchedStatus& status);
+
+  /// Block until everything received so far is written and synced.
+  void flush();
+
+  /// Number of samples that were dropped because writing fell behind.
+  size_t dropped() const;
+
+private:
+  typedef OPENDDS_VECTOR(char) Batch;
+
+  static ACE_THR_FUNC_RETURN run(void* arg);
+  void write_batches();
+  void queue_filling();
+  void write_batch(const Batch& batch);
+  void write_run(const Batch& batch, size_t begin, size_t end, Batch& index);
+  bool open_segment();
+  void close_segment();
+
+  const String directory_;
+  const size_t segment_size_;
+  const size_t max_pending_;
+
+  mutable ACE_Thread_Mutex mutex_;
+  ConditionVariable<ACE_Thread_Mutex> cv_;
+  ThreadStatusManager thread_status_manager_;
+  /// Batch being added to by on_sample_data_received
+  Batch filling_;
+  /// Full batches waiting for the I/O thread, oldest first
+  OPENDDS_LIST(Batch) pending_;
+  size_t pending_bytes_;
+  size_t dropped_;
+  /// Incremented for each batch handed to the I/O thread
+  ACE_UINT64 batches_queued_;
+  /// Incremented for each batch the I/O thread has written
+  ACE_UINT64 batches_written_;
+  bool shutdown_;
+
+  // Only used by the I/O thread
+  unsigned int segment_;
+  ACE_HANDLE data_handle_;
+  ACE_HANDLE index_handle_;
+  size_t segment_bytes_;
+  SystemTimePoint last_indexed_;
+
+  unique_ptr<ThreadPool> thread_;
+};
+
+typedef RcHandle<RecordingListener> RecordingListener_rch;
+
+/**
+ * @class RecordingPlayback
+ *
+ * @brief Plays back samples stored by RecordingListener
+ *
+ * Segments are mapped instead of read.  The index is used to skip to the
+ * start of the requested time range.
+ */
+class OpenDDS_Dcps_Export RecordingPlayback {
+public:
+  class SampleHandler {
+  public:
+    virtual ~SampleHandler() {}
+    /// Returning anything but RETCODE_OK stops the playback.
+    virtual DDS::ReturnCode_t on_sample(const RawDataSample& sample,
+                                        const SystemTimePoint& recorded) = 0;
+  };
+
+  /// Throws std::runtime_error if the directory can't be read.
+  explicit RecordingPlayback(const String& directory);
+
+  /**
+   * Pass the samples recorded from @a start up to, but not including, @a end
+   * to the handler.  A zero start or end means the beginning or end of the
+   * recording.  Samples are passed @a speed times as fast as they were
+   * recorded, so 1 is real time, or as fast as possible if speed is 0.
+   */
+  DDS::ReturnCode_t play(SampleHandler& handler, double speed = 0,
+                         const SystemTimePoint& start = SystemTimePoint::zero_value,
+                         const SystemTimePoint& end = SystemTimePoint::zero_value);
+
+  /// Write the samples using Replayer::write.
+  DDS::ReturnCode_t play(Replayer& replayer, double speed = 0,
+                         const SystemTimePoint& start = SystemTimePoint::zero_value,
+                         const SystemTimePoint& end = SystemTimePoint::zero_value);
+
+private:
+  struct IndexEntry {
+    SystemTimePoint time;
+    unsigned int segment;
+    size_t offset;
+
+    bool operator<(const IndexEntry& other) const
+    {
+      return time < other.time;
+    }
+  };
+
+  const String directory_;
+  OPENDDS_VECTOR(unsigned int) segments_;
+  /// Sorted by time
+  OPENDDS_VECTOR(IndexEntry) index_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_SAMPLERECORDING_H */
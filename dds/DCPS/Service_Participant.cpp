@@ -1590,6 +1590,45 @@ Service_Participant::publisher_content_filter() const
                                     COMMON_DCPS_PUBLISHER_CONTENT_FILTER_default);
 }
 
+void
+Service_Participant::lazy_deserialization(bool flag)
+{
+  config_store_->set_boolean(COMMON_DCPS_LAZY_DESERIALIZATION, flag);
+}
+
+bool
+Service_Participant::lazy_deserialization() const
+{
+  return config_store_->get_boolean(COMMON_DCPS_LAZY_DESERIALIZATION,
+                                    COMMON_DCPS_LAZY_DESERIALIZATION_default);
+}
+
+void
+Service_Participant::reader_delivery_queue_size(size_t size)
+{
+  config_store_->set_uint32(COMMON_DCPS_READER_DELIVERY_QUEUE_SIZE, static_cast<DDS::UInt32>(size));
+}
+
+size_t
+Service_Participant::reader_delivery_queue_size() const
+{
+  return config_store_->get_uint32(COMMON_DCPS_READER_DELIVERY_QUEUE_SIZE,
+                                   COMMON_DCPS_READER_DELIVERY_QUEUE_SIZE_default);
+}
+
+void
+Service_Participant::reader_sample_pool_size(size_t size)
+{
+  config_store_->set_uint32(COMMON_DCPS_READER_SAMPLE_POOL_SIZE, static_cast<DDS::UInt32>(size));
+}
+
+size_t
+Service_Participant::reader_sample_pool_size() const
+{
+  return config_store_->get_uint32(COMMON_DCPS_READER_SAMPLE_POOL_SIZE,
+                                   COMMON_DCPS_READER_SAMPLE_POOL_SIZE_default);
+}
+
 TimeDuration
 Service_Participant::pending_timeout() const
 {
@@ -2091,7 +2130,10 @@ Service_Participant::get_data_durability_cache(
           const String persistent_data_dir =
             config_store_->get(COMMON_DCPS_PERSISTENT_DATA_DIR,
                                COMMON_DCPS_PERSISTENT_DATA_DIR_default);
-          this->persistent_data_cache_.reset(new DataDurabilityCache(kind, persistent_data_dir));
+          const bool use_log =
+            config_store_->get_boolean(COMMON_DCPS_PERSISTENT_DATA_LOG,
+                                       COMMON_DCPS_PERSISTENT_DATA_LOG_default);
+          this->persistent_data_cache_.reset(new DataDurabilityCache(kind, persistent_data_dir, use_log));
         }
 
       } catch (const std::exception& ex) {
@@ -2294,6 +2336,16 @@ Service_Participant::get_type_object(DDS::DomainParticipant_ptr participant,
   return XTypes::TypeObject();
 }
 
+XTypes::TypeObjectCache_rch Service_Participant::type_object_cache()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, xtypes_lock_, XTypes::TypeObjectCache_rch());
+  if (!type_object_cache_) {
+    type_object_cache_ = make_rch<XTypes::TypeObjectCache>(
+      config_store_->get(COMMON_DCPS_TYPE_OBJECT_CACHE_DIR, COMMON_DCPS_TYPE_OBJECT_CACHE_DIR_default));
+  }
+  return type_object_cache_;
+}
+
 namespace {
   const EnumList<Service_Participant::TypeObjectEncoding> type_object_encoding_kinds[] =
     {
@@ -103,6 +103,9 @@ const String COMMON_DCPS_GLOBAL_TRANSPORT_CONFIG_default = "";
 
 const char COMMON_DCPS_INFO_REPO[] = "COMMON_DCPS_INFO_REPO";
 
+const char COMMON_DCPS_LAZY_DESERIALIZATION[] = "COMMON_DCPS_LAZY_DESERIALIZATION";
+const bool COMMON_DCPS_LAZY_DESERIALIZATION_default = false;
+
 const char COMMON_DCPS_LIVELINESS_FACTOR[] = "COMMON_DCPS_LIVELINESS_FACTOR";
 const int COMMON_DCPS_LIVELINESS_FACTOR_default = 80;
 
@@ -111,6 +114,9 @@ const char COMMON_DCPS_LOG_LEVEL[] = "COMMON_DCPS_LOG_LEVEL";
 const char COMMON_DCPS_MONITOR[] = "COMMON_DCPS_MONITOR";
 const bool COMMON_DCPS_MONITOR_default = false;
 
+const char COMMON_DCPS_MONITOR_PERIOD[] = "COMMON_DCPS_MONITOR_PERIOD";
+const TimeDuration COMMON_DCPS_MONITOR_PERIOD_default(1, 0);
+
 const char COMMON_DCPS_PENDING_TIMEOUT[] = "COMMON_DCPS_PENDING_TIMEOUT";
 // Can't use TimeDuration::zero_value since initialization order is undefined.
 const TimeDuration COMMON_DCPS_PENDING_TIMEOUT_default(0, 0);
@@ -118,15 +124,26 @@ const TimeDuration COMMON_DCPS_PENDING_TIMEOUT_default(0, 0);
 #ifndef OPENDDS_NO_PERSISTENCE_PROFILE
 const char COMMON_DCPS_PERSISTENT_DATA_DIR[] = "COMMON_DCPS_PERSISTENT_DATA_DIR";
 const String COMMON_DCPS_PERSISTENT_DATA_DIR_default = "OpenDDS-durable-data-dir";
+const char COMMON_DCPS_PERSISTENT_DATA_LOG[] = "COMMON_DCPS_PERSISTENT_DATA_LOG";
+const bool COMMON_DCPS_PERSISTENT_DATA_LOG_default = false;
 #endif
 
 const char COMMON_DCPS_PUBLISHER_CONTENT_FILTER[] = "COMMON_DCPS_PUBLISHER_CONTENT_FILTER";
 const bool COMMON_DCPS_PUBLISHER_CONTENT_FILTER_default = true;
 
+const char COMMON_DCPS_READER_DELIVERY_QUEUE_SIZE[] = "COMMON_DCPS_READER_DELIVERY_QUEUE_SIZE";
+const size_t COMMON_DCPS_READER_DELIVERY_QUEUE_SIZE_default = 0;
+
+const char COMMON_DCPS_READER_SAMPLE_POOL_SIZE[] = "COMMON_DCPS_READER_SAMPLE_POOL_SIZE";
+const size_t COMMON_DCPS_READER_SAMPLE_POOL_SIZE_default = 0;
+
 const char COMMON_DCPS_THREAD_STATUS_INTERVAL[] = "COMMON_DCPS_THREAD_STATUS_INTERVAL";
 
 const char COMMON_DCPS_TRANSPORT_DEBUG_LEVEL[] = "COMMON_DCPS_TRANSPORT_DEBUG_LEVEL";
 
+const char COMMON_DCPS_TYPE_OBJECT_CACHE_DIR[] = "COMMON_DCPS_TYPE_OBJECT_CACHE_DIR";
+const String COMMON_DCPS_TYPE_OBJECT_CACHE_DIR_default = "";
+
 const char COMMON_DCPS_TYPE_OBJECT_ENCODING[] = "COMMON_DCPS_TYPE_OBJECT_ENCODING";
 const String COMMON_DCPS_TYPE_OBJECT_ENCODING_default = "Normal";
 
@@ -409,6 +426,24 @@ public:
   bool publisher_content_filter() const;
   //@}
 
+  /// Accessors for LazyDeserialization.
+  //@{
+  void lazy_deserialization(bool);
+  bool lazy_deserialization() const;
+  //@}
+
+  /// Accessors for ReaderDeliveryQueueSize.
+  //@{
+  void reader_delivery_queue_size(size_t);
+  size_t reader_delivery_queue_size() const;
+  //@}
+
+  /// Accessors for the number of released samples each DataReader keeps for reuse.
+  //@{
+  void reader_sample_pool_size(size_t);
+  size_t reader_sample_pool_size() const;
+  //@}
+
   /// Accessors for pending data timeout.
   //@{
   TimeDuration pending_timeout() const;
@@ -574,6 +609,12 @@ public:
   XTypes::TypeObject get_type_object(DDS::DomainParticipant_ptr participant,
                                      const XTypes::TypeIdentifier& ti) const;
 
+  /**
+   * Cache of remote TypeObjects shared by all participants, which is kept on
+   * disk if DCPSTypeObjectCacheDir is set.
+   */
+  XTypes::TypeObjectCache_rch type_object_cache();
+
   enum TypeObjectEncoding { Encoding_Normal, Encoding_WriteOldFormat, Encoding_ReadOldFormat };
   TypeObjectEncoding type_object_encoding() const;
   void type_object_encoding(TypeObjectEncoding encoding);
@@ -846,6 +887,8 @@ private:
   /// Thread mutex used to protect the static initialization of XTypes data structures
   ACE_Thread_Mutex xtypes_lock_;
 
+  XTypes::TypeObjectCache_rch type_object_cache_;
+
   /// Used to track state of service participant
   AtomicBool shut_down_;
 
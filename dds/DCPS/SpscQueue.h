@@ -0,0 +1,91 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SPSC_QUEUE_H
+#define OPENDDS_DCPS_SPSC_QUEUE_H
+
+#include "Atomic.h"
+#include "PoolAllocator.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Bounded FIFO queue for exactly one producer thread and one consumer thread
+ * that doesn't need a lock. push may only be called by the producer and pop
+ * by the consumer, but either can be a different thread over time if the
+ * caller makes sure the calls don't overlap.
+ */
+template <typename T>
+class SpscQueue {
+public:
+  explicit SpscQueue(size_t capacity)
+    : slots_(capacity + 1)
+    , head_(0)
+    , tail_(0)
+  {}
+
+  size_t capacity() const { return slots_.size() - 1; }
+
+  /// Returns false without copying value if the queue is full.
+  bool push(const T& value)
+  {
+    const size_t tail = tail_.load();
+    const size_t next = advance(tail);
+    if (next == head_.load()) {
+      return false;
+    }
+    slots_[tail] = value;
+    tail_.store(next);
+    return true;
+  }
+
+  /// Returns false if the queue is empty.
+  bool pop(T& value)
+  {
+    const size_t head = head_.load();
+    if (head == tail_.load()) {
+      return false;
+    }
+    value = slots_[head];
+    // Don't hold on to what the element refers to until the slot is reused.
+    slots_[head] = T();
+    head_.store(advance(head));
+    return true;
+  }
+
+  bool empty() const
+  {
+    return head_.load() == tail_.load();
+  }
+
+private:
+  SpscQueue(const SpscQueue&);
+  SpscQueue& operator=(const SpscQueue&);
+
+  size_t advance(size_t index) const
+  {
+    return index + 1 == slots_.size() ? 0 : index + 1;
+  }
+
+  OPENDDS_VECTOR(T) slots_;
+  /// Next slot to pop, only written by the consumer.
+  Atomic<size_t> head_;
+  /// Next slot to push, only written by the producer.
+  Atomic<size_t> tail_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_SPSC_QUEUE_H */
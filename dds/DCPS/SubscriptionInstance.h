@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_SUBSCRIPTION_INSTANCE_H
 
 #include "dcps_export.h"
+#include "DeadlineList.h"
 #include "ReceivedDataElementList.h"
 #include "ReceivedDataStrategy.h"
 #include "InstanceState.h"
@@ -72,6 +73,9 @@ public:
 
   MonotonicTimePoint deadline_;
 
+  /// Position in DataReaderImpl's deadline list.
+  DeadlineLink<SubscriptionInstance> deadline_link_;
+
   MonotonicTimePoint last_accepted_;
 };
 
@@ -0,0 +1,305 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  /// Expirations further out than this are all treated the same.  They are
+  /// far beyond what the wheel holds, so they are only placed in the top level
+  /// and moved when it gets to them.
+  const time_t max_seconds = 1000000000;
+
+  ACE_UINT64 to_usec(const TimeDuration& duration)
+  {
+    const ACE_Time_Value& value = duration.value();
+    if (value.sec() >= max_seconds) {
+      return static_cast<ACE_UINT64>(max_seconds) * ACE_ONE_SECOND_IN_USECS;
+    }
+    ACE_UINT64 usec;
+    value.to_usec(usec);
+    return usec;
+  }
+}
+
+TimerWheel::TimerWheel(const MonotonicTimePoint& start, const TimeDuration& resolution)
+  : start_(start)
+  , resolution_usec_(std::max(to_usec(resolution), ACE_UINT64(1)))
+  , current_tick_(0)
+  , free_(npos)
+{
+  for (size_t list = 0; list <= due_list; ++list) {
+    heads_[list] = npos;
+    tails_[list] = npos;
+  }
+  for (size_t level = 0; level < levels; ++level) {
+    level_size_[level] = 0;
+  }
+}
+
+bool TimerWheel::insert(TimerId id, const FunArgPair& event, const MonotonicTimePoint& expiration)
+{
+  const std::pair<IdMap::iterator, bool> inserted = ids_.insert(std::make_pair(id, static_cast<size_t>(npos)));
+  if (!inserted.second) {
+    return false;
+  }
+
+  size_t node = free_;
+  if (node != npos) {
+    free_ = nodes_[node].next;
+  } else {
+    node = nodes_.size();
+    nodes_.push_back(Node());
+  }
+  inserted.first->second = node;
+
+  Node& n = nodes_[node];
+  n.id = id;
+  n.event = event;
+  n.tick = to_tick(expiration, true);
+  place(node);
+  return true;
+}
+
+bool TimerWheel::erase(TimerId id, FunArgPair* event)
+{
+  const IdMap::iterator pos = ids_.find(id);
+  if (pos == ids_.end()) {
+    return false;
+  }
+  const size_t node = pos->second;
+  if (event) {
+    *event = nodes_[node].event;
+  }
+  unlink(node);
+  release(node);
+  return true;
+}
+
+size_t TimerWheel::erase(const FunArgPair& event)
+{
+  size_t count = 0;
+  for (size_t node = 0; node < nodes_.size(); ++node) {
+    if (nodes_[node].list != npos && nodes_[node].event == event) {
+      unlink(node);
+      release(node);
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool TimerWheel::contains(TimerId id) const
+{
+  return ids_.find(id) != ids_.end();
+}
+
+void TimerWheel::expire(const MonotonicTimePoint& now, EventQueue& expired)
+{
+  take_list(due_list, expired);
+
+  const ACE_UINT64 target = to_tick(now, false);
+  while (current_tick_ < target) {
+    size_t empty_levels = 0;
+    while (empty_levels < levels && level_size_[empty_levels] == 0) {
+      ++empty_levels;
+    }
+    if (empty_levels == levels) {
+      current_tick_ = target;
+      break;
+    }
+    if (empty_levels) {
+      // Nothing happens before the next tick of the lowest level with timers
+      const unsigned int shift = slot_bits * static_cast<unsigned int>(empty_levels);
+      const ACE_UINT64 last_empty = (((current_tick_ >> shift) + 1) << shift) - 1;
+      current_tick_ = std::min(last_empty, target);
+      if (current_tick_ == target) {
+        break;
+      }
+    }
+
+    ++current_tick_;
+    // Timers from higher levels were inserted before those with the same tick
+    // in lower levels, so the lower levels go first to keep them in order.
+    for (size_t level = 1; level < levels; ++level) {
+      const ACE_UINT64 level_mask = (ACE_UINT64(1) << (slot_bits * level)) - 1;
+      if ((current_tick_ & level_mask) == 0) {
+        cascade(level);
+      }
+    }
+    take_list(static_cast<size_t>(current_tick_ & slot_mask), expired);
+    take_list(due_list, expired);
+  }
+}
+
+MonotonicTimePoint TimerWheel::next_expiration() const
+{
+  if (empty()) {
+    return MonotonicTimePoint::max_value;
+  }
+  if (heads_[due_list] != npos) {
+    return to_time(current_tick_);
+  }
+
+  ACE_UINT64 next = ACE_UINT64(-1);
+  for (size_t level = 0; level < levels; ++level) {
+    if (!level_size_[level]) {
+      continue;
+    }
+    // For the upper levels this is when the slot is moved down a level
+    const unsigned int shift = slot_bits * static_cast<unsigned int>(level);
+    const ACE_UINT64 base = current_tick_ >> shift;
+    for (ACE_UINT64 d = 1; d <= slots_per_level; ++d) {
+      if (heads_[level * slots_per_level + static_cast<size_t>((base + d) & slot_mask)] != npos) {
+        next = std::min(next, (base + d) << shift);
+        break;
+      }
+    }
+  }
+  return to_time(next);
+}
+
+void TimerWheel::clear(EventQueue* events)
+{
+  EventQueue discarded;
+  EventQueue& out = events ? *events : discarded;
+  take_list(due_list, out);
+  for (size_t list = 0; list < due_list; ++list) {
+    take_list(list, out);
+  }
+  nodes_.clear();
+  free_ = npos;
+}
+
+ACE_UINT64 TimerWheel::to_tick(const MonotonicTimePoint& time, bool round_up) const
+{
+  if (time <= start_) {
+    return 0;
+  }
+  const ACE_UINT64 usec = to_usec(time - start_);
+  return (usec + (round_up ? resolution_usec_ - 1 : 0)) / resolution_usec_;
+}
+
+MonotonicTimePoint TimerWheel::to_time(ACE_UINT64 tick) const
+{
+  const ACE_UINT64 max_tick = static_cast<ACE_UINT64>(max_seconds) * ACE_ONE_SECOND_IN_USECS / resolution_usec_;
+  const ACE_UINT64 usec = std::min(tick, max_tick) * resolution_usec_;
+  return start_ + TimeDuration(static_cast<time_t>(usec / ACE_ONE_SECOND_IN_USECS),
+                               static_cast<suseconds_t>(usec % ACE_ONE_SECOND_IN_USECS));
+}
+
+void TimerWheel::place(size_t node, bool cascading)
+{
+  // Cascading happens before the current tick's slot is taken, so timers for
+  // it can still go there, ahead of the ones inserted after them.
+  const ACE_UINT64 tick = nodes_[node].tick;
+  if (tick < current_tick_ || (tick == current_tick_ && !cascading)) {
+    link(node, due_list);
+    return;
+  }
+
+  const ACE_UINT64 delta = tick - current_tick_;
+  size_t level = 0;
+  while (level < levels - 1 && (delta >> (slot_bits * (level + 1))) != 0) {
+    ++level;
+  }
+  ACE_UINT64 placed_tick = tick;
+  if ((delta >> (slot_bits * levels)) != 0) {
+    // Past the end of the wheel, so wait in the furthest slot and be placed
+    // again when that slot is moved down.
+    placed_tick = current_tick_ + (ACE_UINT64(1) << (slot_bits * levels)) - 1;
+  }
+  link(node, level * slots_per_level + static_cast<size_t>((placed_tick >> (slot_bits * level)) & slot_mask),
+       cascading);
+}
+
+void TimerWheel::link(size_t node, size_t list, bool front)
+{
+  Node& n = nodes_[node];
+  n.list = list;
+  if (front) {
+    n.prev = npos;
+    n.next = heads_[list];
+  } else {
+    n.prev = tails_[list];
+    n.next = npos;
+  }
+  if (n.prev != npos) {
+    nodes_[n.prev].next = node;
+  } else {
+    heads_[list] = node;
+  }
+  if (n.next != npos) {
+    nodes_[n.next].prev = node;
+  } else {
+    tails_[list] = node;
+  }
+  if (list < due_list) {
+    ++level_size_[list / slots_per_level];
+  }
+}
+
+void TimerWheel::unlink(size_t node)
+{
+  Node& n = nodes_[node];
+  if (n.prev != npos) {
+    nodes_[n.prev].next = n.next;
+  } else {
+    heads_[n.list] = n.next;
+  }
+  if (n.next != npos) {
+    nodes_[n.next].prev = n.prev;
+  } else {
+    tails_[n.list] = n.prev;
+  }
+  if (n.list < due_list) {
+    --level_size_[n.list / slots_per_level];
+  }
+  n.list = npos;
+}
+
+void TimerWheel::release(size_t node)
+{
+  ids_.erase(nodes_[node].id);
+  nodes_[node].next = free_;
+  free_ = node;
+}
+
+void TimerWheel::cascade(size_t level)
+{
+  const size_t list = level * slots_per_level +
+    static_cast<size_t>((current_tick_ >> (slot_bits * level)) & slot_mask);
+  // Everything in this slot expires within the next tick of this level, so it
+  // goes to lower levels unless it's past the end of the wheel.  It was all
+  // inserted before what's already there, so it goes in front, last one first.
+  while (tails_[list] != npos) {
+    const size_t node = tails_[list];
+    unlink(node);
+    place(node, true);
+  }
+}
+
+void TimerWheel::take_list(size_t list, EventQueue& expired)
+{
+  while (heads_[list] != npos) {
+    const size_t node = heads_[list];
+    expired.push_back(nodes_[node].event);
+    unlink(node);
+    release(node);
+  }
+}
+
+} // DCPS
+} // OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
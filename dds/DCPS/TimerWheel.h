@@ -0,0 +1,138 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TIMER_WHEEL_H
+#define OPENDDS_DCPS_TIMER_WHEEL_H
+
+#include "Definitions.h"
+#include "PoolAllocator.h"
+#include "TimeTypes.h"
+#include "dcps_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class TimerWheel
+ *
+ * @brief Hierarchical timer wheel with constant time insert and erase
+ *
+ * Time is divided into ticks of a fixed resolution.  Each level of the wheel
+ * has a slot for each of the next 64 ticks of that level, where a tick of one
+ * level spans all the slots of the level below it.  Timers are kept in the
+ * lowest level that can hold them and are moved down a level as the wheel
+ * reaches their slot, so no timer is moved more than once per level.
+ *
+ * Timers expire on the first tick boundary at or after their expiration, so
+ * they are never early and late by at most the resolution.  Timers that
+ * expire on the same tick do so in the order they were inserted.
+ *
+ * Not thread safe; DispatchService uses it under its own lock.
+ */
+class OpenDDS_Dcps_Export TimerWheel {
+public:
+  typedef long TimerId;
+  typedef void (*FunPtr)(void*);
+  typedef std::pair<FunPtr, void*> FunArgPair;
+  typedef OPENDDS_DEQUE(FunArgPair) EventQueue;
+
+  explicit TimerWheel(const MonotonicTimePoint& start = MonotonicTimePoint::now(),
+                      const TimeDuration& resolution = TimeDuration::from_msec(1));
+
+  /**
+   * Add a timer
+   * @return false if a timer with this id already exists
+   */
+  bool insert(TimerId id, const FunArgPair& event, const MonotonicTimePoint& expiration);
+
+  /**
+   * Remove a timer by id
+   * @param event if specified, set to the event of the removed timer
+   * @return true if the timer existed
+   */
+  bool erase(TimerId id, FunArgPair* event = 0);
+
+  /// Remove all timers for an event, returning how many there were
+  size_t erase(const FunArgPair& event);
+
+  bool contains(TimerId id) const;
+  size_t size() const { return ids_.size(); }
+  bool empty() const { return ids_.empty(); }
+
+  /// Remove the timers that have expired as of @a now and append their events
+  /// to @a expired, earliest first and in insertion order for the same tick.
+  void expire(const MonotonicTimePoint& now, EventQueue& expired);
+
+  /**
+   * The time to call expire() next.  This is never after the earliest
+   * expiration but can be before it when timers have to be moved down a level
+   * first.  Returns MonotonicTimePoint::max_value if there are no timers.
+   */
+  MonotonicTimePoint next_expiration() const;
+
+  /// Remove all the timers, appending their events to @a events if given.
+  void clear(EventQueue* events = 0);
+
+private:
+  static const unsigned int slot_bits = 6;
+  static const size_t slots_per_level = 1u << slot_bits;
+  static const size_t slot_mask = slots_per_level - 1;
+  static const size_t levels = 4;
+  /// List of timers that expire on the next call to expire()
+  static const size_t due_list = levels * slots_per_level;
+  static const size_t npos = static_cast<size_t>(-1);
+
+  struct Node {
+    TimerId id;
+    FunArgPair event;
+    ACE_UINT64 tick;
+    size_t list;
+    size_t prev;
+    size_t next;
+  };
+
+  ACE_UINT64 to_tick(const MonotonicTimePoint& time, bool round_up) const;
+  MonotonicTimePoint to_time(ACE_UINT64 tick) const;
+
+  void place(size_t node, bool cascading = false);
+  void link(size_t node, size_t list, bool front = false);
+  void unlink(size_t node);
+  void release(size_t node);
+  void cascade(size_t level);
+  void take_list(size_t list, EventQueue& expired);
+
+  const MonotonicTimePoint start_;
+  const ACE_UINT64 resolution_usec_;
+  /// Last tick that expire() has handled
+  ACE_UINT64 current_tick_;
+
+  /// Nodes are recycled through free_ so insert doesn't allocate once the
+  /// wheel has grown to its working size.
+  OPENDDS_VECTOR(Node) nodes_;
+  size_t free_;
+  size_t heads_[due_list + 1];
+  size_t tails_[due_list + 1];
+  size_t level_size_[levels];
+
+#if defined ACE_HAS_CPP11
+  typedef OPENDDS_UNORDERED_MAP(TimerId, size_t) IdMap;
+#else
+  typedef OPENDDS_MAP(TimerId, size_t) IdMap;
+#endif
+  IdMap ids_;
+};
+
+} // DCPS
+} // OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_DCPS_TIMER_WHEEL_H
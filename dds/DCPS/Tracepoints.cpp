@@ -0,0 +1,330 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "Tracepoints.h"
+
+#include "Atomic.h"
+#include "PoolAllocator.h"
+#include "RcObject.h"
+#include "TimeTypes.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <ace/OS_NS_Thread.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <algorithm>
+#include <fstream>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+
+/**
+ * Ring buffer of one thread's records.  Only that thread pushes, and
+ * snapshot can be called from any thread.  The position of the next record
+ * is published after the record is written, so a snapshot knows which records
+ * are complete and which ones were overwritten while it was copying them.
+ * Without C++11 atomics a mutex is used instead.
+ */
+class ThreadLog : public RcObject {
+public:
+  ThreadLog(size_t tid, const String& name)
+    : tid_(tid)
+    , name_(name)
+    , records_(Tracepoints::capacity)
+    , head_(0)
+    , cleared_(0)
+    , exited_(false)
+  {}
+
+  size_t tid() const { return tid_; }
+  const String& name() const { return name_; }
+
+  void push(const Tracepoints::Record& record)
+  {
+#ifdef ACE_HAS_CPP11
+    const ACE_UINT64 head = head_.load(std::memory_order_relaxed);
+    records_[head % Tracepoints::capacity] = record;
+    head_.store(head + 1, std::memory_order_release);
+    // A snapshot that sees any of the next record must also see this head.
+    std::atomic_thread_fence(std::memory_order_release);
+#else
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    records_[head_ % Tracepoints::capacity] = record;
+    ++head_;
+#endif
+  }
+
+  void snapshot(OPENDDS_VECTOR(Tracepoints::Record)& out) const
+  {
+#ifdef ACE_HAS_CPP11
+    const ACE_UINT64 end = head_.load(std::memory_order_acquire);
+    const ACE_UINT64 begin = std::max(oldest(end), cleared_.load());
+    out.reserve(out.size() + (end - begin));
+    const size_t first = out.size();
+    for (ACE_UINT64 i = begin; i < end; ++i) {
+      out.push_back(records_[i % Tracepoints::capacity]);
+    }
+    // Discard the records the thread overwrote while they were copied,
+    // including the one it may be in the middle of writing.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const ACE_UINT64 overwritten = oldest(head_.load(std::memory_order_relaxed) + 1);
+    if (overwritten > begin) {
+      const size_t discard = static_cast<size_t>(std::min(overwritten - begin, end - begin));
+      out.erase(out.begin() + first, out.begin() + first + discard);
+    }
+#else
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    const ACE_UINT64 begin = std::max(oldest(head_), cleared_.load());
+    out.reserve(out.size() + (head_ - begin));
+    for (ACE_UINT64 i = begin; i < head_; ++i) {
+      out.push_back(records_[i % Tracepoints::capacity]);
+    }
+#endif
+  }
+
+  void clear()
+  {
+#ifdef ACE_HAS_CPP11
+    cleared_.store(head_.load());
+#else
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    cleared_.store(head_);
+#endif
+  }
+
+  void exited() { exited_.store(true); }
+  bool has_exited() const { return exited_.load(); }
+
+private:
+  static ACE_UINT64 oldest(ACE_UINT64 head)
+  {
+    return head > Tracepoints::capacity ? head - Tracepoints::capacity : 0;
+  }
+
+  const size_t tid_;
+  const String name_;
+  OPENDDS_VECTOR(Tracepoints::Record) records_;
+#ifdef ACE_HAS_CPP11
+  /// Position of the next record, only written by the owning thread
+  Atomic<ACE_UINT64> head_;
+#else
+  mutable ACE_Thread_Mutex mutex_;
+  ACE_UINT64 head_;
+#endif
+  /// Records before this position were cleared
+  Atomic<ACE_UINT64> cleared_;
+  Atomic<bool> exited_;
+};
+typedef RcHandle<ThreadLog> ThreadLog_rch;
+
+class Registry;
+
+/// Thread specific reference to the thread's log
+struct LogHolder {
+  LogHolder();
+  ~LogHolder();
+
+  ThreadLog_rch log;
+};
+
+/// All the logs, including those of threads that have exited, until clear is
+/// called or too many of them have exited.
+class Registry {
+public:
+  static Registry* instance()
+  {
+    return ACE_Singleton<Registry, ACE_SYNCH_MUTEX>::instance();
+  }
+
+  ThreadLog& current()
+  {
+    return *tss_->log;
+  }
+
+  ThreadLog_rch add_thread()
+  {
+    char buffer[32];
+    const size_t len = ACE_OS::thr_id(buffer, sizeof buffer);
+
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    prune_exited(max_exited_logs);
+    const ThreadLog_rch log = make_rch<ThreadLog>(next_tid_++, String(buffer, len));
+    logs_.push_back(log);
+    return log;
+  }
+
+  void logs(OPENDDS_VECTOR(ThreadLog_rch)& out) const
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    out = logs_;
+  }
+
+  void clear()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    prune_exited(0);
+    for (size_t i = 0; i < logs_.size(); ++i) {
+      logs_[i]->clear();
+    }
+  }
+
+private:
+  friend class ACE_Singleton<Registry, ACE_SYNCH_MUTEX>;
+
+  /// Threads that exit are still included in the trace, but only this many.
+  static const size_t max_exited_logs = 16;
+
+  Registry()
+    : next_tid_(1)
+  {}
+
+  void prune_exited(size_t keep)
+  {
+    size_t exited = 0;
+    for (size_t i = logs_.size(); i > 0; --i) {
+      if (logs_[i - 1]->has_exited() && ++exited > keep) {
+        logs_.erase(logs_.begin() + (i - 1));
+      }
+    }
+  }
+
+  mutable ACE_Thread_Mutex mutex_;
+  OPENDDS_VECTOR(ThreadLog_rch) logs_;
+  size_t next_tid_;
+  ACE_TSS<LogHolder> tss_;
+};
+
+LogHolder::LogHolder()
+  : log(Registry::instance()->add_thread())
+{}
+
+LogHolder::~LogHolder()
+{
+  log->exited();
+}
+
+ACE_UINT64 now_usec()
+{
+  ACE_UINT64 usec;
+  MonotonicTimePoint::now().value().to_usec(usec);
+  return usec;
+}
+
+const char* chrome_phase(ACE_UINT8 phase)
+{
+  switch (phase) {
+  case Tracepoints::PHASE_BEGIN:
+    return "B";
+  case Tracepoints::PHASE_END:
+    return "E";
+  default:
+    return "i";
+  }
+}
+
+}
+
+void Tracepoints::record(Point point, Phase phase, ACE_INT64 arg)
+{
+  Record record;
+  record.usec = now_usec();
+  record.arg = arg;
+  record.point = static_cast<ACE_UINT16>(point);
+  record.phase = static_cast<ACE_UINT8>(phase);
+  Registry::instance()->current().push(record);
+}
+
+const char* Tracepoints::name(Point point)
+{
+  switch (point) {
+  case WRITE:
+    return "DataWriterImpl::write";
+  case WRITE_DATA_ENQUEUE:
+    return "WriteDataContainer::enqueue";
+  case SEND_QUEUED:
+    return "TransportSendStrategy::send queued";
+  case SEND_DIRECT:
+    return "TransportSendStrategy::direct_send";
+  case SOCKET_SEND:
+    return "TransportSendStrategy::do_send_packet";
+  case RECEIVE:
+    return "TransportReceiveStrategy::handle_dds_input";
+  case REASSEMBLE:
+    return "TransportReassembly::reassemble";
+  case DATA_RECEIVED:
+    return "DataReaderImpl::data_received";
+  case LISTENER_UPCALL:
+    return "DataReaderListener::on_data_available";
+  default:
+    return "unknown";
+  }
+}
+
+void Tracepoints::write_chrome_trace(std::ostream& out)
+{
+  OPENDDS_VECTOR(ThreadLog_rch) logs;
+  Registry::instance()->logs(logs);
+  const int pid = static_cast<int>(ACE_OS::getpid());
+
+  OPENDDS_VECTOR(Record) records;
+  records.reserve(capacity);
+  bool first = true;
+
+  out << "{\"traceEvents\":[";
+  for (size_t i = 0; i < logs.size(); ++i) {
+    const ThreadLog& log = *logs[i];
+    out << (first ? "\n" : ",\n")
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":" << log.tid()
+        << ",\"args\":{\"name\":\"" << log.name() << "\"}}";
+    first = false;
+
+    records.clear();
+    log.snapshot(records);
+    for (size_t j = 0; j < records.size(); ++j) {
+      const Record& record = records[j];
+      out << ",\n{\"name\":\"" << name(static_cast<Point>(record.point))
+          << "\",\"cat\":\"opendds\",\"ph\":\"" << chrome_phase(record.phase) << '"';
+      if (record.phase == PHASE_INSTANT) {
+        out << ",\"s\":\"t\"";
+      }
+      out << ",\"ts\":" << record.usec
+          << ",\"pid\":" << pid
+          << ",\"tid\":" << log.tid()
+          << ",\"args\":{\"arg\":" << record.arg << "}}";
+    }
+  }
+  out << "\n]}\n";
+}
+
+bool Tracepoints::write_chrome_trace(const char* path)
+{
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+  write_chrome_trace(out);
+  out.close();
+  return !out.fail();
+}
+
+void Tracepoints::clear()
+{
+  Registry::instance()->clear();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
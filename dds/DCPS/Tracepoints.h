@@ -0,0 +1,141 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRACEPOINTS_H
+#define OPENDDS_DCPS_TRACEPOINTS_H
+
+#include "dcps_export.h"
+#include "Definitions.h"
+
+#include <ace/Basic_Types.h>
+
+#include <iosfwd>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class Tracepoints
+ *
+ * @brief Timestamped events along the path of a sample through OpenDDS
+ *
+ * Each thread records into its own ring buffer, so recording doesn't take a
+ * lock shared with other threads and the oldest events of a thread are
+ * overwritten once its buffer is full.  write_chrome_trace writes the events
+ * of all the threads in the Trace Event Format that chrome://tracing and
+ * Perfetto load.
+ *
+ * The tracepoints in the library are only compiled in when
+ * OPENDDS_CONFIG_TRACEPOINTS is enabled.  See OPENDDS_TRACEPOINT and
+ * OPENDDS_TRACE_SCOPE.
+ */
+class OpenDDS_Dcps_Export Tracepoints {
+public:
+  /// The meaning of the argument recorded with each point is noted.
+  enum Point {
+    /// DataWriterImpl::write, instance handle
+    WRITE,
+    /// WriteDataContainer::enqueue, sequence number
+    WRITE_DATA_ENQUEUE,
+    /// TransportSendStrategy::send queued the element, sequence number
+    SEND_QUEUED,
+    /// TransportSendStrategy::direct_send, packet length
+    SEND_DIRECT,
+    /// TransportSendStrategy::do_send_packet, packet length
+    SOCKET_SEND,
+    /// TransportReceiveStrategy::handle_dds_input, no argument
+    RECEIVE,
+    /// TransportReassembly::reassemble, sequence number
+    REASSEMBLE,
+    /// DataReaderImpl::data_received, sequence number
+    DATA_RECEIVED,
+    /// DataReaderListener::on_data_available, instance handle of the reader
+    LISTENER_UPCALL,
+    POINT_COUNT
+  };
+
+  enum Phase {
+    PHASE_BEGIN,
+    PHASE_END,
+    PHASE_INSTANT
+  };
+
+  struct Record {
+    /// Monotonic time in microseconds
+    ACE_UINT64 usec;
+    ACE_INT64 arg;
+    ACE_UINT16 point;
+    ACE_UINT8 phase;
+  };
+
+  /// Number of records each thread keeps.  Once a thread's buffer is full,
+  /// its oldest record isn't written out since it's the next to be
+  /// overwritten.
+  static const size_t capacity = 8192;
+
+  /// Record an event in the calling thread's ring buffer.
+  static void record(Point point, Phase phase, ACE_INT64 arg);
+
+  static const char* name(Point point);
+
+  /// Write the events recorded so far as a Chrome trace JSON object.
+  /// Events recorded while writing may or may not be included.
+  static void write_chrome_trace(std::ostream& out);
+
+  /// Returns false if the file couldn't be written.
+  static bool write_chrome_trace(const char* path);
+
+  /// Drop the events recorded so far and forget the threads that have exited.
+  static void clear();
+};
+
+/// Records the beginning of a point when constructed and the end of it when
+/// destroyed.
+class TraceScope {
+public:
+  TraceScope(Tracepoints::Point point, ACE_INT64 arg)
+    : point_(point)
+    , arg_(arg)
+  {
+    Tracepoints::record(point_, Tracepoints::PHASE_BEGIN, arg_);
+  }
+
+  ~TraceScope()
+  {
+    Tracepoints::record(point_, Tracepoints::PHASE_END, arg_);
+  }
+
+private:
+  TraceScope(const TraceScope&);
+  TraceScope& operator=(const TraceScope&);
+
+  const Tracepoints::Point point_;
+  const ACE_INT64 arg_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#if OPENDDS_CONFIG_TRACEPOINTS
+#  define OPENDDS_TRACEPOINT(POINT, ARG) \
+  OpenDDS::DCPS::Tracepoints::record(OpenDDS::DCPS::Tracepoints::POINT, \
+    OpenDDS::DCPS::Tracepoints::PHASE_INSTANT, static_cast<ACE_INT64>(ARG))
+#  define OPENDDS_TRACE_SCOPE(POINT, ARG) \
+  const OpenDDS::DCPS::TraceScope opendds_trace_scope_##POINT( \
+    OpenDDS::DCPS::Tracepoints::POINT, static_cast<ACE_INT64>(ARG))
+#else
+#  define OPENDDS_TRACEPOINT(POINT, ARG)
+#  define OPENDDS_TRACE_SCOPE(POINT, ARG)
+#endif
+
+#endif /* OPENDDS_DCPS_TRACEPOINTS_H */
@@ -20,6 +20,7 @@
 #include "Util.h"
 #include "Time_Helper.h"
 #include "GuidConverter.h"
+#include "Tracepoints.h"
 #include "transport/framework/TransportSendElement.h"
 #include "transport/framework/TransportCustomizedElement.h"
 #include "transport/framework/TransportRegistry.h"
@@ -299,6 +300,8 @@ WriteDataContainer::enqueue(
     return DDS::RETCODE_ERROR;
   }
 
+  OPENDDS_TRACEPOINT(WRITE_DATA_ENQUEUE, sample->get_header().sequence_.getValue());
+
   // Get the PublicationInstance pointer from InstanceHandle_t.
   PublicationInstance_rch instance =
     get_handle_instance(instance_handle);
@@ -1612,37 +1615,35 @@ WriteDataContainer::set_deadline_period(const TimeDuration& deadline_period)
   // Reset the deadline timer if the period has changed.
   if (deadline_period_ != deadline_period) {
     if (deadline_period_ == TimeDuration::max_value) {
-      OPENDDS_ASSERT(deadline_map_.empty());
+      OPENDDS_ASSERT(deadline_list_.empty());
 
       for (PublicationInstanceMapType::iterator iter = instances_.begin();
            iter != instances_.end();
            ++iter) {
-        iter->second->deadline_ = deadline;
-        deadline_map_.insert(std::make_pair(deadline, iter->second));
+        deadline_list_.insert(*iter->second, deadline);
       }
 
-      if (!deadline_map_.empty()) {
+      if (!deadline_list_.empty()) {
         deadline_task_->schedule(deadline_period);
       }
     } else if (deadline_period == TimeDuration::max_value) {
-      if (!deadline_map_.empty()) {
+      if (!deadline_list_.empty()) {
         deadline_task_->cancel();
       }
 
-      deadline_map_.clear();
+      deadline_list_.clear();
     } else {
-      DeadlineMapType new_map;
+      // Clear first so each instance is added to the end of the list.
+      deadline_list_.clear();
       for (PublicationInstanceMapType::iterator iter = instances_.begin();
            iter != instances_.end();
            ++iter) {
-        iter->second->deadline_ = deadline;
-        new_map.insert(std::make_pair(iter->second->deadline_, iter->second));
+        deadline_list_.insert(*iter->second, deadline);
       }
-      std::swap(new_map, deadline_map_);
 
-      if (!deadline_map_.empty()) {
+      if (!deadline_list_.empty()) {
         deadline_task_->cancel();
-        deadline_task_->schedule(deadline_map_.begin()->first - MonotonicTimePoint::now());
+        deadline_task_->schedule(deadline_list_.front()->deadline_ - MonotonicTimePoint::now());
       }
     }
 
@@ -1658,17 +1659,14 @@ WriteDataContainer::process_deadlines(const MonotonicTimePoint& now)
   // Lock ourselves.
   ACE_GUARD (ACE_Recursive_Thread_Mutex, wdc_guard, lock_);
 
-  if (deadline_map_.empty()) {
+  if (deadline_list_.empty()) {
     return;
   }
 
   bool notify = false;
 
-  for (DeadlineMapType::iterator pos = deadline_map_.begin(), limit = deadline_map_.end();
-       pos != limit && pos->first < now; pos = deadline_map_.begin()) {
-
-    PublicationInstance_rch instance = pos->second;
-    deadline_map_.erase(pos);
+  for (PublicationInstance_rch instance = deadline_list_.front();
+       instance->deadline_ < now; instance = deadline_list_.front()) {
 
     ++deadline_status_.total_count;
     deadline_status_.total_count_change = deadline_status_.total_count - deadline_last_total_count_;
@@ -1696,15 +1694,14 @@ WriteDataContainer::process_deadlines(const MonotonicTimePoint& now)
       deadline_last_total_count_ = deadline_status_.total_count;
     }
 
-    instance->deadline_ += deadline_period_;
-    deadline_map_.insert(std::make_pair(instance->deadline_, instance));
+    deadline_list_.insert(*instance, instance->deadline_ + deadline_period_);
   }
 
   if (notify) {
     writer_->notify_status_condition();
   }
 
-  deadline_task_->schedule(deadline_map_.begin()->first - now);
+  deadline_task_->schedule(deadline_list_.front()->deadline_ - now);
 }
 
 void
@@ -1716,17 +1713,8 @@ WriteDataContainer::extend_deadline(const PublicationInstance_rch& instance)
     return;
   }
 
-  std::pair<DeadlineMapType::iterator, DeadlineMapType::iterator> r = deadline_map_.equal_range(instance->deadline_);
-  while (r.first != r.second && r.first->second != instance) {
-    ++r.first;
-  }
-  if (r.first != r.second) {
-    // The instance was in the map.
-    deadline_map_.erase(r.first);
-  }
-  instance->deadline_ = MonotonicTimePoint::now() + deadline_period_;
-  bool schedule = deadline_map_.empty();
-  deadline_map_.insert(std::make_pair(instance->deadline_, instance));
+  const bool schedule = deadline_list_.empty();
+  deadline_list_.insert(*instance, MonotonicTimePoint::now() + deadline_period_);
   if (schedule) {
     deadline_task_->schedule(deadline_period_);
   }
@@ -1741,15 +1729,8 @@ WriteDataContainer::cancel_deadline(const PublicationInstance_rch& instance)
     return;
   }
 
-  std::pair<DeadlineMapType::iterator, DeadlineMapType::iterator> r = deadline_map_.equal_range(instance->deadline_);
-  while (r.first != r.second && r.first->second != instance) {
-    ++r.first;
-  }
-  if (r.first != r.second) {
-    deadline_map_.erase(r.first);
-    if (deadline_map_.empty()) {
-      deadline_task_->cancel();
-    }
+  if (deadline_list_.remove(*instance) && deadline_list_.empty()) {
+    deadline_task_->cancel();
   }
 }
 
@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_WRITE_DATA_CONTAINER_H
 
 #include "DataSampleElement.h"
+#include "DeadlineList.h"
 #include "SendStateDataSampleList.h"
 #include "WriterDataSampleList.h"
 #include "DisjointSequence.h"
@@ -558,8 +559,8 @@ private:
   /// Timer responsible for reporting missed offered deadlines.
   RcHandle<DCPS::PmfSporadicTask<WriteDataContainer> > deadline_task_;
   TimeDuration deadline_period_; // TimeDuration::zero_value means no deadline.
-  typedef OPENDDS_MULTIMAP(MonotonicTimePoint, PublicationInstance_rch) DeadlineMapType;
-  DeadlineMapType deadline_map_;
+  typedef DeadlineList<PublicationInstance> DeadlineListType;
+  DeadlineListType deadline_list_;
 
   /// Lock for synchronization of @c status_ member.
   ACE_Recursive_Thread_Mutex& deadline_status_lock_;
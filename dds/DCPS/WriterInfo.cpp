@@ -77,6 +77,7 @@ WriterInfo::WriterInfo(const WriterInfoListener_rch& reader,
   , reader_liveliness_lease_duration_(reader_liveliness_lease_duration)
   , reader_liveliness_lease_duration_is_finite_(!is_infinite(reader_liveliness_lease_duration))
   , handle_(DDS::HANDLE_NIL)
+  , latency_histogram_(0)
 {
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
   reset_coherent_info();
@@ -95,6 +96,21 @@ WriterInfo::~WriterInfo()
 {
   historic_samples_sweeper_task_->cancel();
   liveliness_check_task_->cancel();
+  delete latency_histogram_.load();
+}
+
+LatencyHistogram& WriterInfo::latency_histogram()
+{
+  LatencyHistogram* histogram = latency_histogram_;
+  if (!histogram) {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    histogram = latency_histogram_;
+    if (!histogram) {
+      histogram = new LatencyHistogram;
+      latency_histogram_ = histogram;
+    }
+  }
+  return *histogram;
 }
 
 const char* get_state_str(WriterState state)
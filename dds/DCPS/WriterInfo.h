@@ -14,6 +14,7 @@
 #include "ConditionVariable.h"
 #include "Definitions.h"
 #include "DisjointSequence.h"
+#include "LatencyHistogram.h"
 #include "PoolAllocator.h"
 #include "RcObject.h"
 #include "SporadicTask.h"
@@ -154,6 +155,13 @@ public:
   /// update liveliness when remove_association is called.
   void removed();
 
+  /// Latency of the samples received from this writer, recorded without
+  /// taking mutex_.  It's allocated by the first call, so readers that don't
+  /// have statistics enabled don't pay for it.
+  LatencyHistogram& latency_histogram();
+  /// Null if latency_histogram() hasn't been called yet.
+  LatencyHistogram* latency_histogram_if_allocated() const { return latency_histogram_; }
+
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
   Coherent_State coherent_change_received();
   void reset_coherent_info();
@@ -232,6 +240,8 @@ private:
   /// Number of received coherent changes in active change set.
   Atomic<ACE_UINT32> coherent_samples_;
 
+  Atomic<LatencyHistogram*> latency_histogram_;
+
   /// Is this writer evaluated for owner ?
   typedef OPENDDS_MAP(DDS::InstanceHandle_t, bool) OwnerEvaluateFlags;
   OwnerEvaluateFlags owner_evaluated_;
@@ -896,6 +896,11 @@ DynamicDataImpl::SingleValue::SingleValue(const CORBA::WChar* wstr)
 #endif
 
 DynamicDataImpl::SingleValue::~SingleValue()
+{
+  release();
+}
+
+void DynamicDataImpl::SingleValue::release()
 {
 #define SINGLE_VALUE_DESTRUCT(T) static_cast<ACE_OutputCDR::T*>(active_)->~T(); break
   switch (kind_) {
@@ -1042,9 +1047,13 @@ DynamicDataImpl::SingleValue::SingleValue(const SingleValue& other)
 
 DynamicDataImpl::SingleValue& DynamicDataImpl::SingleValue::operator=(const SingleValue& other)
 {
-  kind_ = other.kind_;
-  active_ = 0;
-  copy(other);
+  if (this != &other) {
+    // Free a string this had before copying over it.
+    release();
+    kind_ = other.kind_;
+    active_ = 0;
+    copy(other);
+  }
   return *this;
 }
 
@@ -3974,6 +3983,19 @@ void DynamicDataImpl::DataContainer::clear()
   sequence_map_.clear();
 }
 
+size_t DynamicDataImpl::DataContainer::expected_size(const DDS::DynamicType_var& type,
+                                                     const DDS::TypeDescriptor_var& type_desc)
+{
+  if (!type.in()) {
+    return 0;
+  }
+  // Arrays can be written in any order, so their elements are all slots.
+  if (type->get_kind() == TK_ARRAY && type_desc.in()) {
+    return bound_total(type_desc);
+  }
+  return type->get_member_count();
+}
+
 // Get largest index among elements of a sequence-like type written to the single map.
 bool DynamicDataImpl::DataContainer::get_largest_single_index(CORBA::ULong& largest_index) const
 {
@@ -4505,22 +4527,14 @@ void serialized_size_wstring_value(const Encoding& encoding, size_t& size, const
 #endif
 
 bool serialized_size_dynamic_member(DDS::DynamicData_ptr data, const Encoding& encoding,
-  size_t& size, const DDS::MemberDescriptor_var& md, DDS::ExtensibilityKind extensibility,
+  size_t& size, const XTypes::SerializationPlan::Member& member, DDS::ExtensibilityKind extensibility,
   size_t& mutable_running_total, Sample::Extent ext)
 {
   using namespace OpenDDS::XTypes;
-  const DDS::MemberId member_id = md->id();
-  const CORBA::Boolean optional = md->is_optional();
-  const DDS::DynamicType_var member_type = get_base_type(md->type());
-  const DDS::TypeKind member_tk = member_type->get_kind();
-  DDS::TypeKind treat_member_as = member_tk;
-
-  if (member_tk == TK_ENUM && enum_bound(member_type, treat_member_as) != DDS::RETCODE_OK) {
-    return false;
-  }
-  if (member_tk == TK_BITMASK && bitmask_bound(member_type, treat_member_as) != DDS::RETCODE_OK) {
-    return false;
-  }
+  const DDS::MemberId member_id = member.id;
+  const CORBA::Boolean optional = member.is_optional;
+  const DDS::TypeKind member_tk = member.kind;
+  const DDS::TypeKind treat_member_as = member.treat_as;
 
   DDS::ReturnCode_t rc = DDS::RETCODE_OK;
   if (is_primitive(treat_member_as)) {
@@ -4676,39 +4690,28 @@ bool serialized_size_dynamic_struct(const Encoding& encoding, size_t& size,
                                     DDS::DynamicData_ptr struct_data, Sample::Extent ext)
 {
   const DDS::DynamicType_var type = struct_data->type();
-  const DDS::DynamicType_var base_type = XTypes::get_base_type(type);
-  const bool struct_has_explicit_keys = XTypes::has_explicit_keys(base_type);
-  DDS::TypeDescriptor_var td;
-  if (!get_type_descriptor(base_type, td)) {
+  const XTypes::SerializationPlan_rch plan = XTypes::get_serialization_plan(type);
+  if (!plan) {
     return false;
   }
 
-  const DDS::ExtensibilityKind extensibility = td->extensibility_kind();
+  const DDS::ExtensibilityKind extensibility = plan->extensibility;
   if (extensibility == DDS::APPENDABLE || extensibility == DDS::MUTABLE) {
     serialized_size_delimiter(encoding, size);
   }
 
   size_t mutable_running_total = 0;
-  const CORBA::ULong member_count = base_type->get_member_count();
-  for (CORBA::ULong i = 0; i < member_count; ++i) {
-    DDS::DynamicTypeMember_var dtm;
-    if (base_type->get_member_by_index(dtm, i) != DDS::RETCODE_OK) {
-      return false;
-    }
-    DDS::MemberDescriptor_var md;
-    if (dtm->get_descriptor(md) != DDS::RETCODE_OK) {
-      return false;
-    }
-
-    if (XTypes::exclude_member(ext, md->is_key(), struct_has_explicit_keys)) {
+  typedef XTypes::SerializationPlan::Members::const_iterator MemberIter;
+  for (MemberIter it = plan->members.begin(); it != plan->members.end(); ++it) {
+    if (XTypes::exclude_member(ext, it->is_key, plan->has_explicit_keys)) {
       continue;
     }
 
-    if (!serialized_size_dynamic_member(struct_data, encoding, size, md, extensibility,
+    if (!serialized_size_dynamic_member(struct_data, encoding, size, *it, extensibility,
                                         mutable_running_total, XTypes::nested(ext))) {
       if (log_level >= LogLevel:: Notice) {
         ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: serialized_size_dynamic_struct:"
-                   " Failed to compute serialized size for member ID %u\n", md->id()));
+                   " Failed to compute serialized size for member ID %u\n", it->id));
       }
       return false;
     }
@@ -4916,9 +4919,11 @@ bool serialized_size_dynamic_union(const Encoding& encoding, size_t& size,
       return false;
     }
 
+    XTypes::SerializationPlan::Member selected_member;
     if (has_branch &&
-        !serialized_size_dynamic_member(union_data, encoding, size, selected_md,
-                                        extensibility, mutable_running_total, nested(ext))) {
+        (!get_member_plan(selected_member, selected_md) ||
+         !serialized_size_dynamic_member(union_data, encoding, size, selected_member,
+                                         extensibility, mutable_running_total, nested(ext)))) {
       return false;
     }
   }
@@ -5217,22 +5222,14 @@ bool serialize_dynamic_primitive_member(Serializer& ser, const T& value, DDS::Re
 }
 
 bool serialize_dynamic_member(Serializer& ser, DDS::DynamicData_ptr data,
-  const DDS::MemberDescriptor_var md, DDS::ExtensibilityKind extensibility, Sample::Extent ext)
+  const XTypes::SerializationPlan::Member& member, DDS::ExtensibilityKind extensibility, Sample::Extent ext)
 {
   using namespace OpenDDS::XTypes;
-  const DDS::MemberId id = md->id();
-  const CORBA::Boolean optional = md->is_optional();
-  const CORBA::Boolean must_understand = md->is_must_understand() || md->is_key();
-  const DDS::DynamicType_var member_type = get_base_type(md->type());
-  const DDS::TypeKind member_tk = member_type->get_kind();
-  DDS::TypeKind treat_member_as = member_tk;
-
-  if (member_tk == TK_ENUM && enum_bound(member_type, treat_member_as) != DDS::RETCODE_OK) {
-    return false;
-  }
-  if (member_tk == TK_BITMASK && bitmask_bound(member_type, treat_member_as) != DDS::RETCODE_OK) {
-    return false;
-  }
+  const DDS::MemberId id = member.id;
+  const CORBA::Boolean optional = member.is_optional;
+  const CORBA::Boolean must_understand = member.is_must_understand;
+  const DDS::TypeKind member_tk = member.kind;
+  const DDS::TypeKind treat_member_as = member.treat_as;
 
   DDS::ReturnCode_t rc = DDS::RETCODE_OK;
   switch (treat_member_as) {
@@ -5385,16 +5382,14 @@ bool serialize_dynamic_struct(Serializer& ser, DDS::DynamicData_ptr data, Sample
 {
   using namespace OpenDDS::XTypes;
   const DDS::DynamicType_var type = data->type();
-  const DDS::DynamicType_var base_type = get_base_type(type);
-  const bool struct_has_explicit_keys = has_explicit_keys(base_type);
-  DDS::TypeDescriptor_var td;
-  if (!get_type_descriptor(base_type, td)) {
+  const SerializationPlan_rch plan = get_serialization_plan(type);
+  if (!plan) {
     return false;
   }
 
   const Encoding& encoding = ser.encoding();
   size_t total_size = 0;
-  const DDS::ExtensibilityKind extensibility = td->extensibility_kind();
+  const DDS::ExtensibilityKind extensibility = plan->extensibility;
   if (extensibility == DDS::APPENDABLE || extensibility == DDS::MUTABLE) {
     if (!serialized_size_dynamic_struct(encoding, total_size, data, ext)
         || !ser.write_delimiter(total_size)) {
@@ -5402,23 +5397,14 @@ bool serialize_dynamic_struct(Serializer& ser, DDS::DynamicData_ptr data, Sample
     }
   }
 
-  const CORBA::ULong member_count = base_type->get_member_count();
-  for (CORBA::ULong i = 0; i < member_count; ++i) {
-    DDS::DynamicTypeMember_var dtm;
-    if (base_type->get_member_by_index(dtm, i) != DDS::RETCODE_OK) {
-      return false;
-    }
-    DDS::MemberDescriptor_var md;
-    if (dtm->get_descriptor(md) != DDS::RETCODE_OK) {
-      return false;
-    }
-
-    if (exclude_member(ext, md->is_key(), struct_has_explicit_keys)) {
+  typedef SerializationPlan::Members::const_iterator MemberIter;
+  for (MemberIter it = plan->members.begin(); it != plan->members.end(); ++it) {
+    if (exclude_member(ext, it->is_key, plan->has_explicit_keys)) {
       continue;
     }
 
     // The serialization function for individual member must account for any header it has.
-    if (!serialize_dynamic_member(ser, data, md, extensibility, nested(ext))) {
+    if (!serialize_dynamic_member(ser, data, *it, extensibility, nested(ext))) {
       return false;
     }
   }
@@ -5586,7 +5572,12 @@ bool serialize_dynamic_union(Serializer& ser, DDS::DynamicData_ptr data, Sample:
   if (get_selected_union_branch(base_type, disc_val, has_branch, selected_md) != DDS::RETCODE_OK) {
     return false;
   }
-  return !has_branch || serialize_dynamic_member(ser, data, selected_md, extensibility, nested(ext));
+  if (!has_branch) {
+    return true;
+  }
+  SerializationPlan::Member selected_member;
+  return get_member_plan(selected_member, selected_md) &&
+    serialize_dynamic_member(ser, data, selected_member, extensibility, nested(ext));
 }
 
 bool serialize_dynamic_element(Serializer& ser, DDS::DynamicData_ptr col_data,
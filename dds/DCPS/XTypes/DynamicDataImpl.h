@@ -13,6 +13,9 @@
 #  include <dds/DCPS/Sample.h>
 #  include <dds/DCPS/ValueWriter.h>
 
+#  include <algorithm>
+#  include <iterator>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -486,6 +489,7 @@ private:
     SingleValue(const SingleValue& other);
     SingleValue& operator=(const SingleValue& other);
     void copy(const SingleValue& other);
+    void release();
 
     ~SingleValue();
 
@@ -580,16 +584,247 @@ private:
     SequenceValue& operator=(const SequenceValue& rhs);
   };
 
-  typedef OPENDDS_MAP(DDS::MemberId, SingleValue)::const_iterator const_single_iterator;
+  // Values keyed by member ID in contiguous storage, so the values of a
+  // sample take a single allocation. IDs that are positions, which are the
+  // element indexes of collections and the IDs of members that weren't given
+  // one, are slots in the front of the storage and are set and found without
+  // searching. Other IDs, like the hashed IDs of mutable types and the IDs of
+  // single values and discriminators, would need the type to find a position,
+  // which is no cheaper than a search, so they are kept sorted after the slots.
+  // Provides the subset of the std::map interface used by the container.
+  // Iterators are invalidated by insert and erase.
+  template<typename Value>
+  class MemberMap {
+  public:
+    typedef std::pair<DDS::MemberId, Value> value_type;
+
+    class const_iterator {
+    public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef typename MemberMap::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef const value_type& reference;
+
+      const_iterator()
+        : map_(0)
+        , pos_(0)
+      {}
+
+      reference operator*() const { return map_->values_[pos_]; }
+      pointer operator->() const { return &map_->values_[pos_]; }
+
+      const_iterator& operator++()
+      {
+        pos_ = map_->skip_forward(pos_ + 1);
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const const_iterator prev(*this);
+        ++*this;
+        return prev;
+      }
+
+      const_iterator& operator--()
+      {
+        pos_ = map_->skip_back(pos_ - 1);
+        return *this;
+      }
+
+      const_iterator operator--(int)
+      {
+        const const_iterator next(*this);
+        --*this;
+        return next;
+      }
+
+      bool operator==(const const_iterator& other) const { return pos_ == other.pos_; }
+      bool operator!=(const const_iterator& other) const { return pos_ != other.pos_; }
+
+    private:
+      friend class MemberMap;
+
+      const_iterator(const MemberMap* map, size_t pos)
+        : map_(map)
+        , pos_(pos)
+      {}
+
+      const MemberMap* map_;
+      size_t pos_;
+    };
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    explicit MemberMap(size_t expected_size = 0)
+      : expected_size_(expected_size)
+      , slot_count_(0)
+      , size_(0)
+    {}
+
+    const_iterator begin() const { return const_iterator(this, skip_forward(0)); }
+    const_iterator end() const { return const_iterator(this, values_.size()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void clear()
+    {
+      values_.clear();
+      slot_count_ = 0;
+      size_ = 0;
+    }
+
+    const_iterator find(DDS::MemberId id) const
+    {
+      if (id < slot_count_) {
+        return const_iterator(this, in_slot(id) ? id : values_.size());
+      }
+      const size_t pos = lower_bound(id);
+      return const_iterator(this, pos != values_.size() && values_[pos].first == id ? pos : values_.size());
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+      const DDS::MemberId id = value.first;
+      if (values_.empty()) {
+        values_.reserve(expected_size_);
+      }
+
+      if (id >= slot_count_ && id < slot_limit() &&
+          (slot_count_ == values_.size() || id < values_[slot_count_].first)) {
+        // Everything after the slots has a larger ID, so the slots can grow to
+        // include this one.
+        values_.insert(values_.begin() + slot_count_, id + 1 - slot_count_, empty_slot());
+        slot_count_ = id + 1;
+      }
+
+      if (id < slot_count_) {
+        if (in_slot(id)) {
+          return std::make_pair(const_iterator(this, id), false);
+        }
+        values_[id] = value;
+        ++size_;
+        return std::make_pair(const_iterator(this, id), true);
+      }
+
+      if (values_.size() == slot_count_ || values_.back().first < id) {
+        values_.push_back(value);
+        ++size_;
+        return std::make_pair(const_iterator(this, values_.size() - 1), true);
+      }
+      const size_t pos = lower_bound(id);
+      if (values_[pos].first == id) {
+        return std::make_pair(const_iterator(this, pos), false);
+      }
+      values_.insert(values_.begin() + pos, value);
+      ++size_;
+      return std::make_pair(const_iterator(this, pos), true);
+    }
+
+    size_t erase(DDS::MemberId id)
+    {
+      if (id < slot_count_) {
+        if (!in_slot(id)) {
+          return 0;
+        }
+        values_[id] = empty_slot();
+        --size_;
+        // Drop empty slots at the end so the last slot is always in use.
+        size_t slots = slot_count_;
+        while (slots > 0 && !in_slot(static_cast<DDS::MemberId>(slots - 1))) {
+          --slots;
+        }
+        values_.erase(values_.begin() + slots, values_.begin() + slot_count_);
+        slot_count_ = slots;
+        return 1;
+      }
+
+      const size_t pos = lower_bound(id);
+      if (pos == values_.size() || values_[pos].first != id) {
+        return 0;
+      }
+      values_.erase(values_.begin() + pos);
+      --size_;
+      return 1;
+    }
+
+  private:
+    friend class const_iterator;
+
+    // Slots are only added for IDs this far past the last one, so a sparse
+    // collection or a large ID doesn't allocate a slot for every ID before it.
+    size_t slot_limit() const
+    {
+      return std::max(expected_size_, 2 * slot_count_ + 8);
+    }
+
+    // An empty slot can't have its own position as its ID.
+    static value_type empty_slot()
+    {
+      return value_type(MEMBER_ID_INVALID, Value());
+    }
+
+    bool in_slot(DDS::MemberId id) const
+    {
+      return values_[id].first == id;
+    }
+
+    size_t skip_forward(size_t pos) const
+    {
+      while (pos < slot_count_ && !in_slot(static_cast<DDS::MemberId>(pos))) {
+        ++pos;
+      }
+      return pos;
+    }
+
+    size_t skip_back(size_t pos) const
+    {
+      while (pos < slot_count_ && !in_slot(static_cast<DDS::MemberId>(pos))) {
+        --pos;
+      }
+      return pos;
+    }
+
+    // The first position after the slots with an ID that isn't less than id
+    size_t lower_bound(DDS::MemberId id) const
+    {
+      size_t first = slot_count_;
+      size_t count = values_.size() - slot_count_;
+      while (count > 0) {
+        const size_t step = count / 2;
+        const size_t mid = first + step;
+        if (values_[mid].first < id) {
+          first = mid + 1;
+          count -= step + 1;
+        } else {
+          count = step;
+        }
+      }
+      return first;
+    }
+
+    size_t expected_size_;
+    // The first slot_count_ values are the slots, indexed by ID
+    size_t slot_count_;
+    size_t size_;
+    OPENDDS_VECTOR(value_type) values_;
+  };
+
+  typedef MemberMap<SingleValue>::const_iterator const_single_iterator;
   typedef OPENDDS_MAP(DDS::MemberId, SequenceValue)::const_iterator const_sequence_iterator;
-  typedef OPENDDS_MAP(DDS::MemberId, DDS::DynamicData_var)::const_iterator const_complex_iterator;
+  typedef MemberMap<DDS::DynamicData_var>::const_iterator const_complex_iterator;
 
   // Container for all data written to this DynamicData object.
   // At anytime, there can be at most 1 entry for any given MemberId in all maps.
   // That is, each member is stored in at most 1 map.
   struct DataContainer {
     DataContainer(const DDS::DynamicType_var& type, const DynamicDataImpl* data)
-      : type_(type)
+      : single_map_(expected_size(type, data->type_desc_))
+      , complex_map_(expected_size(type, data->type_desc_))
+      , type_(type)
       , type_desc_(data->type_desc_)
       , data_(data)
     {}
@@ -605,6 +840,10 @@ private:
 
     void clear();
 
+    // How many members or elements a value of the type usually has
+    static size_t expected_size(const DDS::DynamicType_var& type,
+                                const DDS::TypeDescriptor_var& type_desc);
+
     // Get the largest index of all elements in each map.
     // Call only for collection-like types (sequence, string, etc).
     // Must be called with a non-empty map.
@@ -622,9 +861,9 @@ private:
     bool get_largest_index_basic_sequence(CORBA::ULong& index) const;
 
     // Internal data
-    OPENDDS_MAP(DDS::MemberId, SingleValue) single_map_;
+    MemberMap<SingleValue> single_map_;
     OPENDDS_MAP(DDS::MemberId, SequenceValue) sequence_map_;
-    OPENDDS_MAP(DDS::MemberId, DDS::DynamicData_var) complex_map_;
+    MemberMap<DDS::DynamicData_var> complex_map_;
 
     const DDS::DynamicType_var& type_;
     const DDS::TypeDescriptor_var& type_desc_;
@@ -40,6 +40,7 @@
 
 #  include <ace/OS_NS_string.h>
 
+#  include <algorithm>
 #  include <stdexcept>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -57,6 +58,7 @@ DynamicDataXcdrReadImpl::DynamicDataXcdrReadImpl()
   , reset_align_state_(false)
   , strm_(0, encoding_)
   , item_count_(ITEM_COUNT_INVALID)
+  , mutable_scan_offset_(0)
 {}
 
 DynamicDataXcdrReadImpl::DynamicDataXcdrReadImpl(ACE_Message_Block* chain,
@@ -70,6 +72,7 @@ DynamicDataXcdrReadImpl::DynamicDataXcdrReadImpl(ACE_Message_Block* chain,
   , reset_align_state_(false)
   , strm_(chain_, encoding_)
   , item_count_(ITEM_COUNT_INVALID)
+  , mutable_scan_offset_(0)
 {
   if (encoding_.xcdr_version() != DCPS::Encoding::XCDR_VERSION_1 &&
       encoding_.xcdr_version() != DCPS::Encoding::XCDR_VERSION_2) {
@@ -87,6 +90,7 @@ DynamicDataXcdrReadImpl::DynamicDataXcdrReadImpl(DCPS::Serializer& ser, DDS::Dyn
   , align_state_(ser.rdstate())
   , strm_(chain_, encoding_)
   , item_count_(ITEM_COUNT_INVALID)
+  , mutable_scan_offset_(0)
 {
   if (encoding_.xcdr_version() != DCPS::Encoding::XCDR_VERSION_1 &&
       encoding_.xcdr_version() != DCPS::Encoding::XCDR_VERSION_2) {
@@ -132,6 +136,9 @@ void DynamicDataXcdrReadImpl::copy(const DynamicDataXcdrReadImpl& other)
   strm_ = other.strm_;
   type_ = other.type_;
   item_count_ = other.item_count_;
+  member_offsets_ = other.member_offsets_;
+  mutable_member_offsets_ = other.mutable_member_offsets_;
+  mutable_scan_offset_ = other.mutable_scan_offset_;
 }
 
 DDS::ReturnCode_t DynamicDataXcdrReadImpl::set_descriptor(MemberId, DDS::MemberDescriptor*)
@@ -2190,42 +2197,54 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
       return DDS::RETCODE_ERROR;
     }
     const size_t end_of_struct = strm_.rpos() + dheader;
+    const ACE_CDR::ULong index = member_desc->index();
 
-    for (ACE_CDR::ULong i = 0; i < member_desc->index(); ++i) {
-      DDS::DynamicTypeMember_var dtm;
-      DDS::ReturnCode_t rc = type_->get_member_by_index(dtm, i);
-      if (rc != DDS::RETCODE_OK) {
-        if (DCPS::log_level >= DCPS::LogLevel::Notice) {
-          ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataXcdrReadImpl::skip_to_struct_member:"
-                     " Failed to get DynamicTypeMember for member at index %d\n", i));
-        }
-        return rc;
+    // Members are only skipped over once per DynamicData object. After that
+    // their positions are taken from member_offsets_.
+    if (member_offsets_.empty()) {
+      member_offsets_.push_back(strm_.rpos());
+    }
+    if (!strm_.skip(member_offsets_[(std::min)(size_t(index), member_offsets_.size() - 1)] - strm_.rpos())) {
+      if (DCPS::DCPS_debug_level >= 1) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                   ACE_TEXT(" Failed to skip to the member at index %d\n"), index));
       }
-      DDS::MemberDescriptor_var md;
-      rc = dtm->get_descriptor(md);
-      if (rc != DDS::RETCODE_OK) {
+      return DDS::RETCODE_ERROR;
+    }
+
+    SerializationPlan_rch plan;
+    if (member_offsets_.size() - 1 < index) {
+      plan = get_serialization_plan(type_);
+      if (!plan || plan->members.size() < index) {
         if (DCPS::log_level >= DCPS::LogLevel::Notice) {
           ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataXcdrReadImpl::skip_to_struct_member:"
-                     " Failed to get MemberDescriptor for member at index %d\n", i));
+                     " Failed to get serialization plan for member at index %d\n", index));
         }
-        return rc;
+        return DDS::RETCODE_ERROR;
       }
-      if (exclude_member(extent_, md->is_key(), has_explicit_keys(type_))) {
-        // This member is not present in the sample, don't need to do anything.
-        continue;
+    }
+
+    for (ACE_CDR::ULong i = static_cast<ACE_CDR::ULong>(member_offsets_.size() - 1); i < index; ++i) {
+      if (xcdr2_appendable && i > 0 && strm_.rpos() >= end_of_struct) {
+        return DDS::RETCODE_NO_DATA;
       }
 
-      ACE_CDR::ULong num_skipped;
-      if (!skip_struct_member_at_index(i, num_skipped)) {
-        if (DCPS::DCPS_debug_level >= 1) {
-          ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
-                     ACE_TEXT(" Failed to skip member at index %d\n"), i));
+      // Excluded members are not present in the sample, so there's nothing to skip.
+      if (!exclude_member(extent_, plan->members[i].is_key, plan->has_explicit_keys)) {
+        ACE_CDR::ULong num_skipped;
+        if (!skip_struct_member_at_index(i, num_skipped)) {
+          if (DCPS::DCPS_debug_level >= 1) {
+            ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                       ACE_TEXT(" Failed to skip member at index %d\n"), i));
+          }
+          return DDS::RETCODE_ERROR;
         }
-        return DDS::RETCODE_ERROR;
-      }
-      if (xcdr2_appendable && strm_.rpos() >= end_of_struct) {
-        return DDS::RETCODE_NO_DATA;
       }
+      member_offsets_.push_back(strm_.rpos());
+    }
+
+    if (xcdr2_appendable && index > 0 && strm_.rpos() >= end_of_struct) {
+      return DDS::RETCODE_NO_DATA;
     }
 
     if (member_desc->is_optional()) {
@@ -2254,6 +2273,29 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
     }
 
     const size_t end_of_struct = strm_.rpos() + dheader;
+
+    // Each member header is only read once per DynamicData object. After that
+    // the position of the member is taken from mutable_member_offsets_ and the
+    // search for new members resumes at mutable_scan_offset_.
+    const OffsetMap::const_iterator found = mutable_member_offsets_.find(id);
+    if (found != mutable_member_offsets_.end()) {
+      if (!strm_.skip(found->second - strm_.rpos())) {
+        if (DCPS::DCPS_debug_level >= 1) {
+          ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                     ACE_TEXT(" Failed to skip to member ID %d\n"), id));
+        }
+        return DDS::RETCODE_ERROR;
+      }
+      return DDS::RETCODE_OK;
+    }
+    if (mutable_scan_offset_ > strm_.rpos() && !strm_.skip(mutable_scan_offset_ - strm_.rpos())) {
+      if (DCPS::DCPS_debug_level >= 1) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                   ACE_TEXT(" Failed to skip already searched members while finding member ID %d\n"), id));
+      }
+      return DDS::RETCODE_ERROR;
+    }
+
     while (true) {
       if (strm_.rpos() >= end_of_struct) {
         if (DCPS::DCPS_debug_level >= 1) {
@@ -2274,6 +2316,9 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         return DDS::RETCODE_ERROR;
       }
 
+      mutable_member_offsets_.insert(std::make_pair(member_id, strm_.rpos()));
+      mutable_scan_offset_ = strm_.rpos() + member_size;
+
       if (member_id == id) {
         return DDS::RETCODE_OK;
       }
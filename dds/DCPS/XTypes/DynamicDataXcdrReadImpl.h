@@ -572,6 +572,19 @@ private:
 
   /// Cache the number of items (i.e., members or elements) in the data it holds.
   ACE_CDR::ULong item_count_;
+
+  /// Stream positions of the members of a final or appendable struct by
+  /// member index, filled in as members are skipped over.
+  OPENDDS_VECTOR(size_t) member_offsets_;
+
+  /// Stream positions of the members of a mutable struct by member ID, filled
+  /// in as member headers are read.
+  typedef OPENDDS_MAP(MemberId, size_t) OffsetMap;
+  OffsetMap mutable_member_offsets_;
+
+  /// Stream position of the first member header of a mutable struct that
+  /// hasn't been read yet, or 0 if none have been read.
+  size_t mutable_scan_offset_;
 };
 
 OpenDDS_Dcps_Export bool print_dynamic_data(DDS::DynamicData_ptr dd,
@@ -5,6 +5,7 @@
 #include "DynamicTypeImpl.h"
 
 #include "DynamicTypeMemberImpl.h"
+#include "Utils.h"
 
 #include <dds/DCPS/debug.h>
 
@@ -164,6 +165,9 @@ void DynamicTypeImpl::insert_dynamic_member(DDS::DynamicTypeMember_ptr dtm)
     member_by_id_.insert(std::make_pair(d->id(), DDS::DynamicTypeMember::_duplicate(dtm)));
   }
   member_by_name_.insert(std::make_pair(d->name(), DDS::DynamicTypeMember::_duplicate(dtm)));
+
+  ACE_Guard<ACE_Thread_Mutex> guard(plan_mutex_);
+  plan_.reset();
 }
 
 void DynamicTypeImpl::clear()
@@ -172,6 +176,78 @@ void DynamicTypeImpl::clear()
   member_by_id_.clear();
   member_by_index_.clear();
   descriptor_ = 0;
+
+  ACE_Guard<ACE_Thread_Mutex> guard(plan_mutex_);
+  plan_.reset();
+}
+
+namespace {
+  SerializationPlan_rch compute_serialization_plan(DDS::DynamicType_ptr type)
+  {
+    DDS::TypeDescriptor_var td;
+    if (type->get_kind() != TK_STRUCTURE || type->get_descriptor(td) != DDS::RETCODE_OK) {
+      return SerializationPlan_rch();
+    }
+
+    SerializationPlan_rch plan = DCPS::make_rch<SerializationPlan>();
+    plan->extensibility = td->extensibility_kind();
+    plan->has_explicit_keys = has_explicit_keys(type);
+
+    const ACE_CDR::ULong member_count = type->get_member_count();
+    plan->members.resize(member_count);
+    for (ACE_CDR::ULong i = 0; i < member_count; ++i) {
+      DDS::DynamicTypeMember_var dtm;
+      if (type->get_member_by_index(dtm, i) != DDS::RETCODE_OK) {
+        return SerializationPlan_rch();
+      }
+      DDS::MemberDescriptor_var md;
+      if (dtm->get_descriptor(md) != DDS::RETCODE_OK ||
+          !get_member_plan(plan->members[i], md)) {
+        return SerializationPlan_rch();
+      }
+    }
+    return plan;
+  }
+}
+
+SerializationPlan_rch DynamicTypeImpl::serialization_plan()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(plan_mutex_);
+  if (!plan_) {
+    plan_ = compute_serialization_plan(this);
+  }
+  return plan_;
+}
+
+SerializationPlan_rch get_serialization_plan(DDS::DynamicType_ptr type)
+{
+  const DDS::DynamicType_var base_type = get_base_type(type);
+  if (!base_type) {
+    return SerializationPlan_rch();
+  }
+  DynamicTypeImpl* const impl = dynamic_cast<DynamicTypeImpl*>(base_type.in());
+  return impl ? impl->serialization_plan() : compute_serialization_plan(base_type);
+}
+
+bool get_member_plan(SerializationPlan::Member& member, DDS::MemberDescriptor* md)
+{
+  const DDS::DynamicType_var member_type = get_base_type(md->type());
+  if (!member_type) {
+    return false;
+  }
+  member.id = md->id();
+  member.is_key = md->is_key();
+  member.is_optional = md->is_optional();
+  member.is_must_understand = md->is_must_understand() || md->is_key();
+  member.kind = member_type->get_kind();
+  member.treat_as = member.kind;
+  if (member.kind == TK_ENUM && enum_bound(member_type, member.treat_as) != DDS::RETCODE_OK) {
+    return false;
+  }
+  if (member.kind == TK_BITMASK && bitmask_bound(member_type, member.treat_as) != DDS::RETCODE_OK) {
+    return false;
+  }
+  return true;
 }
 
 DDS::DynamicType_var get_base_type(DDS::DynamicType_ptr type)
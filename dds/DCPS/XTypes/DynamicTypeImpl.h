@@ -10,6 +10,8 @@
 #include <dds/DCPS/RcObject.h>
 #include <dds/DdsDynamicDataC.h>
 
+#include <ace/Thread_Mutex.h>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -97,6 +99,46 @@ private:
   MapType map_;
 };
 
+/**
+ * What the dynamic serializers need to know about the members of a struct
+ * type, computed once per type instead of going through the DynamicTypeMember
+ * and MemberDescriptor of every member for every sample.
+ */
+struct SerializationPlan : public DCPS::RcObject {
+  struct Member {
+    Member()
+      : id(MEMBER_ID_INVALID)
+      , is_key(false)
+      , is_optional(false)
+      , is_must_understand(false)
+      , kind(TK_NONE)
+      , treat_as(TK_NONE)
+    {}
+
+    MemberId id;
+    bool is_key;
+    bool is_optional;
+    /// Either must_understand or key
+    bool is_must_understand;
+    /// Kind of the member type with aliases resolved
+    TypeKind kind;
+    /// Same as kind, except enums and bitmasks are the integer kind they are serialized as
+    TypeKind treat_as;
+  };
+  typedef OPENDDS_VECTOR(Member) Members;
+
+  SerializationPlan()
+    : extensibility(DDS::FINAL)
+    , has_explicit_keys(false)
+  {}
+
+  DDS::ExtensibilityKind extensibility;
+  bool has_explicit_keys;
+  /// In member index order
+  Members members;
+};
+typedef DCPS::RcHandle<SerializationPlan> SerializationPlan_rch;
+
 class OpenDDS_Dcps_Export DynamicTypeImpl : public DDS::DynamicType {
 public:
   DynamicTypeImpl();
@@ -171,6 +213,9 @@ public:
     return preset_type_info_set_ ? &preset_type_info_ : 0;
   }
 
+  /// Computed on first use, see get_serialization_plan
+  SerializationPlan_rch serialization_plan();
+
 private:
   DynamicTypeMembersByNameImpl member_by_name_;
   DynamicTypeMembersByIdImpl member_by_id_;
@@ -184,9 +229,23 @@ private:
   TypeMap complete_tm_;
   bool preset_type_info_set_;
   TypeInformation preset_type_info_;
+
+  ACE_Thread_Mutex plan_mutex_;
+  SerializationPlan_rch plan_;
 };
 
 OpenDDS_Dcps_Export DDS::DynamicType_var get_base_type(DDS::DynamicType_ptr type);
+
+/**
+ * Get the serialization plan of a structure type, which may be an alias.
+ * For DynamicTypeImpl the plan is cached on the type, otherwise it's computed
+ * for each call. Returns a null handle if the plan couldn't be computed.
+ */
+OpenDDS_Dcps_Export SerializationPlan_rch get_serialization_plan(DDS::DynamicType_ptr type);
+
+/// Fill in the plan for a single member, used directly for union branches.
+OpenDDS_Dcps_Export bool get_member_plan(SerializationPlan::Member& member, DDS::MemberDescriptor* md);
+
 bool test_equality(DDS::DynamicType_ptr lhs, DDS::DynamicType_ptr rhs, DynamicTypePtrPairSeen& dt_ptr_pair);
 bool test_equality(DynamicTypeMembersByNameImpl* lhs, DynamicTypeMembersByNameImpl* rhs, DynamicTypePtrPairSeen& dt_ptr_pair);
 bool test_equality(DynamicTypeMembersByIdImpl* lhs, DynamicTypeMembersByIdImpl* rhs, DynamicTypePtrPairSeen& dt_ptr_pair);
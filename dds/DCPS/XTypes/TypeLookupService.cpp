@@ -98,6 +98,12 @@ const TypeObject& TypeLookupService::get_type_object_i(const TypeIdentifier& typ
   if (pos != type_map_.end()) {
     return pos->second;
   }
+  if (type_object_cache_) {
+    const TypeObject* const to = type_object_cache_->find(type_id);
+    if (to) {
+      return *to;
+    }
+  }
   return to_empty_;
 }
 
@@ -145,6 +151,9 @@ void TypeLookupService::add_type_objects_to_cache(const TypeIdentifierTypeObject
       TypeObject to = types[i].type_object;
       if (set_type_object_defaults(to)) {
         type_map_.insert(std::make_pair(types[i].type_identifier, to));
+        if (type_object_cache_) {
+          type_object_cache_->add(types[i].type_identifier, to);
+        }
       }
     }
   }
@@ -1129,7 +1138,14 @@ void TypeLookupService::add_type_dependencies(const TypeIdentifier& type_id,
 bool TypeLookupService::type_object_in_cache(const TypeIdentifier& ti) const
 {
   ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
-  return type_map_.find(ti) != type_map_.end();
+  return type_map_.find(ti) != type_map_.end() ||
+    (type_object_cache_ && type_object_cache_->find(ti));
+}
+
+void TypeLookupService::type_object_cache(const TypeObjectCache_rch& cache)
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+  type_object_cache_ = cache;
 }
 
 bool TypeLookupService::extensibility(TypeFlag extensibility_mask, const TypeIdentifier& type_id) const
@@ -1198,7 +1214,8 @@ void TypeLookupService::remove_guid_from_dynamic_map(const DCPS::GUID_t& guid)
 bool TypeLookupService::has_complete(const TypeIdentifier& ti) const
 {
   ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
-  return ti.kind() == EK_COMPLETE && type_map_.count(ti);
+  return ti.kind() == EK_COMPLETE &&
+    (type_map_.count(ti) || (type_object_cache_ && type_object_cache_->find(ti)));
 }
 #endif
 
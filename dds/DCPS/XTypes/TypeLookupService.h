@@ -11,6 +11,7 @@
 #include "MemberDescriptorImpl.h"
 #include "TypeDescriptorImpl.h"
 #include "DynamicTypeImpl.h"
+#include "TypeObjectCache.h"
 
 #include <dds/DCPS/RcObject.h>
 #include <dds/DCPS/GuidUtils.h>
@@ -68,6 +69,10 @@ public:
   void add(TypeMap::const_iterator begin, TypeMap::const_iterator end);
 
   bool type_object_in_cache(const TypeIdentifier& ti) const;
+
+  /// TypeObjects of remote types are also added to and looked up in this
+  /// cache, which is shared by all participants of the process.
+  void type_object_cache(const TypeObjectCache_rch& cache);
   bool extensibility(TypeFlag extensibility_mask, const TypeIdentifier& ti) const;
 
   /// For caching and retrieving TypeInformation of remote endpoints
@@ -89,6 +94,8 @@ private:
 
   mutable ACE_Thread_Mutex mutex_;
 
+  TypeObjectCache_rch type_object_cache_;
+
   TypeObject to_empty_;
 
   /// Mapping from complete to minimal TypeIdentifiers of dependencies of remote types.
@@ -0,0 +1,151 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <DCPS/DdsDcps_pch.h>
+
+#include "TypeObjectCache.h"
+
+#include <dds/DCPS/debug.h>
+#include <dds/DCPS/SafetyProfileStreams.h>
+
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <fstream>
+#include <iterator>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace XTypes {
+
+TypeObjectCache::TypeObjectCache(const DCPS::String& directory)
+  : directory_(directory)
+{
+  if (!directory_.empty()) {
+    ACE_stat st;
+    if (ACE_OS::stat(ACE_TEXT_CHAR_TO_TCHAR(directory_.c_str()), &st) == -1 &&
+        ACE_OS::mkdir(ACE_TEXT_CHAR_TO_TCHAR(directory_.c_str())) == -1 &&
+        DCPS::log_level >= DCPS::LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: TypeObjectCache::TypeObjectCache: "
+                 "could not create directory %C: %p\n", directory_.c_str(), ACE_TEXT("mkdir")));
+    }
+  }
+}
+
+const TypeObject* TypeObjectCache::find(const TypeIdentifier& ti)
+{
+  if (!cacheable(ti)) {
+    return 0;
+  }
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, 0);
+  const TypeMap::const_iterator pos = type_map_.find(ti);
+  if (pos != type_map_.end()) {
+    return &pos->second;
+  }
+
+  if (directory_.empty() || not_on_disk_.count(ti)) {
+    return 0;
+  }
+
+  TypeObject to;
+  if (!load(ti, to)) {
+    not_on_disk_.insert(ti);
+    return 0;
+  }
+  return &type_map_.insert(std::make_pair(ti, to)).first->second;
+}
+
+void TypeObjectCache::add(const TypeIdentifier& ti, const TypeObject& to)
+{
+  if (!cacheable(ti)) {
+    return;
+  }
+
+  // TypeObjects come from remote participants and the cache is shared by the
+  // whole process and later runs, so one that doesn't hash to its
+  // TypeIdentifier is never trusted.
+  if (makeTypeIdentifier(to) != ti) {
+    if (DCPS::log_level >= DCPS::LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: TypeObjectCache::add: "
+                 "ignoring TypeObject that doesn't match its TypeIdentifier\n"));
+    }
+    return;
+  }
+
+  ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+  if (!type_map_.insert(std::make_pair(ti, to)).second) {
+    return;
+  }
+  if (!directory_.empty()) {
+    not_on_disk_.erase(ti);
+    store(ti, to);
+  }
+}
+
+DCPS::String TypeObjectCache::path(const TypeIdentifier& ti) const
+{
+  return directory_ + '/' + (ti.kind() == EK_MINIMAL ? "minimal_" : "complete_") +
+    equivalence_hash_to_string(ti.equivalence_hash());
+}
+
+bool TypeObjectCache::load(const TypeIdentifier& ti, TypeObject& to) const
+{
+  std::ifstream in(path(ti).c_str(), std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  const DCPS::String contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  ACE_Message_Block buff(contents.size());
+  buff.copy(contents.data(), contents.size());
+  DCPS::Serializer ser(&buff, get_typeobject_encoding());
+  // A file that doesn't hash to its name is ignored, which also covers
+  // TypeObjects written with a different TypeObject encoding.
+  if (!(ser >> to) || makeTypeIdentifier(to) != ti) {
+    if (DCPS::log_level >= DCPS::LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: TypeObjectCache::load: "
+                 "ignoring invalid file %C\n", path(ti).c_str()));
+    }
+    return false;
+  }
+  return true;
+}
+
+void TypeObjectCache::store(const TypeIdentifier& ti, const TypeObject& to) const
+{
+  const DCPS::Encoding& encoding = get_typeobject_encoding();
+  ACE_Message_Block buff(DCPS::serialized_size(encoding, to));
+  DCPS::Serializer ser(&buff, encoding);
+  if (!(ser << to)) {
+    return;
+  }
+
+  // Write to a temporary file first so other processes sharing the directory
+  // never see a partially written TypeObject.
+  const DCPS::String final_path = path(ti);
+  const DCPS::String tmp_path = final_path + ".tmp" + DCPS::to_dds_string(static_cast<unsigned long>(ACE_OS::getpid()));
+  {
+    std::ofstream out(tmp_path.c_str(), std::ios::binary);
+    if (!out.write(buff.rd_ptr(), buff.length())) {
+      if (DCPS::log_level >= DCPS::LogLevel::Warning) {
+        ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: TypeObjectCache::store: "
+                   "could not write %C\n", tmp_path.c_str()));
+      }
+      return;
+    }
+  }
+  if (ACE_OS::rename(ACE_TEXT_CHAR_TO_TCHAR(tmp_path.c_str()),
+                     ACE_TEXT_CHAR_TO_TCHAR(final_path.c_str())) == -1) {
+    ACE_OS::unlink(ACE_TEXT_CHAR_TO_TCHAR(tmp_path.c_str()));
+  }
+}
+
+} // namespace XTypes
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,70 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_XTYPES_TYPE_OBJECT_CACHE_H
+#define OPENDDS_DCPS_XTYPES_TYPE_OBJECT_CACHE_H
+
+#include "TypeObject.h"
+
+#include <dds/DCPS/RcObject.h>
+
+#include <ace/Thread_Mutex.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace XTypes {
+
+/**
+ * TypeObjects of remote types keyed by their hashed TypeIdentifiers, shared
+ * by the TypeLookupServices of all the participants in the process.
+ *
+ * If a directory is given, each TypeObject is also written to a file named
+ * after its EquivalenceHash and read back on demand, so later runs can skip
+ * the type lookup requests for types they have seen before.
+ *
+ * TypeObjects are never removed, so pointers returned by find stay valid for
+ * the lifetime of the cache.
+ */
+class OpenDDS_Dcps_Export TypeObjectCache : public virtual DCPS::RcObject {
+public:
+  explicit TypeObjectCache(const DCPS::String& directory = "");
+
+  /// Returns 0 if the TypeObject is neither in memory nor on disk.
+  const TypeObject* find(const TypeIdentifier& ti);
+  /// Ignored unless @a to hashes to @a ti.
+  void add(const TypeIdentifier& ti, const TypeObject& to);
+
+  /// Only minimal and complete hashed TypeIdentifiers are cached.
+  static bool cacheable(const TypeIdentifier& ti)
+  {
+    return ti.kind() == EK_MINIMAL || ti.kind() == EK_COMPLETE;
+  }
+
+private:
+  DCPS::String path(const TypeIdentifier& ti) const;
+  bool load(const TypeIdentifier& ti, TypeObject& to) const;
+  void store(const TypeIdentifier& ti, const TypeObject& to) const;
+
+  const DCPS::String directory_;
+
+  ACE_Thread_Mutex mutex_;
+  TypeMap type_map_;
+  /// Types already looked for on disk and not found there.
+  TypeIdentifierSet not_on_disk_;
+};
+
+typedef DCPS::RcHandle<TypeObjectCache> TypeObjectCache_rch;
+
+} // namespace XTypes
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_XTYPES_TYPE_OBJECT_CACHE_H */
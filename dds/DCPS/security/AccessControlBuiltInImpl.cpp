@@ -27,6 +27,7 @@
 #include <iterator>
 #include <cstring>
 #include <iomanip>
+#include <limits>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -155,6 +156,7 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   cache_this.local_access_credential_data = local_access_credential_data;
 
   local_ac_perms_.insert(std::make_pair(perm_handle, cache_this));
+  erase_decisions(perm_handle);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
                ACE_TEXT("AccessControlBuiltInImpl::validate_local_permissions local_ac_perms_ (total %B)\n"),
@@ -270,6 +272,7 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
 
   const int perm_handle = generate_handle();
   local_ac_perms_.insert(std::make_pair(perm_handle, cache_this));
+  erase_decisions(perm_handle);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
                ACE_TEXT("AccessControlBuiltInImpl::validate_remote_permissions local_ac_perms_ (total %B)\n"),
@@ -363,52 +366,9 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_datawriter: Invalid Topic Name");
   }
 
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, handle_mutex_, false);
-
-  ACPermsMap::iterator ac_iter = local_ac_perms_.find(permissions_handle);
-
-  if (ac_iter == local_ac_perms_.end()) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_datawriter: No matching permissions handle present");
-  }
-
-  gov_iter begin = ac_iter->second.gov->access_rules().begin();
-  gov_iter end = ac_iter->second.gov->access_rules().end();
-
-  for (gov_iter giter = begin; giter != end; ++giter) {
-
-    if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
-
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_write_protected) {
-            return true;
-          }
-        }
-      }
-    }
-  }
-
-  // Check the Permissions file
-
-  const Permissions::Grant_rch grant = ac_iter->second.perm->find_grant(ac_iter->second.subject);
-  if (!grant) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_datawriter: Permissions grant not found");
-  }
-
-  const time_t now_utc = utc_now();
-  if (!validate_date_time(grant->validity, now_utc, ex)) {
-    return false;
-  }
-
-  time_t expiration_time = grant->validity.not_after;
-  if (!search_permissions(topic_name, domain_id, partition, Permissions::PUBLISH, *grant, now_utc, expiration_time, ex)) {
-    return false;
-  }
-
-  make_task(local_rp_task_)->insert(permissions_handle, expiration_time);
-
-  return true;
+  return check_endpoint("AccessControlBuiltInImpl::check_create_datawriter", permissions_handle,
+                        domain_id, topic_name, partition, Permissions::PUBLISH,
+                        CREATE_DATAWRITER, local_rp_task_, ex);
 }
 
 ::CORBA::Boolean AccessControlBuiltInImpl::check_create_datareader(
@@ -428,52 +388,9 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_datareader: Invalid Topic Name");
   }
 
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, handle_mutex_, false);
-
-  ACPermsMap::iterator ac_iter = local_ac_perms_.find(permissions_handle);
-
-  if (ac_iter == local_ac_perms_.end()) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_datareader: No matching permissions handle present");
-  }
-
-  gov_iter begin = ac_iter->second.gov->access_rules().begin();
-  gov_iter end = ac_iter->second.gov->access_rules().end();
-
-  for (gov_iter giter = begin; giter != end; ++giter) {
-
-    if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
-
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_read_protected) {
-            return true;
-          }
-        }
-      }
-    }
-  }
-
-  // Check the Permissions file
-
-  const Permissions::Grant_rch grant = ac_iter->second.perm->find_grant(ac_iter->second.subject);
-  if (!grant) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_datareader: Permissions grant not found");
-  }
-
-  const time_t now_utc = utc_now();
-  if (!validate_date_time(grant->validity, now_utc, ex)) {
-    return false;
-  }
-
-  time_t expiration_time = grant->validity.not_after;
-  if (!search_permissions(topic_name, domain_id, partition, Permissions::SUBSCRIBE, *grant, now_utc, expiration_time, ex)) {
-    return false;
-  }
-
-  make_task(local_rp_task_)->insert(permissions_handle, expiration_time);
-
-  return true;
+  return check_endpoint("AccessControlBuiltInImpl::check_create_datareader", permissions_handle,
+                        domain_id, topic_name, partition, Permissions::SUBSCRIBE,
+                        CREATE_DATAREADER, local_rp_task_, ex);
 }
 
 ::CORBA::Boolean AccessControlBuiltInImpl::check_create_topic(
@@ -498,16 +415,36 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_topic: No matching permissions handle present");
   }
 
+  const time_t now_utc = utc_now();
+  const AccessDecisionKey key(permissions_handle, domain_id, CREATE_TOPIC, topic_name);
+  const AccessDecision* const decision = find_decision(key, now_utc);
+  if (decision) {
+    if (!decision->allowed) {
+      ex = decision->ex;
+    }
+    return decision->allowed;
+  }
+
+  const bool allowed = check_create_topic_i(ac_iter->second, domain_id, topic_name, ex);
+  return store_decision(key, ac_iter->second, now_utc, allowed, 0, ex);
+}
+
+bool AccessControlBuiltInImpl::check_create_topic_i(
+  const AccessData& data,
+  DDS::Security::DomainId_t domain_id,
+  const char* topic_name,
+  DDS::Security::SecurityException& ex)
+{
   // Check the Governance file for allowable topic attributes
 
-  if (domain_id != ac_iter->second.domain_id) {
+  if (domain_id != data.domain_id) {
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_topic: Requested domain ID does not match permissions handle");
   }
 
-  ::DDS::Security::DomainId_t domain_to_find = ac_iter->second.domain_id;
+  ::DDS::Security::DomainId_t domain_to_find = data.domain_id;
 
-  gov_iter begin = ac_iter->second.gov->access_rules().begin();
-  gov_iter end = ac_iter->second.gov->access_rules().end();
+  gov_iter begin = data.gov->access_rules().begin();
+  gov_iter end = data.gov->access_rules().end();
 
   for (gov_iter giter = begin; giter != end; ++giter) {
 
@@ -524,7 +461,7 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     }
   }
 
-  const Permissions::Grant_rch grant = ac_iter->second.perm->find_grant(ac_iter->second.subject);
+  const Permissions::Grant_rch grant = data.perm->find_grant(data.subject);
   if (!grant) {
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_topic: grant not found");
   }
@@ -705,52 +642,10 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_datawriter: Invalid topic name");
   }
 
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, handle_mutex_, false);
-
-  ACPermsMap::iterator ac_iter = local_ac_perms_.find(permissions_handle);
-
-  if (ac_iter == local_ac_perms_.end()) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_datawriter: No matching permissions handle present");
-  }
-
-  gov_iter begin = ac_iter->second.gov->access_rules().begin();
-  gov_iter end = ac_iter->second.gov->access_rules().end();
-
-  for (gov_iter giter = begin; giter != end; ++giter) {
-
-    if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
-
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(publication_data.base.base.topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_write_protected) {
-            return true;
-          }
-        }
-      }
-    }
-  }
-
-  const Permissions::Grant_rch grant = ac_iter->second.perm->find_grant(ac_iter->second.subject);
-  if (!grant) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_datawriter: Permissions grant not found");
-  }
-
-  const time_t now_utc = utc_now();
-  if (!validate_date_time(grant->validity, now_utc, ex)) {
-    return false;
-  }
-
-  time_t expiration_time = grant->validity.not_after;
-  if (!search_permissions(publication_data.base.base.topic_name, domain_id,
-                          publication_data.base.base.partition, Permissions::PUBLISH,
-                          *grant, now_utc, expiration_time, ex)) {
-    return false;
-  }
-
-  make_task(remote_rp_task_)->insert(permissions_handle, expiration_time);
-
-  return true;
+  return check_endpoint("AccessControlBuiltInImpl::check_remote_datawriter", permissions_handle,
+                        domain_id, publication_data.base.base.topic_name,
+                        publication_data.base.base.partition, Permissions::PUBLISH,
+                        REMOTE_DATAWRITER, remote_rp_task_, ex);
 }
 
 ::CORBA::Boolean AccessControlBuiltInImpl::check_remote_datareader(
@@ -764,55 +659,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_datareader: Invalid permissions handle");
   }
 
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, handle_mutex_, false);
-
-  ACPermsMap::iterator ac_iter = local_ac_perms_.find(permissions_handle);
-
-  if (ac_iter == local_ac_perms_.end()) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_datareader: No matching permissions handle present");
-  }
-
   // Default this to false for now
   relay_only = false;
 
-  gov_iter begin = ac_iter->second.gov->access_rules().begin();
-  gov_iter end = ac_iter->second.gov->access_rules().end();
-
-  for (gov_iter giter = begin; giter != end; ++giter) {
-
-    if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
-
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(subscription_data.base.base.topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_read_protected) {
-            return true;
-          }
-        }
-      }
-    }
-  }
-
-  const Permissions::Grant_rch grant = ac_iter->second.perm->find_grant(ac_iter->second.subject);
-  if (!grant) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_datareader: Permissions grant not found");
-  }
-
-  const time_t now_utc = utc_now();
-  if (!validate_date_time(grant->validity, now_utc, ex)) {
-    return false;
-  }
-
-  time_t expiration_time = grant->validity.not_after;
-  if (!search_permissions(subscription_data.base.base.topic_name, domain_id,
-                          subscription_data.base.base.partition, Permissions::SUBSCRIBE,
-                          *grant, now_utc, expiration_time, ex)) {
-    return false;
-  }
-
-  make_task(remote_rp_task_)->insert(permissions_handle, expiration_time);
-
-  return true;
+  return check_endpoint("AccessControlBuiltInImpl::check_remote_datareader", permissions_handle,
+                        domain_id, subscription_data.base.base.topic_name,
+                        subscription_data.base.base.partition, Permissions::SUBSCRIBE,
+                        REMOTE_DATAREADER, remote_rp_task_, ex);
 }
 
 ::CORBA::Boolean AccessControlBuiltInImpl::check_remote_topic(
@@ -838,6 +691,28 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return CommonUtilities::set_security_error(ex,-1, 0, "AccessControlBuiltInImpl::check_remote_topic: No matching permissions handle present");
   }
 
+  const time_t now_utc = utc_now();
+  const AccessDecisionKey key(permissions_handle, domain_id, REMOTE_TOPIC, topic_data.name);
+  const AccessDecision* const decision = find_decision(key, now_utc);
+  if (decision) {
+    if (!decision->allowed) {
+      ex = decision->ex;
+    }
+    return decision->allowed;
+  }
+
+  const bool allowed = check_remote_topic_i(ac_iter, domain_id, topic_data.name, ex);
+  return store_decision(key, ac_iter->second, now_utc, allowed, 0, ex);
+}
+
+bool AccessControlBuiltInImpl::check_remote_topic_i(
+  ACPermsMap::const_iterator ac_iter,
+  DDS::Security::DomainId_t domain_id,
+  const char* topic_name,
+  DDS::Security::SecurityException& ex)
+{
+  const DDS::Security::PermissionsHandle permissions_handle = ac_iter->first;
+
   // Compare the PluginClassName and MajorVersion of the local permissions_token
   // with those in the remote_permissions_token.
   const std::string remote_class_id = ac_iter->second.perm->perm_token_.class_id.in();
@@ -855,7 +730,7 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_topic: Invalid remote class ID");
   }
 
-  for (ACPermsMap::iterator local_iter = local_ac_perms_.begin(); local_iter != local_ac_perms_.end(); ++local_iter) {
+  for (ACPermsMap::const_iterator local_iter = local_ac_perms_.begin(); local_iter != local_ac_perms_.end(); ++local_iter) {
     if (local_iter->second.domain_id == domain_id && local_iter->first != permissions_handle) {
       const std::string local_class_id = local_iter->second.perm->perm_token_.class_id.in();
 
@@ -887,7 +762,7 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
       Governance::TopicAccessRules::iterator tr_iter;
 
       for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_data.name, tr_iter->topic_expression.c_str())) {
+        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
           if (!tr_iter->topic_attrs.is_read_protected || !tr_iter->topic_attrs.is_write_protected) {
             return true;
           }
@@ -923,7 +798,7 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
           std::vector<std::string>::iterator tl_iter;
           for (tl_iter = tpsr_iter->topics.begin(); tl_iter != tpsr_iter->topics.end(); ++tl_iter) {
 
-            if (pattern_match(topic_data.name, tl_iter->c_str())) {
+            if (pattern_match(topic_name, tl_iter->c_str())) {
               if (ptr_iter->ad_type == Permissions::ALLOW) {
                 return true;
               }
@@ -1090,6 +965,8 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
     return false;
   }
 
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, handle_mutex_, false);
+
   ACPermsMap::iterator ac_iter = local_ac_perms_.find(handle);
 
   if (ac_iter == local_ac_perms_.end()) {
@@ -1098,13 +975,18 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   }
 
   local_ac_perms_.erase(ac_iter);
+  erase_decisions(handle);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
                ACE_TEXT("AccessControlBuiltInImpl::return_permissions_handle local_ac_perms_ (total %B)\n"),
                local_ac_perms_.size()));
   }
-  make_task(local_rp_task_)->erase(handle);
-  make_task(remote_rp_task_)->erase(handle);
+  const RevokePermissionsTask_rch local_task = make_task(local_rp_task_);
+  const RevokePermissionsTask_rch remote_task = make_task(remote_rp_task_);
+  guard.release();
+
+  local_task->erase(handle);
+  remote_task->erase(handle);
 
   return true;
 }
@@ -1525,6 +1407,226 @@ bool AccessControlBuiltInImpl::search_permissions(
   }
 }
 
+bool AccessControlBuiltInImpl::check_endpoint(
+  const char* method,
+  DDS::Security::PermissionsHandle permissions_handle,
+  DDS::Security::DomainId_t domain_id,
+  const char* topic_name,
+  const DDS::PartitionQosPolicy& partition,
+  Permissions::PublishSubscribe_t pub_or_sub,
+  AccessAction action,
+  RevokePermissionsTask_rch& task,
+  DDS::Security::SecurityException& ex)
+{
+  RevokePermissionsTask_rch revoke_task;
+  time_t expiration_time = 0;
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, handle_mutex_, false);
+
+    ACPermsMap::iterator ac_iter = local_ac_perms_.find(permissions_handle);
+
+    if (ac_iter == local_ac_perms_.end()) {
+      return CommonUtilities::set_security_error(ex, -1, 0, (std::string(method) + ": No matching permissions handle present").c_str());
+    }
+
+    const time_t now_utc = utc_now();
+    const AccessDecisionKey key(permissions_handle, domain_id, action, topic_name, partition);
+    const AccessDecision* const decision = find_decision(key, now_utc);
+    if (decision) {
+      if (!decision->allowed) {
+        ex = decision->ex;
+        return false;
+      }
+      expiration_time = decision->expiration;
+
+    } else {
+      const bool allowed = check_endpoint_i(method, ac_iter->second, domain_id, topic_name, partition,
+                                            pub_or_sub, now_utc, expiration_time, ex);
+      if (!store_decision(key, ac_iter->second, now_utc, allowed, expiration_time, ex)) {
+        return false;
+      }
+    }
+
+    if (expiration_time) {
+      revoke_task = make_task(task);
+    }
+  }
+
+  // The revoke task holds its own lock while taking handle_mutex_, so don't
+  // call into it while holding handle_mutex_.
+  if (revoke_task) {
+    revoke_task->insert(permissions_handle, expiration_time);
+  }
+
+  return true;
+}
+
+bool AccessControlBuiltInImpl::check_endpoint_i(
+  const char* method,
+  const AccessData& data,
+  DDS::Security::DomainId_t domain_id,
+  const char* topic_name,
+  const DDS::PartitionQosPolicy& partition,
+  Permissions::PublishSubscribe_t pub_or_sub,
+  time_t now_utc,
+  time_t& expiration_time,
+  DDS::Security::SecurityException& ex)
+{
+  const bool is_write = pub_or_sub == Permissions::PUBLISH;
+  expiration_time = 0;
+
+  gov_iter begin = data.gov->access_rules().begin();
+  gov_iter end = data.gov->access_rules().end();
+
+  for (gov_iter giter = begin; giter != end; ++giter) {
+
+    if (giter->domains.has(domain_id)) {
+      Governance::TopicAccessRules::iterator tr_iter;
+
+      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
+        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
+          if (!(is_write ? tr_iter->topic_attrs.is_write_protected : tr_iter->topic_attrs.is_read_protected)) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+
+  // Check the Permissions file
+
+  const Permissions::Grant_rch grant = data.perm->find_grant(data.subject);
+  if (!grant) {
+    return CommonUtilities::set_security_error(ex, -1, 0, (std::string(method) + ": Permissions grant not found").c_str());
+  }
+
+  if (!validate_date_time(grant->validity, now_utc, ex)) {
+    return false;
+  }
+
+  expiration_time = grant->validity.not_after;
+  if (!search_permissions(topic_name, domain_id, partition, pub_or_sub, *grant, now_utc, expiration_time, ex)) {
+    expiration_time = 0;
+    return false;
+  }
+
+  return true;
+}
+
+AccessControlBuiltInImpl::AccessDecisionKey::AccessDecisionKey(
+  DDS::Security::PermissionsHandle h,
+  DDS::Security::DomainId_t d,
+  AccessAction a,
+  const char* t)
+  : handle(h)
+  , domain_id(d)
+  , action(a)
+  , topic(t)
+{
+}
+
+AccessControlBuiltInImpl::AccessDecisionKey::AccessDecisionKey(
+  DDS::Security::PermissionsHandle h,
+  DDS::Security::DomainId_t d,
+  AccessAction a,
+  const char* t,
+  const DDS::PartitionQosPolicy& p)
+  : handle(h)
+  , domain_id(d)
+  , action(a)
+  , topic(t)
+  , partitions(p.name.length())
+{
+  for (CORBA::ULong i = 0; i < p.name.length(); ++i) {
+    partitions[i] = p.name[i].in();
+  }
+}
+
+bool AccessControlBuiltInImpl::AccessDecisionKey::operator<(const AccessDecisionKey& other) const
+{
+  if (handle != other.handle) {
+    return handle < other.handle;
+  }
+  if (domain_id != other.domain_id) {
+    return domain_id < other.domain_id;
+  }
+  if (action != other.action) {
+    return action < other.action;
+  }
+  if (topic != other.topic) {
+    return topic < other.topic;
+  }
+  return partitions < other.partitions;
+}
+
+const AccessControlBuiltInImpl::AccessDecision*
+AccessControlBuiltInImpl::find_decision(const AccessDecisionKey& key, time_t now_utc) const
+{
+  const DecisionCache::const_iterator pos = decision_cache_.find(key);
+  if (pos == decision_cache_.end()) {
+    return 0;
+  }
+  if (pos->second.valid_until && now_utc >= pos->second.valid_until) {
+    return 0;
+  }
+  return &pos->second;
+}
+
+bool AccessControlBuiltInImpl::store_decision(const AccessDecisionKey& key,
+                                              const AccessData& data,
+                                              time_t now_utc,
+                                              bool allowed,
+                                              time_t expiration,
+                                              const DDS::Security::SecurityException& ex)
+{
+  AccessDecision& decision = decision_cache_[key];
+  decision.allowed = allowed;
+  const Permissions::Grant_rch grant = data.perm->find_grant(data.subject);
+  decision.valid_until = grant ? next_validity_change(*grant, now_utc) : 0;
+  decision.expiration = expiration;
+  decision.ex = allowed ? DDS::Security::SecurityException() : ex;
+  if (DCPS::security_debug.bookkeeping) {
+    ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
+               ACE_TEXT("AccessControlBuiltInImpl::store_decision decision_cache_ (total %B)\n"),
+               decision_cache_.size()));
+  }
+  return allowed;
+}
+
+void AccessControlBuiltInImpl::erase_decisions(DDS::Security::PermissionsHandle handle)
+{
+  // Keys are ordered by handle first, so this handle's decisions are together
+  const AccessDecisionKey first(handle, std::numeric_limits<DDS::Security::DomainId_t>::min(),
+                                CREATE_DATAWRITER, "");
+  DecisionCache::iterator pos = decision_cache_.lower_bound(first);
+  while (pos != decision_cache_.end() && pos->first.handle == handle) {
+    decision_cache_.erase(pos++);
+  }
+}
+
+time_t AccessControlBuiltInImpl::next_validity_change(const Permissions::Grant& grant, time_t now_utc)
+{
+  time_t next = 0;
+  const time_t grant_times[] = {grant.validity.not_before, grant.validity.not_after};
+  for (size_t i = 0; i < sizeof grant_times / sizeof grant_times[0]; ++i) {
+    if (grant_times[i] > now_utc && (!next || grant_times[i] < next)) {
+      next = grant_times[i];
+    }
+  }
+
+  for (Permissions::Rules::const_iterator rit = grant.rules.begin(); rit != grant.rules.end(); ++rit) {
+    for (Permissions::Actions::const_iterator ait = rit->actions.begin(); ait != rit->actions.end(); ++ait) {
+      const time_t action_times[] = {ait->validity.not_before, ait->validity.not_after};
+      for (size_t i = 0; i < sizeof action_times / sizeof action_times[0]; ++i) {
+        if (action_times[i] > now_utc && (!next || action_times[i] < next)) {
+          next = action_times[i];
+        }
+      }
+    }
+  }
+  return next;
+}
+
 void AccessControlBuiltInImpl::parse_class_id(
   const std::string& class_id,
   std::string & plugin_class_name,
@@ -1677,16 +1779,21 @@ AccessControlBuiltInImpl::RevokePermissionsTask::execute(const DCPS::MonotonicTi
   for (ExpirationToHandle::iterator pos = expiration_to_handle_.begin(), limit = expiration_to_handle_.end();
          pos != limit && pos->first < cur_utc_time;) {
     const ::DDS::Security::PermissionsHandle pm_handle = pos->second;
-    ACPermsMap::iterator iter = impl_.local_ac_perms_.find(pm_handle);
-    if (iter == impl_.local_ac_perms_.end()) {
-      ACE_DEBUG((LM_ERROR, ACE_TEXT("(%P|%t) AccessControlBuiltInImpl::Revoke_Permissions_Timer::execute: ")
-                 ACE_TEXT("pm_handle %d not found!\n"), pm_handle));
-    }
-    impl_.local_ac_perms_.erase(iter);
-    if (DCPS::security_debug.bookkeeping) {
-      ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
-                 ACE_TEXT("AccessControlBuiltInImpl::RevokePermissionsTask::execute local_ac_perms_ (total %B)\n"),
-                 impl_.local_ac_perms_.size()));
+    {
+      ACE_Guard<ACE_Thread_Mutex> impl_guard(impl_.handle_mutex_);
+      ACPermsMap::iterator iter = impl_.local_ac_perms_.find(pm_handle);
+      if (iter == impl_.local_ac_perms_.end()) {
+        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%P|%t) AccessControlBuiltInImpl::Revoke_Permissions_Timer::execute: ")
+                   ACE_TEXT("pm_handle %d not found!\n"), pm_handle));
+      } else {
+        impl_.local_ac_perms_.erase(iter);
+      }
+      impl_.erase_decisions(pm_handle);
+      if (DCPS::security_debug.bookkeeping) {
+        ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
+                   ACE_TEXT("AccessControlBuiltInImpl::RevokePermissionsTask::execute local_ac_perms_ (total %B)\n"),
+                   impl_.local_ac_perms_.size()));
+      }
     }
 
     // If a listener exists, call on_revoke_permissions
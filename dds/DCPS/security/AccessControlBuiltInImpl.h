@@ -284,6 +284,54 @@ private:
   RevokePermissionsTask_rch local_rp_task_;
   RevokePermissionsTask_rch remote_rp_task_;
 
+  enum AccessAction {
+    CREATE_DATAWRITER,
+    CREATE_DATAREADER,
+    CREATE_TOPIC,
+    REMOTE_DATAWRITER,
+    REMOTE_DATAREADER,
+    REMOTE_TOPIC
+  };
+
+  struct AccessDecisionKey {
+    DDS::Security::PermissionsHandle handle;
+    DDS::Security::DomainId_t domain_id;
+    AccessAction action;
+    std::string topic;
+    std::vector<std::string> partitions;
+
+    AccessDecisionKey(DDS::Security::PermissionsHandle h,
+                      DDS::Security::DomainId_t d,
+                      AccessAction a,
+                      const char* t);
+    AccessDecisionKey(DDS::Security::PermissionsHandle h,
+                      DDS::Security::DomainId_t d,
+                      AccessAction a,
+                      const char* t,
+                      const DDS::PartitionQosPolicy& p);
+
+    bool operator<(const AccessDecisionKey& other) const;
+  };
+
+  struct AccessDecision {
+    bool allowed;
+    /// The decision may change at this time due to grant or action validity,
+    /// 0 if it doesn't depend on the current time.
+    time_t valid_until;
+    /// Expiration to give the revoke task on success, 0 if none
+    time_t expiration;
+    DDS::Security::SecurityException ex;
+  };
+
+  /// Results of the endpoint and topic checks.  Evaluating the governance and
+  /// permissions rules involves pattern matching every topic and partition
+  /// expression, and discovery repeats the same checks for each endpoint.
+  /// A decision only depends on the AccessData of its handle, so only that
+  /// handle's decisions are erased when it's added to or removed from
+  /// local_ac_perms_.  Protected by handle_mutex_.
+  typedef std::map<AccessDecisionKey, AccessDecision> DecisionCache;
+  DecisionCache decision_cache_;
+
   int generate_handle();
 
   mutable ACE_Thread_Mutex handle_mutex_;
@@ -308,6 +356,52 @@ private:
                           DDS::Security::EndpointSecurityAttributes& attributes,
                           DDS::Security::SecurityException& ex);
 
+  bool check_endpoint(const char* method,
+                      DDS::Security::PermissionsHandle permissions_handle,
+                      DDS::Security::DomainId_t domain_id,
+                      const char* topic_name,
+                      const DDS::PartitionQosPolicy& partition,
+                      Permissions::PublishSubscribe_t pub_or_sub,
+                      AccessAction action,
+                      RevokePermissionsTask_rch& task,
+                      DDS::Security::SecurityException& ex);
+
+  bool check_endpoint_i(const char* method,
+                        const AccessData& data,
+                        DDS::Security::DomainId_t domain_id,
+                        const char* topic_name,
+                        const DDS::PartitionQosPolicy& partition,
+                        Permissions::PublishSubscribe_t pub_or_sub,
+                        time_t now_utc,
+                        time_t& expiration_time,
+                        DDS::Security::SecurityException& ex);
+
+  bool check_create_topic_i(const AccessData& data,
+                            DDS::Security::DomainId_t domain_id,
+                            const char* topic_name,
+                            DDS::Security::SecurityException& ex);
+
+  bool check_remote_topic_i(ACPermsMap::const_iterator ac_iter,
+                            DDS::Security::DomainId_t domain_id,
+                            const char* topic_name,
+                            DDS::Security::SecurityException& ex);
+
+  /// Caller must hold handle_mutex_
+  const AccessDecision* find_decision(const AccessDecisionKey& key, time_t now_utc) const;
+
+  /// Caller must hold handle_mutex_, returns the decision's result
+  bool store_decision(const AccessDecisionKey& key,
+                      const AccessData& data,
+                      time_t now_utc,
+                      bool allowed,
+                      time_t expiration,
+                      const DDS::Security::SecurityException& ex);
+
+  /// Caller must hold handle_mutex_
+  void erase_decisions(DDS::Security::PermissionsHandle handle);
+
+  static time_t next_validity_change(const Permissions::Grant& grant, time_t now_utc);
+
   bool search_permissions(const char* topic_name,
                           DDS::Security::DomainId_t domain_id,
                           const DDS::PartitionQosPolicy& partition,
@@ -322,6 +416,7 @@ private:
                       int& major_version,
                       int& minor_version);
 
+  friend class ::DDS_TEST;
 };
 
 } // namespace Security
@@ -89,7 +89,7 @@ bool CryptoBuiltInImpl::marshal(TAO_OutputCDR&)
 
 NativeCryptoHandle CryptoBuiltInImpl::generate_handle()
 {
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   return generate_handle_i();
 }
 
@@ -164,7 +164,7 @@ ParticipantCryptoHandle CryptoBuiltInImpl::register_local_participant(
   KeySeq keys;
   DCPS::push_back(keys, key);
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -369,7 +369,7 @@ DatawriterCryptoHandle CryptoBuiltInImpl::register_local_datawriter(
     }
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -416,7 +416,7 @@ DatareaderCryptoHandle CryptoBuiltInImpl::register_matched_remote_datareader(
     return DDS::HANDLE_NIL;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto_handle);
   if (iter == keys_.end()) {
     CommonUtilities::set_security_error(ex, -1, 0, "Invalid Local DataWriter Crypto Handle");
@@ -522,7 +522,7 @@ DatareaderCryptoHandle CryptoBuiltInImpl::register_local_datareader(
     DCPS::push_back(keys, key);
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -568,7 +568,7 @@ DatawriterCryptoHandle CryptoBuiltInImpl::register_matched_remote_datawriter(
     return DDS::HANDLE_NIL;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto_handle);
   if (iter == keys_.end()) {
     CommonUtilities::set_security_error(ex, -1, 0, "Invalid Local DataReader Crypto Handle");
@@ -652,7 +652,7 @@ bool CryptoBuiltInImpl::unregister_participant(ParticipantCryptoHandle handle, S
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_common_data(handle);
   for (DerivedKeyIndex_t::iterator it = derived_key_handles_.lower_bound(std::make_pair(handle, 0));
        it != derived_key_handles_.end() && it->first.first == handle; derived_key_handles_.erase(it++)) {
@@ -715,7 +715,7 @@ bool CryptoBuiltInImpl::unregister_datawriter(DatawriterCryptoHandle handle, Sec
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_endpoint_data(handle);
   return true;
 }
@@ -726,7 +726,7 @@ bool CryptoBuiltInImpl::unregister_datareader(DatareaderCryptoHandle handle, Sec
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_endpoint_data(handle);
   return true;
 }
@@ -808,7 +808,7 @@ bool CryptoBuiltInImpl::create_local_participant_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote participant handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_participant_crypto);
   if (iter != keys_.end()) {
     local_participant_crypto_tokens = keys_to_tokens(iter->second);
@@ -831,7 +831,7 @@ bool CryptoBuiltInImpl::have_local_participant_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_participant_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -852,7 +852,7 @@ bool CryptoBuiltInImpl::set_remote_participant_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote participant handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_participant_crypto] = tokens_to_keys(remote_participant_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -873,7 +873,7 @@ bool CryptoBuiltInImpl::have_remote_participant_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_participant_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -894,7 +894,7 @@ bool CryptoBuiltInImpl::create_local_datawriter_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote reader handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto);
   if (iter != keys_.end()) {
     local_datawriter_crypto_tokens = keys_to_tokens(iter->second);
@@ -916,7 +916,7 @@ bool CryptoBuiltInImpl::have_local_datawriter_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -937,7 +937,7 @@ bool CryptoBuiltInImpl::set_remote_datawriter_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote datawriter handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_datawriter_crypto] = tokens_to_keys(remote_datawriter_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -958,7 +958,7 @@ bool CryptoBuiltInImpl::have_remote_datawriter_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_datawriter_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -979,7 +979,7 @@ bool CryptoBuiltInImpl::create_local_datareader_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote writer handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto);
   if (iter != keys_.end()) {
     local_datareader_crypto_tokens = keys_to_tokens(iter->second);
@@ -1001,7 +1001,7 @@ bool CryptoBuiltInImpl::have_local_datareader_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -1022,7 +1022,7 @@ bool CryptoBuiltInImpl::set_remote_datareader_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote datareader handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_datareader_crypto] = tokens_to_keys(remote_datareader_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -1043,7 +1043,7 @@ bool CryptoBuiltInImpl::have_remote_datareader_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_datareader_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -1076,13 +1076,6 @@ namespace {
           kind[TransformKindIndex] == CRYPTO_TRANSFORMATION_KIND_AES256_GMAC);
   }
 
-  struct CipherContext {
-    EVP_CIPHER_CTX* ctx_;
-    CipherContext() : ctx_(EVP_CIPHER_CTX_new()) {}
-    operator EVP_CIPHER_CTX*() { return ctx_; }
-    ~CipherContext() { EVP_CIPHER_CTX_free(ctx_); }
-  };
-
   bool inc32(unsigned char* a)
   {
     for (int i = 0; i < 4; ++i) {
@@ -1110,19 +1103,13 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid datawriter handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  const KeyTable_t::const_iterator keys_iter = keys_.find(sending_datawriter_crypto);
-  const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(sending_datawriter_crypto);
-  if (eo_iter == encrypt_options_.end()) {
-    return CommonUtilities::set_security_error(ex, -1, 0, "Datawriter handle lacks encrypt options");
-  }
-  if (keys_iter == keys_.end() || !eo_iter->second.payload_) {
-    encoded_buffer = plain_buffer;
-    return true;
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
+  const KeyMaterial* master = 0;
+  unsigned int key_idx = 0;
+  if (!payload_key(sending_datawriter_crypto, master, key_idx, ex)) {
+    return false;
   }
-
-  const KeySeq& keyseq = keys_iter->second;
-  if (!keyseq.length()) {
+  if (!master) {
     encoded_buffer = plain_buffer;
     return true;
   }
@@ -1132,17 +1119,15 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   CryptoFooter footer;
   DDS::OctetSeq out;
   const DDS::OctetSeq* pOut = &plain_buffer;
-  // see register_local_datawriter for the assignment of key indexes in the seq
-  const unsigned int key_idx = keyseq.length() >= 2 ? 1 : 0;
   const KeyId_t sKey = std::make_pair(sending_datawriter_crypto, key_idx);
 
-  if (encrypts(keyseq[key_idx])) {
-    ok = encrypt(keyseq[key_idx], sessions_[sKey], plain_buffer,
+  if (encrypts(*master)) {
+    ok = encrypt(*master, session(sKey), plain_buffer,
                  header, footer, out, ex);
     pOut = &out;
 
-  } else if (authenticates(keyseq[key_idx])) {
-    ok = authtag(keyseq[key_idx], sessions_[sKey], plain_buffer,
+  } else if (authenticates(*master)) {
+    ok = authtag(*master, session(sKey), plain_buffer,
                  header, footer, ex);
 
   } else {
@@ -1153,13 +1138,47 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
     return false; // either encrypt() or authtag() already set 'ex'
   }
 
+  return serialize_payload(encoded_buffer, header, footer, *pOut, pOut != &plain_buffer);
+}
+
+bool CryptoBuiltInImpl::payload_key(DatawriterCryptoHandle sending_datawriter_crypto,
+                                    const KeyMaterial*& master, unsigned int& key_idx,
+                                    SecurityException& ex) const
+{
+  const KeyTable_t::const_iterator keys_iter = keys_.find(sending_datawriter_crypto);
+  const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(sending_datawriter_crypto);
+  if (eo_iter == encrypt_options_.end()) {
+    return CommonUtilities::set_security_error(ex, -1, 0, "Datawriter handle lacks encrypt options");
+  }
+  master = 0;
+  if (keys_iter == keys_.end() || !eo_iter->second.payload_) {
+    return true;
+  }
+
+  const KeySeq& keyseq = keys_iter->second;
+  if (!keyseq.length()) {
+    return true;
+  }
+
+  // see register_local_datawriter for the assignment of key indexes in the seq
+  key_idx = keyseq.length() >= 2 ? 1 : 0;
+  master = &keyseq[key_idx];
+  return true;
+}
+
+bool CryptoBuiltInImpl::serialize_payload(DDS::OctetSeq& encoded_buffer,
+                                          const CryptoHeader& header,
+                                          const CryptoFooter& footer,
+                                          const DDS::OctetSeq& content,
+                                          bool encrypted)
+{
   size_t size = serialized_size(common_encoding, header);
 
-  if (pOut != &plain_buffer) {
+  if (encrypted) {
     size += CRYPTO_CONTENT_ADDED_LENGTH;
   }
 
-  size += pOut->length();
+  size += content.length();
   serialized_size(common_encoding, size, footer);
 
   encoded_buffer.length(static_cast<unsigned int>(size));
@@ -1167,15 +1186,141 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   Serializer ser(&mb, common_encoding);
   ser << header;
 
-  if (pOut != &plain_buffer) {
-    ser << pOut->length();
+  if (encrypted) {
+    ser << content.length();
   }
-  ser.write_octet_array(pOut->get_buffer(), pOut->length());
+  ser.write_octet_array(content.get_buffer(), content.length());
 
   ser << footer;
   return ser.good_bit();
 }
 
+CryptoBuiltInImpl::Session::Session()
+  : counter_(0)
+  , key_generation_(0)
+{
+  std::memset(id_, 0, sizeof id_);
+  std::memset(iv_suffix_, 0, sizeof iv_suffix_);
+}
+
+CryptoBuiltInImpl::Session::Session(const Session& other)
+  : key_(other.key_)
+  , counter_(other.counter_)
+  , key_generation_(other.key_generation_)
+{
+  std::memcpy(id_, other.id_, sizeof id_);
+  std::memcpy(iv_suffix_, other.iv_suffix_, sizeof iv_suffix_);
+}
+
+CryptoBuiltInImpl::Session& CryptoBuiltInImpl::Session::operator=(const Session& other)
+{
+  if (this != &other) {
+    std::memcpy(id_, other.id_, sizeof id_);
+    std::memcpy(iv_suffix_, other.iv_suffix_, sizeof iv_suffix_);
+    key_ = other.key_;
+    counter_ = other.counter_;
+    ++key_generation_;
+    free_contexts();
+  }
+  return *this;
+}
+
+CryptoBuiltInImpl::Session::~Session()
+{
+  free_contexts();
+}
+
+void CryptoBuiltInImpl::Session::free_contexts()
+{
+  for (size_t i = 0; i < encrypt_contexts_.size(); ++i) {
+    EVP_CIPHER_CTX_free(encrypt_contexts_[i]);
+  }
+  encrypt_contexts_.clear();
+  for (size_t i = 0; i < decrypt_contexts_.size(); ++i) {
+    EVP_CIPHER_CTX_free(decrypt_contexts_[i]);
+  }
+  decrypt_contexts_.clear();
+}
+
+CryptoBuiltInImpl::Session& CryptoBuiltInImpl::session(const KeyId_t& key)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(sessions_mutex_);
+  return sessions_[key];
+}
+
+namespace {
+  /// Upper bound on idle cipher contexts kept per session and direction,
+  /// roughly the number of threads expected to use one session at once.
+  const size_t MAX_POOLED_CONTEXTS = 8;
+
+  const int IV_LEN = 12, IV_SUFFIX_IDX = 4;
+
+  void make_iv(unsigned char (&iv)[IV_LEN], const SessionIdType& session_id,
+               const IV_SuffixType& iv_suffix)
+  {
+    std::memcpy(iv, &session_id, sizeof session_id);
+    std::memcpy(iv + IV_SUFFIX_IDX, &iv_suffix, sizeof iv_suffix);
+  }
+}
+
+CryptoBuiltInImpl::SessionCipher::SessionCipher(Session& sess, bool encrypt,
+                                                unsigned int key_generation)
+  : sess_(sess)
+  , encrypt_(encrypt)
+  , key_generation_(key_generation)
+  , ctx_(0)
+  , keyed_(false)
+  , in_use_(false)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(sess_.lock_);
+  ContextPool& pool = encrypt_ ? sess_.encrypt_contexts_ : sess_.decrypt_contexts_;
+  if (key_generation_ == sess_.key_generation_ && !pool.empty()) {
+    ctx_ = pool.back();
+    pool.pop_back();
+    keyed_ = true;
+  }
+  guard.release();
+
+  if (!ctx_) {
+    ctx_ = EVP_CIPHER_CTX_new();
+  }
+}
+
+CryptoBuiltInImpl::SessionCipher::~SessionCipher()
+{
+  // A context left in the middle of an operation (after an error) is not
+  // reused, neither is one keyed for a session key that has been replaced.
+  if (keyed_ && !in_use_) {
+    ACE_Guard<ACE_Thread_Mutex> guard(sess_.lock_);
+    ContextPool& pool = encrypt_ ? sess_.encrypt_contexts_ : sess_.decrypt_contexts_;
+    if (key_generation_ == sess_.key_generation_ && pool.size() < MAX_POOLED_CONTEXTS) {
+      pool.push_back(ctx_);
+      return;
+    }
+  }
+  EVP_CIPHER_CTX_free(ctx_);
+}
+
+bool CryptoBuiltInImpl::SessionCipher::init(const KeyOctetSeq& key, const unsigned char* iv)
+{
+  if (!ctx_) {
+    return false;
+  }
+  // Once the context holds the expanded key, later messages only set the IV.
+  const EVP_CIPHER* const cipher = keyed_ ? 0 : EVP_aes_256_gcm();
+  const unsigned char* const key_buffer = keyed_ ? 0 : key.get_buffer();
+  const int result = encrypt_
+    ? EVP_EncryptInit_ex(ctx_, cipher, 0, key_buffer, iv)
+    : EVP_DecryptInit_ex(ctx_, cipher, 0, key_buffer, iv);
+  if (result != 1) {
+    keyed_ = false;
+    return false;
+  }
+  keyed_ = true;
+  in_use_ = true;
+  return true;
+}
+
 bool CryptoBuiltInImpl::Session::create_key(const KeyMaterial& master, SecurityException& ex)
 {
   RAND_bytes(id_, sizeof id_);
@@ -1205,7 +1350,25 @@ void CryptoBuiltInImpl::Session::inc_iv()
 bool CryptoBuiltInImpl::encauth_setup(const KeyMaterial& master, Session& sess,
                                       const DDS::OctetSeq& plain,
                                       CryptoHeader& header,
+                                      KeyOctetSeq& key,
+                                      unsigned int& key_generation,
                                       SecurityException& ex)
+{
+  // Reserve this message's IV and capture the matching session key, the
+  // cipher operation itself then runs without holding the session lock.
+  ACE_Guard<ACE_Thread_Mutex> guard(sess.lock_);
+  if (!encauth_setup_i(master, sess, plain, header, ex)) {
+    return false;
+  }
+  key = sess.key_;
+  key_generation = sess.key_generation_;
+  return true;
+}
+
+bool CryptoBuiltInImpl::encauth_setup_i(const KeyMaterial& master, Session& sess,
+                                        const DDS::OctetSeq& plain,
+                                        CryptoHeader& header,
+                                        SecurityException& ex)
 {
   const unsigned int blocks =
     (plain.length() + BLOCK_LEN_BYTES - 1) / BLOCK_LEN_BYTES;
@@ -1245,22 +1408,29 @@ bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
       to_dds_string(master).c_str()));
   }
 
-  if (!encauth_setup(master, sess, plain, header, ex)) {
+  KeyOctetSeq sess_key;
+  unsigned int key_generation;
+  if (!encauth_setup(master, sess, plain, header, sess_key, key_generation, ex)) {
     return false;
   }
-  static const int IV_LEN = 12, IV_SUFFIX_IDX = 4;
-  unsigned char iv[IV_LEN];
-  std::memcpy(iv, &sess.id_, sizeof sess.id_);
-  std::memcpy(iv + IV_SUFFIX_IDX, &sess.iv_suffix_, sizeof sess.iv_suffix_);
 
+  SessionCipher ctx(sess, true, key_generation);
+  return encrypt_i(ctx, sess_key, plain, header, footer, out, ex);
+}
+
+bool CryptoBuiltInImpl::encrypt_i(SessionCipher& ctx, const KeyOctetSeq& key,
+                                  const DDS::OctetSeq& plain,
+                                  const CryptoHeader& header, CryptoFooter& footer,
+                                  DDS::OctetSeq& out, SecurityException& ex)
+{
   if (security_debug.fake_encryption) {
     out = plain;
     return true;
   }
 
-  CipherContext ctx;
-  const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  unsigned char iv[IV_LEN];
+  make_iv(iv, header.session_id, header.initialization_vector_suffix);
+  if (!ctx.init(key, iv)) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::encrypt - EVP_EncryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1281,6 +1451,7 @@ bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
 
   if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, sizeof footer.common_mac,
                           &footer.common_mac) == 1) {
+    ctx.done();
     return true;
   }
   out.length(0);
@@ -1293,17 +1464,25 @@ bool CryptoBuiltInImpl::authtag(const KeyMaterial& master, Session& sess,
                                 CryptoFooter& footer,
                                 SecurityException& ex)
 {
-  if (!encauth_setup(master, sess, plain, header, ex)) {
+  KeyOctetSeq sess_key;
+  unsigned int key_generation;
+  if (!encauth_setup(master, sess, plain, header, sess_key, key_generation, ex)) {
     return false;
   }
-  static const int IV_LEN = 12, IV_SUFFIX_IDX = 4;
-  unsigned char iv[IV_LEN];
-  std::memcpy(iv, &sess.id_, sizeof sess.id_);
-  std::memcpy(iv + IV_SUFFIX_IDX, &sess.iv_suffix_, sizeof sess.iv_suffix_);
 
-  CipherContext ctx;
-  const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  SessionCipher ctx(sess, true, key_generation);
+  return authtag_i(ctx, sess_key, plain, header, footer, ex);
+}
+
+bool CryptoBuiltInImpl::authtag_i(SessionCipher& ctx, const KeyOctetSeq& key,
+                                  const DDS::OctetSeq& plain,
+                                  const CryptoHeader& header,
+                                  CryptoFooter& footer,
+                                  SecurityException& ex)
+{
+  unsigned char iv[IV_LEN];
+  make_iv(iv, header.session_id, header.initialization_vector_suffix);
+  if (!ctx.init(key, iv)) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::authtag - EVP_EncryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1321,6 +1500,7 @@ bool CryptoBuiltInImpl::authtag(const KeyMaterial& master, Session& sess,
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::authtag - EVP_CIPHER_CTX_ctrl", ERR_peek_last_error());
   }
 
+  ctx.done();
   return true;
 }
 
@@ -1419,7 +1599,7 @@ bool CryptoBuiltInImpl::encode_submessage(
   bool authOnly = false;
 
   if (encrypts(keyseq[submessage_key_index])) {
-    ok = encrypt(keyseq[submessage_key_index], sessions_[sKey], plain_rtps_submessage,
+    ok = encrypt(keyseq[submessage_key_index], session(sKey), plain_rtps_submessage,
                  header, footer, out, ex);
     pOut = &out;
 
@@ -1429,7 +1609,7 @@ bool CryptoBuiltInImpl::encode_submessage(
     if (setOctetsToNextHeader(out, plain_rtps_submessage)) {
       pOut = &out;
     }
-    ok = authtag(keyseq[submessage_key_index], sessions_[sKey], *pOut,
+    ok = authtag(keyseq[submessage_key_index], session(sKey), *pOut,
                  header, footer, ex);
     authOnly = true;
 
@@ -1513,7 +1693,7 @@ bool CryptoBuiltInImpl::encode_datawriter_submessage(
   }
 
   NativeCryptoHandle encode_handle = sending_datawriter_crypto;
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(encode_handle);
   if (eo_iter == encrypt_options_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 0, "Datawriter handle lacks encrypt options");
@@ -1561,7 +1741,7 @@ bool CryptoBuiltInImpl::encode_datareader_submessage(
   }
 
   NativeCryptoHandle encode_handle = sending_datareader_crypto;
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   if (receiving_datawriter_crypto_list.length() == 1) {
     const KeyTable_t::const_iterator iter = keys_.find(encode_handle);
     if (iter != keys_.end()) {
@@ -1592,7 +1772,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_participant_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 0, "No entry for sending_participant_crypto");
@@ -1621,7 +1801,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
   const KeyId_t sKey = std::make_pair(sending_participant_crypto, 0);
 
   if (encrypts(key)) {
-    ok = encrypt(key, sessions_[sKey], transformed, cryptoHdr, cryptoFooter, out, ex);
+    ok = encrypt(key, session(sKey), transformed, cryptoHdr, cryptoFooter, out, ex);
     pOut = &out;
     addSecBody = true;
 
@@ -1632,7 +1812,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
     if (offsetFinal && setOctetsToNextHeader(out, transformed, offsetFinal)) {
       pOut = &out;
     }
-    ok = authtag(key, sessions_[sKey], *pOut, cryptoHdr, cryptoFooter, ex);
+    ok = authtag(key, session(sKey), *pOut, cryptoHdr, cryptoFooter, ex);
 
   } else {
     return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
@@ -1722,7 +1902,7 @@ bool CryptoBuiltInImpl::preprocess_secure_submsg(
       "Could not deserializer CyptoHeader\n"));
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   typedef std::multimap<ParticipantCryptoHandle, EntityInfo>::iterator iter_t;
   const std::pair<iter_t, iter_t> iters =
     participant_to_entity_.equal_range(sending_participant_crypto);
@@ -1786,19 +1966,25 @@ bool CryptoBuiltInImpl::preprocess_secure_submsg(
 KeyOctetSeq
 CryptoBuiltInImpl::Session::get_key(const KeyMaterial& master,
                                     const CryptoHeader& header,
+                                    unsigned int& key_generation,
                                     SecurityException& ex)
 {
-  if (key_.length() && 0 == std::memcmp(&id_, &header.session_id, sizeof id_)) {
-    return key_;
+  ACE_Guard<ACE_Thread_Mutex> guard(lock_);
+  if (!key_.length() || 0 != std::memcmp(&id_, &header.session_id, sizeof id_)) {
+    std::memcpy(&id_, &header.session_id, sizeof id_);
+    key_.length(0);
+    derive_key(master, ex);
   }
-  std::memcpy(&id_, &header.session_id, sizeof id_);
-  key_.length(0);
-  derive_key(master, ex);
+  key_generation = key_generation_;
   return key_;
 }
 
 bool CryptoBuiltInImpl::Session::derive_key(const KeyMaterial& master, SecurityException& ex)
 {
+  // Pooled cipher contexts hold the expansion of the old key
+  ++key_generation_;
+  free_contexts();
+
   PrivateKey pkey(master.master_sender_key);
   DigestContext ctx;
   const EVP_MD* md = EVP_get_digestbyname("SHA256");
@@ -1850,7 +2036,8 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
       to_dds_string(master).c_str()));
   }
 
-  const KeyOctetSeq sess_key = sess.get_key(master, header, ex);
+  unsigned int key_generation;
+  const KeyOctetSeq sess_key = sess.get_key(master, header, key_generation, ex);
   if (!sess_key.length()) {
     return false;
   }
@@ -1869,10 +2056,9 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
     return true;
   }
 
-  CipherContext ctx;
+  SessionCipher ctx(sess, false, key_generation);
   // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  if (!ctx.init(sess_key, header.session_id)) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::decrypt - EVP_DecryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1893,6 +2079,7 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
   int len2;
   if (EVP_DecryptFinal_ex(ctx, out_buffer + len, &len2) == 1) {
     out.length(len + len2);
+    ctx.done();
     return true;
   }
   return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::decrypt - EVP_DecryptFinal_ex", ERR_peek_last_error());
@@ -1905,7 +2092,8 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
                                SecurityException& ex)
 
 {
-  const KeyOctetSeq sess_key = sess.get_key(master, header, ex);
+  unsigned int key_generation;
+  const KeyOctetSeq sess_key = sess.get_key(master, header, key_generation, ex);
   if (!sess_key.length()) {
     return false;
   }
@@ -1918,10 +2106,9 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
     return CommonUtilities::set_security_error(ex, -1, 0, "unsupported transformation kind");
   }
 
-  CipherContext ctx;
+  SessionCipher ctx(sess, false, key_generation);
   // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  if (!ctx.init(sess_key, header.session_id)) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::verify - EVP_DecryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1938,6 +2125,7 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
 
   int len2;
   if (EVP_DecryptFinal_ex(ctx, 0, &len2) == 1) {
+    ctx.done();
     out.length(n);
     std::memcpy(out.get_buffer(), in, n);
     return true;
@@ -2030,7 +2218,7 @@ bool CryptoBuiltInImpl::decode_rtps_message(
     return CommonUtilities::set_security_error(ex, -9, 0, "Failed to find SRTPS_PREFIX/POSTFIX wrapper");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_participant_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 2, "No key for Sending Participant handle");
@@ -2047,14 +2235,14 @@ bool CryptoBuiltInImpl::decode_rtps_message(
           return CommonUtilities::set_security_error(ex, -15, 0, "Failed to find SEC_BODY submessage");
         }
         foundKey = true;
-        if (!decrypt(keyseq[i], sessions_[sKey], encrypted, sizeOfEncrypted,
+        if (!decrypt(keyseq[i], session(sKey), encrypted, sizeOfEncrypted,
                      ch, cf, transformed, ex)) {
           return false;
         }
 
       } else if (authenticates(keyseq[i])) {
         foundKey = true;
-        if (!verify(keyseq[i], sessions_[sKey], afterSrtpsPrefix, sizeOfAuthenticated,
+        if (!verify(keyseq[i], session(sKey), afterSrtpsPrefix, sizeOfAuthenticated,
                     ch, cf, transformed, ex)) {
           return false;
         }
@@ -2149,7 +2337,7 @@ bool CryptoBuiltInImpl::decode_submessage(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator keys_iter = keys_.find(sender_handle);
   if (keys_iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -2, 3, "Crypto Key not found");
@@ -2169,11 +2357,11 @@ bool CryptoBuiltInImpl::decode_submessage(
             "Failed to deserialize content size(?)\n"));
           return false;
         }
-        return decrypt(keyseq[i], sessions_[sKey], mb_in.rd_ptr(), n, ch, cf,
+        return decrypt(keyseq[i], session(sKey), mb_in.rd_ptr(), n, ch, cf,
                        plain_rtps_submessage, ex);
 
       } else if (authenticates(keyseq[i])) {
-        return verify(keyseq[i], sessions_[sKey], mb_in.rd_ptr() - RTPS::SMHDR_SZ,
+        return verify(keyseq[i], session(sKey), mb_in.rd_ptr() - RTPS::SMHDR_SZ,
                       RTPS::SMHDR_SZ + octetsToNext, ch, cf, plain_rtps_submessage, ex);
 
       } else {
@@ -2258,7 +2446,7 @@ bool CryptoBuiltInImpl::decode_serialized_payload(
       sending_datawriter_crypto, receiving_datareader_crypto));
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_datawriter_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 1, "No key for DataWriter crypto handle");
@@ -2303,7 +2491,7 @@ bool CryptoBuiltInImpl::decode_serialized_payload(
         if (!(de_ser >> cf)) {
           return CommonUtilities::set_security_error(ex, -3, 6, "Failed to deserialize CryptoFooter");
         }
-        return decrypt(keyseq[i], sessions_[sKey], ciphertext, n, ch, cf, plain_buffer, ex);
+        return decrypt(keyseq[i], session(sKey), ciphertext, n, ch, cf, plain_buffer, ex);
 
       } else if (authenticates(keyseq[i])) {
         return CommonUtilities::set_security_error(ex, -3, 3, "Auth-only payload "
@@ -14,15 +14,18 @@
 
 #include <tao/LocalObject.h>
 
+#include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
 
 #include <map>
+#include <vector>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 class DDS_TEST;
+struct evp_cipher_ctx_st;
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -39,7 +42,6 @@ public:
   CryptoBuiltInImpl();
   virtual ~CryptoBuiltInImpl();
 
-
 private:
   // Local Object
 
@@ -245,7 +247,10 @@ private:
   DDS::Security::NativeCryptoHandle generate_handle();
   DDS::Security::NativeCryptoHandle generate_handle_i();
 
-  ACE_Thread_Mutex mutex_;
+  /// Protects the handle tables below.  Encode/decode operations only read
+  /// these tables so they hold this as readers and can run concurrently;
+  /// registration, token exchange, and unregistration take it as writers.
+  ACE_RW_Thread_Mutex mutex_;
   int next_handle_;
 
   typedef KeyMaterial_AES_GCM_GMAC KeyMaterial;
@@ -281,23 +286,75 @@ private:
   typedef std::map<HandlePair_t, DDS::Security::NativeCryptoHandle> DerivedKeyIndex_t;
   DerivedKeyIndex_t derived_key_handles_;
 
+  typedef std::vector<evp_cipher_ctx_st*> ContextPool;
+
   struct Session {
     SessionIdType id_;
     IV_SuffixType iv_suffix_;
     KeyOctetSeq key_;
     ACE_UINT64 counter_;
 
+    /// Serializes changes to this session's key, id, IV, counter, and
+    /// context pools so that each session can be used independently of all
+    /// others.
+    ACE_Thread_Mutex lock_;
+
+    /// Idle cipher contexts already keyed with key_, see SessionCipher.
+    ContextPool encrypt_contexts_, decrypt_contexts_;
+
+    /// Incremented each time key_ changes.
+    unsigned int key_generation_;
+
+    Session();
+    Session(const Session& other);
+    Session& operator=(const Session& other);
+    ~Session();
+
     KeyOctetSeq get_key(const KeyMaterial& master, const CryptoHeader& header,
+                        unsigned int& key_generation,
                         DDS::Security::SecurityException& ex);
     bool create_key(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     bool derive_key(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     bool next_id(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     void inc_iv();
+    void free_contexts();
+  };
+
+  /// An AES-GCM cipher context borrowed from a Session's pool.  Expanding
+  /// the key schedule is skipped when a pooled context is reused, init()
+  /// then only sets the new IV.  The context is returned to the pool on
+  /// destruction if done() was called and the session key is unchanged.
+  class SessionCipher {
+  public:
+    SessionCipher(Session& sess, bool encrypt, unsigned int key_generation);
+    ~SessionCipher();
+
+    bool init(const KeyOctetSeq& key, const unsigned char* iv);
+    void done() { in_use_ = false; }
+    operator evp_cipher_ctx_st*() const { return ctx_; }
+
+  private:
+    SessionCipher(const SessionCipher&);
+    SessionCipher& operator=(const SessionCipher&);
+
+    Session& sess_;
+    const bool encrypt_;
+    const unsigned int key_generation_;
+    evp_cipher_ctx_st* ctx_;
+    bool keyed_;
+    bool in_use_;
   };
   typedef std::pair<DDS::Security::NativeCryptoHandle, unsigned int> KeyId_t;
   typedef std::map<KeyId_t, Session> SessionTable_t;
   SessionTable_t sessions_;
 
+  /// Protects insertion into sessions_ by threads that hold mutex_ as readers.
+  /// Entries are only erased while mutex_ is held as a writer.
+  ACE_Thread_Mutex sessions_mutex_;
+
+  /// Find or create a session, caller must hold mutex_ (as reader or writer).
+  Session& session(const KeyId_t& key);
+
   void clear_endpoint_data(DDS::Security::NativeCryptoHandle handle);
   void clear_common_data(DDS::Security::NativeCryptoHandle handle);
 
@@ -316,10 +373,36 @@ private:
                CryptoHeader& header, CryptoFooter& footer,
                DDS::Security::SecurityException& ex);
 
+  bool encrypt_i(SessionCipher& ctx, const KeyOctetSeq& key,
+                 const DDS::OctetSeq& plain,
+                 const CryptoHeader& header, CryptoFooter& footer,
+                 DDS::OctetSeq& out, DDS::Security::SecurityException& ex);
+
+  bool authtag_i(SessionCipher& ctx, const KeyOctetSeq& key,
+                 const DDS::OctetSeq& plain,
+                 const CryptoHeader& header, CryptoFooter& footer,
+                 DDS::Security::SecurityException& ex);
+
   bool encauth_setup(const KeyMaterial& master, Session& sess,
                      const DDS::OctetSeq& plain, CryptoHeader& header,
+                     KeyOctetSeq& key, unsigned int& key_generation,
                      DDS::Security::SecurityException& ex);
 
+  /// Caller must hold sess.lock_
+  bool encauth_setup_i(const KeyMaterial& master, Session& sess,
+                       const DDS::OctetSeq& plain, CryptoHeader& header,
+                       DDS::Security::SecurityException& ex);
+
+  bool payload_key(DDS::Security::DatawriterCryptoHandle sending_datawriter_crypto,
+                   const KeyMaterial*& master, unsigned int& key_idx,
+                   DDS::Security::SecurityException& ex) const;
+
+  static bool serialize_payload(DDS::OctetSeq& encoded_buffer,
+                                const CryptoHeader& header,
+                                const CryptoFooter& footer,
+                                const DDS::OctetSeq& content,
+                                bool encrypted);
+
   bool decode_submessage(DDS::OctetSeq& plain_rtps_submessage,
                          const DDS::OctetSeq& encoded_rtps_submessage,
                          DDS::Security::NativeCryptoHandle sender_handle,
@@ -0,0 +1,169 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "TransportCounters.h"
+
+#include <ace/Singleton.h>
+#include <ace/Synch_Traits.h>
+#include <ace/TSS_T.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+
+/// Gives each thread the next stripe the first time it adds to a counter.
+class StripeAssigner {
+public:
+  static StripeAssigner* instance()
+  {
+    return ACE_Singleton<StripeAssigner, ACE_SYNCH_MUTEX>::instance();
+  }
+
+  size_t stripe()
+  {
+    return tss_->index;
+  }
+
+  size_t next()
+  {
+    return next_++ % TransportCounters::stripe_count;
+  }
+
+private:
+  friend class ACE_Singleton<StripeAssigner, ACE_SYNCH_MUTEX>;
+
+  struct StripeIndex {
+    StripeIndex() : index(StripeAssigner::instance()->next()) {}
+    size_t index;
+  };
+
+  StripeAssigner() : next_(0) {}
+
+  Atomic<size_t> next_;
+  ACE_TSS<StripeIndex> tss_;
+};
+
+}
+
+TransportCounters::Values::Values()
+{
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    values[i] = 0;
+  }
+}
+
+TransportCounters::Stripe::Stripe()
+{
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    values[i].store(0);
+  }
+}
+
+TransportCounters::TransportCounters()
+{}
+
+namespace {
+  ACE_UINT64 usec_since(const MonotonicTimePoint& since, const MonotonicTimePoint& now)
+  {
+    ACE_UINT64 usec = 0;
+    if (since < now) {
+      (now - since).value().to_usec(usec);
+    }
+    return usec;
+  }
+}
+
+TransportCounters::Values TransportCounters::values() const
+{
+  ACE_UINT64 sums[COUNTER_COUNT] = {};
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(modes_mutex_);
+    for (size_t s = 0; s < stripe_count; ++s) {
+      for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        sums[i] += stripes_[s].values[i].load();
+      }
+    }
+    const MonotonicTimePoint now = MonotonicTimePoint::now();
+    for (Modes::const_iterator it = modes_.begin(); it != modes_.end(); ++it) {
+      sums[it->second.counter] += usec_since(it->second.since, now);
+    }
+  }
+
+  Values values;
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    values.values[i] = static_cast<ACE_INT64>(sums[i]);
+  }
+  return values;
+}
+
+void TransportCounters::mode_changed(const void* owner, Counter counter,
+                                     const MonotonicTimePoint& now)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(modes_mutex_);
+  const Modes::iterator it = modes_.find(owner);
+  if (it != modes_.end()) {
+    add(it->second.counter, static_cast<ACE_INT64>(usec_since(it->second.since, now)));
+    if (counter == COUNTER_COUNT) {
+      modes_.erase(it);
+      return;
+    }
+    it->second.counter = counter;
+    it->second.since = now;
+  } else if (counter != COUNTER_COUNT) {
+    const Mode mode = {counter, now};
+    modes_.insert(std::make_pair(owner, mode));
+  }
+}
+
+const char* TransportCounters::name(Counter counter)
+{
+  switch (counter) {
+  case BYTES_SENT:
+    return "bytes_sent";
+  case PACKETS_SENT:
+    return "packets_sent";
+  case BYTES_RECEIVED:
+    return "bytes_received";
+  case PACKETS_RECEIVED:
+    return "packets_received";
+  case RETRANSMISSIONS:
+    return "retransmissions";
+  case NACKS_SENT:
+    return "nacks_sent";
+  case NACKS_RECEIVED:
+    return "nacks_received";
+  case HEARTBEATS_SENT:
+    return "heartbeats_sent";
+  case HEARTBEATS_RECEIVED:
+    return "heartbeats_received";
+  case DATAGRAMS_DROPPED:
+    return "datagrams_dropped";
+  case REASSEMBLY_EXPIRED:
+    return "reassembly_expired";
+  case QUEUE_DEPTH:
+    return "queue_depth";
+  case QUEUE_MODE_USEC:
+    return "queue_mode_usec";
+  case DIRECT_MODE_USEC:
+    return "direct_mode_usec";
+  default:
+    return "unknown";
+  }
+}
+
+size_t TransportCounters::stripe()
+{
+  return StripeAssigner::instance()->stripe();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
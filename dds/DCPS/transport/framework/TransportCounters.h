@@ -0,0 +1,136 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_FRAMEWORK_TRANSPORTCOUNTERS_H
+#define OPENDDS_DCPS_TRANSPORT_FRAMEWORK_TRANSPORTCOUNTERS_H
+
+#include <dds/DCPS/dcps_export.h>
+#include <dds/DCPS/Atomic.h>
+#include <dds/DCPS/PoolAllocator.h>
+#include <dds/DCPS/RcObject.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Basic_Types.h>
+#include <ace/Thread_Mutex.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class TransportCounters
+ *
+ * @brief Counters for the stages of a transport, summed on demand
+ *
+ * Each thread adds to its own slot of counters, padded so slots don't share
+ * a cache line, so threads sending and receiving on the same transport don't
+ * contend on the counters.  Threads beyond stripe_count share slots round
+ * robin.  values() sums the slots, so it may include part of what's being
+ * added while it runs.
+ *
+ * The time counters are kept per owner with mode_changed(), so values() can
+ * include the time spent so far in each owner's current mode.
+ */
+class OpenDDS_Dcps_Export TransportCounters : public RcObject {
+public:
+  enum Counter {
+    BYTES_SENT,
+    PACKETS_SENT,
+    BYTES_RECEIVED,
+    PACKETS_RECEIVED,
+    /// Samples resent in response to NACKs
+    RETRANSMISSIONS,
+    NACKS_SENT,
+    NACKS_RECEIVED,
+    HEARTBEATS_SENT,
+    HEARTBEATS_RECEIVED,
+    /// Datagrams dropped by the transport instead of being sent or processed
+    DATAGRAMS_DROPPED,
+    /// Partially received samples given up on by TransportReassembly
+    REASSEMBLY_EXPIRED,
+    /// Elements currently waiting in send queues, added to and subtracted from
+    QUEUE_DEPTH,
+    /// Time spent with the send strategy queueing because of backpressure
+    QUEUE_MODE_USEC,
+    /// Time spent with the send strategy sending directly
+    DIRECT_MODE_USEC,
+    COUNTER_COUNT
+  };
+
+  static const size_t stripe_count = 16;
+
+  struct Values {
+    Values();
+
+    ACE_INT64 operator[](Counter counter) const { return values[counter]; }
+
+    ACE_INT64 values[COUNTER_COUNT];
+  };
+
+  TransportCounters();
+
+  void add(Counter counter, ACE_INT64 amount = 1)
+  {
+#ifdef ACE_HAS_CPP11
+    stripes_[stripe()].values[counter].fetch_add(static_cast<ACE_UINT64>(amount),
+                                                 std::memory_order_relaxed);
+#else
+    stripes_[stripe()].values[counter] += static_cast<ACE_UINT64>(amount);
+#endif
+  }
+
+  /// Sum of each counter over all the threads, including the time so far
+  /// in the current mode of each owner.
+  Values values() const;
+
+  /// Start counting the time owner spends in a mode with counter, after
+  /// adding the time it spent in its previous mode.  COUNTER_COUNT stops
+  /// counting, for a mode that isn't timed or an owner that's going away.
+  void mode_changed(const void* owner, Counter counter,
+                    const MonotonicTimePoint& now = MonotonicTimePoint::now());
+
+  static const char* name(Counter counter);
+
+private:
+  static const size_t cache_line_size = 64;
+
+  static size_t stripe();
+
+  struct Stripe {
+    Stripe();
+
+    /// Unsigned so subtracting wraps around; the sum is converted back.
+    Atomic<ACE_UINT64> values[COUNTER_COUNT];
+    char pad[cache_line_size];
+  };
+
+  char pad_[cache_line_size];
+  Stripe stripes_[stripe_count];
+
+  struct Mode {
+    Counter counter;
+    MonotonicTimePoint since;
+  };
+  typedef OPENDDS_MAP(const void*, Mode) Modes;
+
+  /// Protects modes_ so a mode's time is either in a stripe or in modes_
+  /// when values() reads them.
+  mutable ACE_Thread_Mutex modes_mutex_;
+  Modes modes_;
+};
+
+typedef RcHandle<TransportCounters> TransportCounters_rch;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_FRAMEWORK_TRANSPORTCOUNTERS_H */
@@ -46,6 +46,8 @@ TransportImpl::TransportImpl(TransportInst_rch config,
 TransportImpl::~TransportImpl()
 {
   DBG_ENTRY_LVL("TransportImpl", "~TransportImpl", 6);
+  // Stop periodic reports before any of the transport goes away
+  monitor_.reset();
   event_dispatcher_->shutdown(true);
 }
 
@@ -32,6 +32,7 @@ TransportInst::TransportInst(const char* type,
   , name_(name)
   , config_prefix_(is_template ? ConfigPair::canonicalize("TRANSPORT_TEMPLATE_" + name_) : ConfigPair::canonicalize("TRANSPORT_" + name_))
   , is_template_(is_template)
+  , counters_(make_rch<TransportCounters>())
 {
   DBG_ENTRY_LVL("TransportInst", "TransportInst", 6);
 }
@@ -13,6 +13,7 @@
 #pragma once
 #endif
 
+#include "TransportCounters.h"
 #include "TransportDefs.h"
 #include "TransportImpl_rch.h"
 #include "TransportImpl.h"
@@ -200,6 +201,10 @@ public:
                                            DDS::DomainId_t /*domain*/,
                                            DomainParticipantImpl* /*participant*/) {}
 
+  /// Counters of all the TransportImpls created from this configuration.
+  /// Use TransportCounters::values to get their current totals.
+  const TransportCounters_rch& counters() const { return counters_; }
+
   static void set_port_in_addr_string(OPENDDS_STRING& addr_str, u_short port_number);
 
   void remove_participant(DDS::DomainId_t domain,
@@ -235,6 +240,7 @@ private:
   const String name_;
   const String config_prefix_;
   const bool is_template_;
+  const TransportCounters_rch counters_;
 
   typedef OPENDDS_MAP(DomainParticipantImpl*, TransportImpl_rch) ParticipantMap;
   typedef OPENDDS_MAP(DDS::DomainId_t, ParticipantMap) DomainMap;
@@ -11,6 +11,7 @@
 
 #include "dds/DCPS/GuidConverter.h"
 #include "dds/DCPS/DisjointSequence.h"
+#include "dds/DCPS/Tracepoints.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -33,8 +34,10 @@ TransportReassembly::FragSample::FragSample(const FragmentRange& fragRange,
 {
 }
 
-TransportReassembly::TransportReassembly(const TimeDuration& timeout)
+TransportReassembly::TransportReassembly(const TimeDuration& timeout,
+                                         const TransportCounters_rch& counters)
   : timeout_(timeout)
+  , counters_(counters)
 {
 }
 
@@ -153,6 +156,8 @@ TransportReassembly::reassemble_i(const FragmentRange& fragRange,
                                   ReceivedDataSample& data,
                                   ACE_UINT32 total_frags)
 {
+  OPENDDS_TRACE_SCOPE(REASSEMBLE, data.header_.sequence_.getValue());
+
   if (Transport_debug_level > 5) {
     LogGuid logger(data.header_.publication_id_);
     ACE_DEBUG((LM_DEBUG, "(%P|%t) TransportReassembly::reassemble_i: "
@@ -296,6 +301,9 @@ void TransportReassembly::check_expirations(const MonotonicTimePoint& now)
       // FragInfo::expiration_ may have changed after insertion into expiration_queue_
       if (iter->second.expiration_ <= now) {
         fragments_.erase(iter);
+        if (counters_) {
+          counters_->add(TransportCounters::REASSEMBLY_EXPIRED);
+        }
         if (Transport_debug_level > 5 || transport_debug.log_fragment_storage) {
           ACE_DEBUG((LM_DEBUG, "(%P|%t) TransportReassembly::check_expirations: "
                      "purge expired leaving %B fragments\n", fragments_.size()));
@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_TRANSPORT_FRAMEWORK_TRANSPORTREASSEMBLY_H
 
 #include "ReceivedDataSample.h"
+#include "TransportCounters.h"
 
 #include "dds/DCPS/dcps_export.h"
 #include "dds/DCPS/Definitions.h"
@@ -64,7 +65,8 @@ typedef std::pair<FragmentNumber, FragmentNumber> FragmentRange;
 
 class OpenDDS_Dcps_Export TransportReassembly : public RcObject {
 public:
-  explicit TransportReassembly(const TimeDuration& timeout = TimeDuration(300));
+  explicit TransportReassembly(const TimeDuration& timeout = TimeDuration(300),
+                               const TransportCounters_rch& counters = TransportCounters_rch());
 
   /// Called by TransportReceiveStrategy if the fragmentation header flag
   /// is set.  Returns true/false to indicate if data should be delivered to
@@ -163,6 +165,9 @@ private:
 
   TimeDuration timeout_;
 
+  /// Counts the expired samples, if given
+  const TransportCounters_rch counters_;
+
   void check_expirations(const MonotonicTimePoint& now);
 };
 
@@ -9,6 +9,8 @@
 
 #include "TransportInst.h"
 
+#include "dds/DCPS/Tracepoints.h"
+
 #include "ace/INET_Addr.h"
 #include "ace/Min_Max.h"
 
@@ -33,7 +35,8 @@ TransportReceiveStrategy<TH, DSH>::TransportReceiveStrategy(const TransportInst_
     buffer_index_(0),
     payload_(0),
     good_pdu_(true),
-    pdu_remaining_(0)
+    pdu_remaining_(0),
+    counters_(config ? config->counters() : TransportCounters_rch())
 {
   DBG_ENTRY_LVL("TransportReceiveStrategy", "TransportReceiveStrategy" ,6);
 
@@ -101,6 +104,7 @@ int
 TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
 {
   DBG_ENTRY_LVL("TransportReceiveStrategy", "handle_dds_input", 6);
+  OPENDDS_TRACE_SCOPE(RECEIVE, 0);
 
   //
   // What we will be doing here:
@@ -362,6 +366,11 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
     }
   }
 
+  if (counters_) {
+    counters_->add(TransportCounters::BYTES_RECEIVED, bytes_remaining);
+    counters_->add(TransportCounters::PACKETS_RECEIVED);
+  }
+
   VDBG_LVL((LM_DEBUG,"(%P|%t) DBG:   "
             "START Adjust the message block chain pointers to account for the "
             "new data.\n"), 5);
@@ -537,6 +546,9 @@ TransportReceiveStrategy<TH, DSH>::handle_dds_input(ACE_HANDLE fd)
         }
 
         this->good_pdu_ = check_header(this->receive_transport_header_);
+        if (!this->good_pdu_ && counters_) {
+          counters_->add(TransportCounters::DATAGRAMS_DROPPED);
+        }
         this->pdu_remaining_ = this->receive_transport_header_.length_;
 
         VDBG((LM_DEBUG,"(%P|%t) DBG:   "
@@ -11,6 +11,7 @@
 #include "dds/DCPS/dcps_export.h"
 #include "ReceivedDataSample.h"
 #include "TransportStrategy.h"
+#include "TransportCounters.h"
 #include "TransportDefs.h"
 #include "TransportHeader.h"
 #include "TransportInst_rch.h"
@@ -175,6 +176,9 @@ protected:
 
   /// Amount of the current PDU that has not been processed yet.
   size_t pdu_remaining_;
+
+  /// Counters of the transport's configuration, null if it has none.
+  const TransportCounters_rch counters_;
 };
 
 } // namespace DCPS */
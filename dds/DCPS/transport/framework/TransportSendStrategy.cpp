@@ -26,6 +26,7 @@
 #include <dds/DCPS/DataSampleElement.h>
 #include <dds/DCPS/DataSampleHeader.h>
 #include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/Tracepoints.h>
 
 #include <dds/OpenDDSConfigWrapper.h>
 
@@ -77,6 +78,7 @@ TransportSendStrategy::TransportSendStrategy(
     start_counter_(0),
     mode_(MODE_DIRECT),
     mode_before_suspend_(MODE_NOT_SET),
+    counted_queue_depth_(0),
     lock_(),
     replaced_element_mb_allocator_(NUM_REPLACED_ELEMENT_CHUNKS * 2),
     replaced_element_db_allocator_(NUM_REPLACED_ELEMENT_CHUNKS * 2),
@@ -93,6 +95,10 @@ TransportSendStrategy::TransportSendStrategy(
     max_samples_ = cfg->max_samples_per_packet();
     optimum_size_ = cfg->optimum_packet_size();
     max_size_ = cfg->max_packet_size();
+    counters_ = cfg->counters();
+  }
+  if (counters_) {
+    counters_->mode_changed(this, mode_counter(mode_));
   }
 
   // Create a ThreadSynch object just for us.
@@ -117,6 +123,12 @@ TransportSendStrategy::~TransportSendStrategy()
 {
   DBG_ENTRY_LVL("TransportSendStrategy","~TransportSendStrategy",6);
 
+  if (counters_) {
+    if (counted_queue_depth_) {
+      counters_->add(TransportCounters::QUEUE_DEPTH, -static_cast<ACE_INT64>(counted_queue_depth_));
+    }
+    counters_->mode_changed(this, TransportCounters::COUNTER_COUNT);
+  }
 
   delayed_delivered_notification_queue_.clear();
 }
@@ -210,7 +222,7 @@ TransportSendStrategy::perform_work()
                   "WORK_OUTCOME_NO_MORE_TO_DO.\n"), 5);
 
         // Flip the mode back to MODE_DIRECT.
-        mode_ = MODE_DIRECT;
+        set_mode(MODE_DIRECT);
 
         // And return WORK_OUTCOME_NO_MORE_TO_DO to tell our caller that
         // perform_work() doesn't need to be called again (at this time).
@@ -224,6 +236,7 @@ TransportSendStrategy::perform_work()
       // There is stuff in the queue_ if we get to this point in the logic.
       // Build-up the current packet using element(s) from the queue_.
       get_packet_elems_from_queue();
+      count_queue_depth();
 
       VDBG_LVL((LM_DEBUG, "(%P|%t) DBG:   "
                 "Prepare the packet from the packet elems_.\n"), 5);
@@ -257,7 +270,7 @@ TransportSendStrategy::perform_work()
                 "WORK_OUTCOME_NO_MORE_TO_DO.\n"), 5);
 
       // Revert back to MODE_DIRECT mode.
-      mode_ = MODE_DIRECT;
+      set_mode(MODE_DIRECT);
       no_more_work = true;
     }
   } // End of scope for guard(lock_);
@@ -810,12 +823,13 @@ TransportSendStrategy::clear(SendMode new_mode, SendMode old_mode)
 
     elems.swap(elems_);
     queue.swap(queue_);
+    count_queue_depth();
 
     header_.length_ = 0;
     pkt_chain_ = 0;
     header_complete_ = false;
     start_counter_ = 0;
-    mode_ = new_mode;
+    set_mode(new_mode);
     mode_before_suspend_ = MODE_NOT_SET;
   }
 
@@ -919,6 +933,12 @@ TransportSendStrategy::stop()
                  ACE_TEXT("(%P|%t) WARNING: TransportSendStrategy::stop() - ")
                  ACE_TEXT("terminating with %d queued elements.\n"),
                  queue_.size()));
+      count_queue_depth();
+    }
+
+    if (counters_) {
+      // Nothing is sent after this, so stop counting the mode's time.
+      counters_->mode_changed(this, TransportCounters::COUNTER_COUNT);
     }
   }
 
@@ -997,7 +1017,9 @@ TransportSendStrategy::send(TransportQueueElement* element, bool relink)
                   "mode_ == %C, so queue elem and leave.\n",
                   mode_as_str(mode_)), 5);
 
+        OPENDDS_TRACEPOINT(SEND_QUEUED, element->sequence().getValue());
         queue_.put(element);
+        count_queue_depth();
 
         if (mode_ != MODE_SUSPEND) {
           synch_->work_available();
@@ -1083,6 +1105,7 @@ TransportSendStrategy::send(TransportQueueElement* element, bool relink)
                     "the mode_ is now MODE_QUEUE or MODE_SUSPEND.  "
                     "Queue elem and leave.\n"), 5);
           queue_.put(element);
+          count_queue_depth();
           synch_->work_available();
 
           return;
@@ -1177,6 +1200,7 @@ TransportSendStrategy::send(TransportQueueElement* element, bool relink)
           if (next_fragment && mode_ != MODE_DIRECT) {
             if (mode_ == MODE_QUEUE) {
               queue_.put(next_fragment);
+              count_queue_depth();
               synch_->work_available();
 
             } else {
@@ -1403,6 +1427,7 @@ TransportSendStrategy::do_remove_sample(const GUID_t&,
 
   QueueRemoveVisitor simple_rem_vis(criteria, remove_all);
   queue_.accept_remove_visitor(simple_rem_vis);
+  count_queue_depth();
 
   RemoveResult status = simple_rem_vis.status();
 
@@ -1469,6 +1494,7 @@ void
 TransportSendStrategy::direct_send(bool do_relink)
 {
   DBG_ENTRY_LVL("TransportSendStrategy", "direct_send", 6);
+  OPENDDS_TRACE_SCOPE(SEND_DIRECT, header_.length_);
 
   VDBG((LM_DEBUG, "(%P|%t) DBG:   "
         "Prepare the current packet for a direct send attempt.\n"));
@@ -1498,7 +1524,7 @@ TransportSendStrategy::direct_send(bool do_relink)
                 "Flip into the MODE_QUEUE mode_.\n"), 5);
 
       // We encountered backpressure, or only sent part of the packet.
-      mode_ = MODE_QUEUE;
+      set_mode(MODE_QUEUE);
 
     } else if ((outcome == OUTCOME_PEER_LOST) ||
                (outcome == OUTCOME_SEND_ERROR)) {
@@ -1525,7 +1551,7 @@ TransportSendStrategy::direct_send(bool do_relink)
 
       if (mode_ != MODE_SUSPEND) {
         mode_before_suspend_ = mode_;
-        mode_ = MODE_SUSPEND;
+        set_mode(MODE_SUSPEND);
       }
 
       if (do_relink) {
@@ -1753,6 +1779,7 @@ TransportSendStrategy::do_send_packet(const ACE_Message_Block* packet, int& bp)
                id(), packet));
   }
   DBG_ENTRY_LVL("TransportSendStrategy", "do_send_packet", 6);
+  OPENDDS_TRACE_SCOPE(SOCKET_SEND, packet->total_length());
 
 #if OPENDDS_CONFIG_SECURITY
   Message_Block_Ptr substitute;
@@ -1790,6 +1817,11 @@ TransportSendStrategy::do_send_packet(const ACE_Message_Block* packet, int& bp)
 
   const ssize_t num_bytes_sent = send_bytes(iov, num_blocks, bp);
 
+  if (num_bytes_sent > 0 && counters_) {
+    counters_->add(TransportCounters::BYTES_SENT, num_bytes_sent);
+    counters_->add(TransportCounters::PACKETS_SENT);
+  }
+
   VDBG_LVL((LM_DEBUG, "(%P|%t) DBG:   "
             "The send_bytes() said that num_bytes_sent == [%d].\n",
             num_bytes_sent), 5);
@@ -1926,6 +1958,40 @@ TransportSendStrategy::non_blocking_send(const iovec iov[], int n, int& bp)
   return result;
 }
 
+void
+TransportSendStrategy::set_mode(SendMode new_mode)
+{
+  const SendMode old_mode = mode_;
+  mode_ = new_mode;
+  if (counters_ && mode_counter(old_mode) != mode_counter(new_mode)) {
+    counters_->mode_changed(this, mode_counter(new_mode));
+  }
+}
+
+TransportCounters::Counter
+TransportSendStrategy::mode_counter(SendMode mode)
+{
+  switch (mode) {
+  case MODE_DIRECT:
+    return TransportCounters::DIRECT_MODE_USEC;
+  case MODE_QUEUE:
+    return TransportCounters::QUEUE_MODE_USEC;
+  default:
+    return TransportCounters::COUNTER_COUNT;
+  }
+}
+
+void
+TransportSendStrategy::count_queue_depth()
+{
+  const size_t depth = queue_.size();
+  if (counters_ && depth != counted_queue_depth_) {
+    counters_->add(TransportCounters::QUEUE_DEPTH,
+                   static_cast<ACE_INT64>(depth) - static_cast<ACE_INT64>(counted_queue_depth_));
+  }
+  counted_queue_depth_ = depth;
+}
+
 void
 TransportSendStrategy::add_delayed_notification(TransportQueueElement* element)
 {
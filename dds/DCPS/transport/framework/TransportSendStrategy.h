@@ -11,6 +11,7 @@
 #include "BasicQueue_T.h"
 #include "ThreadSynchStrategy_rch.h"
 #include "ThreadSynchWorker.h"
+#include "TransportCounters.h"
 #include "TransportDefs.h"
 #include "TransportImpl_rch.h"
 #include "TransportHeader.h"
@@ -345,6 +346,15 @@ private:
   /// Helper function to debugging.
   static const char* mode_as_str(SendMode mode);
 
+  /// Change mode_, counting the time spent in the previous mode.
+  void set_mode(SendMode new_mode);
+
+  /// The counter of the time spent in mode, COUNTER_COUNT if it isn't timed.
+  static TransportCounters::Counter mode_counter(SendMode mode);
+
+  /// Add the change in the size of queue_ to the QUEUE_DEPTH counter.
+  void count_queue_depth();
+
   /// Configuration - max number of samples per transport packet
   size_t max_samples_;
 
@@ -401,6 +411,12 @@ private:
   /// re-established.
   SendMode mode_before_suspend_;
 
+  /// Counters of the transport's configuration, null if it has none.
+  TransportCounters_rch counters_;
+
+  /// The size of queue_ last added to the QUEUE_DEPTH counter.
+  size_t counted_queue_depth_;
+
   /// Used for delayed notifications when performing work.
   typedef std::pair<TransportQueueElement*, SendMode> TQESendModePair;
   OPENDDS_VECTOR(TQESendModePair) delayed_delivered_notification_queue_;
@@ -468,6 +484,8 @@ private:
 protected:
   ThreadSynch* synch() const;
 
+  const TransportCounters_rch& counters() const { return counters_; }
+
   void set_header_source(ACE_INT64 source);
 };
 
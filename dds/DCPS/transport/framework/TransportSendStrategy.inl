@@ -70,7 +70,7 @@ void TransportSendStrategy::suspend_send()
 
   if (this->mode_ != MODE_TERMINATED && this->mode_ != MODE_SUSPEND) {
     this->mode_before_suspend_ = this->mode_;
-    this->mode_ = MODE_SUSPEND;
+    this->set_mode(MODE_SUSPEND);
   }
 }
 
@@ -87,7 +87,7 @@ void TransportSendStrategy::resume_send()
     this->pkt_chain_ = 0;
     this->header_complete_ = false;
     this->start_counter_ = 0;
-    this->mode_ = MODE_DIRECT;
+    this->set_mode(MODE_DIRECT);
     this->mode_before_suspend_ = MODE_NOT_SET;
     this->delayed_delivered_notification_queue_.clear();
 
@@ -96,11 +96,11 @@ void TransportSendStrategy::resume_send()
     this->pkt_chain_ = 0;
     QueueType elems;
     elems.swap(this->elems_);
-    this->mode_ = this->mode_before_suspend_;
+    this->set_mode(this->mode_before_suspend_);
     this->header_complete_ = false;
     this->mode_before_suspend_ = MODE_NOT_SET;
     if (this->queue_.size() > 0) {
-      this->mode_ = MODE_QUEUE;
+      this->set_mode(MODE_QUEUE);
       this->synch_->work_available();
     }
 
@@ -2798,6 +2798,9 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
   CountKeeper counts;
   bundle_mapped_meta_submessages(encoding, addr_map, bundles, counts);
 
+  const RtpsUdpInst_rch cfg = config();
+  const TransportCounters_rch counters = cfg ? cfg->counters() : TransportCounters_rch();
+
   // Reusable INFO_DST
   InfoDestinationSubmessage idst = {
     {INFO_DST, FLAG_E, INFO_DST_SZ},
@@ -2855,6 +2858,9 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
             map_pair.is_new_assigned_ = true;
           }
           res.sm_.heartbeat_sm().count.value = map_pair.new_;
+          if (counters) {
+            counters->add(TransportCounters::HEARTBEATS_SENT);
+          }
           const HeartBeatSubmessage& heartbeat = res.sm_.heartbeat_sm();
           if (transport_debug.log_nonfinal_messages && !(heartbeat.smHeader.flags & RTPS::FLAG_F)) {
             const SequenceNumber hb_first = to_opendds_seqnum(heartbeat.firstSN);
@@ -2866,6 +2872,9 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
         }
         case ACKNACK: {
           const AckNackSubmessage& acknack = res.sm_.acknack_sm();
+          if (counters && acknack.readerSNState.numBits) {
+            counters->add(TransportCounters::NACKS_SENT);
+          }
           if (transport_debug.log_nonfinal_messages && !(acknack.smHeader.flags & RTPS::FLAG_F)) {
             const SequenceNumber ack = to_opendds_seqnum(acknack.readerSNState.bitmapBase);
             ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::bundle_and_send_submessages: ACKNACK: %C -> %C base %q bits %u count %d\n",
@@ -2879,6 +2888,9 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
           res.sm_.nack_frag_sm().count.value = *set.begin();
           set.erase(set.begin());
           const NackFragSubmessage& nackfrag = res.sm_.nack_frag_sm();
+          if (counters) {
+            counters->add(TransportCounters::NACKS_SENT);
+          }
           // All NackFrag messages are technically 'non-final' since they are only used to negatively acknowledge fragments and expect a response
           if (transport_debug.log_nonfinal_messages) {
             const SequenceNumber seq = to_opendds_seqnum(nackfrag.writerSN);
@@ -3742,6 +3754,10 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
 
   if (cumulative_send_count) {
     link->transport()->core().writer_resend_count(id_, static_cast<ACE_CDR::ULong>(cumulative_send_count));
+    const RtpsUdpInst_rch cfg = link->config();
+    if (cfg) {
+      cfg->counters()->add(TransportCounters::RETRANSMISSIONS, static_cast<ACE_INT64>(cumulative_send_count));
+    }
   }
 
   // Gather the consolidated gaps.
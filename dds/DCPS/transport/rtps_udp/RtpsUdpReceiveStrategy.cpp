@@ -41,7 +41,7 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link,
   , recvd_sample_(0)
   , fragment_size_(0)
   , total_frags_(0)
-  , reassembly_(link->config()->fragment_reassembly_timeout())
+  , reassembly_(link->config()->fragment_reassembly_timeout(), link->config()->counters())
   , receiver_(local_prefix)
   , thread_status_manager_(thread_status_manager)
 #if OPENDDS_CONFIG_SECURITY
@@ -303,8 +303,12 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
 
 #if OPENDDS_CONFIG_SECURITY
 namespace {
-  ssize_t recv_err(const char* msg, const ACE_INET_Addr& remote, const DCPS::GUID_t& peer, bool& stop)
+  ssize_t recv_err(const char* msg, const ACE_INET_Addr& remote, const DCPS::GUID_t& peer, bool& stop,
+                   const TransportCounters_rch& counters)
   {
+    if (counters) {
+      counters->add(TransportCounters::DATAGRAMS_DROPPED);
+    }
     if (security_debug.encdec_warn) {
       ACE_ERROR((LM_WARNING, "(%P|%t) {encdec_warn} RtpsUdpReceiveStrategy::receive_bytes - "
                  "from %C %C secure RTPS processing failed: %C\n",
@@ -377,11 +381,11 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
 
     const CryptoTransform_var crypto = link_->security_config()->get_crypto_transform();
     if (!crypto) {
-      return recv_err("no crypto plugin", remote_address, peer, stop);
+      return recv_err("no crypto plugin", remote_address, peer, stop, counters_);
     }
 
     if (ret < RTPS::RTPSHDR_SZ + RTPS::SMHDR_SZ) {
-      return recv_err("message too short", remote_address, peer, stop);
+      return recv_err("message too short", remote_address, peer, stop, counters_);
     }
 
     const unsigned int encLen = static_cast<unsigned int>(ret);
@@ -397,7 +401,7 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
     }
 
     if (copied != encLen) {
-      return recv_err("received bytes didn't fit in iovec array", remote_address, peer, stop);
+      return recv_err("received bytes didn't fit in iovec array", remote_address, peer, stop, counters_);
     }
 
     if (encoded[RTPS::RTPSHDR_SZ] != RTPS::SRTPS_PREFIX) {
@@ -419,6 +423,9 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
                    ACE_TEXT("decode_rtps_message no remote participant crypto handle for %C, dropping\n"),
                    LogGuid(peer).c_str()));
       }
+      if (counters_) {
+        counters_->add(TransportCounters::DATAGRAMS_DROPPED);
+      }
       stop = true;
       return ret;
     }
@@ -438,10 +445,13 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
           ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) {encdec_warn} RtpsUdpReceiveStrategy::receive_bytes: ")
             ACE_TEXT("decode_rtps_message remote participant has crypto handle but no key, dropping\n")));
         }
+        if (counters_) {
+          counters_->add(TransportCounters::DATAGRAMS_DROPPED);
+        }
         stop = true;
         return ret;
       }
-      return recv_err("decode_rtps_message failed", remote_address, peer, stop);
+      return recv_err("decode_rtps_message failed", remote_address, peer, stop, counters_);
     }
 
     copied = 0;
@@ -455,7 +465,7 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
     }
 
     if (copied != plainLen) {
-      return recv_err("plaintext doesn't fit in iovec array", remote_address, peer, stop);
+      return recv_err("plaintext doesn't fit in iovec array", remote_address, peer, stop, counters_);
     }
 
     encoded_rtps_ = true;
@@ -686,6 +696,9 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
       break;
     }
     link_->received(submessage.heartbeat_sm(), receiver_.source_guid_prefix_, receiver_.directed_, remote_addr);
+    if (counters_) {
+      counters_->add(TransportCounters::HEARTBEATS_RECEIVED);
+    }
     if (submessage.heartbeat_sm().smHeader.flags & FLAG_L) {
       // Liveliness has been asserted.  Create a DATAWRITER_LIVELINESS message.
       sample.header_.message_id_ = DATAWRITER_LIVELINESS;
@@ -703,6 +716,9 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
       break;
     }
     link_->received(submessage.acknack_sm(), receiver_.source_guid_prefix_, remote_addr);
+    if (counters_ && submessage.acknack_sm().readerSNState.numBits) {
+      counters_->add(TransportCounters::NACKS_RECEIVED);
+    }
     break;
 
   case HEARTBEAT_FRAG:
@@ -723,6 +739,9 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
       break;
     }
     link_->received(submessage.nack_frag_sm(), receiver_.source_guid_prefix_, remote_addr);
+    if (counters_) {
+      counters_->add(TransportCounters::NACKS_RECEIVED);
+    }
     break;
 
   /* no case DATA_FRAG: by the time deliver_sample() is called, reassemble()
@@ -183,6 +183,9 @@ RtpsUdpSendStrategy::send_rtps_control(RTPS::Message& message,
       if (!alternate) {
         VDBG((LM_DEBUG, "(%P|%t) RtpsUdpSendStrategy::send_rtps_control () - "
               "pre_send_packet returned NULL, dropping.\n"));
+        if (counters()) {
+          counters()->add(TransportCounters::DATAGRAMS_DROPPED);
+        }
         return;
       }
     }
@@ -200,6 +203,10 @@ RtpsUdpSendStrategy::send_rtps_control(RTPS::Message& message,
     ACE_ERROR((prio, "(%P|%t) RtpsUdpSendStrategy::send_rtps_control() - "
       "failed to send RTPS control message\n"));
   }
+  if (result > 0 && counters()) {
+    counters()->add(TransportCounters::BYTES_SENT, result);
+    counters()->add(TransportCounters::PACKETS_SENT);
+  }
 }
 
 void
@@ -223,6 +230,9 @@ RtpsUdpSendStrategy::send_rtps_control(RTPS::Message& message,
       if (!alternate) {
         VDBG((LM_DEBUG, "(%P|%t) RtpsUdpSendStrategy::send_rtps_control () - "
               "pre_send_packet returned NULL, dropping.\n"));
+        if (counters()) {
+          counters()->add(TransportCounters::DATAGRAMS_DROPPED);
+        }
         return;
       }
     }
@@ -240,6 +250,10 @@ RtpsUdpSendStrategy::send_rtps_control(RTPS::Message& message,
     ACE_ERROR((prio, "(%P|%t) RtpsUdpSendStrategy::send_rtps_control() - "
       "failed to send RTPS control message\n"));
   }
+  if (result > 0 && counters()) {
+    counters()->add(TransportCounters::BYTES_SENT, result);
+    counters()->add(TransportCounters::PACKETS_SENT);
+  }
 }
 
 void
@@ -297,6 +311,9 @@ RtpsUdpSendStrategy::send_single_i(const iovec iov[], int n,
 #ifdef OPENDDS_TESTING_FEATURES
   ssize_t total_length;
   if (transport->core().should_drop(iov, n, total_length)) {
+    if (counters()) {
+      counters()->add(TransportCounters::DATAGRAMS_DROPPED);
+    }
     return total_length;
   }
 #endif
@@ -117,7 +117,7 @@ UdpReceiveStrategy::check_header(const TransportHeader& header)
 {
   ReassemblyInfo& info = reassembly_[remote_address_];
   if (!info.first) {
-    info.first = make_rch<TransportReassembly>();
+    info.first = make_rch<TransportReassembly>(TimeDuration(300), counters_);
   }
 
   if (header.sequence_ != info.second &&
@@ -140,7 +140,7 @@ UdpReceiveStrategy::reassemble(ReceivedDataSample& data)
 {
   ReassemblyInfo& info = reassembly_[remote_address_];
   if (!info.first) {
-    info.first = make_rch<TransportReassembly>();
+    info.first = make_rch<TransportReassembly>(TimeDuration(300), counters_);
   }
   const TransportHeader& header = received_header();
   return info.first->reassemble(header.sequence_, header.first_fragment_, data);
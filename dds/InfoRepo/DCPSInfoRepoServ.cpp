@@ -16,6 +16,7 @@
 
 #include <dds/DCPS/Service_Participant.h>
 #include <dds/DCPS/DCPS_Utils.h>
+#include <dds/DCPS/ThreadPool.h>
 #include <dds/DCPS/InfoRepoDiscovery/InfoRepoDiscovery.h>
 //If we need BIT support, pull in TCP so that static builds will have it.
 #ifndef DDS_HAS_MINIMUM_BIT
@@ -56,6 +57,7 @@ InfoRepo::InfoRepo(int argc, ACE_TCHAR *argv[])
 , shutdown_complete_(false)
 , shutdown_signal_(0)
 , dispatch_cleanup_delay_(30,0)
+, orb_threads_(1)
 {
   try {
     this->init();
@@ -76,13 +78,25 @@ void
 InfoRepo::run()
 {
   this->shutdown_complete_ = false;
-  this->orb_->run();
+  {
+    // This thread is one of the orb_threads_ threads running the ORB.  The
+    // others are joined once the ORB shuts down.
+    OpenDDS::DCPS::ThreadPool pool(this->orb_threads_ - 1, run_orb, this);
+    this->orb_->run();
+  }
   this->finalize();
   ACE_GUARD(ACE_Thread_Mutex, g, this->lock_);
   this->shutdown_complete_ = true;
   this->cond_.signal();
 }
 
+ACE_THR_FUNC_RETURN
+InfoRepo::run_orb(void* arg)
+{
+  static_cast<InfoRepo*>(arg)->orb_->run();
+  return 0;
+}
+
 void
 InfoRepo::finalize()
 {
@@ -184,6 +198,7 @@ InfoRepo::usage(const ACE_TCHAR* cmd)
              ACE_TEXT("    -FederateWith <ior> federate initially with object at <ior>\n")
              ACE_TEXT("    -ReassociateDelay <msec> delay between reassociations\n")
              ACE_TEXT("    -DispatchingCheckDelay <sec> delay between checks for cleaning up dispatching connections.\n")
+             ACE_TEXT("    -Threads <number> threads handling requests, default 1\n")
              ACE_TEXT("    -?\n")
              ACE_TEXT("\n"),
              cmd));
@@ -235,6 +250,11 @@ InfoRepo::parse_args(int argc, ACE_TCHAR *argv[])
       this->dispatch_cleanup_delay_.sec(sec);
       arg_shifter.consume_arg();
 
+    } else if ((current_arg = arg_shifter.get_the_parameter(ACE_TEXT("-Threads"))) != 0) {
+      const int threads = ACE_OS::atoi(current_arg);
+      this->orb_threads_ = threads > 1 ? threads : 1;
+      arg_shifter.consume_arg();
+
     }
 
     // The '-?' option
@@ -52,6 +52,8 @@ private:
   void usage(const ACE_TCHAR * cmd);
   void parse_args(int argc, ACE_TCHAR *argv[]);
 
+  static ACE_THR_FUNC_RETURN run_orb(void* arg);
+
   /// Actual finalization of service resources.
   void finalize();
 
@@ -81,6 +83,10 @@ private:
   int shutdown_signal_;
 
   ACE_Time_Value dispatch_cleanup_delay_;
+
+  /// Number of threads running the ORB.  Requests for different domains
+  /// are handled concurrently.
+  size_t orb_threads_;
 };
 
 class OpenDDS_DCPSInfoRepoServ_Export InfoRepo_Shutdown :
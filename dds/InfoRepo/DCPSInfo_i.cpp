@@ -70,9 +70,9 @@ int
 TAO_DDS_DCPSInfo_i::handle_timeout(const ACE_Time_Value& /*now*/,
                                    const void* arg)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
   if (arg == this) {
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+
     if (dispatchingOrb_) {
       if (dispatchingOrb_->work_pending()) {
         // Ten microseconds
@@ -81,11 +81,18 @@ TAO_DDS_DCPSInfo_i::handle_timeout(const ACE_Time_Value& /*now*/,
       }
     }
   } else {
+    DCPS_IR_Domain_Map domains;
+    {
+      ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+      domains = this->domains_;
+    }
+
     // NOTE: This is a purposefully naive approach to addressing defunct
     // associations.  In the future, it may be worthwhile to introduce a
     // callback model to fix the heinous runtime cost below:
-    for (DCPS_IR_Domain_Map::const_iterator dom(this->domains_.begin());
-         dom != this->domains_.end(); ++dom) {
+    for (DCPS_IR_Domain_Map::const_iterator dom(domains.begin());
+         dom != domains.end(); ++dom) {
+      ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, dom->second->lock(), 0);
 
       const DCPS_IR_Participant_Map& participants(dom->second->participants());
       for (DCPS_IR_Participant_Map::const_iterator part(participants.begin());
@@ -125,18 +132,18 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::attach_participant(
   DDS::DomainId_t            domainId,
   const OpenDDS::DCPS::GUID_t& participantId)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), 0);
+
   // Grab the participant.
   DCPS_IR_Participant* participant
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participant) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -155,18 +162,18 @@ TAO_DDS_DCPSInfo_i::changeOwnership(
   long                           sender,
   long                           owner)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     return false;
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
+
   // Grab the participant.
   DCPS_IR_Participant* participant
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participant) {
     return false;
@@ -186,24 +193,25 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::assert_topic(
   const DDS::TopicQos & qos,
   bool /*hasDcpsKey -- only used for RTPS Discovery*/)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::INTERNAL_ERROR);
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), OpenDDS::DCPS::INTERNAL_ERROR);
+
   // Grab the participant.
   DCPS_IR_Participant* participantPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participantPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
 
   OpenDDS::DCPS::TopicStatus topicStatus
-  = where->second->add_topic(
+  = domainPtr->add_topic(
       topicId,
       topicName,
       dataTypeName,
@@ -236,12 +244,10 @@ TAO_DDS_DCPSInfo_i::add_topic(const OpenDDS::DCPS::GUID_t& topicId,
                               const char* dataTypeName,
                               const DDS::TopicQos& qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
       ACE_DEBUG((LM_WARNING,
                  ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_topic: ")
@@ -252,9 +258,11 @@ TAO_DDS_DCPSInfo_i::add_topic(const OpenDDS::DCPS::GUID_t& topicId,
     return false;
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
+
   // Grab the participant.
   DCPS_IR_Participant* participantPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == participantPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -269,8 +277,8 @@ TAO_DDS_DCPSInfo_i::add_topic(const OpenDDS::DCPS::GUID_t& topicId,
   }
 
   OpenDDS::DCPS::TopicStatus topicStatus
-  = where->second->force_add_topic(topicId, topicName, dataTypeName,
-                                   qos, participantPtr);
+  = domainPtr->force_add_topic(topicId, topicName, dataTypeName,
+                               qos, participantPtr);
 
   if (topicStatus != OpenDDS::DCPS::CREATED) {
     return false;
@@ -295,21 +303,21 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::find_topic(
   DDS::TopicQos_out qos,
   OpenDDS::DCPS::GUID_t_out topicId)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::INTERNAL_ERROR);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), OpenDDS::DCPS::INTERNAL_ERROR);
+
   OpenDDS::DCPS::TopicStatus status = OpenDDS::DCPS::NOT_FOUND;
 
   DCPS_IR_Topic* topic = 0;
   qos = new DDS::TopicQos;
 
-  status = where->second->find_topic(topicName, topic);
+  status = domainPtr->find_topic(topicName, topic);
 
   if (0 != topic) {
     status = OpenDDS::DCPS::FOUND;
@@ -327,18 +335,18 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::remove_topic(
   const OpenDDS::DCPS::GUID_t& participantId,
   const OpenDDS::DCPS::GUID_t& topicId)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, OpenDDS::DCPS::INTERNAL_ERROR);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), OpenDDS::DCPS::INTERNAL_ERROR);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -350,7 +358,7 @@ OpenDDS::DCPS::TopicStatus TAO_DDS_DCPSInfo_i::remove_topic(
     throw OpenDDS::DCPS::Invalid_Topic();
   }
 
-  OpenDDS::DCPS::TopicStatus removedStatus = where->second->remove_topic(partPtr, topic);
+  OpenDDS::DCPS::TopicStatus removedStatus = domainPtr->remove_topic(partPtr, topic);
 
   if (this->um_
       && (partPtr->isOwner() == true)
@@ -376,21 +384,23 @@ OpenDDS::DCPS::GUID_t TAO_DDS_DCPSInfo_i::reserve_publication_id(DDS::DomainId_t
                                                                  const OpenDDS::DCPS::GUID_t& topicId)
 {
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), OpenDDS::DCPS::GUID_UNKNOWN);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     throw OpenDDS::DCPS::Invalid_Topic();
@@ -419,24 +429,24 @@ bool TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
     return false;
   }
 
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     throw OpenDDS::DCPS::Invalid_Topic();
@@ -508,7 +518,7 @@ bool TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
     }
   }
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
   return retval;
 }
 
@@ -525,12 +535,10 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
                                     const DDS::OctetSeq & serializedTypeInfo,
                                     bool associate)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
       ACE_DEBUG((LM_WARNING,
                  ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_publication: ")
@@ -541,9 +549,11 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
     return false;
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -558,7 +568,7 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
     return false;
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     OpenDDS::DCPS::RepoIdConverter converter(topicId);
@@ -658,17 +668,17 @@ void TAO_DDS_DCPSInfo_i::remove_publication(
   const OpenDDS::DCPS::GUID_t& participantId,
   const OpenDDS::DCPS::GUID_t& publicationId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
-  DCPS_IR_Participant* const partPtr = where->second->participant(participantId);
+  DCPS_IR_Participant* const partPtr = domainPtr->participant(participantId);
   if (!partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -681,13 +691,13 @@ void TAO_DDS_DCPSInfo_i::remove_publication(
 #endif
 
   if (partPtr->remove_publication(publicationId) != 0) {
-    where->second->remove_dead_participants(in_cleanup);
+    domainPtr->remove_dead_participants(in_cleanup);
 
     // throw exception because the publication was not removed!
     throw OpenDDS::DCPS::Invalid_Publication();
   }
 
-  where->second->remove_dead_participants(in_cleanup);
+  domainPtr->remove_dead_participants(in_cleanup);
 
   if (um_ && partPtr->isOwner() && !partPtr->isBitPublisher()) {
     Update::IdPath path(domainId, participantId, publicationId);
@@ -709,21 +719,23 @@ OpenDDS::DCPS::GUID_t TAO_DDS_DCPSInfo_i::reserve_subscription_id(DDS::DomainId_
                                                                   const OpenDDS::DCPS::GUID_t& topicId)
 {
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), OpenDDS::DCPS::GUID_UNKNOWN);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     throw OpenDDS::DCPS::Invalid_Topic();
@@ -755,70 +767,63 @@ bool TAO_DDS_DCPSInfo_i::add_subscription(DDS::DomainId_t domainId,
     return false;
   }
 
-  DCPS_IR_Domain* domainPtr;
-  DCPS_IR_Participant* partPtr;
-  DCPS_IR_Topic* topic;
-  OpenDDS::DCPS::unique_ptr<DCPS_IR_Subscription> subPtr;
-  {
-    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
+  // Grab the domain.
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-    // Grab the domain.
-    DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  if (!domainPtr) {
+    throw OpenDDS::DCPS::Invalid_Domain();
+  }
 
-    if (where == this->domains_.end()) {
-      throw OpenDDS::DCPS::Invalid_Domain();
-    }
+  // Hold the domain lock until the subscription is in the participant and
+  // topic, otherwise either could be removed by another thread first.
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
 
-    // Grab the domain and participant.
-    domainPtr = where->second.get();
-    partPtr = domainPtr->participant(participantId);
+  // Grab the participant.
+  DCPS_IR_Participant* const partPtr = domainPtr->participant(participantId);
 
-    if (0 == partPtr) {
-      throw OpenDDS::DCPS::Invalid_Participant();
-    }
+  if (0 == partPtr) {
+    throw OpenDDS::DCPS::Invalid_Participant();
+  }
 
-    topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* const topic = domainPtr->find_topic(topicId);
 
-    if (topic == 0) {
-      throw OpenDDS::DCPS::Invalid_Topic();
-    }
+  if (topic == 0) {
+    throw OpenDDS::DCPS::Invalid_Topic();
+  }
 
-    OpenDDS::DCPS::DataReaderRemote_var dispatchingSubscription (
-      OpenDDS::DCPS::DataReaderRemote::_duplicate(subscription));
+  OpenDDS::DCPS::DataReaderRemote_var dispatchingSubscription (
+    OpenDDS::DCPS::DataReaderRemote::_duplicate(subscription));
 
-    if (dispatchingOrb_) {
-      // Remarshall the remote reference onto the dispatching orb.
-      CORBA::String_var subStr = orb_->object_to_string(dispatchingSubscription);
-      CORBA::Object_var subObj = dispatchingOrb_->string_to_object(subStr);
-      if (CORBA::is_nil(subObj.in())) {
-        if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-          ACE_DEBUG((LM_WARNING,
-                     ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
-                     ACE_TEXT("failure marshalling subscription on dispatching orb.\n")));
-        }
-        return false;
+  if (dispatchingOrb_) {
+    // Remarshall the remote reference onto the dispatching orb.
+    CORBA::String_var subStr = orb_->object_to_string(dispatchingSubscription);
+    CORBA::Object_var subObj = dispatchingOrb_->string_to_object(subStr);
+    if (CORBA::is_nil(subObj.in())) {
+      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+        ACE_DEBUG((LM_WARNING,
+                   ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
+                   ACE_TEXT("failure marshalling subscription on dispatching orb.\n")));
       }
-      dispatchingSubscription = OpenDDS::DCPS::DataReaderRemote::_unchecked_narrow(subObj);
+      return false;
     }
-
-    subPtr.reset(
-      new DCPS_IR_Subscription(
-                     subId,
-                     partPtr,
-                     topic,
-                     dispatchingSubscription.in(),
-                     qos,
-                     transInfo,
-                     transportContextDefault,
-                     subscriberQos,
-                     filterClassName,
-                     filterExpression,
-                     exprParams,
-                     serializedTypeInfo));
-
-    // Release lock
+    dispatchingSubscription = OpenDDS::DCPS::DataReaderRemote::_unchecked_narrow(subObj);
   }
 
+  OpenDDS::DCPS::unique_ptr<DCPS_IR_Subscription> subPtr(
+    new DCPS_IR_Subscription(
+                   subId,
+                   partPtr,
+                   topic,
+                   dispatchingSubscription.in(),
+                   qos,
+                   transInfo,
+                   transportContextDefault,
+                   subscriberQos,
+                   filterClassName,
+                   filterExpression,
+                   exprParams,
+                   serializedTypeInfo));
+
   bool retval = true;
   DCPS_IR_Subscription* sub = subPtr.get();
   if (partPtr->add_subscription(OPENDDS_MOVE_NS::move(subPtr)) != 0) {
@@ -877,12 +882,10 @@ TAO_DDS_DCPSInfo_i::add_subscription(
   const DDS::OctetSeq & serializedTypeInfo,
   bool associate)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
       ACE_DEBUG((LM_WARNING,
                  ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
@@ -893,9 +896,11 @@ TAO_DDS_DCPSInfo_i::add_subscription(
     return false;
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -910,7 +915,7 @@ TAO_DDS_DCPSInfo_i::add_subscription(
     return false;
   }
 
-  DCPS_IR_Topic* topic = where->second->find_topic(topicId);
+  DCPS_IR_Topic* topic = domainPtr->find_topic(topicId);
 
   if (topic == 0) {
     if (OpenDDS::DCPS::DCPS_debug_level > 4) {
@@ -1015,17 +1020,17 @@ void TAO_DDS_DCPSInfo_i::remove_subscription(
   const OpenDDS::DCPS::GUID_t& participantId,
   const OpenDDS::DCPS::GUID_t& subscriptionId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
-  DCPS_IR_Participant* const partPtr = where->second->participant(participantId);
+  DCPS_IR_Participant* const partPtr = domainPtr->participant(participantId);
   if (!partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -1035,7 +1040,7 @@ void TAO_DDS_DCPSInfo_i::remove_subscription(
     throw OpenDDS::DCPS::Invalid_Subscription();
   }
 
-  where->second->remove_dead_participants(
+  domainPtr->remove_dead_participants(
 #ifdef DDS_HAS_MINIMUM_BIT
     false
 #else
@@ -1067,17 +1072,24 @@ OpenDDS::DCPS::AddDomainStatus TAO_DDS_DCPSInfo_i::add_domain_participant(
   value.id        = OpenDDS::DCPS::GUID_UNKNOWN;
   value.federated = this->federation_.overridden();
 
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, value);
+  DCPS_IR_Domain_rch domainPtr;
+  OpenDDS::DCPS::GUID_t participantId;
+  {
+    // The participant ids are shared by all domains, so only loading the
+    // domain and allocating the id needs lock_.
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, value);
 
-  // Grab the domain.
-  DCPS_IR_Domain* domainPtr = this->domain(domain);
+    // Grab the domain.
+    if (0 == this->domain(domain)) {
+      throw OpenDDS::DCPS::Invalid_Domain();
+    }
+    domainPtr = find_domain(domain);
 
-  if (0 == domainPtr) {
-    throw OpenDDS::DCPS::Invalid_Domain();
+    // Obtain a shiny new GUID value.
+    participantId = domainPtr->get_next_participant_id();
   }
 
-  // Obtain a shiny new GUID value.
-  OpenDDS::DCPS::GUID_t participantId = domainPtr->get_next_participant_id();
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, domain_guard, domainPtr->lock(), value);
 
   // Determine if this is the 'special' repository internal participant
   // that publishes the built-in topics for a domain.
@@ -1087,7 +1099,7 @@ OpenDDS::DCPS::AddDomainStatus TAO_DDS_DCPSInfo_i::add_domain_participant(
     OpenDDS::DCPS::make_rch<DCPS_IR_Participant>(
                    this->federation_,
                    participantId,
-                   domainPtr,
+                   domainPtr.in(),
                    qos, um_, isBitPart);
 
   // We created the participant, now we can return the Id value (eventually).
@@ -1157,24 +1169,44 @@ TAO_DDS_DCPSInfo_i::add_domain_participant(DDS::DomainId_t domainId
                                            , const OpenDDS::DCPS::GUID_t& participantId
                                            , const DDS::DomainParticipantQos & qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
+  // Prepare to manipulate the participant's Id value.
+  OpenDDS::DCPS::RepoIdConverter converter(participantId);
 
-  // Grab the domain.
-  DCPS_IR_Domain* domainPtr = this->domain(domainId);
+  DCPS_IR_Domain_rch domainPtr;
+  {
+    // The participant ids are shared by all domains, so only loading the
+    // domain and adjusting the ids needs lock_.
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
 
-  if (0 == domainPtr) {
-    if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-      ACE_DEBUG((LM_WARNING,
-                 ACE_TEXT("(%P|%t) WARNING: (bool)TAO_DDS_DCPSInfo_i::add_domain_participant: ")
-                 ACE_TEXT("invalid domain Id: %d\n"),
-                 domainId));
+    // Grab the domain.
+    if (0 == this->domain(domainId)) {
+      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+        ACE_DEBUG((LM_WARNING,
+                   ACE_TEXT("(%P|%t) WARNING: (bool)TAO_DDS_DCPSInfo_i::add_domain_participant: ")
+                   ACE_TEXT("invalid domain Id: %d\n"),
+                   domainId));
+      }
+
+      return false;
     }
+    domainPtr = find_domain(domainId);
 
-    return false;
+    // See if we are adding a participant that was created within this
+    // repository or a different repository.
+    if (converter.federationId() == this->federation_.id()) {
+      // Ensure the participant GUID values do not conflict.
+      domainPtr->last_participant_key(converter.participantId());
+
+      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::add_domain_participant: ")
+                   ACE_TEXT("Adjusting highest participant Id value to at least %d.\n"),
+                   converter.participantId()));
+      }
+    }
   }
 
-  // Prepare to manipulate the participant's Id value.
-  OpenDDS::DCPS::RepoIdConverter converter(participantId);
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, domain_guard, domainPtr->lock(), false);
 
   // Determine if this is the 'special' repository internal participant
   // that publishes the built-in topics for a domain.
@@ -1197,7 +1229,7 @@ TAO_DDS_DCPSInfo_i::add_domain_participant(DDS::DomainId_t domainId
   DCPS_IR_Participant_rch participant =
     OpenDDS::DCPS::make_rch<DCPS_IR_Participant>(this->federation_,
                                      participantId,
-                                     domainPtr,
+                                     domainPtr.in(),
                                      qos, um_, isBitPart);
 
   switch (domainPtr->add_participant(participant)) {
@@ -1227,20 +1259,6 @@ TAO_DDS_DCPSInfo_i::add_domain_participant(DDS::DomainId_t domainId
     break;
   }
 
-  // See if we are adding a participant that was created within this
-  // repository or a different repository.
-  if (converter.federationId() == this->federation_.id()) {
-    // Ensure the participant GUID values do not conflict.
-    domainPtr->last_participant_key(converter.participantId());
-
-    if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-      ACE_DEBUG((LM_DEBUG,
-                 ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::add_domain_participant: ")
-                 ACE_TEXT("Adjusting highest participant Id value to at least %d.\n"),
-                 converter.participantId()));
-    }
-  }
-
   if (OpenDDS::DCPS::DCPS_debug_level > 0) {
     ACE_DEBUG((LM_DEBUG,
                ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::add_domain_participant: ")
@@ -1258,23 +1276,24 @@ TAO_DDS_DCPSInfo_i::remove_by_owner(
   DDS::DomainId_t domain,
   long              owner)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domain);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domain);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     return false;
   }
 
   std::vector<OpenDDS::DCPS::GUID_t> candidates;
-
-  for (DCPS_IR_Participant_Map::const_iterator
-       current = where->second->participants().begin();
-       current != where->second->participants().end();
-       ++current) {
-    if (current->second->owner() == owner) {
-      candidates.push_back(current->second->get_id());
+  {
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
+
+    for (DCPS_IR_Participant_Map::const_iterator
+         current = domainPtr->participants().begin();
+         current != domainPtr->participants().end();
+         ++current) {
+      if (current->second->owner() == owner) {
+        candidates.push_back(current->second->get_id());
+      }
     }
   }
 
@@ -1289,83 +1308,87 @@ TAO_DDS_DCPSInfo_i::remove_by_owner(
   bool status = true;
 
   for (unsigned int index = 0; index < candidates.size(); ++index) {
-    DCPS_IR_Participant* participant
-    = where->second->participant(candidates[index]);
-    if (participant) {
-      std::vector<OpenDDS::DCPS::GUID_t> keylist;
-
-      // Remove Subscriptions
-      for (DCPS_IR_Subscription_Map::const_iterator
-        current = participant->subscriptions().begin();
-        current != participant->subscriptions().end();
-        ++current) {
-        keylist.push_back(current->second->get_id());
-      }
+    {
+      ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), false);
+
+      DCPS_IR_Participant* participant
+      = domainPtr->participant(candidates[index]);
+      if (participant) {
+        std::vector<OpenDDS::DCPS::GUID_t> keylist;
+
+        // Remove Subscriptions
+        for (DCPS_IR_Subscription_Map::const_iterator
+          current = participant->subscriptions().begin();
+          current != participant->subscriptions().end();
+          ++current) {
+          keylist.push_back(current->second->get_id());
+        }
 
-      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
-        OpenDDS::DCPS::RepoIdConverter converter(candidates[index]);
-        ACE_DEBUG((LM_DEBUG,
-          ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::remove_by_owner: ")
-          ACE_TEXT("%d subscriptions to remove from participant %C.\n"),
-          keylist.size(),
-          std::string(converter).c_str()));
-      }
+        if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+          OpenDDS::DCPS::RepoIdConverter converter(candidates[index]);
+          ACE_DEBUG((LM_DEBUG,
+            ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::remove_by_owner: ")
+            ACE_TEXT("%d subscriptions to remove from participant %C.\n"),
+            keylist.size(),
+            std::string(converter).c_str()));
+        }
 
-      for (unsigned int key = 0; key < keylist.size(); ++key) {
-        if (participant->remove_subscription(keylist[key]) != 0) {
-          status = false;
+        for (unsigned int key = 0; key < keylist.size(); ++key) {
+          if (participant->remove_subscription(keylist[key]) != 0) {
+            status = false;
+          }
         }
-      }
 
-      // Remove Publications
-      keylist.clear();
+        // Remove Publications
+        keylist.clear();
 
-      for (DCPS_IR_Publication_Map::const_iterator
-        current = participant->publications().begin();
-        current != participant->publications().end();
-        ++current) {
-        keylist.push_back(current->second->get_id());
-      }
+        for (DCPS_IR_Publication_Map::const_iterator
+          current = participant->publications().begin();
+          current != participant->publications().end();
+          ++current) {
+          keylist.push_back(current->second->get_id());
+        }
 
-      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
-        OpenDDS::DCPS::RepoIdConverter converter(candidates[index]);
-        ACE_DEBUG((LM_DEBUG,
-          ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::remove_by_owner: ")
-          ACE_TEXT("%d publications to remove from participant %C.\n"),
-          keylist.size(),
-          std::string(converter).c_str()));
-      }
+        if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+          OpenDDS::DCPS::RepoIdConverter converter(candidates[index]);
+          ACE_DEBUG((LM_DEBUG,
+            ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::remove_by_owner: ")
+            ACE_TEXT("%d publications to remove from participant %C.\n"),
+            keylist.size(),
+            std::string(converter).c_str()));
+        }
 
-      for (unsigned int key = 0; key < keylist.size(); ++key) {
-        if (participant->remove_publication(keylist[key]) != 0) {
-          status = false;
+        for (unsigned int key = 0; key < keylist.size(); ++key) {
+          if (participant->remove_publication(keylist[key]) != 0) {
+            status = false;
+          }
         }
-      }
 
-      // Remove Topics
-      keylist.clear();
+        // Remove Topics
+        keylist.clear();
 
-      for (DCPS_IR_Topic_Map::const_iterator
-        current = participant->topics().begin();
-        current != participant->topics().end();
-        ++current) {
-        keylist.push_back(current->second->get_id());
-      }
+        for (DCPS_IR_Topic_Map::const_iterator
+          current = participant->topics().begin();
+          current != participant->topics().end();
+          ++current) {
+          keylist.push_back(current->second->get_id());
+        }
 
-      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
-        OpenDDS::DCPS::RepoIdConverter converter(candidates[index]);
-        ACE_DEBUG((LM_DEBUG,
-          ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::remove_by_owner: ")
-          ACE_TEXT("%d topics to remove from participant %C.\n"),
-          keylist.size(),
-          std::string(converter).c_str()));
-      }
+        if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+          OpenDDS::DCPS::RepoIdConverter converter(candidates[index]);
+          ACE_DEBUG((LM_DEBUG,
+            ACE_TEXT("(%P|%t) (bool)TAO_DDS_DCPSInfo_i::remove_by_owner: ")
+            ACE_TEXT("%d topics to remove from participant %C.\n"),
+            keylist.size(),
+            std::string(converter).c_str()));
+        }
 
-      for (unsigned int key = 0; key < keylist.size(); ++key) {
-        DCPS_IR_Topic* discard;
+        for (unsigned int key = 0; key < keylist.size(); ++key) {
+          DCPS_IR_Topic* discard;
 
-        if (participant->remove_topic_reference(keylist[key], discard) != 0) {
-          status = false;
+          if (participant->remove_topic_reference(keylist[key], discard) != 0) {
+            status = false;
+          }
         }
       }
     }
@@ -1383,14 +1406,16 @@ TAO_DDS_DCPSInfo_i::disassociate_participant(
   const OpenDDS::DCPS::GUID_t& local_id,
   const OpenDDS::DCPS::GUID_t& remote_id)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab the domain.
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  DCPS_IR_Domain_Map::iterator it(this->domains_.find(domainId));
-  if (it == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* participant = it->second->participant(local_id);
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
+  DCPS_IR_Participant* participant = domainPtr->participant(local_id);
   if (participant == 0) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -1408,7 +1433,7 @@ TAO_DDS_DCPSInfo_i::disassociate_participant(
     pub->second->disassociate_participant(remote_id, true);
   }
 
-  it->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void
@@ -1418,14 +1443,16 @@ TAO_DDS_DCPSInfo_i::disassociate_subscription(
   const OpenDDS::DCPS::GUID_t& local_id,
   const OpenDDS::DCPS::GUID_t& remote_id)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab the domain.
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  DCPS_IR_Domain_Map::iterator it(this->domains_.find(domainId));
-  if (it == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* participant = it->second->participant(participantId);
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
+  DCPS_IR_Participant* participant = domainPtr->participant(participantId);
   if (participant == 0) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -1450,7 +1477,7 @@ TAO_DDS_DCPSInfo_i::disassociate_subscription(
   // Disassociate from publication temporarily:
   subscription->disassociate_publication(remote_id, true);
 
-  it->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void
@@ -1460,14 +1487,16 @@ TAO_DDS_DCPSInfo_i::disassociate_publication(
   const OpenDDS::DCPS::GUID_t& local_id,
   const OpenDDS::DCPS::GUID_t& remote_id)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+  // Grab the domain.
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  DCPS_IR_Domain_Map::iterator it(this->domains_.find(domainId));
-  if (it == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* participant = it->second->participant(participantId);
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
+  DCPS_IR_Participant* participant = domainPtr->participant(participantId);
   if (participant == 0) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -1492,77 +1521,98 @@ TAO_DDS_DCPSInfo_i::disassociate_publication(
   // Disassociate from subscription temporarily:
   publication->disassociate_subscription(remote_id, true);
 
-  it->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::remove_domain_participant(
   DDS::DomainId_t domainId,
   const OpenDDS::DCPS::GUID_t& participantId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant_rch participant = where->second->participant_rch(participantId);
-  if (!participant) {
-    OpenDDS::DCPS::RepoIdConverter converter(participantId);
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) ERROR: (bool)TAO_DDS_DCPSInfo_i::remove_domain_participant: ")
-               ACE_TEXT("failed to locate participant %C in domain %d.\n"),
-               std::string(converter).c_str(),
-               domainId));
-    throw OpenDDS::DCPS::Invalid_Participant();
-  }
+  bool remove_domain = false;
+  bool cleanup_bits = false;
+  {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
+    DCPS_IR_Participant_rch participant = domainPtr->participant_rch(participantId);
+    if (!participant) {
+      OpenDDS::DCPS::RepoIdConverter converter(participantId);
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: (bool)TAO_DDS_DCPSInfo_i::remove_domain_participant: ")
+                 ACE_TEXT("failed to locate participant %C in domain %d.\n"),
+                 std::string(converter).c_str(),
+                 domainId));
+      throw OpenDDS::DCPS::Invalid_Participant();
+    }
 
-  // Determine if we should propagate this event;  we need to cache this
-  // result as the participant will be gone by the time we use the result.
-  bool sendUpdate = participant->isOwner() && !participant->isBitPublisher();
+    // Determine if we should propagate this event;  we need to cache this
+    // result as the participant will be gone by the time we use the result.
+    bool sendUpdate = participant->isOwner() && !participant->isBitPublisher();
 
-  CORBA::Boolean dont_notify_lost = 0;
-  int status = where->second->remove_participant(participantId, dont_notify_lost);
+    CORBA::Boolean dont_notify_lost = 0;
+    int status = domainPtr->remove_participant(participantId, dont_notify_lost);
 
-  if (0 != status) {
-    // Removing the participant failed
-    throw OpenDDS::DCPS::Invalid_Participant();
-  }
+    if (0 != status) {
+      // Removing the participant failed
+      throw OpenDDS::DCPS::Invalid_Participant();
+    }
 
-  // Update any concerned observers that the participant was destroyed.
-  if (this->um_ && sendUpdate) {
-    Update::IdPath path(
-      where->second->get_id(),
-      participantId,
-      participantId);
-    this->um_->destroy(path, Update::Participant);
+    // Update any concerned observers that the participant was destroyed.
+    if (this->um_ && sendUpdate) {
+      Update::IdPath path(
+        domainPtr->get_id(),
+        participantId,
+        participantId);
+      this->um_->destroy(path, Update::Participant);
 
-    if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-      OpenDDS::DCPS::RepoIdConverter converter(participantId);
-      ACE_DEBUG((LM_DEBUG,
-                 ACE_TEXT("(%P|%t) TAO_DDS_DCPSInfo_i::remove_domain_participant: ")
-                 ACE_TEXT("pushing deletion of participant %C in domain %d.\n"),
-                 std::string(converter).c_str(),
-                 domainId));
+      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+        OpenDDS::DCPS::RepoIdConverter converter(participantId);
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) TAO_DDS_DCPSInfo_i::remove_domain_participant: ")
+                   ACE_TEXT("pushing deletion of participant %C in domain %d.\n"),
+                   std::string(converter).c_str(),
+                   domainId));
+      }
     }
-  }
 
-  if (where->second->participants().empty()
+    remove_domain = domainPtr->participants().empty()
 #ifndef DDS_HAS_MINIMUM_BIT
-    && !(participant->isOwner() && participant->isBitPublisher() && in_cleanup_all_built_in_topics_)
-    // If this is false, we're running as part of cleanup_all_built_in_topics
-    // and we can't remove the domain because we would invalid the iterator
-    // we're using in cleanup_all_built_in_topics. cleanup_all_built_in_topics
-    // will clear the domains once it's done.
+      && !(participant->isOwner() && participant->isBitPublisher() && in_cleanup_all_built_in_topics_)
+      // If this is false, we're running as part of cleanup_all_built_in_topics
+      // and we can't remove the domain because we would invalid the iterator
+      // we're using in cleanup_all_built_in_topics. cleanup_all_built_in_topics
+      // will clear the domains once it's done.
 #endif
-    ) {
-    domains_.erase(where);
+      ;
+#ifndef DDS_HAS_MINIMUM_BIT
+    cleanup_bits = !remove_domain && domainPtr->useBIT() &&
+      domainPtr->participants().size() == 1;
+#endif
+  }
+
+  // The domain's lock has to be released before taking lock_ since other
+  // requests take them in that order.
+  if (remove_domain) {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, domain_guard, domainPtr->lock());
+
+    // Another participant could have been added in the meantime.
+    const DCPS_IR_Domain_Map::iterator where = domains_.find(domainId);
+    if (where != domains_.end() && where->second == domainPtr &&
+        domainPtr->participants().empty()) {
+      domains_.erase(where);
+    }
   }
 #ifndef DDS_HAS_MINIMUM_BIT
-  else if (where->second->useBIT() &&
-           where->second->participants().size() == 1) {
+  else if (cleanup_bits) {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
+
     // The only participant left is the one we created to publish BITs.
     // It can be removed now since no user participants exist in this domain,
     // but it has to be removed on the Service Participant's reactor thread
@@ -1589,8 +1639,12 @@ int TAO_DDS_DCPSInfo_i::BIT_Cleanup_Handler::handle_exception(ACE_HANDLE)
 
   const DCPS_IR_Domain_Map::iterator where = parent_->domains_.find(domain_);
 
-  if (where != parent_->domains_.end() && where->second->participants().size() == 1) {
-    where->second->cleanup_built_in_topics();
+  if (where != parent_->domains_.end()) {
+    const DCPS_IR_Domain_rch domain = where->second;
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, domain_guard, domain->lock(), 0);
+    if (domain->participants().size() == 1) {
+      domain->cleanup_built_in_topics();
+    }
   }
 
   done_ = true;
@@ -1605,18 +1659,18 @@ void TAO_DDS_DCPSInfo_i::ignore_domain_participant(
   const OpenDDS::DCPS::GUID_t& myParticipantId,
   const OpenDDS::DCPS::GUID_t& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1624,7 +1678,7 @@ void TAO_DDS_DCPSInfo_i::ignore_domain_participant(
 
   partPtr->ignore_participant(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::ignore_topic(
@@ -1632,18 +1686,18 @@ void TAO_DDS_DCPSInfo_i::ignore_topic(
   const OpenDDS::DCPS::GUID_t& myParticipantId,
   const OpenDDS::DCPS::GUID_t& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1651,7 +1705,7 @@ void TAO_DDS_DCPSInfo_i::ignore_topic(
 
   partPtr->ignore_topic(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::ignore_subscription(
@@ -1659,18 +1713,18 @@ void TAO_DDS_DCPSInfo_i::ignore_subscription(
   const OpenDDS::DCPS::GUID_t& myParticipantId,
   const OpenDDS::DCPS::GUID_t& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1678,7 +1732,7 @@ void TAO_DDS_DCPSInfo_i::ignore_subscription(
 
   partPtr->ignore_subscription(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 void TAO_DDS_DCPSInfo_i::ignore_publication(
@@ -1686,18 +1740,18 @@ void TAO_DDS_DCPSInfo_i::ignore_publication(
   const OpenDDS::DCPS::GUID_t& myParticipantId,
   const OpenDDS::DCPS::GUID_t& ignoreId)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(myParticipantId);
+  = domainPtr->participant(myParticipantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1705,7 +1759,7 @@ void TAO_DDS_DCPSInfo_i::ignore_publication(
 
   partPtr->ignore_publication(ignoreId);
 
-  where->second->remove_dead_participants();
+  domainPtr->remove_dead_participants();
 }
 
 CORBA::Boolean TAO_DDS_DCPSInfo_i::update_publication_qos(
@@ -1715,18 +1769,18 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_publication_qos(
   const DDS::DataWriterQos & qos,
   const DDS::PublisherQos & publisherQos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), 0);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1791,18 +1845,18 @@ TAO_DDS_DCPSInfo_i::update_publication_qos(
   const OpenDDS::DCPS::GUID_t& dwId,
   const DDS::DataWriterQos&  qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1835,18 +1889,18 @@ TAO_DDS_DCPSInfo_i::update_publication_qos(
   const OpenDDS::DCPS::GUID_t& dwId,
   const DDS::PublisherQos&   qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1879,18 +1933,18 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_subscription_qos(
   const DDS::DataReaderQos & qos,
   const DDS::SubscriberQos & subscriberQos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), 0);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1955,18 +2009,18 @@ TAO_DDS_DCPSInfo_i::update_subscription_qos(
   const OpenDDS::DCPS::GUID_t& drId,
   const DDS::DataReaderQos&  qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -1999,18 +2053,18 @@ TAO_DDS_DCPSInfo_i::update_subscription_qos(
   const OpenDDS::DCPS::GUID_t& drId,
   const DDS::SubscriberQos&  qos)
 {
-  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->lock_);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock());
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(partId);
+  = domainPtr->participant(partId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -2043,14 +2097,16 @@ TAO_DDS_DCPSInfo_i::update_subscription_params(
     const OpenDDS::DCPS::GUID_t& subscriptionId,
     const DDS::StringSeq& params)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
+  // Grab the domain.
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  DCPS_IR_Domain_Map::iterator domain = this->domains_.find(domainId);
-  if (domain == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
-  DCPS_IR_Participant* partPtr = domain->second->participant(participantId);
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), 0);
+
+  DCPS_IR_Participant* partPtr = domainPtr->participant(participantId);
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
   }
@@ -2087,18 +2143,18 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_topic_qos(
   const OpenDDS::DCPS::GUID_t& participantId,
   const DDS::TopicQos & qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), 0);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -2137,18 +2193,18 @@ CORBA::Boolean TAO_DDS_DCPSInfo_i::update_domain_participant_qos(
   const OpenDDS::DCPS::GUID_t& participantId,
   const DDS::DomainParticipantQos & qos)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, 0);
-
   // Grab the domain.
-  DCPS_IR_Domain_Map::iterator where = this->domains_.find(domainId);
+  const DCPS_IR_Domain_rch domainPtr = find_domain(domainId);
 
-  if (where == this->domains_.end()) {
+  if (!domainPtr) {
     throw OpenDDS::DCPS::Invalid_Domain();
   }
 
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, domainPtr->lock(), 0);
+
   // Grab the participant.
   DCPS_IR_Participant* partPtr
-  = where->second->participant(participantId);
+  = domainPtr->participant(participantId);
 
   if (0 == partPtr) {
     throw OpenDDS::DCPS::Invalid_Participant();
@@ -2533,6 +2589,14 @@ TAO_DDS_DCPSInfo_i::domains() const
   return this->domains_;
 }
 
+DCPS_IR_Domain_rch
+TAO_DDS_DCPSInfo_i::find_domain(DDS::DomainId_t domainId)
+{
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, DCPS_IR_Domain_rch());
+  const DCPS_IR_Domain_Map::const_iterator where = this->domains_.find(domainId);
+  return where == this->domains_.end() ? DCPS_IR_Domain_rch() : where->second;
+}
+
 
 char*
 TAO_DDS_DCPSInfo_i::dump_to_string()
@@ -2541,10 +2605,17 @@ TAO_DDS_DCPSInfo_i::dump_to_string()
 #if !defined (OPENDDS_INFOREPO_REDUCED_FOOTPRINT)
   std::string indent ("    ");
 
-  for (DCPS_IR_Domain_Map::const_iterator dm = domains_.begin();
-       dm != domains_.end();
+  DCPS_IR_Domain_Map domains;
+  {
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, CORBA::string_dup(""));
+    domains = this->domains_;
+  }
+
+  for (DCPS_IR_Domain_Map::const_iterator dm = domains.begin();
+       dm != domains.end();
        dm++)
   {
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, dm->second->lock(), CORBA::string_dup(""));
     dump += dm->second->dump_to_string(indent, 0);
   }
 #endif // !defined (OPENDDS_INFOREPO_REDUCED_FOOTPRINT)
@@ -2566,6 +2637,7 @@ void TAO_DDS_DCPSInfo_i::cleanup_all_built_in_topics()
   }
 
   for (DCPS_IR_Domain_Map::iterator it = copy.begin(); it != copy.end(); ++it) {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, it->second->lock());
     it->second->cleanup_built_in_topics();
   }
 
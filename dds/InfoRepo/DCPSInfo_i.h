@@ -33,7 +33,8 @@
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // typedef declarations
-typedef std::map<DDS::DomainId_t, OpenDDS::DCPS::RcHandle<DCPS_IR_Domain> > DCPS_IR_Domain_Map;
+typedef OpenDDS::DCPS::RcHandle<DCPS_IR_Domain> DCPS_IR_Domain_rch;
+typedef std::map<DDS::DomainId_t, DCPS_IR_Domain_rch> DCPS_IR_Domain_Map;
 
 // Forward declaration
 namespace Update {
@@ -419,6 +420,10 @@ public:
   void cleanup_all_built_in_topics();
 
 private:
+  /// Look up an existing domain, holding lock_ only for the lookup.  The
+  /// caller locks the domain itself for the rest of the request.
+  DCPS_IR_Domain_rch find_domain(DDS::DomainId_t domainId);
+
   DCPS_IR_Domain_Map domains_;
   CORBA::ORB_var orb_;
   CORBA::ORB_var dispatchingOrb_;
@@ -432,6 +437,8 @@ private:
   /// Interface to effect shutdown of the process.
   ShutdownInterface* shutdown_;
 
+  /// Protects domains_ and the participant Id generator.  Everything within
+  /// a domain is protected by the domain's own lock.
   ACE_Recursive_Thread_Mutex lock_;
 
   long reassociate_timer_id_;
@@ -455,7 +462,7 @@ private:
     bool done_;
   };
 
-  bool in_cleanup_all_built_in_topics_;
+  OpenDDS::DCPS::AtomicBool in_cleanup_all_built_in_topics_;
 #endif
 };
 
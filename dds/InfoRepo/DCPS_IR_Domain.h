@@ -24,6 +24,7 @@
 #include <dds/DdsDcpsCoreTypeSupportImpl.h>
 #endif // !defined (DDS_HAS_MINIMUM_BIT)
 
+#include <ace/Recursive_Thread_Mutex.h>
 #include <ace/Unbounded_Set.h>
 
 #include <set>
@@ -132,10 +133,12 @@ public:
 
   DDS::DomainId_t get_id();
 
-  /// Next Entity Id value in sequence.
+  /// Next Entity Id value in sequence.  The ids are shared by all domains,
+  /// so the caller holds the repository lock.
   OpenDDS::DCPS::GUID_t get_next_participant_id();
 
   /// Ensure no conflicts with sequence values from persistent storage.
+  /// The caller holds the repository lock.
   void last_participant_key(long key);
 
   /// Initialize the Built-In Topic structures
@@ -177,6 +180,12 @@ public:
 
   bool useBIT() const { return useBIT_; }
 
+  /// Held while handling a request for this domain.  Requests for the same
+  /// domain are serialized while requests for other domains proceed
+  /// concurrently.  The repository's lock is never acquired while holding
+  /// this one.
+  ACE_Recursive_Thread_Mutex& lock() { return lock_; }
+
 private:
   OpenDDS::DCPS::TopicStatus add_topic_i(OpenDDS::DCPS::GUID_t& topicId,
                                          const char * topicName,
@@ -241,6 +250,8 @@ private:
   /// indicates if the BuiltIn Topics are enabled
   OpenDDS::DCPS::AtomicBool useBIT_;
 
+  ACE_Recursive_Thread_Mutex lock_;
+
   ///@{
   /// Built-in Topic variables
   DDS::DomainParticipantFactory_var                bitParticipantFactory_;
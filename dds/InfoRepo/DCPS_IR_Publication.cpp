@@ -21,6 +21,8 @@
 
 #include /**/ "ace/OS_NS_unistd.h"
 
+#include <sstream>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 DCPS_IR_Publication::DCPS_IR_Publication(const OpenDDS::DCPS::GUID_t& id,
@@ -486,6 +488,7 @@ DCPS_IR_Publication::set_qos(const DDS::DataWriterQos& qos)
 
     // Store the new, compatible, value.
     this->qos_ = qos;
+    this->topic_->update_qos_index(this);
 
     if (check) {
       // This will remove any newly stale associations.
@@ -515,6 +518,7 @@ DCPS_IR_Publication::set_qos(const DDS::PublisherQos& qos)
 
     // Store the new, compatible, value.
     this->publisherQos_ = qos;
+    this->topic_->update_qos_index(this);
 
     if (check) {
       // This will remove any newly stale associations.
@@ -560,6 +564,10 @@ bool DCPS_IR_Publication::set_qos(const DDS::DataWriterQos & qos,
     publisherQos_ = publisherQos;
   }
 
+  if (u_dw_qos || u_pub_qos) {
+    topic_->update_qos_index(this);
+  }
+
   if (need_evaluate) {
     // Check if any existing association need be removed first.
     this->reevaluate_existing_associations();
@@ -586,6 +594,31 @@ OpenDDS::DCPS::TransportLocatorSeq DCPS_IR_Publication::get_transportLocatorSeq(
   return info_;
 }
 
+std::string DCPS_IR_Publication::qos_group_key() const
+{
+  std::ostringstream key;
+  for (CORBA::ULong i = 0; i < info_.length(); ++i) {
+    key << info_[i].transport_type.in() << ',';
+  }
+  key << ';' << qos_.reliability.kind
+      << ';' << qos_.durability.kind
+      << ';' << qos_.liveliness.kind
+      << ';' << qos_.liveliness.lease_duration.sec
+      << '.' << qos_.liveliness.lease_duration.nanosec
+      << ';' << qos_.deadline.period.sec
+      << '.' << qos_.deadline.period.nanosec
+      << ';' << qos_.latency_budget.duration.sec
+      << '.' << qos_.latency_budget.duration.nanosec
+      << ';' << qos_.ownership.kind << ';';
+  for (CORBA::ULong i = 0; i < qos_.representation.value.length(); ++i) {
+    key << qos_.representation.value[i] << ',';
+  }
+  key << ';' << publisherQos_.presentation.access_scope
+      << ';' << publisherQos_.presentation.coherent_access
+      << ';' << publisherQos_.presentation.ordered_access;
+  return key.str();
+}
+
 OpenDDS::DCPS::IncompatibleQosStatus* DCPS_IR_Publication::get_incompatibleQosStatus()
 {
   return &incompatibleQosStatus_;
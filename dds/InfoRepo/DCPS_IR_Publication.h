@@ -130,6 +130,11 @@ public:
   OpenDDS::DCPS::TransportLocatorSeq get_transportLocatorSeq() const;
   ACE_CDR::ULong get_transportContext() const { return transportContext_; }
 
+  /// Everything compatibleQOS checks besides the partition, as a string.
+  /// Publications with the same key have incompatible QoS with the same
+  /// subscriptions.
+  std::string qos_group_key() const;
+
   /// Return pointer to the incompatible qos status
   /// Publication retains ownership
   OpenDDS::DCPS::IncompatibleQosStatus* get_incompatibleQosStatus();
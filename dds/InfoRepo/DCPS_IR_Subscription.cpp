@@ -20,6 +20,8 @@
 
 #include /**/ "ace/OS_NS_unistd.h"
 
+#include <sstream>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 DCPS_IR_Subscription::DCPS_IR_Subscription(const OpenDDS::DCPS::GUID_t& id,
@@ -480,6 +482,31 @@ OpenDDS::DCPS::TransportLocatorSeq DCPS_IR_Subscription::get_transportLocatorSeq
   return info_;
 }
 
+std::string DCPS_IR_Subscription::qos_group_key() const
+{
+  std::ostringstream key;
+  for (CORBA::ULong i = 0; i < info_.length(); ++i) {
+    key << info_[i].transport_type.in() << ',';
+  }
+  key << ';' << qos_.reliability.kind
+      << ';' << qos_.durability.kind
+      << ';' << qos_.liveliness.kind
+      << ';' << qos_.liveliness.lease_duration.sec
+      << '.' << qos_.liveliness.lease_duration.nanosec
+      << ';' << qos_.deadline.period.sec
+      << '.' << qos_.deadline.period.nanosec
+      << ';' << qos_.latency_budget.duration.sec
+      << '.' << qos_.latency_budget.duration.nanosec
+      << ';' << qos_.ownership.kind << ';';
+  for (CORBA::ULong i = 0; i < qos_.representation.value.length(); ++i) {
+    key << qos_.representation.value[i] << ',';
+  }
+  key << ';' << subscriberQos_.presentation.access_scope
+      << ';' << subscriberQos_.presentation.coherent_access
+      << ';' << subscriberQos_.presentation.ordered_access;
+  return key.str();
+}
+
 OpenDDS::DCPS::IncompatibleQosStatus* DCPS_IR_Subscription::get_incompatibleQosStatus()
 {
   return &incompatibleQosStatus_;
@@ -507,6 +534,7 @@ DCPS_IR_Subscription::set_qos(const DDS::DataReaderQos& qos)
 
     // Store the new, compatible, value.
     this->qos_ = qos;
+    this->topic_->get_topic_description()->update_qos_index(this);
 
     if (check) {
       // This will remove any newly stale associations.
@@ -536,6 +564,7 @@ DCPS_IR_Subscription::set_qos(const DDS::SubscriberQos& qos)
 
     // Store the new, compatible, value.
     this->subscriberQos_ = qos;
+    this->topic_->get_topic_description()->update_qos_index(this);
 
     if (check) {
       // This will remove any newly stale associations.
@@ -581,6 +610,10 @@ bool DCPS_IR_Subscription::set_qos(const DDS::DataReaderQos & qos,
     subscriberQos_ = subscriberQos;
   }
 
+  if (u_dr_qos || u_sub_qos) {
+    topic_->get_topic_description()->update_qos_index(this);
+  }
+
   if (need_evaluate) {
     // Check if any existing association need be removed first.
     this->reevaluate_existing_associations();
@@ -61,6 +61,9 @@ int DCPS_IR_Topic::add_publication_reference(DCPS_IR_Publication* publication
 
   switch (status) {
   case 0:
+    publicationPartitions_.insert(publication,
+                                  publication->get_publisher_qos()->partition,
+                                  publication->qos_group_key());
 
     // Publish the BIT information
     domain_->publish_publication_bit(publication);
@@ -117,6 +120,8 @@ int DCPS_IR_Topic::remove_publication_reference(DCPS_IR_Publication* publication
   int status = publicationRefs_.remove(publication);
 
   if (0 == status) {
+    publicationPartitions_.remove(publication);
+
     if (OpenDDS::DCPS::DCPS_debug_level > 0) {
       OpenDDS::DCPS::RepoIdConverter topic_converter(id_);
       OpenDDS::DCPS::RepoIdConverter pub_converter(publication->get_id());
@@ -140,6 +145,15 @@ int DCPS_IR_Topic::remove_publication_reference(DCPS_IR_Publication* publication
   return status;
 }
 
+void DCPS_IR_Topic::update_qos_index(DCPS_IR_Publication* publication)
+{
+  if (publicationRefs_.find(publication) == 0) {
+    publicationPartitions_.insert(publication,
+                                  publication->get_publisher_qos()->partition,
+                                  publication->qos_group_key());
+  }
+}
+
 int DCPS_IR_Topic::add_subscription_reference(DCPS_IR_Subscription* subscription
                                               , bool associate)
 {
@@ -294,24 +308,47 @@ void DCPS_IR_Topic::try_associate(DCPS_IR_Subscription* subscription)
     }
 
   } else {
-    // check all publications for compatibility
-    DCPS_IR_Publication* pub = 0;
-    OpenDDS::DCPS::IncompatibleQosStatus* qosStatus = 0;
-
-    DCPS_IR_Publication_Set::ITERATOR iter = publicationRefs_.begin();
-    DCPS_IR_Publication_Set::ITERATOR end = publicationRefs_.end();
+    // check the publications that could be in a matching partition for
+    // compatibility, the others can only have incompatible QoS
+    PartitionIndex<DCPS_IR_Publication>::Entities candidates;
+    const bool indexed =
+      publicationPartitions_.candidates(subscription->get_subscriber_qos()->partition,
+                                        candidates);
+
+    if (!indexed) {
+      DCPS_IR_Publication_Set::ITERATOR iter = publicationRefs_.begin();
+      DCPS_IR_Publication_Set::ITERATOR end = publicationRefs_.end();
+
+      for (; iter != end; ++iter) {
+        description_->try_associate(*iter, subscription);
+        DCPS_IR_Topic_Description::update_incompatible_qos(*iter);
+      }
 
-    while (iter != end) {
-      pub = *iter;
-      ++iter;
-      description_->try_associate(pub, subscription);
-      // Check the publications QOS status
-      qosStatus = pub->get_incompatibleQosStatus();
+    } else {
+      typedef PartitionIndex<DCPS_IR_Publication>::Entities::const_iterator EntityIter;
+      for (EntityIter iter = candidates.begin(); iter != candidates.end(); ++iter) {
+        description_->try_associate(*iter, subscription);
+        DCPS_IR_Topic_Description::update_incompatible_qos(*iter);
+      }
 
-      if (0 < qosStatus->count_since_last_send) {
-        pub->update_incompatible_qos();
+      // The publications in a QoS group are either all compatible with the
+      // subscription or all incompatible, so only the incompatible groups
+      // have to be gone through.
+      typedef PartitionIndex<DCPS_IR_Publication>::QosGroups QosGroups;
+      const QosGroups& groups = publicationPartitions_.qos_groups();
+      for (QosGroups::const_iterator group = groups.begin(); group != groups.end(); ++group) {
+        if (!DCPS_IR_Topic_Description::has_incompatible_qos(*group->second.begin(),
+                                                             subscription)) {
+          continue;
+        }
+        for (EntityIter iter = group->second.begin(); iter != group->second.end(); ++iter) {
+          if (!candidates.count(*iter)) {
+            description_->check_incompatible_qos(*iter, subscription);
+            DCPS_IR_Topic_Description::update_incompatible_qos(*iter);
+          }
+        }
       }
-    } /* while (iter != end) */
+    }
 
     // The subscription QOS is not checked because
     // we don't know if the subscription is finished cycling
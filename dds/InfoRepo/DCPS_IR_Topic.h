@@ -9,6 +9,7 @@
 #define DCPS_IR_TOPIC_H
 
 #include  "inforepo_export.h"
+#include "PartitionIndex.h"
 #include /**/ "dds/DdsDcpsInfrastructureC.h"
 #include /**/ "dds/DdsDcpsTopicC.h"
 #include /**/ "dds/DCPS/InfoRepoDiscovery/InfoC.h"
@@ -70,6 +71,10 @@ public:
   /// Returns 0 if successful
   int remove_publication_reference(DCPS_IR_Publication* publication);
 
+  /// Called when the QoS of the publication or its publisher might have
+  /// changed.
+  void update_qos_index(DCPS_IR_Publication* publication);
+
   /// Adds the subscription to the list of subscriptions
   /// and let description handle the association.
   /// Returns 0 if added, 1 if already exists, -1 other failure
@@ -133,6 +138,8 @@ private:
   CORBA::Boolean isBIT_;
 
   DCPS_IR_Publication_Set publicationRefs_;
+  /// publicationRefs_ by the partition of their publisher and their QoS
+  PartitionIndex<DCPS_IR_Publication> publicationPartitions_;
   /// Keep track the subscriptions of this topic so the TopicQos
   /// change can be published for those subscriptions.
   DCPS_IR_Subscription_Set subscriptionRefs_;
@@ -42,6 +42,9 @@ int DCPS_IR_Topic_Description::add_subscription_reference(DCPS_IR_Subscription*
 
   switch (status) {
   case 0:
+    subscriptionPartitions_.insert(subscription,
+                                   subscription->get_subscriber_qos()->partition,
+                                   subscription->qos_group_key());
 
     // Publish the BIT information
     domain_->publish_subscription_bit(subscription);
@@ -92,6 +95,8 @@ int DCPS_IR_Topic_Description::remove_subscription_reference(DCPS_IR_Subscriptio
   int status = subscriptionRefs_.remove(subscription);
 
   if (0 == status) {
+    subscriptionPartitions_.remove(subscription);
+
     if (OpenDDS::DCPS::DCPS_debug_level > 0) {
       OpenDDS::DCPS::RepoIdConverter converter(subscription->get_id());
       ACE_DEBUG((LM_DEBUG,
@@ -113,6 +118,15 @@ int DCPS_IR_Topic_Description::remove_subscription_reference(DCPS_IR_Subscriptio
   return status;
 }
 
+void DCPS_IR_Topic_Description::update_qos_index(DCPS_IR_Subscription* subscription)
+{
+  if (subscriptionRefs_.find(subscription) == 0) {
+    subscriptionPartitions_.insert(subscription,
+                                   subscription->get_subscriber_qos()->partition,
+                                   subscription->qos_group_key());
+  }
+}
+
 int DCPS_IR_Topic_Description::add_topic(DCPS_IR_Topic* topic)
 {
   int status = topics_.insert(topic);
@@ -206,32 +220,48 @@ DCPS_IR_Topic* DCPS_IR_Topic_Description::get_first_topic()
 
 void DCPS_IR_Topic_Description::try_associate_publication(DCPS_IR_Publication* publication)
 {
-  // for each subscription check for compatibility
-  DCPS_IR_Subscription* subscription = 0;
-  OpenDDS::DCPS::IncompatibleQosStatus* qosStatus = 0;
-
-  DCPS_IR_Subscription_Set::ITERATOR iter = subscriptionRefs_.begin();
-  DCPS_IR_Subscription_Set::ITERATOR end = subscriptionRefs_.end();
-
-  while (iter != end) {
-    subscription = *iter;
-    ++iter;
-    try_associate(publication, subscription);
+  // for each subscription that could be in a matching partition check for
+  // compatibility, the others can only have incompatible QoS
+  PartitionIndex<DCPS_IR_Subscription>::Entities candidates;
+  const bool indexed =
+    subscriptionPartitions_.candidates(publication->get_publisher_qos()->partition,
+                                       candidates);
+
+  if (!indexed) {
+    DCPS_IR_Subscription_Set::ITERATOR iter = subscriptionRefs_.begin();
+    DCPS_IR_Subscription_Set::ITERATOR end = subscriptionRefs_.end();
+
+    for (; iter != end; ++iter) {
+      try_associate(publication, *iter);
+      update_incompatible_qos(*iter);
+    }
 
-    // Check the subscriptions QOS status
-    qosStatus = subscription->get_incompatibleQosStatus();
+  } else {
+    typedef PartitionIndex<DCPS_IR_Subscription>::Entities::const_iterator EntityIter;
+    for (EntityIter iter = candidates.begin(); iter != candidates.end(); ++iter) {
+      try_associate(publication, *iter);
+      update_incompatible_qos(*iter);
+    }
 
-    if (0 < qosStatus->count_since_last_send) {
-      subscription->update_incompatible_qos();
+    // The subscriptions in a QoS group are either all compatible with the
+    // publication or all incompatible, so only the incompatible groups
+    // have to be gone through.
+    typedef PartitionIndex<DCPS_IR_Subscription>::QosGroups QosGroups;
+    const QosGroups& groups = subscriptionPartitions_.qos_groups();
+    for (QosGroups::const_iterator group = groups.begin(); group != groups.end(); ++group) {
+      if (!has_incompatible_qos(publication, *group->second.begin())) {
+        continue;
+      }
+      for (EntityIter iter = group->second.begin(); iter != group->second.end(); ++iter) {
+        if (!candidates.count(*iter)) {
+          check_incompatible_qos(publication, *iter);
+          update_incompatible_qos(*iter);
+        }
+      }
     }
   }
 
-  // Check the publications QOS status
-  qosStatus = publication->get_incompatibleQosStatus();
-
-  if (0 < qosStatus->count_since_last_send) {
-    publication->update_incompatible_qos();
-  }
+  update_incompatible_qos(publication);
 }
 
 void DCPS_IR_Topic_Description::try_associate_subscription(DCPS_IR_Subscription* subscription)
@@ -336,6 +366,63 @@ DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
   return false;
 }
 
+void DCPS_IR_Topic_Description::check_incompatible_qos(DCPS_IR_Publication* publication,
+                                                       DCPS_IR_Subscription* subscription)
+{
+  if (publication->is_subscription_ignored(subscription->get_participant_id(),
+                                           subscription->get_topic_id(),
+                                           subscription->get_id()) ||
+      subscription->is_publication_ignored(publication->get_participant_id(),
+                                           publication->get_topic_id(),
+                                           publication->get_id())) {
+    return;
+  }
+
+  // compatibleQOS checks the partitions last, so this counts the same
+  // incompatibilities as when the pair was tried for association.
+  OpenDDS::DCPS::compatibleQOS(publication->get_incompatibleQosStatus(),
+                               subscription->get_incompatibleQosStatus(),
+                               publication->get_transportLocatorSeq(),
+                               subscription->get_transportLocatorSeq(),
+                               publication->get_datawriter_qos(),
+                               subscription->get_datareader_qos(),
+                               publication->get_publisher_qos(),
+                               subscription->get_subscriber_qos());
+}
+
+bool DCPS_IR_Topic_Description::has_incompatible_qos(DCPS_IR_Publication* publication,
+                                                     DCPS_IR_Subscription* subscription)
+{
+  // compatibleQOS returns false for unmatched partitions too, so look at
+  // what it counted instead.
+  OpenDDS::DCPS::IncompatibleQosStatus status;
+  status.total_count = 0;
+  status.count_since_last_send = 0;
+  status.last_policy_id = 0;
+  OpenDDS::DCPS::compatibleQOS(&status, 0,
+                               publication->get_transportLocatorSeq(),
+                               subscription->get_transportLocatorSeq(),
+                               publication->get_datawriter_qos(),
+                               subscription->get_datareader_qos(),
+                               publication->get_publisher_qos(),
+                               subscription->get_subscriber_qos());
+  return status.total_count > 0;
+}
+
+void DCPS_IR_Topic_Description::update_incompatible_qos(DCPS_IR_Publication* publication)
+{
+  if (0 < publication->get_incompatibleQosStatus()->count_since_last_send) {
+    publication->update_incompatible_qos();
+  }
+}
+
+void DCPS_IR_Topic_Description::update_incompatible_qos(DCPS_IR_Subscription* subscription)
+{
+  if (0 < subscription->get_incompatibleQosStatus()->count_since_last_send) {
+    subscription->update_incompatible_qos();
+  }
+}
+
 void DCPS_IR_Topic_Description::associate(DCPS_IR_Publication* publication,
                                           DCPS_IR_Subscription* subscription)
 {
@@ -9,6 +9,7 @@
 #define DCPS_IR_TOPIC_DESCRIPTION_H
 
 #include  "inforepo_export.h"
+#include "PartitionIndex.h"
 #include /**/ "ace/Unbounded_Set.h"
 #include /**/ "ace/SString.h"
 #include /**/ "tao/corbafwd.h"
@@ -61,6 +62,10 @@ public:
   /// Returns 0 if successful
   int remove_subscription_reference(DCPS_IR_Subscription* subscription);
 
+  /// Called when the QoS of the subscription or its subscriber might
+  /// have changed.
+  void update_qos_index(DCPS_IR_Subscription* subscription);
+
   /// Add a topic
   /// Takes ownership of memory pointed to by topic
   /// Returns 0 if added, 1 if already exists, -1 other failure
@@ -88,6 +93,21 @@ public:
   bool try_associate(DCPS_IR_Publication* publication,
                      DCPS_IR_Subscription* subscription);
 
+  /// Counts the incompatible QoS of a publication and subscription
+  ///  that can't be in a matching partition, the same as
+  ///  try_associate would.
+  void check_incompatible_qos(DCPS_IR_Publication* publication,
+                              DCPS_IR_Subscription* subscription);
+
+  /// Returns true if the publication and subscription have incompatible
+  ///  QoS, without counting it.  Their partitions are not looked at.
+  static bool has_incompatible_qos(DCPS_IR_Publication* publication,
+                                   DCPS_IR_Subscription* subscription);
+
+  /// Sends the incompatible QoS status if there is something new in it.
+  static void update_incompatible_qos(DCPS_IR_Publication* publication);
+  static void update_incompatible_qos(DCPS_IR_Subscription* subscription);
+
   /// Associate the publication and subscription
   void associate(DCPS_IR_Publication* publication,
                  DCPS_IR_Subscription* subscription);
@@ -114,6 +134,8 @@ private:
   DCPS_IR_Domain* domain_;
 
   DCPS_IR_Subscription_Set subscriptionRefs_;
+  /// subscriptionRefs_ by the partition of their subscriber and their QoS
+  PartitionIndex<DCPS_IR_Subscription> subscriptionPartitions_;
   DCPS_IR_Topic_Set topics_;
 };
 
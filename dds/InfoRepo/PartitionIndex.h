@@ -0,0 +1,168 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef PARTITION_INDEX_H
+#define PARTITION_INDEX_H
+
+#include /**/ "dds/DdsDcpsInfrastructureC.h"
+#include /**/ "dds/DCPS/DCPS_Utils.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class PartitionIndex
+ *
+ * @brief Publications or subscriptions of a topic by partition name and QoS
+ *
+ * Narrows down which entities could be in a matching partition with a new
+ * entity on the other side, so only those are tried for association.  The
+ * candidates may include entities that don't match; compatibleQOS still
+ * makes the final decision.
+ *
+ * The others are still checked for incompatible QoS, which is reported
+ * regardless of partitions.  For that the entities are also grouped by a key
+ * made of everything compatibleQOS looks at besides the partition (see
+ * DCPS_IR_Publication::qos_group_key), so one check per group tells if any
+ * of its entities has incompatible QoS.
+ *
+ * An empty partition list is indexed as the default partition "".  Entities
+ * with a wildcard partition name are candidates for everything.
+ */
+template <typename T>
+class PartitionIndex {
+public:
+  typedef std::set<T*> Entities;
+  typedef std::map<std::string, Entities> QosGroups;
+
+  /// Index the entity, replacing what it was indexed under before.
+  void insert(T* entity, const DDS::PartitionQosPolicy& partition,
+              const std::string& qos_key)
+  {
+    remove(entity);
+
+    Entry& entry = entries_[entity];
+    entry.qos_key = qos_key;
+    qos_groups_[qos_key].insert(entity);
+
+    std::vector<std::string>& names = entry.names;
+    if (has_wildcard(partition)) {
+      wildcards_.insert(entity);
+      return;
+    }
+
+    if (partition.name.length() == 0) {
+      names.push_back("");
+    } else {
+      for (CORBA::ULong i = 0; i < partition.name.length(); ++i) {
+        names.push_back(partition.name[i].in());
+      }
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+      by_name_[names[i]].insert(entity);
+    }
+  }
+
+  void remove(T* entity)
+  {
+    const typename EntryMap::iterator entry = entries_.find(entity);
+    if (entry == entries_.end()) {
+      return;
+    }
+
+    wildcards_.erase(entity);
+    const std::vector<std::string>& names = entry->second.names;
+    for (size_t i = 0; i < names.size(); ++i) {
+      erase(by_name_, names[i], entity);
+    }
+    erase(qos_groups_, entry->second.qos_key, entity);
+    entries_.erase(entry);
+  }
+
+  /// Add the entities that could be in a matching partition with an entity
+  /// on the other side that has this partition.  Returns false if the
+  /// partition has a wildcard, in which case every entity has to be checked.
+  bool candidates(const DDS::PartitionQosPolicy& partition, Entities& out) const
+  {
+    if (has_wildcard(partition)) {
+      return false;
+    }
+
+    out.insert(wildcards_.begin(), wildcards_.end());
+    if (partition.name.length() == 0) {
+      add_named("", out);
+    } else {
+      for (CORBA::ULong i = 0; i < partition.name.length(); ++i) {
+        add_named(partition.name[i].in(), out);
+      }
+    }
+    return true;
+  }
+
+  /// All the entities, grouped by their QoS key.
+  const QosGroups& qos_groups() const
+  {
+    return qos_groups_;
+  }
+
+private:
+  typedef std::map<std::string, Entities> ByName;
+
+  struct Entry {
+    std::vector<std::string> names;
+    std::string qos_key;
+  };
+  typedef std::map<T*, Entry> EntryMap;
+
+  static void erase(ByName& map, const std::string& key, T* entity)
+  {
+    const typename ByName::iterator iter = map.find(key);
+    if (iter != map.end()) {
+      iter->second.erase(entity);
+      if (iter->second.empty()) {
+        map.erase(iter);
+      }
+    }
+  }
+
+  static bool has_wildcard(const DDS::PartitionQosPolicy& partition)
+  {
+    for (CORBA::ULong i = 0; i < partition.name.length(); ++i) {
+      if (OpenDDS::DCPS::is_wildcard(partition.name[i])) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void add_named(const std::string& name, Entities& out) const
+  {
+    const typename ByName::const_iterator iter = by_name_.find(name);
+    if (iter != by_name_.end()) {
+      out.insert(iter->second.begin(), iter->second.end());
+    }
+  }
+
+  ByName by_name_;
+  /// Entities with a wildcard partition name
+  Entities wildcards_;
+  QosGroups qos_groups_;
+  /// What each entity is indexed under
+  EntryMap entries_;
+};
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* PARTITION_INDEX_H */
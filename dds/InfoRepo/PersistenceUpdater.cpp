@@ -14,265 +14,250 @@
 #include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/debug.h"
 
-#include "ace/Malloc_T.h"
-#include "ace/MMAP_Memory_Pool.h"
+#include "ace/ACE.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
 #include "ace/OS_NS_strings.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
 #include "ace/Svc_Handler.h"
 #include "ace/Dynamic_Service.h"
 
-#include <algorithm>
+#include <fstream>
+#include <iterator>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace {
-  void assign(Update::BinSeq& to, const Update::BinSeq& from,
-              Update::PersistenceUpdater::ALLOCATOR* allocator)
-  {
-    const size_t len = from.first;
-    void* out_buf;
-    ACE_ALLOCATOR(out_buf, allocator->malloc(len));
-    ACE_OS::memcpy(out_buf, from.second, len);
-    to = std::make_pair(len, static_cast<char*>(out_buf));
-  }
+  const char snapshot_magic[] = "ODDSIRS1";
+  const char log_magic[] = "ODDSIRL1";
+  const size_t magic_size = sizeof snapshot_magic - 1;
+  /// Magic and generation
+  const size_t file_header_size = magic_size + 8;
+  /// Payload length and CRC of the payload
+  const size_t record_header_size = 8;
+
+  enum RecordKind {
+    RECORD_TOPIC,
+    RECORD_PARTICIPANT,
+    RECORD_ACTOR,
+    RECORD_DESTROY,
+    RECORD_LAST_PART_ID
+  };
+
+  typedef std::vector<char> Bytes;
+
+  /// Appends values to a buffer in little-endian order, so the files can be
+  /// read on any host.
+  class Writer {
+  public:
+    explicit Writer(Bytes& out) : out_(out) {}
+
+    void octet(ACE_CDR::Octet value)
+    {
+      out_.push_back(static_cast<char>(value));
+    }
 
-  void assign(ACE_CString& to, const char* from,
-              Update::PersistenceUpdater::ALLOCATOR* allocator)
-  {
-    const size_t len = ACE_OS::strlen (from) + 1;
-    void* out_buf;
-    ACE_ALLOCATOR(out_buf, allocator->malloc(len));
-    ACE_OS::memcpy(out_buf, from, len);
-    to.set(static_cast<char*>(out_buf), len - 1, false);
-  }
-}
+    void ulong(ACE_CDR::ULong value)
+    {
+      for (int i = 0; i < 4; ++i) {
+        octet(static_cast<ACE_CDR::Octet>(value >> (8 * i)));
+      }
+    }
 
-namespace Update {
+    void ulonglong(ACE_UINT64 value)
+    {
+      for (int i = 0; i < 8; ++i) {
+        octet(static_cast<ACE_CDR::Octet>(value >> (8 * i)));
+      }
+    }
 
-// Template specializations with custom constructors
-// and cleanup methods
-template<>
-struct TopicStrt<QosSeq, ACE_CString> {
-  DDS::DomainId_t   domainId;
-  IdType            topicId;
-  IdType            participantId;
-  ACE_CString       name;
-  ACE_CString       dataType;
-  QosSeq            topicQos;
-
-  TopicStrt(const DTopic& topic,
-            PersistenceUpdater::ALLOCATOR* allocator)
-    : domainId(topic.domainId),
-      topicId(topic.topicId),
-      participantId(topic.participantId)
-  {
-    assign(name, topic.name.c_str(), allocator);
-    assign(dataType, topic.dataType.c_str(), allocator);
+    void raw(const char* data, size_t size)
+    {
+      out_.insert(out_.end(), data, data + size);
+    }
 
-    topicQos.first = TopicQos;
-    assign(topicQos.second, topic.topicQos.second, allocator);
-  }
+    void bytes(const Bytes& value)
+    {
+      ulong(static_cast<ACE_CDR::ULong>(value.size()));
+      out_.insert(out_.end(), value.begin(), value.end());
+    }
 
-  void cleanup(PersistenceUpdater::ALLOCATOR* allocator)
-  {
-    if (name.length() > 0)
+    void string(const std::string& value)
     {
-      char* strMemory = const_cast<char*>(name.fast_rep());
-      name.fast_clear();
-      allocator->free(strMemory);
+      ulong(static_cast<ACE_CDR::ULong>(value.size()));
+      raw(value.data(), value.size());
     }
-    if (dataType.length() > 0)
+
+    void guid(const Update::IdType& id)
     {
-      char* strMemory = const_cast<char*>(dataType.fast_rep());
-      dataType.fast_clear();
-      allocator->free(strMemory);
+      raw(reinterpret_cast<const char*>(&id), sizeof id);
     }
 
-    allocator->free(topicQos.second.second);
-  }
-};
-
-template<>
-struct ParticipantStrt<QosSeq> {
-  DDS::DomainId_t   domainId;
-  long              owner;
-  IdType            participantId;
-  QosSeq            participantQos;
-
-  ParticipantStrt(const DDS::DomainId_t& dId,
-                  long                   own,
-                  const IdType&          pId,
-                  const QosSeq&          pQos)
-    : domainId(dId),
-      owner(own),
-      participantId(pId),
-      participantQos(pQos) {}
-
-  ParticipantStrt(const DParticipant& participant,
-                  PersistenceUpdater::ALLOCATOR* allocator)
-    : domainId(participant.domainId),
-      owner(participant.owner),
-      participantId(participant.participantId)
-  {
-    participantQos.first = ParticipantQos;
-    assign(participantQos.second, participant.participantQos.second, allocator);
-  }
+  private:
+    Bytes& out_;
+  };
 
-  void cleanup(PersistenceUpdater::ALLOCATOR* allocator)
-  {
-    allocator->free(participantQos.second.second);
-  }
-};
-
-template<>
-struct ActorStrt<QosSeq, QosSeq,
-                 ACE_CString, BinSeq, ContentSubscriptionBin,
-                 BinSeq> {
-  DDS::DomainId_t   domainId;
-  IdType            actorId;
-  IdType            topicId;
-  IdType            participantId;
-  ActorType         type;
-  ACE_CString       callback;
-  QosSeq            pubsubQos;
-  QosSeq            drdwQos;
-  BinSeq            transportInterfaceInfo;
-  ACE_CDR::ULong    transportContext;
-  BinSeq            serializedTypeInfo;
-  ContentSubscriptionBin contentSubscriptionProfile;
-
-  ActorStrt(const DActor& actor,
-            PersistenceUpdater::ALLOCATOR* allocator)
-    : domainId(actor.domainId),
-      actorId(actor.actorId),
-      topicId(actor.topicId),
-      participantId(actor.participantId), type(actor.type)
-    , transportContext(actor.transportContext)
-  {
-    assign(callback, actor.callback.c_str(), allocator);
+  /// Reads what Writer wrote, failing instead of reading past the end.
+  class Reader {
+  public:
+    Reader(const char* data, size_t size) : pos_(data), end_(data + size) {}
 
-    pubsubQos.first = actor.pubsubQos.first;
-    assign(pubsubQos.second, actor.pubsubQos.second, allocator);
+    bool octet(ACE_CDR::Octet& value)
+    {
+      if (pos_ == end_) {
+        return false;
+      }
+      value = static_cast<ACE_CDR::Octet>(*pos_++);
+      return true;
+    }
 
-    drdwQos.first = actor.drdwQos.first;
-    assign(drdwQos.second, actor.drdwQos.second, allocator);
+    bool ulong(ACE_CDR::ULong& value)
+    {
+      value = 0;
+      for (int i = 0; i < 4; ++i) {
+        ACE_CDR::Octet o;
+        if (!octet(o)) {
+          return false;
+        }
+        value |= static_cast<ACE_CDR::ULong>(o) << (8 * i);
+      }
+      return true;
+    }
 
-    assign(transportInterfaceInfo, actor.transportInterfaceInfo, allocator);
+    bool ulonglong(ACE_UINT64& value)
+    {
+      value = 0;
+      for (int i = 0; i < 8; ++i) {
+        ACE_CDR::Octet o;
+        if (!octet(o)) {
+          return false;
+        }
+        value |= static_cast<ACE_UINT64>(o) << (8 * i);
+      }
+      return true;
+    }
 
-    contentSubscriptionProfile.filterClassName =
-      ACE_CString(actor.contentSubscriptionProfile.filterClassName.c_str(),
-                  allocator);
-    contentSubscriptionProfile.filterExpr =
-      ACE_CString(actor.contentSubscriptionProfile.filterExpr.c_str(),
-                  allocator);
-    assign(contentSubscriptionProfile.exprParams,
-      actor.contentSubscriptionProfile.exprParams, allocator);
-  }
+    bool bytes(Bytes& value)
+    {
+      ACE_CDR::ULong size;
+      if (!ulong(size) || size > static_cast<size_t>(end_ - pos_)) {
+        return false;
+      }
+      value.assign(pos_, pos_ + size);
+      pos_ += size;
+      return true;
+    }
 
-  void cleanup(PersistenceUpdater::ALLOCATOR* allocator)
-  {
-    if (callback.length() > 0)
+    bool string(std::string& value)
+    {
+      ACE_CDR::ULong size;
+      if (!ulong(size) || size > static_cast<size_t>(end_ - pos_)) {
+        return false;
+      }
+      value.assign(pos_, size);
+      pos_ += size;
+      return true;
+    }
+
+    bool guid(Update::IdType& id)
     {
-      char* strMemory = const_cast<char*>(callback.fast_rep());
-      callback.fast_clear();
-      allocator->free(strMemory);
+      if (sizeof id > static_cast<size_t>(end_ - pos_)) {
+        return false;
+      }
+      ACE_OS::memcpy(&id, pos_, sizeof id);
+      pos_ += sizeof id;
+      return true;
     }
 
-    allocator->free(pubsubQos.second.second);
-    allocator->free(drdwQos.second.second);
-    allocator->free(transportInterfaceInfo.second);
-    allocator->free(contentSubscriptionProfile.exprParams.second);
+  private:
+    const char* pos_;
+    const char* const end_;
+  };
+
+  void write_header(Bytes& out, const char* magic, ACE_UINT64 generation)
+  {
+    Writer writer(out);
+    writer.raw(magic, magic_size);
+    writer.ulonglong(generation);
   }
-};
 
-PersistenceUpdater::IdType_ExtId::IdType_ExtId()
-  : id_(OpenDDS::DCPS::GUID_UNKNOWN)
-{}
+  /// Returns false if data doesn't start with the header for magic.
+  bool read_header(const Bytes& data, const char* magic, ACE_UINT64& generation)
+  {
+    if (data.size() < file_header_size ||
+        ACE_OS::memcmp(&data[0], magic, magic_size) != 0) {
+      return false;
+    }
+    Reader reader(&data[magic_size], data.size() - magic_size);
+    return reader.ulonglong(generation);
+  }
 
-PersistenceUpdater::IdType_ExtId::IdType_ExtId(IdType id)
-  : id_(id)
-{}
+  void append_record(Bytes& out, const Bytes& payload)
+  {
+    Writer writer(out);
+    writer.ulong(static_cast<ACE_CDR::ULong>(payload.size()));
+    writer.ulong(ACE::crc32(&payload[0], payload.size()));
+    writer.raw(&payload[0], payload.size());
+  }
 
-PersistenceUpdater::IdType_ExtId::IdType_ExtId(const IdType_ExtId& ext)
-  : id_(ext.id_)
-{}
+  bool read_file(const std::string& path, Bytes& data)
+  {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+      return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+  }
 
-void
-PersistenceUpdater::IdType_ExtId::operator= (const IdType_ExtId& ext)
-{
-  id_ = ext.id_;
-}
+  bool write_all(ACE_HANDLE handle, const Bytes& data)
+  {
+    return data.empty() ||
+      ACE::write_n(handle, &data[0], data.size()) == static_cast<ssize_t>(data.size());
+  }
 
-bool
-PersistenceUpdater::IdType_ExtId::operator== (const IdType_ExtId& ext) const
-{
-  return (id_ == ext.id_);
+  template <typename T>
+  Bytes to_bytes(const T& value)
+  {
+    TAO_OutputCDR outCdr;
+    outCdr << value;
+    ACE_Message_Block dst;
+    ACE_CDR::consolidate(&dst, outCdr.begin());
+    return Bytes(dst.rd_ptr(), dst.rd_ptr() + dst.length());
+  }
+
+  /// The BinSeq refers to value, which has to outlive it.
+  Update::BinSeq to_bin(Bytes& value)
+  {
+    return Update::BinSeq(value.size(), value.empty() ? 0 : &value[0]);
+  }
 }
 
-unsigned long
-PersistenceUpdater::IdType_ExtId::hash() const
-{
-  return OpenDDS::DCPS::RepoIdConverter(id_).checksum();
-};
+namespace Update {
 
 PersistenceUpdater::PersistenceUpdater()
   : persistence_file_(ACE_TEXT("InforepoPersist"))
   , reset_(false)
+  , commit_interval_(100)
+  , snapshot_records_(10000)
   , um_(0)
-  , topic_index_(0)
-  , participant_index_(0)
-  , actor_index_(0)
+  , commit_cond_(lock_)
+  , shutdown_(false)
   , last_part_id_(0)
+  , log_handle_(ACE_INVALID_HANDLE)
+  , log_records_(0)
+  , generation_(0)
+  , unsynced_(false)
+  , snapshotting_(false)
 {}
 
 PersistenceUpdater::~PersistenceUpdater()
-{}
-
-// utility functions
-void* createIndex(const std::string& tag
-                  , PersistenceUpdater::ALLOCATOR& allocator
-                  , size_t size, bool& exists)
-{
-  void* index = 0;
-
-  // This is the easy case since if we find hash table in the
-  // memory-mapped file we know it's already initialized.
-  if (allocator.find(tag.c_str(), index) == 0) {
-    exists = true;
-    return index;
-
-  } else {
-    ACE_ALLOCATOR_RETURN(index, allocator.malloc(size), 0);
-
-    if (allocator.bind(tag.c_str(), index) == -1) {
-      allocator.free(index);
-      index = 0;
-    }
-  }
-
-  if (!index) {
-    ACE_ERROR((LM_ERROR,
-      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::init: ")
-      ACE_TEXT("Initial allocation/Bind failed for %C.\n"),
-      tag.c_str()));
-  }
-
-  return index;
-}
-
-template<typename I> void
-index_cleanup(I* index
-              , PersistenceUpdater::ALLOCATOR* allocator)
 {
-  for (typename I::ITERATOR iter = index->begin()
-                                   ; iter != index->end();) {
-    typename I::ITERATOR current_iter = iter;
-    iter++;
-
-    if (index->unbind((*current_iter).ext_id_, allocator) != 0) {
-      ACE_ERROR((LM_ERROR,
-        ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::init: ")
-        ACE_TEXT("Index unbind failed.\n")));
-    }
+  stop();
+  if (log_handle_ != ACE_INVALID_HANDLE) {
+    ACE_OS::close(log_handle_);
   }
 }
 
@@ -290,66 +275,15 @@ PersistenceUpdater::init(int argc, ACE_TCHAR *argv[])
 
   this->parse(argc, argv);
 
-#if defined ACE_HAS_MAC_OSX && defined __x86_64__ && __x86_64__
-  ACE_MMAP_Memory_Pool::OPTIONS options((void*)0x200000000);
-#else
-  ACE_MMAP_Memory_Pool::OPTIONS options(ACE_DEFAULT_BASE_ADDR);
-#endif
-
-  // Create the allocator with the appropriate options.  The name used
-  // for  the lock is the same as one used for the file.
-  ALLOCATOR* allocator;
-  ACE_NEW_RETURN(allocator,
-                 ALLOCATOR(persistence_file_.c_str(),
-                           persistence_file_.c_str(),
-                           &options),
-                 -1);
-  allocator_.reset(allocator);
-
-  bool exists = false;
-
-  char* topic_index = (char*)createIndex("TopicIndex", *allocator_
-                                         , sizeof(TopicIndex), exists);
-  if (!topic_index) {
+  if (!recover()) {
     return -1;
   }
 
-  char* participant_index = (char*)createIndex("ParticipantIndex", *allocator_
-                                               , sizeof(ParticipantIndex), exists);
-  if (!participant_index) {
-    return -1;
-  }
-
-  char* actor_index = (char*)createIndex("ActorIndex", *allocator_
-                                         , sizeof(ActorIndex), exists);
-  if (!actor_index) {
-    return -1;
-  }
-
-  void* last_part_id = createIndex(
-    "LastParticipantId", *allocator_, sizeof(PartIdType), exists);
-  if (!last_part_id) {
+  if (activate(THR_NEW_LWP | THR_JOINABLE, 1) == -1) {
+    ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::init ")
+               ACE_TEXT("could not start the commit thread.\n")));
     return -1;
   }
-  last_part_id_ = reinterpret_cast<PartIdType*>(last_part_id);
-
-  if (exists) {
-    topic_index_ = reinterpret_cast<TopicIndex*>(topic_index);
-    participant_index_ = reinterpret_cast<ParticipantIndex*>(participant_index);
-    actor_index_ = reinterpret_cast<ActorIndex*>(actor_index);
-  } else {
-    topic_index_ = new(topic_index) TopicIndex(allocator_.get());
-    participant_index_ = new(participant_index) ParticipantIndex(allocator_.get());
-    actor_index_ = new(actor_index) ActorIndex(allocator_.get());
-    *last_part_id_ = 0;
-  }
-
-  if (reset_) {
-    index_cleanup(topic_index_, allocator_.get());
-    index_cleanup(participant_index_, allocator_.get());
-    index_cleanup(actor_index_, allocator_.get());
-    *last_part_id_ = 0;
-  }
 
   // lastly register the callback
   um_->add(this);
@@ -379,6 +313,20 @@ PersistenceUpdater::parse(int argc, ACE_TCHAR *argv[])
         count++;
       }
 
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-commit")) == 0) {
+      if ((count + 1) < argc) {
+        const int val = ACE_OS::atoi(argv[count+1]);
+        commit_interval_ = val > 0 ? val : 1;
+        count++;
+      }
+
+    } else if (ACE_OS::strcasecmp(argv[count], ACE_TEXT("-snapshot")) == 0) {
+      if ((count + 1) < argc) {
+        const int val = ACE_OS::atoi(argv[count+1]);
+        snapshot_records_ = val > 0 ? val : 1;
+        count++;
+      }
+
     } else {
       ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) PersistenceUpdater::parse: Unknown option %s\n")
                  , argv[count]));
@@ -392,280 +340,577 @@ PersistenceUpdater::parse(int argc, ACE_TCHAR *argv[])
 int
 PersistenceUpdater::fini()
 {
+  if (um_) {
+    um_->remove(this);
+  }
+  stop();
+  commit();
   return 0;
 }
 
 int
 PersistenceUpdater::svc()
 {
+  ACE_Time_Value interval;
+  interval.msec(static_cast<long>(commit_interval_));
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, -1);
+  while (!shutdown_) {
+    const ACE_Time_Value deadline = ACE_OS::gettimeofday() + interval;
+    commit_cond_.wait(&deadline);
+
+    guard.release();
+    commit();
+    guard.acquire();
+  }
   return 0;
 }
 
 void
-PersistenceUpdater::requestImage()
+PersistenceUpdater::stop()
 {
-  if (um_ == NULL) {
-    return;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+    shutdown_ = true;
+    commit_cond_.signal();
   }
+  wait();
+}
 
-  DImage image;
+std::string
+PersistenceUpdater::snapshot_path() const
+{
+  return ACE_TEXT_ALWAYS_CHAR(persistence_file_.c_str());
+}
 
-  for (ParticipantIndex::ITERATOR iter = participant_index_->begin();
-       iter != participant_index_->end(); iter++) {
-    const PersistenceUpdater::Participant* participant = iter->int_id_;
+std::string
+PersistenceUpdater::log_path() const
+{
+  return snapshot_path() + ".log";
+}
 
-    const BinSeq& in_seq = participant->participantQos.second;
-    const QosSeq qos(ParticipantQos, in_seq);
-    const DParticipant dparticipant(participant->domainId
-                                    , participant->owner
-                                    , participant->participantId
-                                    , qos);
-    image.participants.push_back(dparticipant);
-    if (OpenDDS::DCPS::DCPS_debug_level >= 2)  {
-      OpenDDS::DCPS::RepoIdConverter conv(participant->participantId);
-      ACE_DEBUG((LM_DEBUG,
-        "(%P|%t) PersistenceUpdater::requestImage(): loaded participant %C\n",
-        OPENDDS_STRING(conv).c_str()));
+bool
+PersistenceUpdater::recover()
+{
+  const std::string snapshot = snapshot_path();
+  const std::string log = log_path();
+  if (reset_) {
+    ACE_OS::unlink(snapshot.c_str());
+    ACE_OS::unlink(log.c_str());
+  }
+
+  Bytes data;
+  size_t records = 0;
+  generation_ = 0;
+  if (read_file(snapshot, data)) {
+    if (!read_header(data, snapshot_magic, generation_)) {
+      ACE_ERROR((LM_ERROR,
+        ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::init: ")
+        ACE_TEXT("%C is not an InfoRepo snapshot, use -reset 1 to replace it.\n"),
+        snapshot.c_str()));
+      return false;
     }
+    replay(&data[file_header_size], data.size() - file_header_size, snapshot, records);
   }
 
-  for (TopicIndex::ITERATOR iter = topic_index_->begin();
-       iter != topic_index_->end(); iter++) {
-    const PersistenceUpdater::Topic* topic = iter->int_id_;
+  // A log with another generation was written before the snapshot, so
+  // everything in it is already in the snapshot, or it was left by an
+  // unrelated run that didn't leave a snapshot.
+  ACE_UINT64 log_generation = 0;
+  size_t log_records = 0;
+  if (read_file(log, data) && data.size() >= file_header_size) {
+    if (!read_header(data, log_magic, log_generation)) {
+      ACE_ERROR((LM_ERROR,
+        ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::init: ")
+        ACE_TEXT("%C is not an InfoRepo log, use -reset 1 to replace it.\n"),
+        log.c_str()));
+      return false;
+    }
+    if (log_generation == generation_) {
+      replay(&data[file_header_size], data.size() - file_header_size, log, log_records);
+    }
+  }
 
-    const BinSeq& in_seq = topic->topicQos.second;
-    const QosSeq qos(TopicQos, in_seq);
-    const DTopic dTopic(topic->domainId, topic->topicId
-                        , topic->participantId, topic->name.c_str()
-                        , topic->dataType.c_str(), qos);
-    image.topics.push_back(dTopic);
+  if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+    ACE_DEBUG((LM_DEBUG,
+      ACE_TEXT("(%P|%t) PersistenceUpdater::init: recovered %B snapshot ")
+      ACE_TEXT("and %B log records\n"), records, log_records));
   }
 
-  for (ActorIndex::ITERATOR iter = actor_index_->begin();
-       iter != actor_index_->end(); iter++) {
-    const PersistenceUpdater::RWActor* actor = iter->int_id_;
+  log_handle_ = ACE_OS::open(log.c_str(), O_RDWR | O_CREAT, ACE_DEFAULT_FILE_PERMS);
+  if (log_handle_ == ACE_INVALID_HANDLE) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::init: ")
+      ACE_TEXT("could not open %C: %p\n"), log.c_str(), ACE_TEXT("open")));
+    return false;
+  }
 
-    const BinSeq& in_pubsub_seq = actor->pubsubQos.second;
-    const QosSeq pubsub_qos(actor->pubsubQos.first, in_pubsub_seq);
+  // Start from a new snapshot so the log written by this run always has one
+  // with the same generation.  Generation 0 is never written, so a log left
+  // without its snapshot isn't replayed.
+  Bytes snapshot;
+  encode_snapshot(snapshot, generation_ + 1);
+  return write_snapshot(snapshot);
+}
 
-    const BinSeq& in_drdw_seq = actor->drdwQos.second;
-    const QosSeq drdw_qos(actor->drdwQos.first, in_drdw_seq);
+size_t
+PersistenceUpdater::replay(const char* data, size_t size,
+                           const std::string& path, size_t& records)
+{
+  size_t pos = 0;
+  while (pos + record_header_size <= size) {
+    Reader header(data + pos, record_header_size);
+    ACE_CDR::ULong length, crc;
+    if (!header.ulong(length) || !header.ulong(crc) ||
+        length > size - pos - record_header_size) {
+      break;
+    }
+    const char* const payload = data + pos + record_header_size;
+    if (ACE::crc32(payload, length) != crc || !apply(payload, length)) {
+      break;
+    }
+    pos += record_header_size + length;
+    ++records;
+  }
 
-    const BinSeq& in_transport_seq = actor->transportInterfaceInfo;
-    const BinSeq& in_type_info = actor->serializedTypeInfo;
+  if (pos != size) {
+    ACE_ERROR((LM_NOTICE,
+      ACE_TEXT("(%P|%t) NOTICE: PersistenceUpdater::init: ")
+      ACE_TEXT("ignoring %B bytes at the end of %C\n"), size - pos, path.c_str()));
+  }
+  return pos;
+}
 
-    ContentSubscriptionBin in_csp_bin;
-    if (actor->type == DataReader) {
-      in_csp_bin.filterClassName = actor->contentSubscriptionProfile.filterClassName;
-      in_csp_bin.filterExpr = actor->contentSubscriptionProfile.filterExpr;
-      in_csp_bin.exprParams = actor->contentSubscriptionProfile.exprParams;
-    }
+bool
+PersistenceUpdater::apply(const char* data, size_t size)
+{
+  Reader reader(data, size);
+  ACE_CDR::Octet kind;
+  IdType id;
+  if (!reader.octet(kind)) {
+    return false;
+  }
 
-    const DActor dActor(actor->domainId, actor->actorId, actor->topicId
-                        , actor->participantId
-                        , actor->type, actor->callback.c_str()
-                        , pubsub_qos, drdw_qos, in_transport_seq, actor->transportContext, in_csp_bin
-                        , in_type_info);
-    image.actors.push_back(dActor);
+  switch (kind) {
+  case RECORD_TOPIC: {
+    TopicRecord topic;
+    ACE_CDR::ULong domain;
+    if (!reader.guid(id) || !reader.ulong(domain) ||
+        !reader.guid(topic.participantId) || !reader.string(topic.name) ||
+        !reader.string(topic.dataType) || !reader.bytes(topic.topicQos)) {
+      return false;
+    }
+    topic.domainId = static_cast<DomainIdType>(domain);
+    topics_[id] = topic;
+    return true;
   }
+  case RECORD_PARTICIPANT: {
+    ParticipantRecord participant;
+    ACE_CDR::ULong domain, owner;
+    if (!reader.guid(id) || !reader.ulong(domain) || !reader.ulong(owner) ||
+        !reader.bytes(participant.participantQos)) {
+      return false;
+    }
+    participant.domainId = static_cast<DomainIdType>(domain);
+    participant.owner = static_cast<ACE_CDR::Long>(owner);
+    participants_[id] = participant;
+    return true;
+  }
+  case RECORD_ACTOR: {
+    ActorRecord actor;
+    ACE_CDR::ULong domain;
+    ACE_CDR::Octet type, pubsub_kind, drdw_kind;
+    if (!reader.guid(id) || !reader.ulong(domain) ||
+        !reader.guid(actor.topicId) || !reader.guid(actor.participantId) ||
+        !reader.octet(type) || !reader.string(actor.callback) ||
+        !reader.octet(pubsub_kind) || !reader.bytes(actor.pubsubQos) ||
+        !reader.octet(drdw_kind) || !reader.bytes(actor.drdwQos) ||
+        !reader.bytes(actor.transportInterfaceInfo) ||
+        !reader.ulong(actor.transportContext) ||
+        !reader.string(actor.filterClassName) || !reader.string(actor.filterExpr) ||
+        !reader.bytes(actor.exprParams) || !reader.bytes(actor.serializedTypeInfo)) {
+      return false;
+    }
+    actor.domainId = static_cast<DomainIdType>(domain);
+    actor.type = static_cast<ActorType>(type);
+    actor.pubsubQosKind = static_cast<SpecificQos>(pubsub_kind);
+    actor.drdwQosKind = static_cast<SpecificQos>(drdw_kind);
+    actors_[id] = actor;
+    return true;
+  }
+  case RECORD_DESTROY: {
+    ACE_CDR::Octet type;
+    if (!reader.octet(type) || !reader.guid(id)) {
+      return false;
+    }
+    switch (type) {
+    case Update::Topic:
+      topics_.erase(id);
+      break;
+    case Update::Participant:
+      participants_.erase(id);
+      break;
+    case Update::Actor:
+      actors_.erase(id);
+      break;
+    }
+    return true;
+  }
+  case RECORD_LAST_PART_ID: {
+    ACE_CDR::ULong part_id;
+    if (!reader.ulong(part_id)) {
+      return false;
+    }
+    last_part_id_ = static_cast<ACE_CDR::Long>(part_id);
+    return true;
+  }
+  }
+  return false;
+}
 
-  image.lastPartId = *last_part_id_;
+PersistenceUpdater::Bytes
+PersistenceUpdater::encode(const IdType& id, const TopicRecord& topic)
+{
+  Bytes payload;
+  Writer writer(payload);
+  writer.octet(RECORD_TOPIC);
+  writer.guid(id);
+  writer.ulong(static_cast<ACE_CDR::ULong>(topic.domainId));
+  writer.guid(topic.participantId);
+  writer.string(topic.name);
+  writer.string(topic.dataType);
+  writer.bytes(topic.topicQos);
+  return payload;
+}
 
-  um_->pushImage(image);
+PersistenceUpdater::Bytes
+PersistenceUpdater::encode(const IdType& id, const ParticipantRecord& participant)
+{
+  Bytes payload;
+  Writer writer(payload);
+  writer.octet(RECORD_PARTICIPANT);
+  writer.guid(id);
+  writer.ulong(static_cast<ACE_CDR::ULong>(participant.domainId));
+  writer.ulong(static_cast<ACE_CDR::ULong>(participant.owner));
+  writer.bytes(participant.participantQos);
+  return payload;
 }
 
-void
-PersistenceUpdater::create(const UTopic& topic)
+PersistenceUpdater::Bytes
+PersistenceUpdater::encode(const IdType& id, const ActorRecord& actor)
 {
-  // serialize the Topic QOS
-  TAO_OutputCDR outCdr;
-  outCdr << topic.topicQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
+  Bytes payload;
+  Writer writer(payload);
+  writer.octet(RECORD_ACTOR);
+  writer.guid(id);
+  writer.ulong(static_cast<ACE_CDR::ULong>(actor.domainId));
+  writer.guid(actor.topicId);
+  writer.guid(actor.participantId);
+  writer.octet(static_cast<ACE_CDR::Octet>(actor.type));
+  writer.string(actor.callback);
+  writer.octet(static_cast<ACE_CDR::Octet>(actor.pubsubQosKind));
+  writer.bytes(actor.pubsubQos);
+  writer.octet(static_cast<ACE_CDR::Octet>(actor.drdwQosKind));
+  writer.bytes(actor.drdwQos);
+  writer.bytes(actor.transportInterfaceInfo);
+  writer.ulong(actor.transportContext);
+  writer.string(actor.filterClassName);
+  writer.string(actor.filterExpr);
+  writer.bytes(actor.exprParams);
+  writer.bytes(actor.serializedTypeInfo);
+  return payload;
+}
 
-  const BinSeq qos_bin(dst.length(), dst.base());
+void
+PersistenceUpdater::encode_snapshot(Bytes& snapshot, ACE_UINT64 generation) const
+{
+  write_header(snapshot, snapshot_magic, generation);
 
-  const QosSeq p(TopicQos, qos_bin);
-  const DTopic topic_data(topic.domainId, topic.topicId, topic.participantId
-                          , topic.name.c_str(), topic.dataType.c_str(), p);
+  for (Participants::const_iterator iter = participants_.begin();
+       iter != participants_.end(); ++iter) {
+    append_record(snapshot, encode(iter->first, iter->second));
+  }
+  for (Topics::const_iterator iter = topics_.begin();
+       iter != topics_.end(); ++iter) {
+    append_record(snapshot, encode(iter->first, iter->second));
+  }
+  for (Actors::const_iterator iter = actors_.begin();
+       iter != actors_.end(); ++iter) {
+    append_record(snapshot, encode(iter->first, iter->second));
+  }
 
-  // allocate memory for TopicData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::Topic)));
+  Bytes payload;
+  Writer writer(payload);
+  writer.octet(RECORD_LAST_PART_ID);
+  writer.ulong(static_cast<ACE_CDR::ULong>(last_part_id_));
+  append_record(snapshot, payload);
+}
 
-  // Initialize TopicData
-  PersistenceUpdater::Topic* persistent_data
-  = new(buffer) PersistenceUpdater::Topic(topic_data, allocator_.get());
+void
+PersistenceUpdater::log_record(const Bytes& payload)
+{
+  Bytes record;
+  append_record(record, payload);
+  if (write_all(log_handle_, record)) {
+    ++log_records_;
+  } else {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::log_record: ")
+      ACE_TEXT("could not write %C: %p\n"), log_path().c_str(), ACE_TEXT("write")));
+    // Nothing written after a partial record would be recovered, so start
+    // over with a snapshot.
+    log_records_ = snapshot_records_;
+  }
 
-  IdType_ExtId ext(topic_data.topicId);
+  if (snapshotting_) {
+    snapshot_tail_.insert(snapshot_tail_.end(), record.begin(), record.end());
+  }
+  unsynced_ = true;
 
-  // bind TopicData with the topicId
-  if (topic_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
+  // Don't let a burst of changes wait for the commit interval to snapshot.
+  if (log_records_ >= snapshot_records_) {
+    commit_cond_.signal();
   }
 }
 
 void
-PersistenceUpdater::create(const UParticipant& participant)
+PersistenceUpdater::commit()
 {
-  // serialize the Topic QOS
-  TAO_OutputCDR outCdr;
-  outCdr << participant.participantQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
-
-  const BinSeq qos_bin(dst.length(), dst.base());
+  Bytes snapshot;
+  ACE_HANDLE handle;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+    if (log_records_ >= snapshot_records_) {
+      encode_snapshot(snapshot, generation_ + 1);
+      snapshotting_ = true;
+    } else if (!unsynced_) {
+      return;
+    }
+    unsynced_ = false;
+    handle = log_handle_;
+  }
 
-  QosSeq p(ParticipantQos, qos_bin);
-  DParticipant participant_data
-  (participant.domainId, participant.owner, participant.participantId, p);
+  if (!snapshot.empty() && write_snapshot(snapshot)) {
+    return;
+  }
 
-  // allocate memory for ParticipantData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::Participant)));
+  if (ACE_OS::fsync(handle) == -1) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::commit: ")
+      ACE_TEXT("could not sync %C: %p\n"), log_path().c_str(), ACE_TEXT("fsync")));
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+    log_records_ = snapshot_records_;
+  }
+}
 
-  // Initialize ParticipantData
-  PersistenceUpdater::Participant* persistent_data
-  = new(buffer) PersistenceUpdater::Participant(participant_data
-                                                , allocator_.get());
+bool
+PersistenceUpdater::write_snapshot(const Bytes& snapshot)
+{
+  // Write to a temporary file first so a crash never leaves a partially
+  // written snapshot.
+  const std::string path = snapshot_path();
+  const std::string tmp_path = path + ".tmp";
+  const ACE_HANDLE handle = ACE_OS::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                                         ACE_DEFAULT_FILE_PERMS);
+  if (handle == ACE_INVALID_HANDLE) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::write_snapshot: ")
+      ACE_TEXT("could not open %C: %p\n"), tmp_path.c_str(), ACE_TEXT("open")));
+  }
+  bool written = handle != ACE_INVALID_HANDLE && write_all(handle, snapshot);
+
+  // Changes logged while the snapshot was being written are only in the log,
+  // which is replaced below, so they go at the end of the snapshot.  Nothing
+  // else can be logged until the new log is started.
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, false);
+  written = written && write_all(handle, snapshot_tail_) && ACE_OS::fsync(handle) != -1;
+  snapshot_tail_.clear();
+  snapshotting_ = false;
+  if (handle != ACE_INVALID_HANDLE) {
+    ACE_OS::close(handle);
+  }
+  if (!written || ACE_OS::rename(tmp_path.c_str(), path.c_str()) == -1) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::write_snapshot: ")
+      ACE_TEXT("could not write %C: %p\n"), path.c_str(), ACE_TEXT("write")));
+    ACE_OS::unlink(tmp_path.c_str());
+    return false;
+  }
 
-  IdType_ExtId ext(participant_data.participantId);
+  // The snapshot has everything in the log, which is ignored from now on
+  // because its generation is older.
+  ++generation_;
+  if (!start_log(generation_)) {
+    log_records_ = snapshot_records_;
+    return false;
+  }
+  log_records_ = 0;
+  unsynced_ = false;
+  return true;
+}
 
-  // bind ParticipantData with the participantId
-  if (participant_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
+bool
+PersistenceUpdater::start_log(ACE_UINT64 generation)
+{
+  Bytes header;
+  write_header(header, log_magic, generation);
+  if (ACE_OS::ftruncate(log_handle_, 0) == -1 ||
+      ACE_OS::lseek(log_handle_, 0, SEEK_SET) == -1 ||
+      !write_all(log_handle_, header) || ACE_OS::fsync(log_handle_) == -1) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::start_log: ")
+      ACE_TEXT("could not write %C: %p\n"), log_path().c_str(), ACE_TEXT("write")));
+    return false;
   }
+  return true;
 }
 
 void
-PersistenceUpdater::create(const URActor& actor)
+PersistenceUpdater::requestImage()
 {
-  TAO_OutputCDR outCdr;
-  outCdr << actor.pubsubQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
-
-  const BinSeq pubsub_qos_bin(dst.length(), dst.base());
-  const QosSeq pubsub_qos(SubscriberQos, pubsub_qos_bin);
-
-  outCdr.reset();
-  outCdr << actor.drdwQos;
-  ACE_Message_Block dst2;
-  ACE_CDR::consolidate(&dst2, outCdr.begin());
+  if (um_ == NULL) {
+    return;
+  }
 
-  const BinSeq dwdr_qos_bin(dst2.length(), dst2.base());
-  const QosSeq dwdr_qos(DataReaderQos, dwdr_qos_bin);
+  // Pushing the image may call back into this updater, so it works on copies.
+  Topics topics;
+  Participants participants;
+  Actors actors;
+  DImage image;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+    topics = topics_;
+    participants = participants_;
+    actors = actors_;
+    image.lastPartId = last_part_id_;
+  }
 
-  outCdr.reset();
-  outCdr << actor.transportInterfaceInfo;
-  ACE_Message_Block dst3;
-  ACE_CDR::consolidate(&dst3, outCdr.begin());
+  for (Participants::iterator iter = participants.begin();
+       iter != participants.end(); ++iter) {
+    ParticipantRecord& participant = iter->second;
 
-  const BinSeq tr_bin(dst3.length(), dst3.base());
+    const QosSeq qos(ParticipantQos, to_bin(participant.participantQos));
+    const DParticipant dparticipant(participant.domainId
+                                    , participant.owner
+                                    , iter->first
+                                    , qos);
+    image.participants.push_back(dparticipant);
+    if (OpenDDS::DCPS::DCPS_debug_level >= 2)  {
+      OpenDDS::DCPS::RepoIdConverter conv(iter->first);
+      ACE_DEBUG((LM_DEBUG,
+        "(%P|%t) PersistenceUpdater::requestImage(): loaded participant %C\n",
+        OPENDDS_STRING(conv).c_str()));
+    }
+  }
 
-  outCdr.reset();
-  outCdr << actor.contentSubscriptionProfile.exprParams;
-  ACE_Message_Block dst4;
-  ACE_CDR::consolidate(&dst4, outCdr.begin());
+  for (Topics::iterator iter = topics.begin(); iter != topics.end(); ++iter) {
+    TopicRecord& topic = iter->second;
 
-  ContentSubscriptionBin csp_bin;
-  csp_bin.filterClassName = actor.contentSubscriptionProfile.filterClassName;
-  csp_bin.filterExpr = actor.contentSubscriptionProfile.filterExpr;
-  csp_bin.exprParams = std::make_pair(dst4.length(), dst4.base());
+    const QosSeq qos(TopicQos, to_bin(topic.topicQos));
+    const DTopic dTopic(topic.domainId, iter->first
+                        , topic.participantId, topic.name.c_str()
+                        , topic.dataType.c_str(), qos);
+    image.topics.push_back(dTopic);
+  }
 
-  outCdr.reset();
-  outCdr << actor.serializedTypeInfo;
-  ACE_Message_Block dst5;
-  ACE_CDR::consolidate(&dst5, outCdr.begin());
+  for (Actors::iterator iter = actors.begin(); iter != actors.end(); ++iter) {
+    ActorRecord& actor = iter->second;
 
-  const BinSeq ti_seq(dst5.length(), dst5.base());
+    const QosSeq pubsub_qos(actor.pubsubQosKind, to_bin(actor.pubsubQos));
+    const QosSeq drdw_qos(actor.drdwQosKind, to_bin(actor.drdwQos));
 
+    ContentSubscriptionBin in_csp_bin;
+    if (actor.type == DataReader) {
+      in_csp_bin.filterClassName = actor.filterClassName.c_str();
+      in_csp_bin.filterExpr = actor.filterExpr.c_str();
+      in_csp_bin.exprParams = to_bin(actor.exprParams);
+    }
 
-  const DActor actor_data(actor.domainId, actor.actorId, actor.topicId
-                          , actor.participantId
-                          , DataReader, actor.callback.c_str(), pubsub_qos
-                          , dwdr_qos, tr_bin, actor.transportContext, csp_bin
-                          , ti_seq);
+    const DActor dActor(actor.domainId, iter->first, actor.topicId
+                        , actor.participantId
+                        , actor.type, actor.callback.c_str()
+                        , pubsub_qos, drdw_qos, to_bin(actor.transportInterfaceInfo)
+                        , actor.transportContext, in_csp_bin
+                        , to_bin(actor.serializedTypeInfo));
+    image.actors.push_back(dActor);
+  }
 
-  // allocate memory for ActorData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::RWActor)));
+  um_->pushImage(image);
+}
 
-  // Initialize ActorData
-  PersistenceUpdater::RWActor* persistent_data =
-    new(buffer) PersistenceUpdater::RWActor(actor_data
-                                            , allocator_.get());
+void
+PersistenceUpdater::create(const UTopic& topic)
+{
+  TopicRecord record;
+  record.domainId = topic.domainId;
+  record.participantId = topic.participantId;
+  record.name = topic.name;
+  record.dataType = topic.dataType;
+  record.topicQos = to_bytes(topic.topicQos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  topics_[topic.topicId] = record;
+  log_record(encode(topic.topicId, record));
+}
 
-  IdType_ExtId ext(actor.actorId);
+void
+PersistenceUpdater::create(const UParticipant& participant)
+{
+  ParticipantRecord record;
+  record.domainId = participant.domainId;
+  record.owner = participant.owner;
+  record.participantQos = to_bytes(participant.participantQos);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  participants_[participant.participantId] = record;
+  log_record(encode(participant.participantId, record));
+}
 
-  // bind ActorData with the actorId
-  if (actor_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
-  }
+void
+PersistenceUpdater::create(const URActor& actor)
+{
+  ActorRecord record;
+  record.domainId = actor.domainId;
+  record.topicId = actor.topicId;
+  record.participantId = actor.participantId;
+  record.type = DataReader;
+  record.callback = actor.callback;
+  record.pubsubQosKind = SubscriberQos;
+  record.pubsubQos = to_bytes(actor.pubsubQos);
+  record.drdwQosKind = DataReaderQos;
+  record.drdwQos = to_bytes(actor.drdwQos);
+  record.transportInterfaceInfo = to_bytes(actor.transportInterfaceInfo);
+  record.transportContext = actor.transportContext;
+  record.filterClassName = actor.contentSubscriptionProfile.filterClassName.in();
+  record.filterExpr = actor.contentSubscriptionProfile.filterExpr.in();
+  record.exprParams = to_bytes(actor.contentSubscriptionProfile.exprParams);
+  record.serializedTypeInfo = to_bytes(actor.serializedTypeInfo);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  actors_[actor.actorId] = record;
+  log_record(encode(actor.actorId, record));
 }
 
 void
 PersistenceUpdater::create(const UWActor& actor)
 {
-  TAO_OutputCDR outCdr;
-  outCdr << actor.pubsubQos;
-  ACE_Message_Block dst;
-  ACE_CDR::consolidate(&dst, outCdr.begin());
-
-  const BinSeq pubsub_qos_bin(dst.length(), dst.base());
-  const QosSeq pubsub_qos(PublisherQos, pubsub_qos_bin);
-
-  outCdr.reset();
-  outCdr << actor.drdwQos;
-  ACE_Message_Block dst2;
-  ACE_CDR::consolidate(&dst2, outCdr.begin());
-
-  const BinSeq dwdr_qos_bin(dst2.length(), dst2.base());
-  const QosSeq dwdr_qos(DataWriterQos, dwdr_qos_bin);
-
-  outCdr.reset();
-  outCdr << actor.transportInterfaceInfo;
-  ACE_Message_Block dst3;
-  ACE_CDR::consolidate(&dst3, outCdr.begin());
-
-  const BinSeq tr_bin(dst3.length(), dst3.base());
-
-  outCdr.reset();
-  outCdr << actor.serializedTypeInfo;
-  ACE_Message_Block dst4;
-  ACE_CDR::consolidate(&dst4, outCdr.begin());
-
-  const BinSeq ti_seq(dst4.length(), dst4.base());
-
-  const DActor actor_data(actor.domainId, actor.actorId, actor.topicId
-                          , actor.participantId
-                          , DataWriter, actor.callback.c_str(), pubsub_qos
-                          , dwdr_qos, tr_bin, actor.transportContext, ContentSubscriptionBin()
-                          , ti_seq);
-
-  // allocate memory for ActorData
-  void* buffer;
-  ACE_ALLOCATOR(buffer, allocator_->malloc
-                (sizeof(PersistenceUpdater::RWActor)));
-
-  // Initialize ActorData
-  PersistenceUpdater::RWActor* persistent_data =
-    new(buffer) PersistenceUpdater::RWActor(actor_data
-                                            , allocator_.get());
-
-  IdType_ExtId ext(actor.actorId);
-
-  // bind ActorData with the actorId
-  if (actor_index_->bind(ext, persistent_data, allocator_.get()) != 0) {
-    allocator_->free((void *) buffer);
-    return;
-  }
+  ActorRecord record;
+  record.domainId = actor.domainId;
+  record.topicId = actor.topicId;
+  record.participantId = actor.participantId;
+  record.type = DataWriter;
+  record.callback = actor.callback;
+  record.pubsubQosKind = PublisherQos;
+  record.pubsubQos = to_bytes(actor.pubsubQos);
+  record.drdwQosKind = DataWriterQos;
+  record.drdwQos = to_bytes(actor.drdwQos);
+  record.transportInterfaceInfo = to_bytes(actor.transportInterfaceInfo);
+  record.transportContext = actor.transportContext;
+  record.serializedTypeInfo = to_bytes(actor.serializedTypeInfo);
+
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  actors_[actor.actorId] = record;
+  log_record(encode(actor.actorId, record));
 }
 
 void
@@ -677,16 +922,13 @@ PersistenceUpdater::create(const OwnershipData& /* data */)
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::DomainParticipantQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::Participant* part_data = 0;
-
-  if (this->participant_index_->find(ext, part_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+  const Bytes qos_bytes = to_bytes(qos);
 
-    this->storeUpdate(dst, part_data->participantQos.second);
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const Participants::iterator iter = participants_.find(id.id);
+  if (iter != participants_.end()) {
+    iter->second.participantQos = qos_bytes;
+    log_record(encode(iter->first, iter->second));
 
   } else {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -700,16 +942,13 @@ PersistenceUpdater::update(const IdPath& id, const DDS::DomainParticipantQos& qo
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::TopicQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::Topic* topic_data = 0;
-
-  if (this->topic_index_->find(ext, topic_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+  const Bytes qos_bytes = to_bytes(qos);
 
-    this->storeUpdate(dst, topic_data->topicQos.second);
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const Topics::iterator iter = topics_.find(id.id);
+  if (iter != topics_.end()) {
+    iter->second.topicQos = qos_bytes;
+    log_record(encode(iter->first, iter->second));
 
   } else {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -723,16 +962,13 @@ PersistenceUpdater::update(const IdPath& id, const DDS::TopicQos& qos)
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::DataWriterQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
+  const Bytes qos_bytes = to_bytes(qos);
 
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
-
-    this->storeUpdate(dst, actor_data->drdwQos.second);
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const Actors::iterator iter = actors_.find(id.id);
+  if (iter != actors_.end()) {
+    iter->second.drdwQos = qos_bytes;
+    log_record(encode(iter->first, iter->second));
 
   } else {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -746,16 +982,13 @@ PersistenceUpdater::update(const IdPath& id, const DDS::DataWriterQos& qos)
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::PublisherQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
-
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+  const Bytes qos_bytes = to_bytes(qos);
 
-    this->storeUpdate(dst, actor_data->pubsubQos.second);
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const Actors::iterator iter = actors_.find(id.id);
+  if (iter != actors_.end()) {
+    iter->second.pubsubQos = qos_bytes;
+    log_record(encode(iter->first, iter->second));
 
   } else {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -769,16 +1002,13 @@ PersistenceUpdater::update(const IdPath& id, const DDS::PublisherQos& qos)
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::DataReaderQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
-
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+  const Bytes qos_bytes = to_bytes(qos);
 
-    this->storeUpdate(dst, actor_data->drdwQos.second);
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const Actors::iterator iter = actors_.find(id.id);
+  if (iter != actors_.end()) {
+    iter->second.drdwQos = qos_bytes;
+    log_record(encode(iter->first, iter->second));
 
   } else {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -792,16 +1022,13 @@ PersistenceUpdater::update(const IdPath& id, const DDS::DataReaderQos& qos)
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::SubscriberQos& qos)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
-
-  if (this->actor_index_->find(ext, actor_data, this->allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << qos;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+  const Bytes qos_bytes = to_bytes(qos);
 
-    this->storeUpdate(dst, actor_data->pubsubQos.second);
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const Actors::iterator iter = actors_.find(id.id);
+  if (iter != actors_.end()) {
+    iter->second.pubsubQos = qos_bytes;
+    log_record(encode(iter->first, iter->second));
 
   } else {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -815,16 +1042,13 @@ PersistenceUpdater::update(const IdPath& id, const DDS::SubscriberQos& qos)
 void
 PersistenceUpdater::update(const IdPath& id, const DDS::StringSeq& exprParams)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::RWActor* actor_data = 0;
-
-  if (actor_index_->find(ext, actor_data, allocator_.get()) ==  0) {
-    TAO_OutputCDR outCdr;
-    outCdr << exprParams;
-    ACE_Message_Block dst;
-    ACE_CDR::consolidate(&dst, outCdr.begin());
+  const Bytes params_bytes = to_bytes(exprParams);
 
-    storeUpdate(dst, actor_data->contentSubscriptionProfile.exprParams);
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  const Actors::iterator iter = actors_.find(id.id);
+  if (iter != actors_.end()) {
+    iter->second.exprParams = params_bytes;
+    log_record(encode(iter->first, iter->second));
 
   } else {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -838,35 +1062,18 @@ PersistenceUpdater::update(const IdPath& id, const DDS::StringSeq& exprParams)
 void
 PersistenceUpdater::destroy(const IdPath& id, ItemType type, ActorType)
 {
-  IdType_ExtId ext(id.id);
-  PersistenceUpdater::Topic* topic = 0;
-  PersistenceUpdater::Participant* participant = 0;
-  PersistenceUpdater::RWActor* actor = 0;
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
 
+  bool erased = false;
   switch (type) {
   case Update::Topic:
-
-    if (topic_index_->unbind(ext, topic, allocator_.get()) == 0) {
-      topic->cleanup(allocator_.get());
-      allocator_->free((void *) topic);
-    }
-
+    erased = topics_.erase(id.id) != 0;
     break;
   case Update::Participant:
-
-    if (participant_index_->unbind(ext, participant, allocator_.get()) == 0) {
-      participant->cleanup(allocator_.get());
-      allocator_->free((void *) participant);
-    }
-
+    erased = participants_.erase(id.id) != 0;
     break;
   case Update::Actor:
-
-    if (actor_index_->unbind(ext, actor, allocator_.get()) == 0) {
-      actor->cleanup(allocator_.get());
-      allocator_->free((void *) actor);
-    }
-
+    erased = actors_.erase(id.id) != 0;
     break;
   default: {
     OpenDDS::DCPS::RepoIdConverter converter(id.id);
@@ -876,24 +1083,39 @@ PersistenceUpdater::destroy(const IdPath& id, ItemType type, ActorType)
                std::string(converter).c_str()));
   }
   }
-}
 
-void
-PersistenceUpdater::storeUpdate(const ACE_Message_Block& data, BinSeq& storage)
-{
-  size_t len = data.length();
-
-  void* buffer;
-  ACE_ALLOCATOR(buffer, this->allocator_->malloc(len));
-  ACE_OS::memcpy(buffer, data.base(), len);
-
-  storage.first  = len;
-  storage.second = static_cast<char*>(buffer);
+  if (erased) {
+    Bytes payload;
+    Writer writer(payload);
+    writer.octet(RECORD_DESTROY);
+    writer.octet(static_cast<ACE_CDR::Octet>(type));
+    writer.guid(id.id);
+    log_record(payload);
+  }
 }
 
 void PersistenceUpdater::updateLastPartId(PartIdType partId)
 {
-  *last_part_id_ = partId;
+  ACE_HANDLE handle;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+    last_part_id_ = partId;
+
+    Bytes payload;
+    Writer writer(payload);
+    writer.octet(RECORD_LAST_PART_ID);
+    writer.ulong(static_cast<ACE_CDR::ULong>(partId));
+    log_record(payload);
+    handle = log_handle_;
+  }
+
+  // Don't wait for the next commit.  If the id was lost in a crash, the
+  // reincarnated InfoRepo would give it to another participant.
+  if (ACE_OS::fsync(handle) == -1) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: PersistenceUpdater::updateLastPartId: ")
+      ACE_TEXT("could not sync %C: %p\n"), log_path().c_str(), ACE_TEXT("fsync")));
+  }
 }
 
 } // namespace Update
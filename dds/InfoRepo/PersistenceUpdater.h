@@ -12,16 +12,19 @@
 #include "Updater.h"
 
 #include "dds/DdsDcpsInfoUtilsC.h"
-#include "dds/DCPS/unique_ptr.h"
+#include "dds/DCPS/GuidUtils.h"
 
 #include "ace/Task.h"
-#include "ace/Hash_Map_With_Allocator_T.h"
-#include "ace/Malloc_T.h"
-#include "ace/MMAP_Memory_Pool.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Thread_Mutex.h"
 #include "ace/Service_Object.h"
 #include "ace/Service_Config.h"
 
+#include <map>
 #include <string>
+#include <vector>
+
+class DDS_TEST;
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -30,45 +33,23 @@ namespace Update {
 // Forward declaration
 class Manager;
 
+/**
+ * @class PersistenceUpdater
+ *
+ * @brief Persists the InfoRepo's entities so it can be restarted with -r
+ *
+ * Changes are applied to an in-memory copy of what is persisted and written
+ * to a write-ahead log, <file>.log, as they are made.  The svc() thread syncs
+ * the log every -commit milliseconds, so the InfoRepo doesn't wait on storage
+ * for each entity change.  Once -snapshot records have been logged, the svc()
+ * thread writes everything to a new snapshot, <file>, and the log is started
+ * over.  Recovery loads the snapshot and replays the short log tail, then
+ * writes a new snapshot and starts a new log.
+ *
+ * Changes made since the last sync can be lost if the host crashes, except
+ * for the last participant id, which is synced before it's used.
+ */
 class OpenDDS_InfoRepoLib_Export PersistenceUpdater : public Updater, public ACE_Task_Base {
-public:
-  class IdType_ExtId {
-  public:
-    IdType_ExtId();
-
-    IdType_ExtId(IdType id);
-
-    IdType_ExtId(const IdType_ExtId& ext);
-
-    void operator= (const IdType_ExtId& ext);
-
-    bool operator== (const IdType_ExtId& ext) const;
-
-    unsigned long hash() const;
-
-  private:
-    IdType id_;
-  };
-
-public:
-  typedef ACE_Allocator_Adapter <ACE_Malloc <ACE_MMAP_MEMORY_POOL
-  , TAO_SYNCH_MUTEX> > ALLOCATOR;
-
-  /// Persisted topic data structure
-  typedef struct TopicStrt <QosSeq, ACE_CString> Topic;
-
-  /// Persisted participant data structure
-  typedef struct ParticipantStrt <QosSeq> Participant;
-
-  /// Persisted actor data structure
-  typedef struct ActorStrt <QosSeq, QosSeq, ACE_CString,
-                            BinSeq, ContentSubscriptionBin,
-                            BinSeq> RWActor;
-
-  typedef ACE_Hash_Map_With_Allocator<IdType_ExtId, Topic*> TopicIndex;
-  typedef ACE_Hash_Map_With_Allocator<IdType_ExtId, Participant*> ParticipantIndex;
-  typedef ACE_Hash_Map_With_Allocator<IdType_ExtId, RWActor*> ActorIndex;
-
 public:
   PersistenceUpdater();
   virtual ~PersistenceUpdater();
@@ -130,27 +111,117 @@ public:
   virtual void updateLastPartId(PartIdType partId);
 
 private:
+  friend class ::DDS_TEST; // allows tests to get at privates
+
+  typedef std::vector<char> Bytes;
+
+  /// Persisted topic
+  struct TopicRecord {
+    DomainIdType domainId;
+    IdType participantId;
+    std::string name;
+    std::string dataType;
+    Bytes topicQos;
+  };
+
+  /// Persisted participant
+  struct ParticipantRecord {
+    DomainIdType domainId;
+    long owner;
+    Bytes participantQos;
+  };
+
+  /// Persisted reader or writer
+  struct ActorRecord {
+    DomainIdType domainId;
+    IdType topicId;
+    IdType participantId;
+    ActorType type;
+    std::string callback;
+    SpecificQos pubsubQosKind;
+    Bytes pubsubQos;
+    SpecificQos drdwQosKind;
+    Bytes drdwQos;
+    Bytes transportInterfaceInfo;
+    ACE_CDR::ULong transportContext;
+    std::string filterClassName;
+    std::string filterExpr;
+    Bytes exprParams;
+    Bytes serializedTypeInfo;
+  };
+
+  typedef std::map<IdType, TopicRecord, OpenDDS::DCPS::GUID_tKeyLessThan> Topics;
+  typedef std::map<IdType, ParticipantRecord, OpenDDS::DCPS::GUID_tKeyLessThan> Participants;
+  typedef std::map<IdType, ActorRecord, OpenDDS::DCPS::GUID_tKeyLessThan> Actors;
+
   int parse(int argc, ACE_TCHAR *argv[]);
-  void storeUpdate(const ACE_Message_Block& data, BinSeq& storage);
+
+  /// Load the snapshot and replay the log.
+  bool recover();
+  /// Apply the records in data until one is incomplete or corrupt.  Returns
+  /// how many bytes were applied.
+  size_t replay(const char* data, size_t size, const std::string& path,
+                size_t& records);
+  bool apply(const char* data, size_t size);
+
+  static Bytes encode(const IdType& id, const TopicRecord& topic);
+  static Bytes encode(const IdType& id, const ParticipantRecord& participant);
+  static Bytes encode(const IdType& id, const ActorRecord& actor);
+  /// Everything persisted, with the file header.  Called with lock_.
+  void encode_snapshot(Bytes& snapshot, ACE_UINT64 generation) const;
+
+  /// Write a change to the log.  Called with lock_.
+  void log_record(const Bytes& payload);
+
+  /// Sync the log, or write a snapshot if enough has been logged.  Called by
+  /// the svc() thread, and by fini() once it has stopped.
+  void commit();
+  /// Replace the snapshot with snapshot, plus anything logged while it was
+  /// being written, and start a new log.  Called without lock_.
+  bool write_snapshot(const Bytes& snapshot);
+  /// Called with lock_.
+  bool start_log(ACE_UINT64 generation);
+  std::string snapshot_path() const;
+  std::string log_path() const;
+  void stop();
 
   ACE_TString persistence_file_;
   bool reset_;
+  /// How often the log is synced in milliseconds
+  unsigned long commit_interval_;
+  /// How many records can be logged before a snapshot is written
+  size_t snapshot_records_;
 
   Manager *um_;
 
-  OpenDDS::DCPS::unique_ptr<ALLOCATOR> allocator_;
+  /// Protects the persisted entities and the log
+  ACE_Thread_Mutex lock_;
+  ACE_Condition_Thread_Mutex commit_cond_;
+  bool shutdown_;
 
   /// Persisted Topics
-  TopicIndex *topic_index_;
+  Topics topics_;
 
   /// Persisted Participants
-  ParticipantIndex *participant_index_;
+  Participants participants_;
 
   /// Persisted Readers and Writers
-  ActorIndex *actor_index_;
+  Actors actors_;
 
   /// What the last participant id is/was
-  PartIdType* last_part_id_;
+  PartIdType last_part_id_;
+
+  ACE_HANDLE log_handle_;
+  /// Records in the log since the last snapshot
+  size_t log_records_;
+  ACE_UINT64 generation_;
+  /// Records have been written to the log since it was last synced
+  bool unsynced_;
+
+  /// A snapshot is being written outside of lock_, so records logged in the
+  /// meantime are also kept in snapshot_tail_ to be added to it.
+  bool snapshotting_;
+  Bytes snapshot_tail_;
 };
 
 } // End of namespace Update
@@ -37,6 +37,8 @@ Manager::add(TAO_DDS_DCPSInfo_i* info)
 void
 Manager::add(Updater* updater)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // push new element to the back.
   updaters_.insert(updater);
 }
@@ -51,6 +53,8 @@ Manager::remove()
 void
 Manager::remove(const Updater* updater)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // check if the Updaters is part of the list.
   Updaters::iterator iter = updaters_.find(const_cast<Updater*>(updater));
 
@@ -303,6 +307,8 @@ Manager::pushImage(const DImage& image)
 void
 Manager::destroy(const IdPath& id, ItemType type, ActorType actor)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   // Invoke remove on each of the iterators.
   for (Updaters::iterator iter = updaters_.begin();
        iter != updaters_.end();
@@ -418,6 +424,8 @@ Manager::add(const DActor& actor)
 
 void Manager::updateLastPartId(PartIdType partId)
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+
   for (Updaters::iterator iter = updaters_.begin();
        iter != updaters_.end();
        iter++) {
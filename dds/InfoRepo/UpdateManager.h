@@ -17,6 +17,7 @@
 
 #include "tao/CDR.h"
 
+#include "ace/Recursive_Thread_Mutex.h"
 #include "ace/Service_Object.h"
 #include "ace/Service_Config.h"
 
@@ -87,6 +88,11 @@ private:
 
   TAO_DDS_DCPSInfo_i* info_;
   Updaters updaters_;
+
+  /// Serializes the updates propagated from different domains.  Not held
+  /// while passing persisted data to the InfoRepo, since the InfoRepo
+  /// propagates updates while holding a domain's lock.
+  ACE_Recursive_Thread_Mutex lock_;
 };
 
 } // End of namespace Update
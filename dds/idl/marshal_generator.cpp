@@ -22,6 +22,7 @@
 #include <iostream>
 #include <cctype>
 #include <map>
+#include <algorithm>
 
 #define OPENDDS_IDL_STR(X) #X
 
@@ -907,6 +908,8 @@ namespace {
     }
   }
 
+  bool plain_layout(AST_Type* type, size_t& size, size_t& align);
+
   void gen_array_i(
     UTL_ScopedName* name, AST_Array* arr, bool nested_key_only, const FieldInfo* anonymous = 0)
   {
@@ -932,6 +935,13 @@ namespace {
     const std::string cxx_elem =
       anonymous ? anonymous->scoped_elem_ : scoped(deepest_named_type(arr->base_type())->name());
     const ACE_CDR::ULong n_elems = array_element_count(arr);
+    size_t plain_size = 0, plain_align = 0;
+    const bool plain = !nested_key_only && (elem_cls & CL_STRUCTURE)
+      && plain_layout(elem, plain_size, plain_align);
+    string elem_suffix;
+    for (unsigned int i = 1; i < arr->n_dims(); ++i) {
+      elem_suffix += use_cxx11 ? "->data()" : "[0]";
+    }
 
     RefWrapper(base_wrapper).done().generate_tag();
 
@@ -1019,6 +1029,15 @@ namespace {
           "  return strm.write_" << getSerializerName(elem)
           << "_array(" << accessor << suffix << ", " << n_elems << ");\n";
       } else { // Enum, String, Struct, Array, Sequence, Union
+        if (plain) {
+          // The elements are contiguous and their C++ layout matches the serialized form.
+          be_global->impl_ <<
+            "  if (!strm.swap_bytes() && sizeof(" << cxx_elem << ") == " << plain_size << ") {\n"
+            "    return strm.align_w(" << plain_align << ")\n"
+            "      && strm.write_octet_array(reinterpret_cast<const ACE_CDR::Octet*>("
+              << accessor << elem_suffix << "), " << plain_size * n_elems << ");\n"
+            "  }\n";
+        }
         {
           string indent = "  ";
           NestedForLoops nfl("CORBA::ULong", "i", arr, indent);
@@ -1066,6 +1085,14 @@ namespace {
           "  return strm.read_" << getSerializerName(elem)
           << "_array(" << accessor << suffix << ", " << n_elems << ");\n";
       } else { // Enum, String, Struct, Array, Sequence, Union
+        if (plain) {
+          be_global->impl_ <<
+            "  if (!strm.swap_bytes() && sizeof(" << cxx_elem << ") == " << plain_size << ") {\n"
+            "    return strm.align_r(" << plain_align << ")\n"
+            "      && strm.read_octet_array(reinterpret_cast<ACE_CDR::Octet*>("
+              << accessor << elem_suffix << "), " << plain_size * n_elems << ");\n"
+            "  }\n";
+        }
         {
           string indent = "  ";
           NestedForLoops nfl("CORBA::ULong", "i", arr, indent);
@@ -1397,6 +1424,22 @@ namespace {
     }
   }
 
+  /**
+   * Prefix for the names of generated constants that are specific to an
+   * encoding kind.
+   */
+  const char* encoding_to_constant_prefix(Encoding::Kind encoding)
+  {
+    switch (encoding) {
+    case Encoding::KIND_XCDR1:
+      return "xcdr1_";
+    case Encoding::KIND_XCDR2:
+      return "xcdr2_";
+    default:
+      return "unaligned_cdr_";
+    }
+  }
+
   void align(Encoding::Kind encoding, size_t& value, size_t by)
   {
     const Encoding enc(encoding);
@@ -2163,14 +2206,10 @@ namespace {
     const std::string name = scoped(node->name());
     const ExtensibilityKind exten = be_global->extensibility(node);
 
-    be_global->header_ <<
-      "  static SerializedSizeBound " << function_prefix <<
-        "serialized_size_bound(const Encoding& encoding)\n"
-      "  {\n"
-      "    switch (encoding.kind()) {\n";
+    std::ostringstream constants, cases;
     for (unsigned e = 0; e <= Encoding::KIND_UNALIGNED_CDR; ++e) {
       const Encoding::Kind encoding = static_cast<Encoding::Kind>(e);
-      be_global->header_ <<
+      cases <<
         "    case " << encoding_to_encoding_kind(encoding) << ":\n"
         "      return SerializedSizeBound(";
       if (is_bounded_topic_struct(type_node, encoding, key_only, keys, info)) {
@@ -2186,10 +2225,24 @@ namespace {
             idl_max_serialized_size(encoding, size, (*i)->field_type());
           }
         }
-        be_global->header_ << size;
+        // Bounds are also available as constants so they can be used at
+        // compile time, for example to size a static buffer.
+        const std::string constant = std::string(encoding_to_constant_prefix(encoding)) +
+          function_prefix + "serialized_size_bound";
+        constants <<
+          "  static const size_t " << constant << " = " << size << ";\n";
+        cases << constant;
       }
-      be_global->header_ << ");\n";
+      cases << ");\n";
+    }
+    if (!constants.str().empty()) {
+      be_global->header_ << constants.str() << "\n";
     }
+    be_global->header_ <<
+      "  static SerializedSizeBound " << function_prefix <<
+        "serialized_size_bound(const Encoding& encoding)\n"
+      "  {\n"
+      "    switch (encoding.kind()) {\n" << cases.str();
     be_global->header_ <<
       "    default:\n"
       "      OPENDDS_ASSERT(false);\n"
@@ -2426,6 +2479,263 @@ namespace {
     return true;
   }
 
+  /**
+   * Returns true if the C++ representation of type is identical to its
+   * serialized form in every encoding when the byte order is native, so it can
+   * be copied in bulk.  This is the case for fixed-size primitives other than
+   * boolean and wchar, arrays of them, and final structs of those where each
+   * field is at an offset that's a multiple of its alignment, the first field
+   * has the largest alignment, and there is no tail padding.  Starting at an
+   * offset aligned for the first field then means no encoding inserts padding.
+   * size and align are set to the serialized size and the largest alignment.
+   */
+  bool plain_layout(AST_Type* type, size_t& size, size_t& align)
+  {
+    AST_Type* const actual = resolveActualType(type);
+    switch (actual->node_type()) {
+    case AST_Decl::NT_pre_defined:
+      switch (dynamic_cast<AST_PredefinedType*>(actual)->pt()) {
+      case AST_PredefinedType::PT_octet:
+      case AST_PredefinedType::PT_char:
+#if OPENDDS_HAS_EXPLICIT_INTS
+      case AST_PredefinedType::PT_int8:
+      case AST_PredefinedType::PT_uint8:
+#endif
+        size = 1;
+        break;
+      case AST_PredefinedType::PT_short:
+      case AST_PredefinedType::PT_ushort:
+        size = 2;
+        break;
+      case AST_PredefinedType::PT_long:
+      case AST_PredefinedType::PT_ulong:
+      case AST_PredefinedType::PT_float:
+        size = 4;
+        break;
+      case AST_PredefinedType::PT_longlong:
+      case AST_PredefinedType::PT_ulonglong:
+      case AST_PredefinedType::PT_double:
+        size = 8;
+        break;
+      default:
+        return false;
+      }
+      align = size;
+      return true;
+
+    case AST_Decl::NT_array:
+      {
+        AST_Array* const arr = dynamic_cast<AST_Array*>(actual);
+        if (!plain_layout(arr->base_type(), size, align)) {
+          return false;
+        }
+        size *= array_element_count(arr);
+        return size != 0;
+      }
+
+    case AST_Decl::NT_struct:
+      {
+        AST_Structure* const node = dynamic_cast<AST_Structure*>(actual);
+        if (be_global->extensibility(node) != extensibilitykind_final ||
+            scoped(node->name()).find(RtpsNamespace) == 0) {
+          return false;
+        }
+        const Fields fields(node);
+        size_t offset = 0, first_align = 0;
+        align = 0;
+        for (Fields::Iterator i = fields.begin(); i != fields.end(); ++i) {
+          AST_Field* const field = *i;
+          size_t field_size, field_align;
+          if (be_global->is_optional(field) || be_global->is_external(field) ||
+              !plain_layout(field->field_type(), field_size, field_align) ||
+              offset % field_align != 0) {
+            return false;
+          }
+          if (!first_align) {
+            first_align = field_align;
+          }
+          align = (std::max)(align, field_align);
+          offset += field_size;
+        }
+        if (!first_align || first_align != align || offset % align != 0) {
+          return false;
+        }
+        size = offset;
+        return true;
+      }
+
+    default:
+      return false;
+    }
+  }
+
+  /// Generate checks that the C++ layout of a plain_layout struct is what the
+  /// generator assumed.
+  std::string plain_layout_asserts(AST_Structure* node, const std::string& cpp_name, size_t size)
+  {
+    const bool use_cxx11 = be_global->language_mapping() == BE_GlobalData::LANGMAP_CXX11;
+    be_global->add_include("<cstddef>", BE_GlobalData::STREAM_CPP);
+    std::ostringstream asserts;
+    asserts <<
+      "#ifdef ACE_HAS_CPP11\n"
+      "  static_assert(sizeof(" << cpp_name << ") == " << size << ", \"unexpected size\");\n";
+    const Fields fields(node);
+    size_t offset = 0;
+    for (Fields::Iterator i = fields.begin(); i != fields.end(); ++i) {
+      AST_Field* const field = *i;
+      size_t field_size, field_align;
+      plain_layout(field->field_type(), field_size, field_align);
+      asserts <<
+        "  static_assert(offsetof(" << cpp_name << ", " << (use_cxx11 ? "_" : "")
+        << field->local_name()->get_string() << ") == " << offset << ", \"unexpected layout\");\n";
+      offset += field_size;
+    }
+    asserts << "#endif\n";
+    return asserts.str();
+  }
+
+  /**
+   * Adds the serialized size of type to size, starting from size, if it's the
+   * same for every value of the type.  Returns false if it depends on the
+   * value.  This has to match what the generated serialized_size functions
+   * compute, so it's limited to fixed-size primitives, enums, arrays of those,
+   * and final structs of those without optional or external members.
+   */
+  bool fixed_serialized_size(Encoding::Kind encoding, size_t& size, AST_Type* type)
+  {
+    AST_Type* const actual = resolveActualType(type);
+    const Classification cls = classify(actual);
+    if (cls & CL_ENUM) {
+      align(encoding, size, 4);
+      size += 4;
+      return true;
+    }
+
+    switch (actual->node_type()) {
+    case AST_Decl::NT_pre_defined:
+      {
+        size_t width = 0;
+        switch (dynamic_cast<AST_PredefinedType*>(actual)->pt()) {
+        case AST_PredefinedType::PT_boolean:
+        case AST_PredefinedType::PT_octet:
+        case AST_PredefinedType::PT_char:
+#if OPENDDS_HAS_EXPLICIT_INTS
+        case AST_PredefinedType::PT_int8:
+        case AST_PredefinedType::PT_uint8:
+#endif
+          width = 1;
+          break;
+        case AST_PredefinedType::PT_short:
+        case AST_PredefinedType::PT_ushort:
+          width = 2;
+          break;
+        case AST_PredefinedType::PT_long:
+        case AST_PredefinedType::PT_ulong:
+        case AST_PredefinedType::PT_float:
+          width = 4;
+          break;
+        case AST_PredefinedType::PT_longlong:
+        case AST_PredefinedType::PT_ulonglong:
+        case AST_PredefinedType::PT_double:
+          width = 8;
+          break;
+        default:
+          return false;
+        }
+        align(encoding, size, width);
+        size += width;
+        return true;
+      }
+
+    case AST_Decl::NT_array:
+      {
+        AST_Array* const arr = dynamic_cast<AST_Array*>(actual);
+        AST_Type* const elem = arr->base_type();
+        if (!(classify(resolveActualType(elem)) & CL_PRIMITIVE) &&
+            encoding == Encoding::KIND_XCDR2) {
+          align(encoding, size, 4);
+          size += 4;
+        }
+        size_t n = array_element_count(arr);
+        const size_t max_align = Encoding(encoding).max_align();
+        while (n > 0) {
+          const size_t prev = size;
+          if (!fixed_serialized_size(encoding, size, elem)) {
+            return false;
+          }
+          --n;
+          // Once an element ends at the same alignment it started at, the
+          // rest of them take the same space.
+          const size_t elem_size = size - prev;
+          if (!max_align || elem_size % max_align == 0) {
+            size += n * elem_size;
+            break;
+          }
+        }
+        return true;
+      }
+
+    case AST_Decl::NT_struct:
+      {
+        AST_Structure* const node = dynamic_cast<AST_Structure*>(actual);
+        if (be_global->extensibility(node) != extensibilitykind_final ||
+            scoped(node->name()).find(RtpsNamespace) == 0) {
+          return false;
+        }
+        const Fields fields(node);
+        for (Fields::Iterator i = fields.begin(); i != fields.end(); ++i) {
+          AST_Field* const field = *i;
+          if (be_global->is_optional(field) || be_global->is_external(field) ||
+              !fixed_serialized_size(encoding, size, field->field_type())) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+    default:
+      return false;
+    }
+  }
+
+  /**
+   * If the serialized size of the struct doesn't depend on its value, return
+   * code for serialized_size that skips walking the fields for the standard
+   * encodings.  The size has to be the same as walking the fields from any
+   * starting offset, once that offset is aligned for the encoding.
+   */
+  std::string fixed_serialized_size_code(AST_Structure* node)
+  {
+    std::ostringstream code;
+    for (unsigned e = 0; e <= Encoding::KIND_UNALIGNED_CDR; ++e) {
+      const Encoding::Kind encoding = static_cast<Encoding::Kind>(e);
+      const size_t max_align = Encoding(encoding).max_align();
+      size_t fixed_size = 0;
+      if (!fixed_serialized_size(encoding, fixed_size, node)) {
+        return "";
+      }
+      for (size_t start = 1; start < max_align; ++start) {
+        size_t size = start;
+        fixed_serialized_size(encoding, size, node);
+        if (size - start != fixed_size + (max_align - start)) {
+          return "";
+        }
+      }
+      code <<
+        "  if (encoding.xcdr_version() == " << encoding_to_xcdr_version(encoding) <<
+        " && encoding.max_align() == " << max_align << ") {\n";
+      if (max_align) {
+        code <<
+          "    encoding.align(size, " << max_align << ");\n";
+      }
+      code <<
+        "    size += " << fixed_size << ";\n"
+        "    return;\n"
+        "  }\n";
+    }
+    return code.str();
+  }
+
   bool generate_struct_deserialization(AST_Structure* node,
                                        FieldFilter field_filter)
   {
@@ -2486,6 +2796,15 @@ namespace {
           "\n";
       }
 
+      size_t plain_size, plain_align;
+      if (field_filter == FieldFilter_All && plain_layout(node, plain_size, plain_align)) {
+        be_global->impl_ <<
+          "  if (!strm.swap_bytes() && sizeof(stru) == " << plain_size << ") {\n"
+          "    return strm.align_r(" << plain_align << ")\n"
+          "      && strm.read_octet_array(reinterpret_cast<ACE_CDR::Octet*>(&stru), " << plain_size << ");\n"
+          "  }\n";
+      }
+
       if (is_mutable) {
         be_global->impl_ <<
           "  if (encoding.xcdr_version() != Encoding::XCDR_VERSION_NONE) {\n"
@@ -2766,6 +3085,10 @@ namespace {
       serialized_size.addArg("stru", const_cpp_name);
       serialized_size.endArgs();
 
+      if (field_filter == FieldFilter_All) {
+        be_global->impl_ << fixed_serialized_size_code(node);
+      }
+
       if (is_mutable) {
         /*
          * For parameter lists this is used to hold the total size while
@@ -2862,6 +3185,16 @@ namespace {
           "  }\n";
       }
 
+      size_t plain_size, plain_align;
+      if (field_filter == FieldFilter_All && plain_layout(node, plain_size, plain_align)) {
+        be_global->impl_ <<
+          plain_layout_asserts(node, actual_cpp_name, plain_size) <<
+          "  if (!strm.swap_bytes() && sizeof(stru) == " << plain_size << ") {\n"
+          "    return strm.align_w(" << plain_align << ")\n"
+          "      && strm.write_octet_array(reinterpret_cast<const ACE_CDR::Octet*>(&stru), " << plain_size << ");\n"
+          "  }\n";
+      }
+
       // Non-Mutable Code
       string expr;
       for (Fields::Iterator i = fields.begin(); i != fields_end; ++i) {
@@ -18,14 +18,22 @@ namespace DCPS {
 
 
 DRPeriodicMonitorImpl::DRPeriodicMonitorImpl(DataReaderImpl* dr,
-              OpenDDS::DCPS::DataReaderPeriodicReportDataWriter_ptr dr_per_writer)
+              OpenDDS::DCPS::DataReaderPeriodicReportDataWriter_ptr dr_per_writer,
+              const PeriodicReporter_rch& reporter)
   : dr_(dr),
-    dr_per_writer_(DataReaderPeriodicReportDataWriter::_duplicate(dr_per_writer))
+    dr_per_writer_(DataReaderPeriodicReportDataWriter::_duplicate(dr_per_writer)),
+    reporter_(reporter)
 {
+  if (reporter_) {
+    reporter_->add(this);
+  }
 }
 
 DRPeriodicMonitorImpl::~DRPeriodicMonitorImpl()
 {
+  if (reporter_) {
+    reporter_->remove(this);
+  }
 }
 
 void
@@ -33,7 +41,23 @@ DRPeriodicMonitorImpl::report() {
   if (!CORBA::is_nil(this->dr_per_writer_.in())) {
     DataReaderPeriodicReport report;
     report.dr_id   = dr_->get_guid();
-    //report.associations = dr_->
+    DataReaderImpl::LatencySummaryPairVec summaries;
+    dr_->get_latency_summaries(summaries);
+    CORBA::ULong length = 0;
+    report.associations.length(static_cast<CORBA::ULong>(summaries.size()));
+    for (DataReaderImpl::LatencySummaryPairVec::iterator iter = summaries.begin();
+         iter != summaries.end();
+         ++iter) {
+      DataReaderAssociationPeriodic& association = report.associations[length++];
+      association.dw_id = iter->first;
+      // Not tracked per writer
+      association.samples_available = 0;
+      association.latency.n = iter->second.count;
+      association.latency.p50 = iter->second.p50.to_double();
+      association.latency.p99 = iter->second.p99.to_double();
+      association.latency.p99_9 = iter->second.p999.to_double();
+      association.latency.maximum = iter->second.maximum.to_double();
+    }
     this->dr_per_writer_->write(report, DDS::HANDLE_NIL);
   }
 }
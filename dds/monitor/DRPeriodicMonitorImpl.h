@@ -9,6 +9,7 @@
 #define OPENDDS_MONITOR_DRPERIODICMONITORIMPL_H
 
 #include "monitor_export.h"
+#include "PeriodicReporter.h"
 #include "dds/DCPS/MonitorFactory.h"
 #include "monitorTypeSupportImpl.h"
 
@@ -24,13 +25,15 @@ namespace DCPS {
 class DRPeriodicMonitorImpl : public Monitor {
 public:
   DRPeriodicMonitorImpl(DataReaderImpl* dr,
-                   OpenDDS::DCPS::DataReaderPeriodicReportDataWriter_ptr dr_per_writer);
+                   OpenDDS::DCPS::DataReaderPeriodicReportDataWriter_ptr dr_per_writer,
+                   const PeriodicReporter_rch& reporter);
   virtual ~DRPeriodicMonitorImpl();
   virtual void report();
 
 private:
   DataReaderImpl* dr_;
   OpenDDS::DCPS::DataReaderPeriodicReportDataWriter_var dr_per_writer_;
+  const PeriodicReporter_rch reporter_;
 };
 
 } // namespace DCPS
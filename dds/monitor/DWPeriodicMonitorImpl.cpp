@@ -17,14 +17,22 @@ namespace OpenDDS {
 namespace DCPS {
 
 DWPeriodicMonitorImpl::DWPeriodicMonitorImpl(DataWriterImpl* dw,
-              OpenDDS::DCPS::DataWriterPeriodicReportDataWriter_ptr dw_per_writer)
+              OpenDDS::DCPS::DataWriterPeriodicReportDataWriter_ptr dw_per_writer,
+              const PeriodicReporter_rch& reporter)
   : dw_(dw),
-    dw_per_writer_(DataWriterPeriodicReportDataWriter::_duplicate(dw_per_writer))
+    dw_per_writer_(DataWriterPeriodicReportDataWriter::_duplicate(dw_per_writer)),
+    reporter_(reporter)
 {
+  if (reporter_) {
+    reporter_->add(this);
+  }
 }
 
 DWPeriodicMonitorImpl::~DWPeriodicMonitorImpl()
 {
+  if (reporter_) {
+    reporter_->remove(this);
+  }
 }
 
 void
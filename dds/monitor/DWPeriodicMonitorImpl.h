@@ -9,6 +9,7 @@
 #define OPENDDS_MONITOR_DWPERIODICMONITORIMPL_H
 
 #include "monitor_export.h"
+#include "PeriodicReporter.h"
 #include "dds/DCPS/MonitorFactory.h"
 #include "monitorTypeSupportImpl.h"
 
@@ -24,13 +25,15 @@ namespace DCPS {
 class DWPeriodicMonitorImpl : public Monitor {
 public:
   DWPeriodicMonitorImpl(DataWriterImpl* dw,
-                   OpenDDS::DCPS::DataWriterPeriodicReportDataWriter_ptr dw_per_writer);
+                   OpenDDS::DCPS::DataWriterPeriodicReportDataWriter_ptr dw_per_writer,
+                   const PeriodicReporter_rch& reporter);
   virtual ~DWPeriodicMonitorImpl();
   virtual void report();
 
 private:
   DataWriterImpl* dw_;
   OpenDDS::DCPS::DataWriterPeriodicReportDataWriter_var dw_per_writer_;
+  const PeriodicReporter_rch reporter_;
 };
 
 } // namespace DCPS
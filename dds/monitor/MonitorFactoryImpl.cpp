@@ -90,7 +90,7 @@ MonitorFactoryImpl::create_data_writer_monitor(DataWriterImpl* dw)
 OpenDDS::DCPS::Monitor*
 MonitorFactoryImpl::create_data_writer_periodic_monitor(DataWriterImpl* dw)
 {
-  return new DWPeriodicMonitorImpl(dw, this->dw_per_writer_);
+  return new DWPeriodicMonitorImpl(dw, this->dw_per_writer_, reporter_);
 }
 
 OpenDDS::DCPS::Monitor*
@@ -102,13 +102,13 @@ MonitorFactoryImpl::create_data_reader_monitor(DataReaderImpl* dr)
 OpenDDS::DCPS::Monitor*
 MonitorFactoryImpl::create_data_reader_periodic_monitor(DataReaderImpl* dr)
 {
-  return new DRPeriodicMonitorImpl(dr, this->dr_per_writer_);
+  return new DRPeriodicMonitorImpl(dr, this->dr_per_writer_, reporter_);
 }
 
 OpenDDS::DCPS::Monitor*
 MonitorFactoryImpl::create_transport_monitor(TransportImpl* transport)
 {
-  return new TransportMonitorImpl(transport, this->transport_writer_);
+  return new TransportMonitorImpl(transport, this->transport_writer_, reporter_);
 }
 
 DDS::DataWriter_ptr
@@ -372,10 +372,23 @@ MonitorFactoryImpl::initialize()
   } else {
     ACE_DEBUG((LM_DEBUG, "MonitorFactoryImpl::initialize(): Failed to register transport_ts\n"));
   }
+
+  // Created last so the monitor's own writers aren't reported
+  reporter_ = make_rch<PeriodicReporter>(TheServiceParticipant->reactor_task());
+  const TimeDuration period = TheServiceParticipant->config_store()->get(
+    COMMON_DCPS_MONITOR_PERIOD, COMMON_DCPS_MONITOR_PERIOD_default, ConfigStoreImpl::Format_IntegerMilliseconds);
+  if (period > TimeDuration::zero_value) {
+    reporter_->enable(false, period);
+  }
 }
 
 void MonitorFactoryImpl::deinitialize()
 {
+  if (reporter_) {
+    reporter_->disable();
+    reporter_.reset();
+  }
+
   if (participant_) {
     DDS::ReturnCode_t tmp = participant_->delete_contained_entities();
     if (tmp && log_level >= LogLevel::Error) {
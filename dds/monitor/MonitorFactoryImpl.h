@@ -9,6 +9,7 @@
 #define OPENDDS_MONITOR_MONITORFACTORYIMPL_H
 
 #include "monitor_export.h"
+#include "PeriodicReporter.h"
 #include "dds/DCPS/MonitorFactory.h"
 #include "monitorTypeSupportImpl.h"
 
@@ -82,6 +83,8 @@ private:
                                          const DDS::DataWriterQos& dw_qos);
 
   DDS::DomainParticipant_var participant_;
+  /// Reports the periodic and transport monitors every DCPSMonitorPeriod
+  PeriodicReporter_rch reporter_;
   ServiceParticipantReportDataWriter_var  sp_writer_;
   DomainParticipantReportDataWriter_var   dp_writer_;
   TopicReportDataWriter_var               topic_writer_;
@@ -0,0 +1,50 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "PeriodicReporter.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+PeriodicReporter::PeriodicReporter(ReactorTask_rch reactor_task)
+  : PeriodicTask(reactor_task)
+{
+}
+
+void
+PeriodicReporter::add(Monitor* monitor)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  monitors_.insert(monitor);
+}
+
+void
+PeriodicReporter::remove(Monitor* monitor)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  monitors_.erase(monitor);
+}
+
+void
+PeriodicReporter::report_all()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, lock_);
+  for (Monitors::iterator it = monitors_.begin(); it != monitors_.end(); ++it) {
+    (*it)->report();
+  }
+}
+
+void
+PeriodicReporter::execute(const MonotonicTimePoint&)
+{
+  report_all();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,61 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_MONITOR_PERIODICREPORTER_H
+#define OPENDDS_MONITOR_PERIODICREPORTER_H
+
+#include "monitor_export.h"
+
+#include <dds/DCPS/MonitorFactory.h>
+#include <dds/DCPS/PeriodicTask.h>
+#include <dds/DCPS/PoolAllocator.h>
+
+#include <ace/Thread_Mutex.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class PeriodicReporter
+ *
+ * @brief Calls report() on the periodic monitors on a timer
+ *
+ * The data reader, data writer, and transport monitors add themselves when
+ * they're created and remove themselves when they're destroyed.  Monitors
+ * are reported under the reporter's lock, so a monitor that has been removed
+ * is never reported again.
+ */
+class OpenDDS_monitor_Export PeriodicReporter : public PeriodicTask {
+public:
+  explicit PeriodicReporter(ReactorTask_rch reactor_task);
+
+  void add(Monitor* monitor);
+  void remove(Monitor* monitor);
+
+  /// Report every monitor that has been added
+  void report_all();
+
+private:
+  virtual void execute(const MonotonicTimePoint& now);
+
+  ACE_Thread_Mutex lock_;
+  typedef OPENDDS_SET(Monitor*) Monitors;
+  Monitors monitors_;
+};
+
+typedef RcHandle<PeriodicReporter> PeriodicReporter_rch;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_MONITOR_PERIODICREPORTER_H */
@@ -9,6 +9,7 @@
 #include "monitorC.h"
 #include "monitorTypeSupportImpl.h"
 #include "dds/DCPS/transport/framework/TransportImpl.h"
+#include "dds/DCPS/transport/framework/TransportInst.h"
 #include <dds/DdsDcpsInfrastructureC.h>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -19,18 +20,27 @@ namespace DCPS {
 TransportMonitorImpl::TransportReportVec TransportMonitorImpl::queue_;
 ACE_Recursive_Thread_Mutex TransportMonitorImpl::queue_lock_;
 
-TransportMonitorImpl::TransportMonitorImpl(TransportImpl* /*transport*/,
-              OpenDDS::DCPS::TransportReportDataWriter_ptr transport_writer)
-  : transport_writer_(TransportReportDataWriter::_duplicate(transport_writer))
+TransportMonitorImpl::TransportMonitorImpl(TransportImpl* transport,
+              OpenDDS::DCPS::TransportReportDataWriter_ptr transport_writer,
+              const PeriodicReporter_rch& reporter)
+  : transport_(transport)
+  , transport_writer_(TransportReportDataWriter::_duplicate(transport_writer))
+  , reporter_(reporter)
 {
   char host[256];
   ACE_OS::hostname(host, 256);
   hostname_ = host;
   pid_  = ACE_OS::getpid();
+  if (reporter_) {
+    reporter_->add(this);
+  }
 }
 
 TransportMonitorImpl::~TransportMonitorImpl()
 {
+  if (reporter_) {
+    reporter_->remove(this);
+  }
 }
 
 void
@@ -42,7 +52,21 @@ TransportMonitorImpl::report() {
   // TODO: remove/replace
   report.transport_id  = 0;
   report.transport_type = "";
-  // ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, queue_lock_);
+  const TransportInst_rch config = transport_ ? transport_->config() : TransportInst_rch();
+  if (config) {
+    report.transport_type = config->transport_type_.c_str();
+
+    // Counters are doubles since they don't fit in a long.
+    const TransportCounters::Values counts = config->counters()->values();
+    report.values.length(TransportCounters::COUNTER_COUNT);
+    for (CORBA::ULong i = 0; i < TransportCounters::COUNTER_COUNT; ++i) {
+      const TransportCounters::Counter counter = static_cast<TransportCounters::Counter>(i);
+      report.values[i].name = TransportCounters::name(counter);
+      report.values[i].value.double_value(static_cast<double>(counts[counter]));
+    }
+  }
+  // Reports come from the transport and from the periodic reporter's thread
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, queue_lock_);
   if (!CORBA::is_nil(this->transport_writer_.in())) {
     if (this->queue_.size()) {
       // ACE_DEBUG((LM_DEBUG, "TransportMonitorImpl::report(): popping\n"));
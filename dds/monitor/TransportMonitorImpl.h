@@ -9,6 +9,7 @@
 #define OPENDDS_MONITOR_TRANSPORTMONITORIMPL_H
 
 #include "monitor_export.h"
+#include "PeriodicReporter.h"
 #include "dds/DCPS/MonitorFactory.h"
 #include "monitorTypeSupportImpl.h"
 #include "ace/Recursive_Thread_Mutex.h"
@@ -26,12 +27,15 @@ namespace DCPS {
 class TransportMonitorImpl : public Monitor {
 public:
   TransportMonitorImpl(TransportImpl* transport,
-                   OpenDDS::DCPS::TransportReportDataWriter_ptr transport_writer);
+                   OpenDDS::DCPS::TransportReportDataWriter_ptr transport_writer,
+                   const PeriodicReporter_rch& reporter);
   virtual ~TransportMonitorImpl();
   virtual void report();
 
 private:
+  TransportImpl* transport_;
   OpenDDS::DCPS::TransportReportDataWriter_var transport_writer_;
+  const PeriodicReporter_rch reporter_;
   std::string hostname_;
   pid_t pid_;
 
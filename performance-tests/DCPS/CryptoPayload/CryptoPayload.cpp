@@ -0,0 +1,161 @@
+/*
+ * Crypto payload benchmark
+ *
+ * Protects and then verifies the same serialized payload many times with
+ * the built-in crypto plugin, the way an RTPS writer and reader would with
+ * payload protection enabled.  Reported: time per payload for
+ * encode_serialized_payload and decode_serialized_payload.
+ */
+
+#include <dds/OpenDDSConfigWrapper.h>
+
+#include <dds/DCPS/TimeTypes.h>
+
+#if OPENDDS_CONFIG_SECURITY
+#  include <dds/DCPS/security/CryptoBuiltInImpl.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+struct Options {
+  Options()
+    : size(256)
+    , messages(20000)
+    , encrypt(true)
+  {}
+
+  int size; // bytes per payload
+  int messages;
+  bool encrypt; // otherwise only authenticate
+};
+
+bool parse_args(int argc, ACE_TCHAR* argv[], Options& opts)
+{
+  ACE_Arg_Shifter shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = shifter.get_the_parameter(ACE_TEXT("-size")))) {
+      opts.size = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else if ((arg = shifter.get_the_parameter(ACE_TEXT("-messages")))) {
+      opts.messages = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else if (shifter.cur_arg_strncasecmp(ACE_TEXT("-authenticate")) == 0) {
+      opts.encrypt = false;
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+  if (opts.size <= 0 || opts.messages <= 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: -size and -messages must be positive\n"));
+    return false;
+  }
+  return true;
+}
+
+#if OPENDDS_CONFIG_SECURITY
+struct SharedSecret : DDS::Security::SharedSecretHandle {
+  DDS::OctetSeq* challenge1() { return 0; }
+  DDS::OctetSeq* challenge2() { return 0; }
+  DDS::OctetSeq* sharedSecret() { return 0; }
+};
+
+int run(const Options& opts)
+{
+  using namespace DDS::Security;
+
+  DDS::Security::CryptoKeyFactory_var factory = new OpenDDS::Security::CryptoBuiltInImpl;
+  CryptoKeyExchange& exchange = dynamic_cast<CryptoKeyExchange&>(*factory.in());
+  CryptoTransform& transform = dynamic_cast<CryptoTransform&>(*factory.in());
+
+  DDS::PropertySeq no_properties;
+  const EndpointSecurityAttributes attributes = {{false, false, false, false}, false, true, false,
+    opts.encrypt ? PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED : 0u, no_properties};
+  SecurityException ex = {"", 0, 0};
+  SharedSecret shared_secret;
+
+  // The writer and the reader that receives its samples
+  const DatawriterCryptoHandle local_writer =
+    factory->register_local_datawriter(0, no_properties, attributes, ex);
+  const DatareaderCryptoHandle local_reader =
+    factory->register_local_datareader(0, no_properties, attributes, ex);
+  const ParticipantCryptoHandle remote_participant =
+    factory->register_matched_remote_participant(0, 1, 2, &shared_secret, ex);
+  const DatawriterCryptoHandle remote_writer =
+    factory->register_matched_remote_datawriter(local_reader, remote_participant, &shared_secret, ex);
+  DatawriterCryptoTokenSeq tokens;
+  if (local_writer == DDS::HANDLE_NIL || remote_writer == DDS::HANDLE_NIL ||
+      !exchange.create_local_datawriter_crypto_tokens(tokens, local_writer, 99, ex) ||
+      !exchange.set_remote_datawriter_crypto_tokens(local_reader, remote_writer, tokens, ex)) {
+    ACE_ERROR((LM_ERROR, "ERROR: could not set up crypto handles: %C\n", ex.message.in()));
+    return EXIT_FAILURE;
+  }
+
+  DDS::OctetSeq plain;
+  plain.length(opts.size);
+  for (int i = 0; i < opts.size; ++i) {
+    plain[i] = static_cast<CORBA::Octet>(i);
+  }
+
+  DDS::OctetSeq encoded, inline_qos;
+  const MonotonicTimePoint encode_start = MonotonicTimePoint::now();
+  for (int i = 0; i < opts.messages; ++i) {
+    if (!transform.encode_serialized_payload(encoded, inline_qos, plain, local_writer, ex)) {
+      ACE_ERROR((LM_ERROR, "ERROR: encode_serialized_payload failed: %C\n", ex.message.in()));
+      return EXIT_FAILURE;
+    }
+  }
+  const double encode = (MonotonicTimePoint::now() - encode_start).to_double();
+
+  DDS::OctetSeq decoded;
+  const MonotonicTimePoint decode_start = MonotonicTimePoint::now();
+  for (int i = 0; i < opts.messages; ++i) {
+    if (!transform.decode_serialized_payload(decoded, encoded, inline_qos,
+                                             local_reader, remote_writer, ex)) {
+      ACE_ERROR((LM_ERROR, "ERROR: decode_serialized_payload failed: %C\n", ex.message.in()));
+      return EXIT_FAILURE;
+    }
+  }
+  const double decode = (MonotonicTimePoint::now() - decode_start).to_double();
+
+  if (decoded != plain) {
+    ACE_ERROR((LM_ERROR, "ERROR: decoded payload doesn't match the original\n"));
+    return EXIT_FAILURE;
+  }
+
+  ACE_DEBUG((LM_INFO,
+             "(%P|%t) CryptoPayload results (%C)\n"
+             "  payload size:  %d bytes\n"
+             "  payloads:      %d\n"
+             "  encode:        %.3f us/payload\n"
+             "  decode:        %.3f us/payload\n",
+             opts.encrypt ? "encrypt" : "authenticate",
+             opts.size, opts.messages,
+             encode * 1e6 / opts.messages,
+             decode * 1e6 / opts.messages));
+  return EXIT_SUCCESS;
+}
+#endif
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  Options opts;
+  if (!parse_args(argc, argv, opts)) {
+    return EXIT_FAILURE;
+  }
+#if OPENDDS_CONFIG_SECURITY
+  return run(opts);
+#else
+  ACE_ERROR((LM_ERROR, "ERROR: CryptoPayload requires OpenDDS to be built with security\n"));
+  return EXIT_FAILURE;
+#endif
+}
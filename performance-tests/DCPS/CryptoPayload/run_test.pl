@@ -0,0 +1,24 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+# Any extra arguments (for example "-size 1024 -messages 100000" or
+# "-authenticate") are passed through to the benchmark.
+my $args = join(' ', @ARGV);
+
+my $test = new PerlDDS::TestFramework();
+$test->enable_console_logging();
+$test->process('bench', 'CryptoPayload', $args);
+$test->start_process('bench');
+my $result = $test->finish(300);
+if ($result != 0) {
+  print STDERR "ERROR: CryptoPayload returned $result\n";
+  exit 1;
+}
+
+exit 0;
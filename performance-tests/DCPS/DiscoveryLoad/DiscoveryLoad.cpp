@@ -0,0 +1,569 @@
+/*
+ * Discovery load benchmark
+ *
+ * One real DomainParticipant (with one DataWriter and one DataReader) is
+ * exposed to N simulated remote participants living in the same process.
+ * Each simulated participant announces itself with SPDP and then announces
+ * M publications and M subscriptions with SEDP.  All traffic is synthesized
+ * directly on a UDP socket and sent over the loopback interface to the fixed
+ * SPDP/SEDP addresses configured in discovery_load.ini, so the Spdp/Sedp code
+ * paths under test are exactly the ones used with real remote peers.
+ *
+ * Reported: time to discover all participants, time to full match of all
+ * endpoints, messages processed per second, peak RSS, CPU time and context
+ * switches.  Voluntary context switches are used as the lock contention
+ * indicator since discovery threads block on Spdp/Sedp locks when contended.
+ */
+
+#include "DiscoveryLoadTypeSupportImpl.h"
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/NetworkResource.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/TimeTypes.h>
+#include <dds/DCPS/RTPS/BaseMessageTypes.h>
+#include <dds/DCPS/RTPS/GuidGenerator.h>
+#include <dds/DCPS/RTPS/MessageTypes.h>
+#include <dds/DCPS/RTPS/MessageUtils.h>
+#include <dds/DCPS/RTPS/ParameterListConverter.h>
+#include <dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h>
+
+#include <dds/OpenDDSConfigWrapper.h>
+
+#include <dds/DCPS/StaticIncludes.h>
+#ifdef ACE_AS_STATIC_LIBS
+#  include <dds/DCPS/RTPS/RtpsDiscovery.h>
+#  include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_sys_resource.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/SOCK_Dgram.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+using namespace OpenDDS::RTPS;
+
+namespace {
+
+const char TOPIC_NAME[] = "DiscoveryLoad";
+
+struct Options {
+  Options()
+    : participants(100)
+    , endpoints(10)
+    , timeout(120)
+    , spdp_addr(u_short(7575), "127.0.0.1")
+    , sedp_addr(u_short(7576), "127.0.0.1")
+  {}
+
+  int participants; // N simulated remote participants
+  int endpoints; // M publications and M subscriptions per participant
+  int timeout; // seconds
+  ACE_INET_Addr spdp_addr;
+  ACE_INET_Addr sedp_addr;
+};
+
+bool parse_args(int argc, ACE_TCHAR* argv[], Options& opts)
+{
+  ACE_Arg_Shifter shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = shifter.get_the_parameter(ACE_TEXT("-participants")))) {
+      opts.participants = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else if ((arg = shifter.get_the_parameter(ACE_TEXT("-endpoints")))) {
+      opts.endpoints = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else if ((arg = shifter.get_the_parameter(ACE_TEXT("-timeout")))) {
+      opts.timeout = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else if ((arg = shifter.get_the_parameter(ACE_TEXT("-spdp")))) {
+      opts.spdp_addr.set(arg);
+      shifter.consume_arg();
+    } else if ((arg = shifter.get_the_parameter(ACE_TEXT("-sedp")))) {
+      opts.sedp_addr.set(arg);
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+  if (opts.participants <= 0 || opts.endpoints <= 0 || opts.timeout <= 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: -participants, -endpoints and -timeout must be positive\n"));
+    return false;
+  }
+  return true;
+}
+
+struct Usage {
+  Usage()
+    : user_sec(0)
+    , sys_sec(0)
+    , max_rss_kb(0)
+    , voluntary_switches(0)
+    , involuntary_switches(0)
+  {}
+
+  static Usage now()
+  {
+    Usage u;
+#ifdef ACE_HAS_GETRUSAGE
+    ACE_Rusage ru;
+    if (ACE_OS::getrusage(RUSAGE_SELF, &ru) == 0) {
+      u.user_sec = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+      u.sys_sec = ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+      u.max_rss_kb = ru.ru_maxrss;
+      u.voluntary_switches = ru.ru_nvcsw;
+      u.involuntary_switches = ru.ru_nivcsw;
+    }
+#endif
+    return u;
+  }
+
+  double user_sec;
+  double sys_sec;
+  long max_rss_kb;
+  long voluntary_switches;
+  long involuntary_switches;
+};
+
+/// A remote participant that only exists as the RTPS messages it sends.
+class SimulatedParticipant {
+public:
+  SimulatedParticipant(const GuidPrefix_t& prefix, int endpoints)
+    : hb_count_(0)
+  {
+    assign(prefix_, prefix);
+    spdp_seq_.high = 0;
+    spdp_seq_.low = 0;
+    const Header hdr = {
+      {'R', 'T', 'P', 'S'}, PROTOCOLVERSION, VENDORID_OPENDDS,
+      {prefix[0], prefix[1], prefix[2], prefix[3], prefix[4], prefix[5],
+       prefix[6], prefix[7], prefix[8], prefix[9], prefix[10], prefix[11]}
+    };
+    std::memcpy(&hdr_, &hdr, sizeof(Header));
+    for (int i = 0; i < endpoints; ++i) {
+      writers_.push_back(make_entity(i, ENTITYKIND_USER_WRITER_WITH_KEY));
+      readers_.push_back(make_entity(i, ENTITYKIND_USER_READER_WITH_KEY));
+    }
+  }
+
+  /// Build and send the SPDP announcement for this participant.
+  bool send_spdp(ACE_SOCK_Dgram& sock, const ACE_INET_Addr& to,
+                 const LocatorSeq& locators, size_t& sent)
+  {
+    const BuiltinEndpointSet_t endpoints =
+      DISC_BUILTIN_ENDPOINT_PARTICIPANT_ANNOUNCER |
+      DISC_BUILTIN_ENDPOINT_PARTICIPANT_DETECTOR |
+      DISC_BUILTIN_ENDPOINT_PUBLICATION_ANNOUNCER |
+      DISC_BUILTIN_ENDPOINT_PUBLICATION_DETECTOR |
+      DISC_BUILTIN_ENDPOINT_SUBSCRIPTION_ANNOUNCER |
+      DISC_BUILTIN_ENDPOINT_SUBSCRIPTION_DETECTOR;
+
+    const DDS::DomainParticipantQos& qos =
+      TheServiceParticipant->initial_DomainParticipantQos();
+    const GuidPrefix_t& gp = prefix_;
+    const SPDPdiscoveredParticipantData pdata = {
+      {DDS::BuiltinTopicKey_t(), qos.user_data},
+      {
+        0 // domainId
+        , ""
+        , PROTOCOLVERSION
+        , {gp[0], gp[1], gp[2], gp[3], gp[4], gp[5], gp[6], gp[7], gp[8], gp[9], gp[10], gp[11]}
+        , VENDORID_OPENDDS
+        , false // expectsIQoS
+        , endpoints
+        , 0
+        , locators // metatrafficUnicastLocatorList
+        , LocatorSeq() // metatrafficMulticastLocatorList
+        , LocatorSeq() // defaultMulticastLocatorList
+        , locators // defaultUnicastLocatorList
+        , {0} // manualLivelinessCount
+        , qos.property
+        , {PFLAGS_EMPTY} // opendds_participant_flags
+        , false // opendds_rtps_relay_application_participant
+#if OPENDDS_CONFIG_SECURITY
+        , 0 // availableExtendedBuiltinEndpoints
+#endif
+        , 0
+      },
+      {300, 0}, // leaseDuration, long enough to outlive the benchmark
+      {0, 0}
+    };
+
+    ParameterList plist;
+    if (!ParameterListConverter::to_param_list(pdata, plist)) {
+      ACE_ERROR((LM_ERROR, "ERROR: SimulatedParticipant::send_spdp: to_param_list failed\n"));
+      return false;
+    }
+    const SequenceNumber_t seq = {0, ++spdp_seq_.low};
+    return send_data(sock, to, ENTITYID_SPDP_BUILTIN_PARTICIPANT_WRITER, seq, plist, sent);
+  }
+
+  /// Announce all publications and subscriptions with SEDP.  Each builtin
+  /// writer first heartbeats the full range so the (reliable) Sedp readers
+  /// accept the following DATA submessages in order.
+  bool send_sedp(ACE_SOCK_Dgram& sock, const ACE_INET_Addr& to,
+                 const LocatorSeq& locators, const char* type_name,
+                 size_t& sent)
+  {
+    TransportLocatorSeq trans_info;
+    trans_info.length(1);
+    trans_info[0].transport_type = "rtps_udp";
+    locators_to_blob(locators, VENDORID_OPENDDS, trans_info[0].data);
+
+    ++hb_count_;
+    const TypeInformation no_type_info;
+
+    const DDS::DataWriterQos& dw_qos = TheServiceParticipant->initial_DataWriterQos();
+    const DDS::PublisherQos& pub_qos = TheServiceParticipant->initial_PublisherQos();
+    const SequenceNumber_t last_pub = {0, static_cast<ACE_UINT32>(writers_.size())};
+    if (!send_heartbeat(sock, to, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER, last_pub, sent)) {
+      return false;
+    }
+    for (size_t i = 0; i < writers_.size(); ++i) {
+      DiscoveredWriterData dwd;
+      dwd.ddsPublicationData.topic_name = TOPIC_NAME;
+      dwd.ddsPublicationData.type_name = type_name;
+      dwd.ddsPublicationData.durability = dw_qos.durability;
+      dwd.ddsPublicationData.durability_service = dw_qos.durability_service;
+      dwd.ddsPublicationData.deadline = dw_qos.deadline;
+      dwd.ddsPublicationData.latency_budget = dw_qos.latency_budget;
+      dwd.ddsPublicationData.liveliness = dw_qos.liveliness;
+      dwd.ddsPublicationData.reliability = dw_qos.reliability;
+      dwd.ddsPublicationData.reliability.kind = DDS::BEST_EFFORT_RELIABILITY_QOS;
+      dwd.ddsPublicationData.lifespan = dw_qos.lifespan;
+      dwd.ddsPublicationData.user_data = dw_qos.user_data;
+      dwd.ddsPublicationData.ownership = dw_qos.ownership;
+      dwd.ddsPublicationData.ownership_strength = dw_qos.ownership_strength;
+      dwd.ddsPublicationData.destination_order = dw_qos.destination_order;
+      dwd.ddsPublicationData.representation = dw_qos.representation;
+      dwd.ddsPublicationData.presentation = pub_qos.presentation;
+      dwd.ddsPublicationData.partition = pub_qos.partition;
+      dwd.ddsPublicationData.group_data = pub_qos.group_data;
+      dwd.writerProxy.remoteWriterGuid = make_id(prefix_, writers_[i]);
+      dwd.writerProxy.allLocators = trans_info;
+
+      ParameterList plist;
+      if (!ParameterListConverter::to_param_list(dwd, plist, false, no_type_info)) {
+        ACE_ERROR((LM_ERROR, "ERROR: SimulatedParticipant::send_sedp: to_param_list(dwd) failed\n"));
+        return false;
+      }
+      const SequenceNumber_t seq = {0, static_cast<ACE_UINT32>(i + 1)};
+      if (!send_data(sock, to, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER, seq, plist, sent)) {
+        return false;
+      }
+    }
+
+    const DDS::DataReaderQos& dr_qos = TheServiceParticipant->initial_DataReaderQos();
+    const DDS::SubscriberQos& sub_qos = TheServiceParticipant->initial_SubscriberQos();
+    const SequenceNumber_t last_sub = {0, static_cast<ACE_UINT32>(readers_.size())};
+    if (!send_heartbeat(sock, to, ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER, last_sub, sent)) {
+      return false;
+    }
+    for (size_t i = 0; i < readers_.size(); ++i) {
+      DiscoveredReaderData drd;
+      drd.ddsSubscriptionData.topic_name = TOPIC_NAME;
+      drd.ddsSubscriptionData.type_name = type_name;
+      drd.ddsSubscriptionData.durability = dr_qos.durability;
+      drd.ddsSubscriptionData.deadline = dr_qos.deadline;
+      drd.ddsSubscriptionData.latency_budget = dr_qos.latency_budget;
+      drd.ddsSubscriptionData.liveliness = dr_qos.liveliness;
+      drd.ddsSubscriptionData.reliability = dr_qos.reliability;
+      drd.ddsSubscriptionData.reliability.kind = DDS::BEST_EFFORT_RELIABILITY_QOS;
+      drd.ddsSubscriptionData.ownership = dr_qos.ownership;
+      drd.ddsSubscriptionData.destination_order = dr_qos.destination_order;
+      drd.ddsSubscriptionData.user_data = dr_qos.user_data;
+      drd.ddsSubscriptionData.time_based_filter = dr_qos.time_based_filter;
+      drd.ddsSubscriptionData.representation = dr_qos.representation;
+      drd.ddsSubscriptionData.presentation = sub_qos.presentation;
+      drd.ddsSubscriptionData.partition = sub_qos.partition;
+      drd.ddsSubscriptionData.group_data = sub_qos.group_data;
+      drd.ddsSubscriptionData.type_consistency = dr_qos.type_consistency;
+      drd.readerProxy.remoteReaderGuid = make_id(prefix_, readers_[i]);
+      drd.readerProxy.expectsInlineQos = false;
+      drd.readerProxy.allLocators = trans_info;
+      drd.contentFilterProperty.filterClassName = "";
+
+      ParameterList plist;
+      if (!ParameterListConverter::to_param_list(drd, plist, false, no_type_info)) {
+        ACE_ERROR((LM_ERROR, "ERROR: SimulatedParticipant::send_sedp: to_param_list(drd) failed\n"));
+        return false;
+      }
+      const SequenceNumber_t seq = {0, static_cast<ACE_UINT32>(i + 1)};
+      if (!send_data(sock, to, ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER, seq, plist, sent)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  static EntityId_t make_entity(int index, CORBA::Octet kind)
+  {
+    const EntityId_t id = {
+      {static_cast<CORBA::Octet>((index >> 16) & 0xff),
+       static_cast<CORBA::Octet>((index >> 8) & 0xff),
+       static_cast<CORBA::Octet>(index & 0xff)},
+      kind
+    };
+    return id;
+  }
+
+  bool send_heartbeat(ACE_SOCK_Dgram& sock, const ACE_INET_Addr& to,
+                      const EntityId_t& writer, const SequenceNumber_t& last,
+                      size_t& sent)
+  {
+    const Encoding encoding(Encoding::KIND_XCDR1, ENDIAN_LITTLE);
+    const SequenceNumber_t first = {0, 1};
+    const HeartBeatSubmessage hb = {
+      {HEARTBEAT, FLAG_E, HEARTBEAT_SZ},
+      ENTITYID_UNKNOWN, writer, first, last, {hb_count_}
+    };
+    size_t size = 0;
+    serialized_size(encoding, size, hdr_);
+    serialized_size(encoding, size, hb);
+
+    ACE_Message_Block mb(size);
+    Serializer ser(&mb, encoding);
+    if (!(ser << hdr_ && ser << hb)) {
+      ACE_ERROR((LM_ERROR, "ERROR: SimulatedParticipant::send_heartbeat: serialization failed\n"));
+      return false;
+    }
+    return send(sock, to, mb, sent);
+  }
+
+  bool send_data(ACE_SOCK_Dgram& sock, const ACE_INET_Addr& to,
+                 const EntityId_t& writer, const SequenceNumber_t& seq,
+                 const ParameterList& plist, size_t& sent)
+  {
+    const Encoding encoding(Encoding::KIND_XCDR1, ENDIAN_LITTLE);
+    const DataSubmessage ds = {
+      {DATA, FLAG_E | FLAG_D, 0},
+      0, DATA_OCTETS_TO_IQOS, ENTITYID_UNKNOWN, writer, seq, ParameterList()
+    };
+    size_t size = 0;
+    serialized_size(encoding, size, hdr_);
+    serialized_size(encoding, size, ds);
+    primitive_serialized_size_ulong(encoding, size);
+    serialized_size(encoding, size, plist);
+
+    ACE_Message_Block mb(size);
+    Serializer ser(&mb, encoding);
+    const EncapsulationHeader encap(encoding, MUTABLE);
+    if (!(ser << hdr_ && ser << ds && ser << encap && ser << plist)) {
+      ACE_ERROR((LM_ERROR, "ERROR: SimulatedParticipant::send_data: serialization failed\n"));
+      return false;
+    }
+    return send(sock, to, mb, sent);
+  }
+
+  static bool send(ACE_SOCK_Dgram& sock, const ACE_INET_Addr& to,
+                   const ACE_Message_Block& mb, size_t& sent)
+  {
+    if (sock.send(mb.rd_ptr(), mb.length(), to) < 0) {
+      ACE_ERROR((LM_ERROR, "ERROR: SimulatedParticipant::send: %p\n", ACE_TEXT("send")));
+      return false;
+    }
+    ++sent;
+    return true;
+  }
+
+  GuidPrefix_t prefix_;
+  Header hdr_;
+  SequenceNumber_t spdp_seq_;
+  CORBA::Long hb_count_;
+  std::vector<EntityId_t> writers_;
+  std::vector<EntityId_t> readers_;
+};
+
+/// Read and discard whatever the participant under test sends back,
+/// returning the number of datagrams drained.
+size_t drain(ACE_SOCK_Dgram& sock)
+{
+  static char buffer[64 * 1024];
+  size_t count = 0;
+  ACE_INET_Addr from;
+  const ACE_Time_Value no_wait(0);
+  while (sock.recv(buffer, sizeof buffer, from, 0, &no_wait) > 0) {
+    ++count;
+  }
+  return count;
+}
+
+CORBA::ULong matched_count(DDS::DomainParticipant_ptr dp, DDS::DataWriter_ptr writer,
+                           DDS::DataReader_ptr reader, CORBA::ULong& participants)
+{
+  DDS::InstanceHandleSeq handles;
+  dp->get_discovered_participants(handles);
+  participants = handles.length();
+
+  CORBA::ULong matched = 0;
+  writer->get_matched_subscriptions(handles);
+  matched += handles.length();
+  reader->get_matched_publications(handles);
+  matched += handles.length();
+  return matched;
+}
+
+int run(int argc, ACE_TCHAR* argv[])
+{
+  DDS::DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+  Options opts;
+  if (!parse_args(argc, argv, opts)) {
+    return EXIT_FAILURE;
+  }
+
+  DDS::DomainParticipant_var dp =
+    dpf->create_participant(0, PARTICIPANT_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+  if (!dp) {
+    ACE_ERROR((LM_ERROR, "ERROR: create_participant failed\n"));
+    return EXIT_FAILURE;
+  }
+
+  DiscoveryLoad::SampleTypeSupport_var ts = new DiscoveryLoad::SampleTypeSupportImpl;
+  if (ts->register_type(dp, "") != DDS::RETCODE_OK) {
+    ACE_ERROR((LM_ERROR, "ERROR: register_type failed\n"));
+    return EXIT_FAILURE;
+  }
+  CORBA::String_var type_name = ts->get_type_name();
+
+  DDS::Topic_var topic = dp->create_topic(TOPIC_NAME, type_name,
+                                          TOPIC_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+  DDS::Publisher_var pub = dp->create_publisher(PUBLISHER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+  DDS::Subscriber_var sub = dp->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+  if (!topic || !pub || !sub) {
+    ACE_ERROR((LM_ERROR, "ERROR: failed to create topic, publisher or subscriber\n"));
+    return EXIT_FAILURE;
+  }
+  DDS::DataWriter_var writer = pub->create_datawriter(topic, DATAWRITER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+  DDS::DataReader_var reader = sub->create_datareader(topic, DATAREADER_QOS_DEFAULT, 0, DEFAULT_STATUS_MASK);
+  if (!writer || !reader) {
+    ACE_ERROR((LM_ERROR, "ERROR: failed to create data writer or data reader\n"));
+    return EXIT_FAILURE;
+  }
+
+  ACE_SOCK_Dgram sock;
+  ACE_INET_Addr sock_addr(u_short(0), "127.0.0.1");
+  if (sock.open(sock_addr) != 0 || sock.get_local_addr(sock_addr) != 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: failed to open simulation socket: %p\n", ACE_TEXT("open")));
+    return EXIT_FAILURE;
+  }
+  LocatorSeq locators(1);
+  locators.length(1);
+  address_to_locator(locators[0], sock_addr);
+
+  std::vector<SimulatedParticipant> participants;
+  participants.reserve(opts.participants);
+  GuidGenerator gen;
+  for (int i = 0; i < opts.participants; ++i) {
+    GUID_t guid;
+    gen.populate(guid);
+    participants.push_back(SimulatedParticipant(guid.guidPrefix, opts.endpoints));
+  }
+
+  const CORBA::ULong expected_participants = static_cast<CORBA::ULong>(opts.participants);
+  const CORBA::ULong expected_matches = 2 * expected_participants * opts.endpoints;
+  const TimeDuration resend(1);
+  const TimeDuration poll(0, 10000);
+  size_t sent = 0;
+  size_t received = 0;
+
+  ACE_DEBUG((LM_INFO, "(%P|%t) DiscoveryLoad: %d participants x %d publications + %d subscriptions\n",
+             opts.participants, opts.endpoints, opts.endpoints));
+
+  const Usage usage_start = Usage::now();
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  const MonotonicTimePoint deadline = start + TimeDuration(opts.timeout);
+  MonotonicTimePoint next_send = start;
+  MonotonicTimePoint participants_done;
+  bool all_discovered = false;
+  CORBA::ULong discovered = 0;
+  CORBA::ULong matched = 0;
+  bool ok = true;
+
+  while (ok) {
+    const MonotonicTimePoint now = MonotonicTimePoint::now();
+    if (now >= deadline) {
+      ACE_ERROR((LM_ERROR, "ERROR: timed out with %u/%u participants and %u/%u matches\n",
+                 discovered, expected_participants, matched, expected_matches));
+      ok = false;
+      break;
+    }
+
+    // Announce (and periodically re-announce, as real peers would) until
+    // every participant is discovered, then do the same for the endpoints.
+    if (now >= next_send) {
+      for (size_t i = 0; ok && i < participants.size(); ++i) {
+        ok = participants[i].send_spdp(sock, opts.spdp_addr, locators, sent);
+        if (ok && all_discovered) {
+          ok = participants[i].send_sedp(sock, opts.sedp_addr, locators, type_name, sent);
+        }
+        received += drain(sock);
+      }
+      next_send = MonotonicTimePoint::now() + resend;
+    }
+
+    received += drain(sock);
+    matched = matched_count(dp, writer, reader, discovered);
+    if (!all_discovered && discovered >= expected_participants) {
+      all_discovered = true;
+      participants_done = MonotonicTimePoint::now();
+      next_send = participants_done;
+    }
+    if (matched >= expected_matches) {
+      break;
+    }
+    ACE_OS::sleep(poll.value());
+  }
+
+  const MonotonicTimePoint end = MonotonicTimePoint::now();
+  const Usage usage_end = Usage::now();
+
+  if (ok) {
+    const double total = (end - start).to_double();
+    const double spdp = (participants_done - start).to_double();
+    ACE_DEBUG((LM_INFO,
+               "(%P|%t) DiscoveryLoad results\n"
+               "  participants discovered:   %u in %.3f s\n"
+               "  endpoints matched:         %u in %.3f s (time to full match)\n"
+               "  messages sent:             %B (%.0f msg/s)\n"
+               "  messages received:         %B (%.0f msg/s)\n"
+               "  peak RSS:                  %d KB\n"
+               "  CPU user/system:           %.3f s / %.3f s\n"
+               "  voluntary ctx switches:    %d (lock contention indicator)\n"
+               "  involuntary ctx switches:  %d\n",
+               discovered, spdp,
+               matched, total,
+               sent, sent / total,
+               received, received / total,
+               static_cast<int>(usage_end.max_rss_kb),
+               usage_end.user_sec - usage_start.user_sec,
+               usage_end.sys_sec - usage_start.sys_sec,
+               static_cast<int>(usage_end.voluntary_switches - usage_start.voluntary_switches),
+               static_cast<int>(usage_end.involuntary_switches - usage_start.involuntary_switches)));
+  }
+
+  dp->delete_contained_entities();
+  dpf->delete_participant(dp);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int result = EXIT_FAILURE;
+  try {
+    result = run(argc, argv);
+  } catch (const CORBA::Exception& e) {
+    e._tao_print_exception("ERROR: exception caught in main():");
+  }
+  TheServiceParticipant->shutdown();
+  return result;
+}
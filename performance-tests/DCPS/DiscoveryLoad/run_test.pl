@@ -0,0 +1,24 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+# Any extra arguments (for example "-participants 1000 -endpoints 20") are
+# passed through to the benchmark.
+my $args = join(' ', @ARGV);
+
+my $test = new PerlDDS::TestFramework();
+$test->enable_console_logging();
+$test->process('bench', 'DiscoveryLoad', "-DCPSConfigFile discovery_load.ini $args");
+$test->start_process('bench');
+my $result = $test->finish(300);
+if ($result != 0) {
+  print STDERR "ERROR: DiscoveryLoad returned $result\n";
+  exit 1;
+}
+
+exit 0;
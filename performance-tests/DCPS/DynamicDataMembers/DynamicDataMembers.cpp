@@ -0,0 +1,253 @@
+/*
+ * DynamicData member storage benchmark
+ *
+ * Sets and gets every member of DynamicDataImpl objects to time how the
+ * values are stored: a final struct whose member IDs are 0 to N-1, a
+ * mutable struct with hashed member IDs, an unbounded sequence and a large
+ * array.  Reported: time per member for each operation.
+ */
+
+#include "DynamicDataMembersTypeSupportImpl.h"
+
+#include <dds/DCPS/TimeTypes.h>
+#include <dds/DCPS/XTypes/DynamicDataImpl.h>
+#include <dds/DCPS/XTypes/DynamicTypeImpl.h>
+#include <dds/DCPS/XTypes/TypeLookupService.h>
+#include <dds/DCPS/XTypes/Utils.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+using OpenDDS::XTypes::DynamicDataImpl;
+
+namespace {
+
+struct Options {
+  Options()
+    : samples(20000)
+    , elements(10000)
+  {}
+
+  int samples; // objects created for each struct type
+  int elements; // length of the sequence
+};
+
+bool parse_args(int argc, ACE_TCHAR* argv[], Options& opts)
+{
+  ACE_Arg_Shifter shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = shifter.get_the_parameter(ACE_TEXT("-samples")))) {
+      opts.samples = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else if ((arg = shifter.get_the_parameter(ACE_TEXT("-elements")))) {
+      opts.elements = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+  if (opts.samples <= 0 || opts.elements <= 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: -samples and -elements must be positive\n"));
+    return false;
+  }
+  return true;
+}
+
+template <typename Xtag>
+DDS::DynamicType_var get_type(OpenDDS::XTypes::TypeLookupService& tls)
+{
+  const OpenDDS::XTypes::TypeIdentifier& ti = getCompleteTypeIdentifier<Xtag>();
+  const OpenDDS::XTypes::TypeMap& type_map = getCompleteTypeMap<Xtag>();
+  tls.add(type_map.begin(), type_map.end());
+  const OpenDDS::XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  if (it == type_map.end()) {
+    return 0;
+  }
+  return tls.complete_to_dynamic(it->second.complete, GUID_t());
+}
+
+DDS::DynamicType_var get_member_type(DDS::DynamicType_ptr type, const char* name)
+{
+  DDS::DynamicTypeMember_var dtm;
+  DDS::MemberDescriptor_var md;
+  if (type->get_member_by_name(dtm, name) != DDS::RETCODE_OK ||
+      dtm->get_descriptor(md) != DDS::RETCODE_OK) {
+    return 0;
+  }
+  return OpenDDS::XTypes::get_base_type(md->type());
+}
+
+struct Timing {
+  Timing() : forward(0), reverse(0), get(0) {}
+  double forward;
+  double reverse;
+  double get;
+};
+
+/// Set all members of a struct in order and in reverse, then get them all.
+bool time_struct(DDS::DynamicType_ptr type, int samples, Timing& timing, unsigned& members)
+{
+  members = type->get_member_count();
+  std::vector<DDS::MemberId> ids(members);
+  for (unsigned i = 0; i < members; ++i) {
+    DDS::DynamicTypeMember_var dtm;
+    if (type->get_member_by_index(dtm, i) != DDS::RETCODE_OK) {
+      return false;
+    }
+    ids[i] = dtm->get_id();
+  }
+
+  std::vector<DDS::DynamicData_var> data(samples);
+  const MonotonicTimePoint forward_start = MonotonicTimePoint::now();
+  for (int s = 0; s < samples; ++s) {
+    data[s] = new DynamicDataImpl(type);
+    for (unsigned i = 0; i < members; ++i) {
+      if (data[s]->set_int32_value(ids[i], i) != DDS::RETCODE_OK) {
+        return false;
+      }
+    }
+  }
+  timing.forward = (MonotonicTimePoint::now() - forward_start).to_double();
+
+  const MonotonicTimePoint reverse_start = MonotonicTimePoint::now();
+  for (int s = 0; s < samples; ++s) {
+    DDS::DynamicData_var reversed = new DynamicDataImpl(type);
+    for (unsigned i = members; i > 0; --i) {
+      if (reversed->set_int32_value(ids[i - 1], i) != DDS::RETCODE_OK) {
+        return false;
+      }
+    }
+  }
+  timing.reverse = (MonotonicTimePoint::now() - reverse_start).to_double();
+
+  const MonotonicTimePoint get_start = MonotonicTimePoint::now();
+  for (int s = 0; s < samples; ++s) {
+    for (unsigned i = 0; i < members; ++i) {
+      CORBA::Long value = 0;
+      if (data[s]->get_int32_value(value, ids[i]) != DDS::RETCODE_OK ||
+          value != static_cast<CORBA::Long>(i)) {
+        return false;
+      }
+    }
+  }
+  timing.get = (MonotonicTimePoint::now() - get_start).to_double();
+  return true;
+}
+
+int run(const Options& opts)
+{
+  OpenDDS::XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var dense = get_type<DynamicDataMembers_Dense_xtag>(tls);
+  const DDS::DynamicType_var sparse = get_type<DynamicDataMembers_Sparse_xtag>(tls);
+  const DDS::DynamicType_var collections = get_type<DynamicDataMembers_Collections_xtag>(tls);
+  if (!dense.in() || !sparse.in() || !collections.in()) {
+    ACE_ERROR((LM_ERROR, "ERROR: could not get the DynamicTypes\n"));
+    return EXIT_FAILURE;
+  }
+  const DDS::DynamicType_var seq_type = get_member_type(collections, "values");
+  const DDS::DynamicType_var array_type = get_member_type(collections, "fixed");
+  if (!seq_type.in() || !array_type.in()) {
+    ACE_ERROR((LM_ERROR, "ERROR: could not get the collection types\n"));
+    return EXIT_FAILURE;
+  }
+
+  Timing dense_timing, sparse_timing;
+  unsigned dense_members = 0, sparse_members = 0;
+  if (!time_struct(dense, opts.samples, dense_timing, dense_members) ||
+      !time_struct(sparse, opts.samples, sparse_timing, sparse_members)) {
+    ACE_ERROR((LM_ERROR, "ERROR: setting or getting a struct member failed\n"));
+    return EXIT_FAILURE;
+  }
+
+  // Append to the sequence, then remove its first element until it's empty,
+  // which shifts all the elements after it.
+  const CORBA::ULong elements = opts.elements;
+  DDS::DynamicData_var seq = new DynamicDataImpl(seq_type);
+  const MonotonicTimePoint append_start = MonotonicTimePoint::now();
+  for (CORBA::ULong i = 0; i < elements; ++i) {
+    if (seq->set_int32_value(i, i) != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR, "ERROR: appending to the sequence failed\n"));
+      return EXIT_FAILURE;
+    }
+  }
+  const double append = (MonotonicTimePoint::now() - append_start).to_double();
+
+  const MonotonicTimePoint remove_start = MonotonicTimePoint::now();
+  for (CORBA::ULong i = 0; i < elements; ++i) {
+    if (seq->clear_value(0) != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR, "ERROR: removing from the sequence failed\n"));
+      return EXIT_FAILURE;
+    }
+  }
+  const double remove = (MonotonicTimePoint::now() - remove_start).to_double();
+
+  // Fill the array from the end
+  DDS::TypeDescriptor_var array_td;
+  if (array_type->get_descriptor(array_td) != DDS::RETCODE_OK) {
+    ACE_ERROR((LM_ERROR, "ERROR: could not get the array descriptor\n"));
+    return EXIT_FAILURE;
+  }
+  const CORBA::ULong array_length = OpenDDS::XTypes::bound_total(array_td);
+  const int arrays = opts.samples / 100 + 1;
+  const MonotonicTimePoint array_start = MonotonicTimePoint::now();
+  for (int s = 0; s < arrays; ++s) {
+    DDS::DynamicData_var array = new DynamicDataImpl(array_type);
+    for (CORBA::ULong i = array_length; i > 0; --i) {
+      if (array->set_int32_value(i - 1, i) != DDS::RETCODE_OK) {
+        ACE_ERROR((LM_ERROR, "ERROR: setting an array element failed\n"));
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  const double array_fill = (MonotonicTimePoint::now() - array_start).to_double();
+
+  const double dense_count = double(opts.samples) * dense_members;
+  const double sparse_count = double(opts.samples) * sparse_members;
+  ACE_DEBUG((LM_INFO,
+             "(%P|%t) DynamicDataMembers results\n"
+             "  samples:               %d\n"
+             "  final struct (%u members with IDs 0 to %u):\n"
+             "    set in order:        %.1f ns/member\n"
+             "    set in reverse:      %.1f ns/member\n"
+             "    get:                 %.1f ns/member\n"
+             "  mutable struct (%u members with hashed IDs):\n"
+             "    set in order:        %.1f ns/member\n"
+             "    set in reverse:      %.1f ns/member\n"
+             "    get:                 %.1f ns/member\n"
+             "  sequence (%u elements):\n"
+             "    append:              %.1f ns/element\n"
+             "    remove first:        %.1f ns/element\n"
+             "  array (%u elements):\n"
+             "    set in reverse:      %.1f ns/element\n",
+             opts.samples,
+             dense_members, dense_members - 1,
+             dense_timing.forward * 1e9 / dense_count,
+             dense_timing.reverse * 1e9 / dense_count,
+             dense_timing.get * 1e9 / dense_count,
+             sparse_members,
+             sparse_timing.forward * 1e9 / sparse_count,
+             sparse_timing.reverse * 1e9 / sparse_count,
+             sparse_timing.get * 1e9 / sparse_count,
+             elements,
+             append * 1e9 / elements,
+             remove * 1e9 / elements,
+             array_length,
+             array_fill * 1e9 / (double(arrays) * array_length)));
+  return EXIT_SUCCESS;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  Options opts;
+  if (!parse_args(argc, argv, opts)) {
+    return EXIT_FAILURE;
+  }
+  return run(opts);
+}
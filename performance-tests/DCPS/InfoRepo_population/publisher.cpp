@@ -22,6 +22,7 @@
 #include "ace/High_Res_Timer.h"
 #include "ace/Get_Opt.h"
 #include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_unistd.h"
 
 #include <string>
 #include <sstream>
@@ -37,6 +38,7 @@ public:
 
 private:
   bool parse_args (int argc, ACE_TCHAR *argv[]);
+  bool create_unmatched (::DDS::DomainId_t domain_id);
 
   size_t topic_count_;
   size_t participant_count_;
@@ -46,8 +48,10 @@ private:
   size_t subscriber_count_;
 
   std::string sync_server_;
+  size_t unmatched_count_;
 
   DDS::DomainParticipantFactory_var dpf_;
+  DDS::DomainParticipant_var unmatched_participant_;
   std::vector<DDS::DomainParticipant_var> participant_;
   std::vector<DDS::Topic_var> topic_;
   std::vector<DDS::Publisher_var> pub_;
@@ -59,12 +63,12 @@ private:
 bool
 Publisher::parse_args (int argc, ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:n:p:c:s:i:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:n:p:c:s:i:u:"));
   int c;
   std::string usage = " -t <topic count>\n"
     " -n <participant count>\n -p <publisher count>\n"
     " -c <control file>\n -s <subscriber count>\n"
-    " -y <syncServer ior>";
+    " -y <syncServer ior>\n -u <writers in unmatched partitions>";
 
   while ((c = get_opts ()) != -1)
   {
@@ -88,6 +92,9 @@ Publisher::parse_args (int argc, ACE_TCHAR *argv[])
       case 'y':
         sync_server_ = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
         break;
+      case 'u':
+        unmatched_count_ = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
       case '?':
       default:
         ACE_ERROR_RETURN ((LM_ERROR,
@@ -104,6 +111,7 @@ Publisher::parse_args (int argc, ACE_TCHAR *argv[])
 Publisher::Publisher (int argc, ACE_TCHAR *argv[])
   : topic_count_ (1), participant_count_ (1), writer_count_ (1)
   , control_file_ ("barrier_file"), subscriber_count_(1)
+  , unmatched_count_ (0)
 {
   try
     {
@@ -145,6 +153,73 @@ Publisher::Publisher (int argc, ACE_TCHAR *argv[])
   dw_.resize (writer_count_);
 }
 
+// Creates writers that are each alone in a partition, so they never match
+// anything but still have to be looked at by the InfoRepo for every datareader
+// created on the other side.
+bool
+Publisher::create_unmatched (::DDS::DomainId_t domain_id)
+{
+  unmatched_participant_ =
+    dpf_->create_participant (domain_id,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil (unmatched_participant_.in ())) {
+    cerr << "create_participant failed." << endl;
+    return false;
+  }
+
+  Messenger::MessageTypeSupport_var mts = new Messenger::MessageTypeSupportImpl();
+  if (DDS::RETCODE_OK != mts->register_type(unmatched_participant_.in (), "")) {
+    cerr << "register_type failed." << endl;
+    return false;
+  }
+
+  CORBA::String_var type_name = mts->get_type_name ();
+  DDS::Topic_var topic =
+    unmatched_participant_->create_topic ("Movie Discussion List",
+                                          type_name.in (),
+                                          TOPIC_QOS_DEFAULT,
+                                          DDS::TopicListener::_nil(),
+                                          ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil (topic.in ())) {
+    cerr << "create_topic failed." << endl;
+    return false;
+  }
+
+  DDS::PublisherQos pub_qos;
+  unmatched_participant_->get_default_publisher_qos (pub_qos);
+  pub_qos.partition.name.length (1);
+
+  for (size_t count = 0; count < unmatched_count_; count++)
+    {
+      std::ostringstream name;
+      name << "unmatched_publisher_" << ACE_OS::getpid () << '_' << count;
+      pub_qos.partition.name[0] = name.str ().c_str ();
+
+      DDS::Publisher_var pub =
+        unmatched_participant_->create_publisher (pub_qos,
+                                                  DDS::PublisherListener::_nil(),
+                                                  ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      if (CORBA::is_nil (pub.in ())) {
+        cerr << "create_publisher failed." << endl;
+        return false;
+      }
+
+      DDS::DataWriter_var datawriter =
+        pub->create_datawriter (topic.in (),
+                                DATAWRITER_QOS_DEFAULT,
+                                DDS::DataWriterListener::_nil(),
+                                ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      if (CORBA::is_nil (datawriter.in ())) {
+        cerr << "create_datawriter failed." << endl;
+        return false;
+      }
+    }
+
+  return true;
+}
+
 bool
 Publisher::run (void)
 {
@@ -152,6 +227,10 @@ Publisher::run (void)
 
   try
     {
+      if (unmatched_count_ > 0 && !create_unmatched (domain_id)) {
+        return false;
+      }
+
       sync_client_->way_point_reached (1);
       sync_client_->get_notification ();
 
@@ -278,6 +357,10 @@ Publisher::run (void)
           participant_[count]->delete_contained_entities ();
           dpf_->delete_participant (participant_[count].in ());
         }
+      if (!CORBA::is_nil (unmatched_participant_.in ())) {
+        unmatched_participant_->delete_contained_entities ();
+        dpf_->delete_participant (unmatched_participant_.in ());
+      }
       TheServiceParticipant->shutdown ();
   }
   catch (CORBA::Exception& e)
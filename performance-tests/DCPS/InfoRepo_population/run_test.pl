@@ -38,8 +38,13 @@ $opts = "-ORBDebugLevel $orbdebuglevel " if $orbdebuglevel;
 $opts .= "-DCPSDebugLevel $debuglevel "   if $debuglevel;
 $opts .= "-ORBVerboseLogging 1 "          if $verbose;
 $opts .= "-ORBLogFile $debugfile "        if $debugfile;
-$pub_opts = "$opts -DCPSConfigFile pub.ini -DCPSBit 0 -t5 -n5 -p5 -s5";
-$sub_opts = "$opts -DCPSConfigFile sub.ini -DCPSBit 0 -t5 -n5 -s5 -p10";
+# With "unmatched" each process first creates endpoints that are alone in
+# their partitions, which the InfoRepo still has to check for incompatible
+# QoS whenever one of the timed endpoints is created.
+my $unmatched = (grep { $_ eq 'unmatched' } @ARGV) ? "-u 500" : "";
+
+$pub_opts = "$opts -DCPSConfigFile pub.ini -DCPSBit 0 -t5 -n5 -p5 -s5 $unmatched";
+$sub_opts = "$opts -DCPSConfigFile sub.ini -DCPSBit 0 -t5 -n5 -s5 -p10 $unmatched";
 
 my $syncopts  = "-ORBDebugLevel $orbdebuglevel " if $orbdebuglevel;
    $syncopts .= "-ORBVerboseLogging 1 "          if $verbose;
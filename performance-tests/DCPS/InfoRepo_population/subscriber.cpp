@@ -37,6 +37,7 @@ public:
 
 private:
   bool parse_args (int argc, ACE_TCHAR *argv[]);
+  bool create_unmatched (::DDS::DomainId_t domain_id);
 
   size_t topic_count_;
   size_t participant_count_;
@@ -46,8 +47,10 @@ private:
   size_t publisher_count_;
 
   std::string sync_server_;
+  size_t unmatched_count_;
 
   DDS::DomainParticipantFactory_var dpf_;
+  DDS::DomainParticipant_var unmatched_participant_;
   std::vector<DDS::DomainParticipant_var> participant_;
   std::vector<DDS::Topic_var> topic_;
   std::vector<DDS::Subscriber_var> subs_;
@@ -60,7 +63,7 @@ private:
 bool
 Subscriber::parse_args (int argc, ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:n:p:c:s:i:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("t:n:p:c:s:i:u:"));
   int c;
   std::string usage = " -t <topic count>\n"
     " -n <participant count>\n -p <publisher count>\n"
@@ -89,6 +92,9 @@ Subscriber::parse_args (int argc, ACE_TCHAR *argv[])
       case 'y':
         sync_server_ = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
         break;
+      case 'u':
+        unmatched_count_ = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
       case '?':
       default:
         ACE_ERROR_RETURN ((LM_ERROR,
@@ -105,6 +111,7 @@ Subscriber::parse_args (int argc, ACE_TCHAR *argv[])
 Subscriber::Subscriber (int argc, ACE_TCHAR *argv[])
   : topic_count_ (1), participant_count_ (1), reader_count_(1)
   , control_file_ ("barrier_file"), publisher_count_ (1)
+  , unmatched_count_ (0)
 {
   try
     {
@@ -141,6 +148,73 @@ Subscriber::Subscriber (int argc, ACE_TCHAR *argv[])
   dr_.resize (reader_count_);
 }
 
+// Creates readers that are each alone in a partition, so they never match
+// anything but still have to be looked at by the InfoRepo for every datawriter
+// created on the other side.
+bool
+Subscriber::create_unmatched (::DDS::DomainId_t domain_id)
+{
+  unmatched_participant_ =
+    dpf_->create_participant (domain_id,
+                              PARTICIPANT_QOS_DEFAULT,
+                              DDS::DomainParticipantListener::_nil(),
+                              ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil (unmatched_participant_.in ())) {
+    cerr << "create_participant failed." << endl;
+    return false;
+  }
+
+  Messenger::MessageTypeSupport_var mts = new Messenger::MessageTypeSupportImpl();
+  if (DDS::RETCODE_OK != mts->register_type(unmatched_participant_.in (), "")) {
+    cerr << "register_type failed." << endl;
+    return false;
+  }
+
+  CORBA::String_var type_name = mts->get_type_name ();
+  DDS::Topic_var topic =
+    unmatched_participant_->create_topic ("Movie Discussion List",
+                                          type_name.in (),
+                                          TOPIC_QOS_DEFAULT,
+                                          DDS::TopicListener::_nil(),
+                                          ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil (topic.in ())) {
+    cerr << "create_topic failed." << endl;
+    return false;
+  }
+
+  DDS::SubscriberQos sub_qos;
+  unmatched_participant_->get_default_subscriber_qos (sub_qos);
+  sub_qos.partition.name.length (1);
+
+  for (size_t count = 0; count < unmatched_count_; count++)
+    {
+      std::ostringstream name;
+      name << "unmatched_subscriber_" << ACE_OS::getpid () << '_' << count;
+      sub_qos.partition.name[0] = name.str ().c_str ();
+
+      DDS::Subscriber_var sub =
+        unmatched_participant_->create_subscriber (sub_qos,
+                                                   DDS::SubscriberListener::_nil(),
+                                                   ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      if (CORBA::is_nil (sub.in ())) {
+        cerr << "create_subscriber failed." << endl;
+        return false;
+      }
+
+      DDS::DataReader_var datareader =
+        sub->create_datareader (topic.in (),
+                                DATAREADER_QOS_DEFAULT,
+                                DDS::DataReaderListener::_nil(),
+                                ::OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+      if (CORBA::is_nil (datareader.in ())) {
+        cerr << "create_datareader failed." << endl;
+        return false;
+      }
+    }
+
+  return true;
+}
+
 bool
 Subscriber::run (void)
 {
@@ -148,6 +222,10 @@ Subscriber::run (void)
 
   try
     {
+      if (unmatched_count_ > 0 && !create_unmatched (domain_id)) {
+        return false;
+      }
+
       sync_client_->way_point_reached (1);
       sync_client_->get_notification ();
 
@@ -295,6 +373,10 @@ Subscriber::run (void)
           participant_[count]->delete_contained_entities ();
           dpf_->delete_participant (participant_[count].in ());
         }
+      if (!CORBA::is_nil (unmatched_participant_.in ())) {
+        unmatched_participant_->delete_contained_entities ();
+        dpf_->delete_participant (unmatched_participant_.in ());
+      }
       //ACE_OS::sleep(2);
 
       TheServiceParticipant->shutdown ();
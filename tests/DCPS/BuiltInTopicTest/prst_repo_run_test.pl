@@ -97,7 +97,7 @@ sub early_fail() {
 
 sub cleanup() {
   unlink $dcpsrepo_ior;
-  unlink $info_prst_file;
+  unlink $info_prst_file, "$info_prst_file.log", "$info_prst_file.tmp";
   unlink $synch_file;
 }
 
@@ -1964,6 +1964,109 @@ TEST(IdVsDeclOrder, test)
   serializer_test<IdVsDeclOrder>(xcdr2, id_vs_decl_order_expected);
 }
 
+// PlainLayoutStruct ==========================================================
+
+struct PlainLayoutStructExpectedBE {
+  STREAM_DATA
+};
+
+const unsigned char PlainLayoutStructExpectedBE::expected[] = {
+  // long_long_field
+  0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // +8 = 8
+  // long_field
+  0x7f, 0xff, 0xff, 0xff, // +4 = 12
+  // short_field
+  0x7f, 0xff, // +2 = 14
+  // octet_field
+  0x01, // +1 = 15
+  // octet_field2
+  0x00 // +1 = 16
+};
+const unsigned PlainLayoutStructExpectedBE::layout[] = {8,4,2,1,1};
+const size_t plain_layout_struct_max_size = 16;
+
+TEST(PlainLayoutStruct, Xcdr1)
+{
+  baseline_checks<PlainLayoutStruct>(xcdr1, PlainLayoutStructExpectedBE::expected, plain_layout_struct_max_size);
+}
+
+TEST(PlainLayoutStruct, Xcdr2)
+{
+  baseline_checks<PlainLayoutStruct>(xcdr2, PlainLayoutStructExpectedBE::expected, plain_layout_struct_max_size);
+}
+
+TEST(PlainLayoutStruct, Xcdr2LE)
+{
+  test_little_endian<PlainLayoutStruct, PlainLayoutStructExpectedBE>();
+}
+
+TEST(PlainLayoutStruct, Array)
+{
+  PlainLayoutArrayStruct value;
+  for (size_t i = 0; i < value.array_field().size(); ++i) {
+    set_base_values(value.array_field()[i]);
+    value.array_field()[i].octet_field2(static_cast<CORBA::Octet>(i));
+  }
+
+  const Encoding encodings[] = {xcdr1, xcdr2, xcdr2_le};
+  for (size_t e = 0; e < sizeof(encodings) / sizeof(encodings[0]); ++e) {
+    const Encoding& encoding = encodings[e];
+    ACE_Message_Block buffer(1024);
+    {
+      Serializer serializer(&buffer, encoding);
+      ASSERT_TRUE(serializer << value);
+    }
+    EXPECT_EQ(serialized_size(encoding, value), buffer.length());
+
+    PlainLayoutArrayStruct result;
+    {
+      Serializer serializer(&buffer, encoding);
+      ASSERT_TRUE(serializer >> result);
+    }
+    for (size_t i = 0; i < value.array_field().size(); ++i) {
+      expect_values_equal(value.array_field()[i], result.array_field()[i]);
+      EXPECT_EQ(value.array_field()[i].octet_field2(), result.array_field()[i].octet_field2());
+    }
+  }
+}
+
+TEST(PlainLayoutStruct, ConstantBounds)
+{
+  // The bounds must be usable as compile time constants
+  char buffer[MarshalTraits<PlainLayoutStruct>::xcdr2_serialized_size_bound];
+  EXPECT_EQ(sizeof(buffer), plain_layout_struct_max_size);
+  EXPECT_EQ(static_cast<size_t>(MarshalTraits<PlainLayoutStruct>::xcdr1_serialized_size_bound),
+    plain_layout_struct_max_size);
+  EXPECT_EQ(static_cast<size_t>(MarshalTraits<PlainLayoutStruct>::unaligned_cdr_serialized_size_bound),
+    plain_layout_struct_max_size);
+  EXPECT_EQ(static_cast<size_t>(MarshalTraits<PlainLayoutArrayStruct>::xcdr2_serialized_size_bound),
+    MarshalTraits<PlainLayoutArrayStruct>::serialized_size_bound(xcdr2).get());
+}
+
+TEST(PlainLayoutStruct, FixedSerializedSize)
+{
+  // The size of a fixed size type is computed without walking the fields, so
+  // check it against what's actually written starting from every offset.
+  PlainLayoutArrayStruct value;
+  const Encoding encodings[] = {xcdr1, xcdr2, Encoding(Encoding::KIND_UNALIGNED_CDR)};
+  for (size_t e = 0; e < sizeof(encodings) / sizeof(encodings[0]); ++e) {
+    const Encoding& encoding = encodings[e];
+    for (size_t offset = 0; offset < 8; ++offset) {
+      ACE_Message_Block buffer(1024);
+      {
+        Serializer serializer(&buffer, encoding);
+        for (size_t i = 0; i < offset; ++i) {
+          ASSERT_TRUE(serializer << ACE_OutputCDR::from_octet(0));
+        }
+        ASSERT_TRUE(serializer << value);
+      }
+      size_t size = offset;
+      serialized_size(encoding, size, value);
+      EXPECT_EQ(size, buffer.length());
+    }
+  }
+}
+
 // KeyOnly Serialization ======================================================
 
 template <typename Type>
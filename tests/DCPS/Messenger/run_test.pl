@@ -33,6 +33,12 @@ if ($test->flag('thread_per')) {
     $thread_per_connection = " -p ";
 }
 
+# Have the InfoRepo handle requests on several threads
+my $repo_threads = "";
+if ($test->flag('inforepo_threads')) {
+    $repo_threads = " -Threads 4";
+}
+
 my $flag_found = 1;
 if ($test->flag('udp')) {
     $pub_opts .= " -DCPSConfigFile pub_udp.ini";
@@ -142,7 +148,7 @@ $test->report_unused_flags(!$flag_found);
 $pub_opts .= $thread_per_connection;
 
 $test->setup_discovery("-ORBDebugLevel 1 -ORBLogFile DCPSInfoRepo.log " .
-                       "$repo_bit_opt") unless $is_rtps_disc;
+                       "$repo_bit_opt$repo_threads") unless $is_rtps_disc;
 
 $test->process("publisher", "publisher", $pub_opts);
 my $sub_exe = ($stack_based ? 'stack_' : '') . "subscriber";
@@ -57,7 +57,12 @@ void DRPerMDataReaderListenerImpl::on_data_available(DDS::DataReader_ptr reader)
         for (CORBA::ULong i = 0; i < drperr.associations.length(); i++) {
 
           cout << "    dw_id = " << drperr.associations[i].dw_id << endl
-               << "    samples_available = " << drperr.associations[i].samples_available << endl;
+               << "    samples_available = " << drperr.associations[i].samples_available << endl
+               << "    latency.n = " << drperr.associations[i].latency.n << endl
+               << "    latency.p50 = " << drperr.associations[i].latency.p50 << endl
+               << "    latency.p99 = " << drperr.associations[i].latency.p99 << endl
+               << "    latency.p99_9 = " << drperr.associations[i].latency.p99_9 << endl
+               << "    latency.maximum = " << drperr.associations[i].latency.maximum << endl;
         }
 
       } else if (si.instance_state == DDS::NOT_ALIVE_DISPOSED_INSTANCE_STATE) {
@@ -55,7 +55,14 @@ void TransportMDataReaderListenerImpl::on_data_available(DDS::DataReader_ptr rea
              << "  host           = " << transportr.host.in()           << endl
              << "  pid            = " << transportr.pid                 << endl
              << "  transport_id   = " << transportr.transport_id        << endl
-             << "  transport_type = " << transportr.transport_type.in() << endl;
+             << "  transport_type = " << transportr.transport_type.in() << endl
+             << "  values         = " << endl;
+        for (CORBA::ULong i = 0; i < transportr.values.length(); ++i) {
+          const OpenDDS::DCPS::NameValuePair& value = transportr.values[i];
+          if (value.value._d() == OpenDDS::DCPS::DOUBLE_TYPE) {
+            cout << "    " << value.name.in() << " = " << value.value.double_value() << endl;
+          }
+        }
 
       } else if (si.instance_state == DDS::NOT_ALIVE_DISPOSED_INSTANCE_STATE) {
         ACE_DEBUG((LM_DEBUG, ACE_TEXT("%N:%l: INFO: instance is disposed\n")));
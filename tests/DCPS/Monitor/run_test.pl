@@ -104,6 +104,16 @@ if ($mon_count < 55) {
     $status = 1;
 }
 
+# The periodic reports carry the reader's latency and the transport counters
+if (!grep /latency\.n = [1-9]/, @monout) {
+    print STDERR "ERROR: No DataReaderPeriodicReport with latency seen\n";
+    $status = 1;
+}
+if (!grep /bytes_(sent|received) = [1-9]/, @monout) {
+    print STDERR "ERROR: No TransportReport with counters seen\n";
+    $status = 1;
+}
+
 if ($status == 0) {
   print "test PASSED.\n";
 } else {
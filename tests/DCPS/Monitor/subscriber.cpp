@@ -11,6 +11,7 @@
 #include <ace/OS_NS_stdlib.h>
 
 #include <dds/DdsDcpsInfrastructureC.h>
+#include <dds/DdsDcpsSubscriptionExtC.h>
 #include <dds/DCPS/Marked_Default_Qos.h>
 #include <dds/DCPS/Service_Participant.h>
 #include <dds/DCPS/SubscriberImpl.h>
@@ -96,6 +97,10 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
                         ACE_TEXT(" ERROR: create_datareader() failed!\n")), -1);
     }
 
+    // Latency is only recorded, and in the periodic reports, with statistics
+    OpenDDS::DCPS::DataReaderEx_var reader_ex = OpenDDS::DCPS::DataReaderEx::_narrow(reader.in());
+    reader_ex->statistics_enabled(true);
+
     // Block until Publisher completes
     DDS::StatusCondition_var condition = reader->get_statuscondition();
     condition->set_enabled_statuses(DDS::SUBSCRIPTION_MATCHED_STATUS);
@@ -86,7 +86,7 @@ my $dcpsrepo_ior = "repo.ior";
 my $info_prst_file = "info.pr";
 
 unlink $dcpsrepo_ior;
-unlink $info_prst_file;
+unlink $info_prst_file, "$info_prst_file.log", "$info_prst_file.tmp";
 unlink <*.log>;
 
 my $SRV_PORT = PerlACE::random_port();
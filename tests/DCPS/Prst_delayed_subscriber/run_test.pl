@@ -90,7 +90,7 @@ $app_bit_opt = "-DCPSBit 0";
 $SRV_PORT = PerlACE::random_port();
 
 unlink $dcpsrepo_ior;
-unlink $info_prst_file;
+unlink $info_prst_file, "$info_prst_file.log", "$info_prst_file.tmp";
 
 # If InfoRepo is running in persistent mode, use a
 #  static endpoint (instead of transient)
@@ -166,7 +166,7 @@ if ($ir != 0) {
     $status = 1;
 }
 unlink $dcpsrepo_ior;
-unlink $info_prst_file;
+unlink $info_prst_file, "$info_prst_file.log", "$info_prst_file.tmp";
 
 if ($status == 0) {
   print "test PASSED.\n";
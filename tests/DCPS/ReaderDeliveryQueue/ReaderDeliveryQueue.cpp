@@ -0,0 +1,330 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+/*
+ * Test of the DataReader delivery queue (DCPSReaderDeliveryQueueSize).
+ *
+ * The reader's first on_data_available, which runs on the reactor thread
+ * that drains the queue, blocks until every sample has been written and
+ * acknowledged.  The queue can't be drained in the meantime, so the
+ * transport thread finds it full and falls back to delivering the samples
+ * itself.  After that read and take have to see every sample, in order for
+ * each instance, and nothing may be left in the queue.
+ */
+
+#include "ReaderDeliveryQueueTypeSupportImpl.h"
+
+#include <dds/DCPS/Atomic.h>
+#include <dds/DCPS/LocalObject.h>
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/WaitSet.h>
+#include <dds/DCPS/StaticIncludes.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <vector>
+
+using namespace ReaderDeliveryQueue;
+
+namespace {
+
+const DDS::DomainId_t DOMAIN_ID = 111;
+
+int instances = 4;
+int samples_per_instance = 250;
+
+class BlockingListener
+  : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener> {
+public:
+  BlockingListener()
+    : release_(new DDS::GuardCondition)
+    , blocked_(false)
+    , timed_out_(false)
+  {}
+
+  /// Let the blocked on_data_available return.
+  void release()
+  {
+    release_->set_trigger_value(true);
+  }
+
+  bool blocked() const { return blocked_; }
+  bool timed_out() const { return timed_out_; }
+
+  void on_data_available(DDS::DataReader_ptr)
+  {
+    // Only the first call blocks.  Later ones can come from the transport
+    // thread while it delivers the samples the queue had no room for.
+    if (blocked_.exchange(true)) {
+      return;
+    }
+    DDS::WaitSet_var ws = new DDS::WaitSet;
+    ws->attach_condition(release_);
+    DDS::ConditionSeq active;
+    const DDS::Duration_t timeout = {30, 0};
+    if (ws->wait(active, timeout) != DDS::RETCODE_OK) {
+      timed_out_ = true;
+    }
+    ws->detach_condition(release_);
+  }
+
+  void on_requested_deadline_missed(DDS::DataReader_ptr, const DDS::RequestedDeadlineMissedStatus&) {}
+  void on_requested_incompatible_qos(DDS::DataReader_ptr, const DDS::RequestedIncompatibleQosStatus&) {}
+  void on_sample_rejected(DDS::DataReader_ptr, const DDS::SampleRejectedStatus&) {}
+  void on_liveliness_changed(DDS::DataReader_ptr, const DDS::LivelinessChangedStatus&) {}
+  void on_subscription_matched(DDS::DataReader_ptr, const DDS::SubscriptionMatchedStatus&) {}
+  void on_sample_lost(DDS::DataReader_ptr, const DDS::SampleLostStatus&) {}
+
+private:
+  DDS::GuardCondition_var release_;
+  OpenDDS::DCPS::Atomic<bool> blocked_;
+  OpenDDS::DCPS::Atomic<bool> timed_out_;
+};
+
+void parse_args(int argc, ACE_TCHAR* argv[])
+{
+  ACE_Arg_Shifter shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = shifter.get_the_parameter(ACE_TEXT("-instances")))) {
+      instances = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else if ((arg = shifter.get_the_parameter(ACE_TEXT("-samples")))) {
+      samples_per_instance = ACE_OS::atoi(arg);
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+}
+
+bool wait_for_match(DDS::DataWriter_ptr writer)
+{
+  DDS::StatusCondition_var condition = writer->get_statuscondition();
+  condition->set_enabled_statuses(DDS::PUBLICATION_MATCHED_STATUS);
+  DDS::WaitSet_var ws = new DDS::WaitSet;
+  ws->attach_condition(condition);
+  const DDS::Duration_t timeout = {30, 0};
+  DDS::PublicationMatchedStatus status = {0, 0, 0, 0, 0};
+  while (status.current_count == 0) {
+    DDS::ConditionSeq active;
+    if (ws->wait(active, timeout) != DDS::RETCODE_OK ||
+        writer->get_publication_matched_status(status) != DDS::RETCODE_OK) {
+      break;
+    }
+  }
+  ws->detach_condition(condition);
+  return status.current_count != 0;
+}
+
+bool wait_for_blocked(const BlockingListener& listener)
+{
+  for (int i = 0; i < 3000 && !listener.blocked(); ++i) {
+    ACE_OS::sleep(ACE_Time_Value(0, 10000));
+  }
+  return listener.blocked();
+}
+
+/// Check that the samples are the next ones for their instances.
+bool check_order(const SampleSeq& data, const DDS::SampleInfoSeq& info, std::vector<int>& next_seq)
+{
+  for (CORBA::ULong i = 0; i < data.length(); ++i) {
+    if (!info[i].valid_data) {
+      continue;
+    }
+    const int instance = data[i].instance;
+    if (instance < 0 || instance >= instances) {
+      ACE_ERROR((LM_ERROR, "ERROR: unexpected instance %d\n", instance));
+      return false;
+    }
+    if (data[i].seq != next_seq[instance]) {
+      ACE_ERROR((LM_ERROR, "ERROR: instance %d expected sample %d but got %d\n",
+                 instance, next_seq[instance], data[i].seq));
+      return false;
+    }
+    ++next_seq[instance];
+  }
+  return true;
+}
+
+bool run(DDS::DomainParticipant_ptr participant)
+{
+  SampleTypeSupport_var ts = new SampleTypeSupportImpl;
+  if (ts->register_type(participant, "") != DDS::RETCODE_OK) {
+    ACE_ERROR((LM_ERROR, "ERROR: register_type failed\n"));
+    return false;
+  }
+  CORBA::String_var type_name = ts->get_type_name();
+  DDS::Topic_var topic = participant->create_topic("ReaderDeliveryQueue", type_name,
+    TOPIC_QOS_DEFAULT, 0, OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+  const int total = instances * samples_per_instance;
+
+  DDS::Publisher_var pub = participant->create_publisher(PUBLISHER_QOS_DEFAULT, 0,
+    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::DataWriterQos dw_qos;
+  pub->get_default_datawriter_qos(dw_qos);
+  dw_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+  dw_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+  DDS::DataWriter_var dw = pub->create_datawriter(topic, dw_qos, 0,
+    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+
+  // The reader keeps every sample so that any that are lost or reordered
+  // show up in the check.
+  DDS::Subscriber_var sub = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT, 0,
+    OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  DDS::DataReaderQos dr_qos;
+  sub->get_default_datareader_qos(dr_qos);
+  dr_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+  dr_qos.history.kind = DDS::KEEP_LAST_HISTORY_QOS;
+  dr_qos.history.depth = samples_per_instance;
+  BlockingListener* const listener_impl = new BlockingListener;
+  DDS::DataReaderListener_var listener = listener_impl;
+  DDS::DataReader_var dr = sub->create_datareader(topic, dr_qos, listener,
+    DDS::DATA_AVAILABLE_STATUS);
+  if (CORBA::is_nil(dw.in()) || CORBA::is_nil(dr.in())) {
+    ACE_ERROR((LM_ERROR, "ERROR: could not create the writer and reader\n"));
+    return false;
+  }
+
+  if (!wait_for_match(dw)) {
+    ACE_ERROR((LM_ERROR, "ERROR: the writer didn't match the reader\n"));
+    return false;
+  }
+
+  SampleDataWriter_var writer = SampleDataWriter::_narrow(dw);
+  for (int seq = 0; seq < samples_per_instance; ++seq) {
+    for (int instance = 0; instance < instances; ++instance) {
+      const Sample sample = {instance, seq};
+      if (writer->write(sample, DDS::HANDLE_NIL) != DDS::RETCODE_OK) {
+        ACE_ERROR((LM_ERROR, "ERROR: write failed\n"));
+        listener_impl->release();
+        return false;
+      }
+    }
+
+    // Write the rest once the listener is holding up the reactor thread, so
+    // the queue fills up.
+    if (seq == 0 && !wait_for_blocked(*listener_impl)) {
+      ACE_ERROR((LM_ERROR, "ERROR: on_data_available wasn't called\n"));
+      listener_impl->release();
+      return false;
+    }
+  }
+
+  // Every sample has been given to the reader once it's acknowledged.
+  const DDS::Duration_t ack_timeout = {30, 0};
+  const DDS::ReturnCode_t acked = dw->wait_for_acknowledgments(ack_timeout);
+  listener_impl->release();
+  if (acked != DDS::RETCODE_OK) {
+    ACE_ERROR((LM_ERROR, "ERROR: wait_for_acknowledgments failed\n"));
+    return false;
+  }
+
+  // Read the samples as they're delivered and check their order.
+  SampleDataReader_var reader = SampleDataReader::_narrow(dr);
+  DDS::ReadCondition_var not_read = dr->create_readcondition(DDS::NOT_READ_SAMPLE_STATE,
+    DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
+  DDS::WaitSet_var ws = new DDS::WaitSet;
+  ws->attach_condition(not_read);
+  std::vector<int> next_seq(instances, 0);
+  int received = 0;
+  bool ok = true;
+  while (ok && received < total) {
+    DDS::ConditionSeq active;
+    const DDS::Duration_t timeout = {30, 0};
+    if (ws->wait(active, timeout) != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR, "ERROR: only read %d of %d samples\n", received, total));
+      ok = false;
+      break;
+    }
+    SampleSeq data;
+    DDS::SampleInfoSeq info;
+    const DDS::ReturnCode_t rc = reader->read_w_condition(data, info, DDS::LENGTH_UNLIMITED, not_read);
+    if (rc == DDS::RETCODE_NO_DATA) {
+      continue;
+    }
+    if (rc != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR, "ERROR: read_w_condition failed\n"));
+      ok = false;
+      break;
+    }
+    ok = check_order(data, info, next_seq);
+    received += data.length();
+    reader->return_loan(data, info);
+  }
+  ws->detach_condition(not_read);
+  dr->delete_readcondition(not_read);
+  if (!ok) {
+    return false;
+  }
+  if (received != total) {
+    ACE_ERROR((LM_ERROR, "ERROR: read %d samples, expected %d\n", received, total));
+    return false;
+  }
+
+  // take returns the same samples in the same order and leaves nothing.
+  SampleSeq data;
+  DDS::SampleInfoSeq info;
+  if (reader->take(data, info, DDS::LENGTH_UNLIMITED, DDS::ANY_SAMPLE_STATE,
+                   DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE) != DDS::RETCODE_OK) {
+    ACE_ERROR((LM_ERROR, "ERROR: take failed\n"));
+    return false;
+  }
+  std::vector<int> take_seq(instances, 0);
+  if (!check_order(data, info, take_seq)) {
+    return false;
+  }
+  if (take_seq != next_seq || static_cast<int>(data.length()) != total) {
+    ACE_ERROR((LM_ERROR, "ERROR: took %u samples, expected %d\n", data.length(), total));
+    return false;
+  }
+  reader->return_loan(data, info);
+  if (reader->take(data, info, DDS::LENGTH_UNLIMITED, DDS::ANY_SAMPLE_STATE,
+                   DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE) != DDS::RETCODE_NO_DATA) {
+    ACE_ERROR((LM_ERROR, "ERROR: samples were left after take\n"));
+    return false;
+  }
+
+  if (listener_impl->timed_out()) {
+    ACE_ERROR((LM_ERROR, "ERROR: on_data_available wasn't released\n"));
+    return false;
+  }
+  return true;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  DDS::DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+  parse_args(argc, argv);
+
+  if (TheServiceParticipant->reader_delivery_queue_size() == 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: DCPSReaderDeliveryQueueSize must be set\n"));
+    return EXIT_FAILURE;
+  }
+  if (instances <= 0 || samples_per_instance <= 0) {
+    ACE_ERROR((LM_ERROR, "ERROR: -instances and -samples must be positive\n"));
+    return EXIT_FAILURE;
+  }
+
+  DDS::DomainParticipant_var participant = dpf->create_participant(DOMAIN_ID,
+    PARTICIPANT_QOS_DEFAULT, 0, OpenDDS::DCPS::DEFAULT_STATUS_MASK);
+  if (CORBA::is_nil(participant.in())) {
+    ACE_ERROR((LM_ERROR, "ERROR: create_participant failed\n"));
+    return EXIT_FAILURE;
+  }
+
+  const bool passed = run(participant);
+
+  participant->delete_contained_entities();
+  dpf->delete_participant(participant);
+  TheServiceParticipant->shutdown();
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,23 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use lib "$ENV{DDS_ROOT}/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+# The queue is kept small so the transport thread fills it and has to fall
+# back to delivering samples itself.
+my $args = '-DCPSReaderDeliveryQueueSize 8';
+
+my $test = new PerlDDS::TestFramework();
+$test->{'nobits'} = 1;
+
+$test->setup_discovery();
+$test->process('queue', 'ReaderDeliveryQueue', $args);
+$test->start_process('queue');
+
+exit $test->finish(180);
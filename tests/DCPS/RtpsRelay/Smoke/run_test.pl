@@ -57,6 +57,9 @@ elsif ($test->flag('partition_same_relay')) {
     $sub_ini = ' sub_same_relay.ini -b 1 -p OCJ';
 }
 
+# Drain several datagrams per readable event (recvmmsg on Linux)
+my $relay_batch_opts = $test->flag('batch') ? " -ReceiveBatchSize 16" : "";
+
 sub get_relay_args {
   my $n = shift;
   my $port_digit = 3 + $n;
@@ -81,8 +84,8 @@ sub get_relay_args {
 }
 
 $test->process("monitor", "monitor", "-DCPSConfigFile monitor.ini");
-$test->process("relay1", "$ENV{DDS_ROOT}/bin/RtpsRelay", get_relay_args(1) . $relay_security_opts);
-$test->process("relay2", "$ENV{DDS_ROOT}/bin/RtpsRelay", get_relay_args(2) . $relay_security_opts) unless uses_one_relay();
+$test->process("relay1", "$ENV{DDS_ROOT}/bin/RtpsRelay", get_relay_args(1) . $relay_security_opts . $relay_batch_opts);
+$test->process("relay2", "$ENV{DDS_ROOT}/bin/RtpsRelay", get_relay_args(2) . $relay_security_opts . $relay_batch_opts) unless uses_one_relay();
 $test->process("publisher", "publisher", "-ORBDebugLevel 1 -DCPSConfigFile". $pub_ini . $pub_sub_security_opts);
 $test->process("subscriber", "subscriber", "-ORBDebugLevel 1 -DCPSConfigFile" . $sub_ini . $pub_sub_security_opts);
 $test->process("metachecker", "metachecker", "127.0.0.1:8081");
@@ -1401,6 +1401,98 @@ int ACE_TMAIN (int argc, ACE_TCHAR *argv[])
 
       } // t7
 
+      {
+        //=====================================================
+        // 7b) show that take_batch takes samples of several instances in one call
+        //=====================================================
+        ACE_DEBUG((LM_INFO,"==== TEST 7b : show that take_batch takes samples of several instances in one call.\n"));
+
+        OpenDDS::DCPS::DataReaderImpl_T<Test::Simple>* const foo_dri =
+          dynamic_cast<OpenDDS::DCPS::DataReaderImpl_T<Test::Simple>*>(foo_dr.in());
+
+        // It is important that the last test case took all of the samples!
+
+        // new instances, since depth=1 would drop a second sample of one instance
+        foo.key = 71;
+        foo.count = 71;
+        foo_dw->write(foo, ::DDS::HANDLE_NIL);
+        foo.key = 72;
+        foo.count = 72;
+        foo_dw->write(foo, ::DDS::HANDLE_NIL);
+
+        const CORBA::ULong max_batch = 3;
+        Test::Simple data[max_batch];
+        OpenDDS::DCPS::BatchSampleInfo info[max_batch];
+        CORBA::ULong total = 0;
+        long count_sum = 0;
+        for (int attempt = 0; total < 2 && attempt < 5; ++attempt) {
+          // wait for writes to propagate
+          if (!wait_for_data(sub.in (), 5))
+            ACE_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT("(%P|%t) t7b ERROR: timeout waiting for data.\n")),
+                            1);
+
+          CORBA::ULong count = 0;
+          const DDS::ReturnCode_t status = foo_dri->take_batch(data, info, max_batch, count);
+          if (status != ::DDS::RETCODE_OK)
+          {
+            ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT("(%P|%t) t7b ERROR: take_batch failed with %C.\n"),
+                    OpenDDS::DCPS::retcode_to_string(status)));
+            test_failed = 1;
+            break;
+          }
+          for (CORBA::ULong i = 0; i < count; ++i)
+          {
+            if (!info[i].valid_data || data[i].key != data[i].count ||
+                info[i].instance_state != ::DDS::ALIVE_INSTANCE_STATE)
+            {
+              ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT("(%P|%t) t7b ERROR: unexpected sample or info.\n") ));
+              test_failed = 1;
+            }
+            count_sum += data[i].count;
+          }
+          total += count;
+        }
+
+        if (total != 2 || count_sum != 71 + 72)
+        {
+          ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT("(%P|%t) t7b ERROR: expected the 2 samples written, got %u.\n"),
+                  total));
+          test_failed = 1;
+        }
+
+        // a dispose is taken as a sample with only the key set
+        data[0].key = -1;
+        foo.key = 71;
+        foo_dw->dispose(foo, ::DDS::HANDLE_NIL);
+        if (!wait_for_data(sub.in (), 5))
+          ACE_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT("(%P|%t) t7b ERROR: timeout waiting for the dispose.\n")),
+                          1);
+
+        CORBA::ULong count = 0;
+        if (foo_dri->take_batch(data, info, max_batch, count) != ::DDS::RETCODE_OK || count != 1 ||
+            info[0].valid_data || data[0].key != 71 ||
+            info[0].instance_state != ::DDS::NOT_ALIVE_DISPOSED_INSTANCE_STATE)
+        {
+          ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT("(%P|%t) t7b ERROR: unexpected sample or info for the dispose.\n") ));
+          test_failed = 1;
+        }
+
+        count = 0;
+        if (foo_dri->take_batch(data, info, max_batch, count) != ::DDS::RETCODE_NO_DATA || count)
+        {
+          ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT("(%P|%t) t7b ERROR: expected no data after the batch take.\n") ));
+          test_failed = 1;
+        }
+
+      } // t7b
+
       const CORBA::Long max_samples = 2;
       // scope must be larger than the sequences that use the allocator.
       BogusExampleAllocator<Test::Simple*,max_samples> the_allocator;
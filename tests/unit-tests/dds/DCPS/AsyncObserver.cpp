@@ -0,0 +1,91 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/AsyncObserver.h>
+#include <dds/DCPS/Time_Helper.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct NullDispatcher : ValueDispatcher {
+    void* new_value() const { return 0; }
+    void delete_value(void*) const {}
+    bool read(ValueReader&, void*, Sample::Extent) const { return false; }
+    bool write(ValueWriter&, const void*, Sample::Extent) const { return false; }
+    DDS::InstanceHandle_t register_instance_helper(DDS::DataWriter*, const void*) const { return DDS::HANDLE_NIL; }
+    DDS::ReturnCode_t write_helper(DDS::DataWriter*, const void*, DDS::InstanceHandle_t) const { return DDS::RETCODE_UNSUPPORTED; }
+    DDS::ReturnCode_t unregister_instance_helper(DDS::DataWriter*, const void*, DDS::InstanceHandle_t) const { return DDS::RETCODE_UNSUPPORTED; }
+    DDS::ReturnCode_t dispose_helper(DDS::DataWriter*, const void*, DDS::InstanceHandle_t) const { return DDS::RETCODE_UNSUPPORTED; }
+  };
+
+  struct CollectingHandler : AsyncObserver::Handler {
+    void on_records(const AsyncObserver::RecordBatch& batch)
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex);
+      records.insert(records.end(), batch.begin(), batch.end());
+    }
+
+    ACE_Thread_Mutex mutex;
+    AsyncObserver::RecordBatch records;
+  };
+
+  Observer::Sample make_sample(const NullDispatcher& dispatcher, DDS::InstanceHandle_t instance, ACE_INT64 seq)
+  {
+    return Observer::Sample(instance, DDS::ALIVE_INSTANCE_STATE, make_time_t(1, 0),
+                            SequenceNumber(seq), 0, dispatcher);
+  }
+}
+
+TEST(dds_DCPS_AsyncObserver, Batches)
+{
+  const NullDispatcher dispatcher;
+  const RcHandle<CollectingHandler> handler = make_rch<CollectingHandler>();
+  // The thread can take records as soon as they're queued, so they may be
+  // handed off in more than one batch, but in order.
+  const AsyncObserver_rch observer = make_rch<AsyncObserver>(handler, 16, TimeDuration(3600));
+
+  observer->on_sample_sent(0, make_sample(dispatcher, 1, 1));
+  observer->on_sample_received(0, make_sample(dispatcher, 2, 2));
+  observer->on_sample_taken(0, make_sample(dispatcher, 2, 3));
+  observer->flush();
+
+  ACE_Guard<ACE_Thread_Mutex> guard(handler->mutex);
+  ASSERT_EQ(3u, handler->records.size());
+  EXPECT_EQ(Observer::Event(Observer::e_SAMPLE_SENT), handler->records[0].event);
+  EXPECT_TRUE(handler->records[0].is_writer);
+  EXPECT_EQ(GUID_UNKNOWN, handler->records[0].entity);
+  EXPECT_EQ(1, handler->records[0].instance);
+  EXPECT_EQ(Observer::Event(Observer::e_SAMPLE_RECEIVED), handler->records[1].event);
+  EXPECT_FALSE(handler->records[1].is_writer);
+  EXPECT_EQ(SequenceNumber(2), handler->records[1].sequence_number);
+  EXPECT_EQ(Observer::Event(Observer::e_SAMPLE_TAKEN), handler->records[2].event);
+  EXPECT_EQ(make_time_t(1, 0), handler->records[2].source_timestamp);
+  EXPECT_FALSE(handler->records[2].observed.is_zero());
+  EXPECT_EQ(0u, observer->dropped());
+}
+
+TEST(dds_DCPS_AsyncObserver, DropWhenFull)
+{
+  const NullDispatcher dispatcher;
+  const RcHandle<CollectingHandler> handler = make_rch<CollectingHandler>();
+  size_t pushed = 0;
+  {
+    const AsyncObserver_rch observer = make_rch<AsyncObserver>(handler, 4, TimeDuration(3600));
+    // The thread may be woken up to take some as they are added, but it can't
+    // keep up with all of them.
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(handler->mutex);
+      for (ACE_INT64 seq = 1; seq <= 100; ++seq) {
+        observer->on_sample_sent(0, make_sample(dispatcher, 1, seq));
+      }
+    }
+    pushed = 100 - observer->dropped();
+    EXPECT_LT(0u, observer->dropped());
+  }
+  // Destroying the observer handles what was queued
+  EXPECT_EQ(pushed, handler->records.size());
+}
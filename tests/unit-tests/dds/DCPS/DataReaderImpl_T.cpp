@@ -0,0 +1,56 @@
+#include <Xcdr2ValueWriterTypeSupportImpl.h>
+
+#include <dds/DCPS/DataReaderImpl_T.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+  typedef OpenDDS::DCPS::DataReaderImpl_T<Test::FinalComplexStruct> ReaderImpl;
+  typedef ReaderImpl::MessageTypeWithAllocator Sample;
+}
+
+TEST(dds_DCPS_DataReaderImpl_T, SamplePoolReuse)
+{
+  ReaderImpl::DataAllocator allocator(2);
+  ReaderImpl::SamplePool pool(1);
+
+  Sample* const first = pool.get(allocator);
+  Sample* const second = pool.get(allocator);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first, second);
+
+  first->seq_field.length(100);
+  const CORBA::Short* const buffer = first->seq_field.get_buffer();
+
+  // The pool only has room for one, so the second is freed
+  Sample::release(first);
+  Sample::release(second);
+
+  Sample* const reused = pool.get(allocator);
+  EXPECT_EQ(first, reused);
+
+  // and the sequence keeps its buffer to be deserialized into
+  reused->seq_field.length(50);
+  EXPECT_EQ(buffer, reused->seq_field.get_buffer());
+
+  Sample* const fresh = pool.get(allocator);
+  EXPECT_NE(reused, fresh);
+  EXPECT_EQ(0u, fresh->seq_field.length());
+
+  Sample::release(fresh);
+  // Released while the pool is full, so this one is freed
+  Sample::release(reused);
+}
+
+TEST(dds_DCPS_DataReaderImpl_T, ReleaseWithoutPool)
+{
+  ReaderImpl::DataAllocator allocator(1);
+
+  // Samples that didn't come from a pool are just freed
+  Sample* const sample = new (allocator) Sample;
+  sample->str_field = "freed";
+  Sample::release(sample);
+
+  Sample::release(0);
+}
@@ -0,0 +1,84 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/DeadlineList.h>
+#include <dds/DCPS/RcObject.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct TestInstance : RcObject {
+    MonotonicTimePoint deadline_;
+    DeadlineLink<TestInstance> deadline_link_;
+  };
+  typedef RcHandle<TestInstance> TestInstance_rch;
+
+  const MonotonicTimePoint start(ACE_Time_Value(1000, 0));
+
+  MonotonicTimePoint at_msec(ACE_UINT64 msec)
+  {
+    return start + TimeDuration::from_msec(msec);
+  }
+}
+
+TEST(dds_DCPS_DeadlineList, InsertInOrder)
+{
+  TestInstance_rch a = make_rch<TestInstance>();
+  TestInstance_rch b = make_rch<TestInstance>();
+  TestInstance_rch c = make_rch<TestInstance>();
+
+  DeadlineList<TestInstance> list;
+  EXPECT_TRUE(list.empty());
+  list.insert(*a, at_msec(10));
+  list.insert(*b, at_msec(20));
+  // Earlier than the end of the list
+  list.insert(*c, at_msec(15));
+  EXPECT_EQ(3u, list.size());
+  EXPECT_EQ(a, list.front());
+
+  // Moving an instance to the end, like writing a sample for it
+  list.insert(*a, at_msec(30));
+  EXPECT_EQ(3u, list.size());
+  EXPECT_EQ(at_msec(30), a->deadline_);
+  EXPECT_EQ(c, list.front());
+  EXPECT_TRUE(list.remove(*c));
+  EXPECT_EQ(b, list.front());
+  EXPECT_TRUE(list.remove(*b));
+  EXPECT_EQ(a, list.front());
+  EXPECT_TRUE(list.remove(*a));
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(dds_DCPS_DeadlineList, Remove)
+{
+  TestInstance_rch a = make_rch<TestInstance>();
+  TestInstance_rch b = make_rch<TestInstance>();
+
+  DeadlineList<TestInstance> list;
+  list.insert(*a, at_msec(10));
+  list.insert(*b, at_msec(10));
+  EXPECT_TRUE(DeadlineList<TestInstance>::contains(*a));
+  EXPECT_TRUE(list.remove(*a));
+  EXPECT_FALSE(list.remove(*a));
+  EXPECT_FALSE(DeadlineList<TestInstance>::contains(*a));
+  EXPECT_EQ(b, list.front());
+  EXPECT_EQ(1u, list.size());
+}
+
+TEST(dds_DCPS_DeadlineList, HoldsReference)
+{
+  TestInstance* raw;
+  DeadlineList<TestInstance> list;
+  {
+    TestInstance_rch a = make_rch<TestInstance>();
+    raw = a.in();
+    list.insert(*a, at_msec(10));
+  }
+  EXPECT_EQ(raw, list.front().in());
+  list.clear();
+  EXPECT_TRUE(list.empty());
+}
@@ -0,0 +1,271 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_NO_PERSISTENCE_PROFILE
+
+#include <dds/DCPS/DurabilityLog.h>
+#include <dds/DCPS/DirentWrapper.h>
+
+#include <gtest/gtest.h>
+
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  const char directory[] = "DurabilityLog_test_dir";
+
+  void remove_directory()
+  {
+    ACE_Dirent dir;
+    if (dir.open(ACE_TEXT(directory)) == 0) {
+      for (ACE_DIRENT* ent = dir.read(); ent; ent = dir.read()) {
+        const String name = ACE_TEXT_ALWAYS_CHAR(ent->d_name);
+        if (name != "." && name != "..") {
+          ACE_OS::unlink(ACE_TEXT_CHAR_TO_TCHAR((String(directory) + '/' + name).c_str()));
+        }
+      }
+    }
+    ACE_OS::rmdir(ACE_TEXT(directory));
+  }
+
+  size_t segment_count()
+  {
+    size_t count = 0;
+    ACE_Dirent dir;
+    if (dir.open(ACE_TEXT(directory)) == 0) {
+      for (ACE_DIRENT* ent = dir.read(); ent; ent = dir.read()) {
+        count += String(ACE_TEXT_ALWAYS_CHAR(ent->d_name)).find("durability-") == 0;
+      }
+    }
+    return count;
+  }
+
+  typedef OPENDDS_MAP(String, String) Files;
+
+  Files read_segments()
+  {
+    Files files;
+    ACE_Dirent dir;
+    if (dir.open(ACE_TEXT(directory)) == 0) {
+      for (ACE_DIRENT* ent = dir.read(); ent; ent = dir.read()) {
+        const String name = ACE_TEXT_ALWAYS_CHAR(ent->d_name);
+        if (name.find("durability-") == 0) {
+          std::ifstream in((String(directory) + '/' + name).c_str(), std::ios::binary);
+          files[name].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+      }
+    }
+    return files;
+  }
+
+  void restore_segments(const Files& files)
+  {
+    for (Files::const_iterator it = files.begin(); it != files.end(); ++it) {
+      const String path = String(directory) + '/' + it->first;
+      if (!std::ifstream(path.c_str())) {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out.write(it->second.data(), it->second.size());
+      }
+    }
+  }
+
+  struct Collector : DurabilityLog::Replayer {
+    void on_sample(const DurabilityLog::Sample& sample)
+    {
+      EXPECT_EQ(7, sample.domain_id);
+      EXPECT_EQ("topic", sample.topic_name);
+      EXPECT_EQ("type", sample.type_name);
+      queue_ids.push_back(sample.queue_id);
+      data.push_back(String(sample.data, sample.length));
+      seconds.push_back(sample.timestamp.sec);
+    }
+
+    OPENDDS_VECTOR(DurabilityLog::QueueId) queue_ids;
+    OPENDDS_VECTOR(String) data;
+    OPENDDS_VECTOR(CORBA::Long) seconds;
+  };
+
+  bool append(DurabilityLog& log, DurabilityLog::QueueId queue_id, const char* data, CORBA::Long sec = 1)
+  {
+    const DDS::Time_t timestamp = {sec, 0};
+    return log.append(queue_id, 7, "topic", "type", timestamp, data, std::strlen(data));
+  }
+}
+
+TEST(dds_DCPS_DurabilityLog, AppendReplay)
+{
+  remove_directory();
+  DurabilityLog::QueueId queue_b;
+  {
+    DurabilityLog log(directory);
+    const DurabilityLog::QueueId queue_a = log.next_queue_id();
+    queue_b = log.next_queue_id();
+    EXPECT_TRUE(append(log, queue_a, "a1"));
+    EXPECT_TRUE(append(log, queue_b, "b1", 2));
+    EXPECT_TRUE(append(log, queue_a, "a2"));
+    EXPECT_TRUE(log.commit());
+    EXPECT_TRUE(log.drop(queue_a));
+    EXPECT_TRUE(log.commit());
+  }
+
+  // A later run sees only what wasn't dropped
+  DurabilityLog log(directory);
+  Collector collector;
+  log.replay(collector);
+  ASSERT_EQ(1u, collector.data.size());
+  EXPECT_EQ(queue_b, collector.queue_ids[0]);
+  EXPECT_EQ("b1", collector.data[0]);
+  EXPECT_EQ(2, collector.seconds[0]);
+  EXPECT_GT(log.next_queue_id(), queue_b);
+  remove_directory();
+}
+
+TEST(dds_DCPS_DurabilityLog, IgnoreIncompleteRecord)
+{
+  remove_directory();
+  {
+    DurabilityLog log(directory);
+    EXPECT_TRUE(append(log, log.next_queue_id(), "complete"));
+  }
+  {
+    // Like a crash in the middle of a commit
+    std::ofstream out((String(directory) + "/durability-00000000.log").c_str(),
+                      std::ios::binary | std::ios::app);
+    const char partial[] = "\x40\0\0\0partial";
+    out.write(partial, sizeof partial - 1);
+  }
+
+  DurabilityLog log(directory);
+  Collector collector;
+  log.replay(collector);
+  ASSERT_EQ(1u, collector.data.size());
+  EXPECT_EQ("complete", collector.data[0]);
+  remove_directory();
+}
+
+TEST(dds_DCPS_DurabilityLog, Compaction)
+{
+  remove_directory();
+  {
+    DurabilityLog log(directory, 256);
+    const DurabilityLog::QueueId dropped = log.next_queue_id();
+    const DurabilityLog::QueueId live = log.next_queue_id();
+    EXPECT_TRUE(append(log, live, "live"));
+    for (int i = 0; i < 20; ++i) {
+      EXPECT_TRUE(append(log, dropped, "dropped"));
+      EXPECT_TRUE(log.commit());
+    }
+    EXPECT_TRUE(log.drop(dropped));
+    EXPECT_TRUE(log.commit());
+    EXPECT_GT(segment_count(), 1u);
+    ASSERT_TRUE(log.needs_compaction());
+
+    ASSERT_TRUE(log.begin_compaction());
+    EXPECT_TRUE(append(log, live, "live"));
+    // Dropped during compaction, so appending it is ignored
+    EXPECT_TRUE(log.drop(dropped));
+    EXPECT_TRUE(append(log, dropped, "dropped"));
+    EXPECT_TRUE(log.end_compaction());
+    EXPECT_EQ(1u, segment_count());
+    EXPECT_FALSE(log.needs_compaction());
+  }
+
+  DurabilityLog log(directory, 256);
+  Collector collector;
+  log.replay(collector);
+  ASSERT_EQ(1u, collector.data.size());
+  EXPECT_EQ("live", collector.data[0]);
+  remove_directory();
+}
+
+TEST(dds_DCPS_DurabilityLog, CrashBeforeRemovingSegments)
+{
+  remove_directory();
+  {
+    DurabilityLog log(directory, 256);
+    const DurabilityLog::QueueId dropped = log.next_queue_id();
+    const DurabilityLog::QueueId live = log.next_queue_id();
+    EXPECT_TRUE(append(log, live, "live"));
+    for (int i = 0; i < 20; ++i) {
+      EXPECT_TRUE(append(log, dropped, "dropped"));
+      EXPECT_TRUE(log.commit());
+    }
+    EXPECT_TRUE(log.drop(dropped));
+    EXPECT_TRUE(log.commit());
+    const Files old_segments = read_segments();
+
+    ASSERT_TRUE(log.begin_compaction());
+    EXPECT_TRUE(append(log, live, "live"));
+    EXPECT_TRUE(log.end_compaction());
+    // Like a crash after the live samples were committed but before the old
+    // segments were removed
+    restore_segments(old_segments);
+    EXPECT_GT(segment_count(), 1u);
+  }
+
+  DurabilityLog log(directory, 256);
+  Collector collector;
+  log.replay(collector);
+  ASSERT_EQ(1u, collector.data.size());
+  EXPECT_EQ("live", collector.data[0]);
+  // Replay finishes removing them
+  EXPECT_EQ(1u, segment_count());
+  remove_directory();
+}
+
+TEST(dds_DCPS_DurabilityLog, InterruptedCompaction)
+{
+  remove_directory();
+  DurabilityLog::QueueId live;
+  {
+    DurabilityLog log(directory, 256);
+    const DurabilityLog::QueueId dropped = log.next_queue_id();
+    live = log.next_queue_id();
+    EXPECT_TRUE(append(log, live, "live"));
+    for (int i = 0; i < 20; ++i) {
+      EXPECT_TRUE(append(log, dropped, "dropped"));
+      EXPECT_TRUE(log.commit());
+    }
+    EXPECT_TRUE(log.drop(dropped));
+    EXPECT_TRUE(log.commit());
+
+    // Like a crash before end_compaction
+    ASSERT_TRUE(log.begin_compaction());
+    EXPECT_TRUE(append(log, live, "live"));
+    EXPECT_TRUE(log.commit());
+  }
+
+  DurabilityLog::QueueId later;
+  {
+    DurabilityLog log(directory, 256);
+    Collector collector;
+    log.replay(collector);
+    ASSERT_EQ(1u, collector.data.size());
+    EXPECT_EQ(live, collector.queue_ids[0]);
+    EXPECT_EQ("live", collector.data[0]);
+
+    later = log.next_queue_id();
+    EXPECT_TRUE(append(log, later, "later"));
+    EXPECT_TRUE(log.commit());
+  }
+
+  DurabilityLog log(directory, 256);
+  Collector collector;
+  log.replay(collector);
+  ASSERT_EQ(2u, collector.data.size());
+  EXPECT_EQ("live", collector.data[0]);
+  EXPECT_EQ(later, collector.queue_ids[1]);
+  EXPECT_EQ("later", collector.data[1]);
+  remove_directory();
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/LatencyHistogram.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  TimeDuration usec(ACE_UINT64 value)
+  {
+    return TimeDuration(static_cast<time_t>(value / 1000000),
+                        static_cast<suseconds_t>(value % 1000000));
+  }
+}
+
+TEST(dds_DCPS_LatencyHistogram, Buckets)
+{
+  EXPECT_EQ(0u, LatencyHistogram::bucket_index(0));
+  EXPECT_EQ(15u, LatencyHistogram::bucket_index(15));
+  EXPECT_EQ(16u, LatencyHistogram::bucket_index(16));
+  EXPECT_EQ(31u, LatencyHistogram::bucket_index(31));
+  // 32 and 33 share a bucket
+  EXPECT_EQ(32u, LatencyHistogram::bucket_index(32));
+  EXPECT_EQ(32u, LatencyHistogram::bucket_index(33));
+  EXPECT_EQ(33u, LatencyHistogram::bucket_index(34));
+  EXPECT_EQ(LatencyHistogram::bucket_count - 1,
+            LatencyHistogram::bucket_index(ACE_UINT64(1) << 40));
+
+  for (size_t i = 0; i < LatencyHistogram::bucket_count; ++i) {
+    const ACE_UINT64 upper = LatencyHistogram::bucket_upper_bound(i);
+    EXPECT_EQ(i, LatencyHistogram::bucket_index(upper));
+    if (i + 1 < LatencyHistogram::bucket_count) {
+      EXPECT_EQ(i + 1, LatencyHistogram::bucket_index(upper + 1));
+    }
+  }
+}
+
+TEST(dds_DCPS_LatencyHistogram, Percentiles)
+{
+  LatencyHistogram histogram;
+  EXPECT_EQ(0u, histogram.count());
+  EXPECT_EQ(TimeDuration::zero_value, histogram.percentile(0.5));
+
+  for (int i = 0; i < 980; ++i) {
+    histogram.record(usec(100));
+  }
+  for (int i = 0; i < 28; ++i) {
+    histogram.record(usec(10000));
+  }
+  histogram.record(usec(2000000));
+  histogram.record(usec(2000000));
+
+  const LatencyHistogram::Summary summary = histogram.summary();
+  EXPECT_EQ(1010u, summary.count);
+  // Within a sixteenth of the actual value
+  EXPECT_GE(summary.p50, usec(100));
+  EXPECT_LE(summary.p50, usec(107));
+  EXPECT_GE(summary.p99, usec(10000));
+  EXPECT_LE(summary.p99, usec(10625));
+  EXPECT_EQ(usec(2000000), summary.p999);
+  EXPECT_EQ(usec(2000000), summary.maximum);
+}
+
+TEST(dds_DCPS_LatencyHistogram, NegativeAndReset)
+{
+  LatencyHistogram histogram;
+  histogram.record(TimeDuration(-1));
+  EXPECT_EQ(1u, histogram.count());
+  EXPECT_EQ(TimeDuration::zero_value, histogram.maximum());
+
+  histogram.record(usec(500));
+  histogram.reset();
+  EXPECT_EQ(0u, histogram.count());
+  EXPECT_EQ(TimeDuration::zero_value, histogram.maximum());
+}
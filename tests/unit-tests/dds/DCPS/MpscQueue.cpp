@@ -0,0 +1,90 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/MpscQueue.h>
+#include <dds/DCPS/ThreadPool.h>
+
+#include <ace/OS_NS_Thread.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+const int producer_count = 4;
+const int produced_count = 10000;
+
+struct Producers {
+  MpscQueue<int> queue;
+  Atomic<int> next_producer;
+
+  Producers()
+    : queue(16)
+    , next_producer(0)
+  {}
+};
+
+ACE_THR_FUNC_RETURN produce(void* arg)
+{
+  Producers& producers = *static_cast<Producers*>(arg);
+  const int producer = producers.next_producer++;
+  for (int i = 0; i < produced_count; ++i) {
+    while (!producers.queue.push(producer * produced_count + i)) {
+      ACE_OS::thr_yield();
+    }
+  }
+  return 0;
+}
+
+} // (anonymous) namespace
+
+TEST(dds_DCPS_MpscQueue, PushPop)
+{
+  // Rounded up to a power of two
+  MpscQueue<int> queue(3);
+  EXPECT_EQ(queue.capacity(), 4u);
+
+  int value = 0;
+  EXPECT_FALSE(queue.pop(value));
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(queue.push(i));
+  }
+  EXPECT_FALSE(queue.push(5));
+
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 1);
+  // Wraps around the end of the ring
+  EXPECT_TRUE(queue.push(5));
+  for (int i = 2; i <= 5; ++i) {
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(dds_DCPS_MpscQueue, ProducerThreads)
+{
+  Producers producers;
+  int expected[producer_count] = {};
+  int total = 0;
+  {
+    ThreadPool threads(producer_count, produce, &producers);
+    while (total < producer_count * produced_count) {
+      int value;
+      if (producers.queue.pop(value)) {
+        // Each producer's values come out in the order it pushed them
+        const int producer = value / produced_count;
+        EXPECT_EQ(value % produced_count, expected[producer]);
+        expected[producer] = value % produced_count + 1;
+        ++total;
+      } else {
+        ACE_OS::thr_yield();
+      }
+    }
+  }
+  int value;
+  EXPECT_FALSE(producers.queue.pop(value));
+}
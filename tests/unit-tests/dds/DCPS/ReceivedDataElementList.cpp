@@ -0,0 +1,66 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/ReceivedDataElementList.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct LongWithAllocator {
+    LongWithAllocator() : value(0) {}
+    ACE_CDR::Long* message() { return &value; }
+    static void release(LongWithAllocator* sample) { delete sample; }
+    ACE_CDR::Long value;
+  };
+
+  const Encoding encoding(Encoding::KIND_XCDR2, ENDIAN_BIG);
+
+  ReceivedDataElement* make_element(ACE_New_Allocator& pool, ACE_Recursive_Thread_Mutex& mutex,
+                                    ACE_Message_Block* payload)
+  {
+    DataSampleHeader header;
+    header.message_id_ = SAMPLE_DATA;
+    ReceivedDataElement* const rde =
+      new (pool) ReceivedDataElementWithType<LongWithAllocator>(header, new LongWithAllocator, &mutex);
+    rde->deferred_payload_.reset(payload);
+    rde->deferred_encoding_ = encoding;
+    return rde;
+  }
+}
+
+TEST(dds_DCPS_ReceivedDataElementList, CompleteDeferredData)
+{
+  ACE_Message_Block* const payload = new ACE_Message_Block(8);
+  Serializer ser(payload, encoding);
+  ASSERT_TRUE(ser << ACE_CDR::Long(42));
+
+  ACE_New_Allocator pool;
+  ACE_Recursive_Thread_Mutex mutex;
+  ReceivedDataElement* const rde = make_element(pool, mutex, payload);
+  EXPECT_TRUE(rde->complete_data());
+  EXPECT_EQ(42, static_cast<LongWithAllocator*>(rde->registered_data_)->value);
+  EXPECT_TRUE(rde->valid_data_);
+  EXPECT_FALSE(rde->deferred_payload_.get());
+
+  // Already complete
+  EXPECT_TRUE(rde->complete_data());
+  rde->dec_ref();
+}
+
+TEST(dds_DCPS_ReceivedDataElementList, CompleteDeferredDataFails)
+{
+  ACE_Message_Block* const payload = new ACE_Message_Block(8);
+  payload->wr_ptr(2);
+
+  ACE_New_Allocator pool;
+  ACE_Recursive_Thread_Mutex mutex;
+  ReceivedDataElement* const rde = make_element(pool, mutex, payload);
+  EXPECT_FALSE(rde->complete_data());
+  EXPECT_FALSE(rde->valid_data_);
+  EXPECT_FALSE(rde->deferred_payload_.get());
+  rde->dec_ref();
+}
@@ -0,0 +1,110 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/SampleRecording.h>
+#include <dds/DCPS/DirentWrapper.h>
+#include <dds/DCPS/GuidUtils.h>
+
+#include <gtest/gtest.h>
+
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <cstring>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  const char directory[] = "SampleRecording_test_dir";
+
+  void remove_directory()
+  {
+    ACE_Dirent dir;
+    if (dir.open(ACE_TEXT(directory)) == 0) {
+      for (ACE_DIRENT* ent = dir.read(); ent; ent = dir.read()) {
+        const String name = ACE_TEXT_ALWAYS_CHAR(ent->d_name);
+        if (name != "." && name != "..") {
+          ACE_OS::unlink(ACE_TEXT_CHAR_TO_TCHAR((String(directory) + '/' + name).c_str()));
+        }
+      }
+    }
+    ACE_OS::rmdir(ACE_TEXT(directory));
+  }
+
+  RawDataSample make_sample(const char* data, CORBA::Long sec)
+  {
+    DataSampleHeader header;
+    header.message_id_ = SAMPLE_DATA;
+    header.sequence_ = sec + 1;
+    header.message_length_ = static_cast<ACE_UINT32>(std::strlen(data));
+    Message_Block_Ptr mb(new ACE_Message_Block(std::strlen(data)));
+    mb->copy(data, std::strlen(data));
+    GUID_t pub = GUID_UNKNOWN;
+    pub.entityId.entityKey[2] = 3;
+    return RawDataSample(header, SAMPLE_DATA, sec, 5, pub, true, mb.get(),
+                         Encoding::KIND_XCDR2);
+  }
+
+  struct Collector : RecordingPlayback::SampleHandler {
+    DDS::ReturnCode_t on_sample(const RawDataSample& sample, const SystemTimePoint& recorded)
+    {
+      EXPECT_EQ(SAMPLE_DATA, sample.message_id_);
+      EXPECT_EQ(5u, sample.source_timestamp_.nanosec);
+      EXPECT_EQ(3, sample.publication_id_.entityId.entityKey[2]);
+      EXPECT_TRUE(sample.sample_byte_order_);
+      EXPECT_EQ(Encoding::KIND_XCDR2, sample.encoding_kind_);
+      EXPECT_EQ(sample.source_timestamp_.sec + 1, sample.header_.sequence_.getValue());
+      data.push_back(String(sample.sample_->rd_ptr(), sample.sample_->length()));
+      times.push_back(recorded);
+      return DDS::RETCODE_OK;
+    }
+
+    OPENDDS_VECTOR(String) data;
+    OPENDDS_VECTOR(SystemTimePoint) times;
+  };
+}
+
+TEST(dds_DCPS_SampleRecording, RecordPlay)
+{
+  remove_directory();
+  {
+    // Small segments so the recording spans several of them
+    RecordingListener_rch listener = make_rch<RecordingListener>(directory, 256);
+    for (int i = 0; i < 20; ++i) {
+      listener->on_sample_data_received(0, make_sample("recorded sample", i));
+    }
+    listener->flush();
+    EXPECT_EQ(0u, listener->dropped());
+  }
+
+  RecordingPlayback playback(directory);
+  Collector all;
+  EXPECT_EQ(DDS::RETCODE_OK, playback.play(all));
+  ASSERT_EQ(20u, all.data.size());
+  for (size_t i = 0; i < all.data.size(); ++i) {
+    EXPECT_EQ("recorded sample", all.data[i]);
+  }
+
+  // Playing a range only passes the samples recorded in it
+  Collector range;
+  EXPECT_EQ(DDS::RETCODE_OK, playback.play(range, 0, all.times[5], all.times[15]));
+  ASSERT_FALSE(range.data.empty());
+  EXPECT_GE(range.times.front(), all.times[5]);
+  EXPECT_LT(range.times.back(), all.times[15]);
+  remove_directory();
+}
+
+TEST(dds_DCPS_SampleRecording, DropWhenFull)
+{
+  remove_directory();
+  {
+    RecordingListener_rch listener =
+      make_rch<RecordingListener>(directory, RecordingListener::default_segment_size, 1);
+    listener->on_sample_data_received(0, make_sample("dropped", 1));
+    listener->flush();
+    EXPECT_EQ(1u, listener->dropped());
+  }
+  remove_directory();
+}
@@ -0,0 +1,75 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/SpscQueue.h>
+#include <dds/DCPS/ThreadPool.h>
+
+#include <ace/OS_NS_Thread.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+const int produced_count = 10000;
+
+ACE_THR_FUNC_RETURN produce(void* arg)
+{
+  SpscQueue<int>& queue = *static_cast<SpscQueue<int>*>(arg);
+  for (int i = 0; i < produced_count; ++i) {
+    while (!queue.push(i)) {
+      ACE_OS::thr_yield();
+    }
+  }
+  return 0;
+}
+
+} // (anonymous) namespace
+
+TEST(dds_DCPS_SpscQueue, PushPop)
+{
+  SpscQueue<int> queue(2);
+  EXPECT_EQ(queue.capacity(), 2u);
+  EXPECT_TRUE(queue.empty());
+
+  int value = 0;
+  EXPECT_FALSE(queue.pop(value));
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_FALSE(queue.push(3));
+  EXPECT_FALSE(queue.empty());
+
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 1);
+  // Wraps around the end of the ring
+  EXPECT_TRUE(queue.push(3));
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(queue.pop(value));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(dds_DCPS_SpscQueue, ProducerThread)
+{
+  SpscQueue<int> queue(16);
+  int expected = 0;
+  {
+    ThreadPool producer(1, produce, &queue);
+    while (expected < produced_count) {
+      int value;
+      if (queue.pop(value)) {
+        // Not ASSERT, returning would leave the producer blocked on a full queue
+        EXPECT_EQ(value, expected);
+        expected = value + 1;
+      } else {
+        ACE_OS::thr_yield();
+      }
+    }
+  }
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,153 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/TimerWheel.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  const MonotonicTimePoint start(ACE_Time_Value(1000, 0));
+
+  MonotonicTimePoint at_msec(ACE_UINT64 msec)
+  {
+    return start + TimeDuration::from_msec(msec);
+  }
+
+  void* arg(size_t i)
+  {
+    return reinterpret_cast<void*>(i);
+  }
+
+  void fun(void*) {}
+}
+
+TEST(dds_DCPS_TimerWheel, ExpireInOrder)
+{
+  TimerWheel wheel(start);
+  EXPECT_TRUE(wheel.insert(1, std::make_pair(fun, arg(1)), at_msec(50)));
+  EXPECT_TRUE(wheel.insert(2, std::make_pair(fun, arg(2)), at_msec(10)));
+  // Far enough to be moved down two levels
+  EXPECT_TRUE(wheel.insert(3, std::make_pair(fun, arg(3)), at_msec(5000)));
+  EXPECT_FALSE(wheel.insert(3, std::make_pair(fun, arg(3)), at_msec(5000)));
+  EXPECT_EQ(3u, wheel.size());
+
+  TimerWheel::EventQueue expired;
+  wheel.expire(at_msec(9), expired);
+  EXPECT_TRUE(expired.empty());
+  EXPECT_LE(wheel.next_expiration(), at_msec(10));
+
+  wheel.expire(at_msec(60), expired);
+  ASSERT_EQ(2u, expired.size());
+  EXPECT_EQ(arg(2), expired[0].second);
+  EXPECT_EQ(arg(1), expired[1].second);
+
+  expired.clear();
+  wheel.expire(at_msec(4999), expired);
+  EXPECT_TRUE(expired.empty());
+  wheel.expire(at_msec(5000), expired);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(arg(3), expired[0].second);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_TRUE(wheel.next_expiration().is_max());
+}
+
+TEST(dds_DCPS_TimerWheel, SameExpirationInInsertOrder)
+{
+  TimerWheel wheel(start);
+  TimerWheel::EventQueue expired;
+  // Inserted at different distances, so they start in different levels
+  EXPECT_TRUE(wheel.insert(1, std::make_pair(fun, arg(1)), at_msec(5000)));
+  EXPECT_TRUE(wheel.insert(2, std::make_pair(fun, arg(2)), at_msec(5000)));
+  wheel.expire(at_msec(4000), expired);
+  EXPECT_TRUE(wheel.insert(3, std::make_pair(fun, arg(3)), at_msec(5000)));
+  wheel.expire(at_msec(4950), expired);
+  EXPECT_TRUE(wheel.insert(4, std::make_pair(fun, arg(4)), at_msec(5000)));
+  wheel.expire(at_msec(4995), expired);
+  EXPECT_TRUE(wheel.insert(5, std::make_pair(fun, arg(5)), at_msec(5000)));
+  EXPECT_TRUE(expired.empty());
+
+  wheel.expire(at_msec(5000), expired);
+  ASSERT_EQ(5u, expired.size());
+  for (size_t i = 0; i < expired.size(); ++i) {
+    EXPECT_EQ(arg(i + 1), expired[i].second);
+  }
+
+  // and when they're already due
+  expired.clear();
+  EXPECT_TRUE(wheel.insert(6, std::make_pair(fun, arg(6)), at_msec(10)));
+  EXPECT_TRUE(wheel.insert(7, std::make_pair(fun, arg(7)), at_msec(10)));
+  wheel.expire(at_msec(5000), expired);
+  ASSERT_EQ(2u, expired.size());
+  EXPECT_EQ(arg(6), expired[0].second);
+  EXPECT_EQ(arg(7), expired[1].second);
+}
+
+TEST(dds_DCPS_TimerWheel, NeverEarly)
+{
+  TimerWheel wheel(start, TimeDuration::from_msec(10));
+  EXPECT_TRUE(wheel.insert(1, std::make_pair(fun, arg(1)), at_msec(15)));
+
+  TimerWheel::EventQueue expired;
+  wheel.expire(at_msec(14), expired);
+  EXPECT_TRUE(expired.empty());
+  wheel.expire(at_msec(19), expired);
+  EXPECT_TRUE(expired.empty());
+  wheel.expire(at_msec(20), expired);
+  EXPECT_EQ(1u, expired.size());
+}
+
+TEST(dds_DCPS_TimerWheel, Erase)
+{
+  TimerWheel wheel(start);
+  EXPECT_TRUE(wheel.insert(1, std::make_pair(fun, arg(1)), at_msec(10)));
+  EXPECT_TRUE(wheel.insert(2, std::make_pair(fun, arg(2)), at_msec(20)));
+  EXPECT_TRUE(wheel.insert(3, std::make_pair(fun, arg(1)), at_msec(30)));
+  EXPECT_TRUE(wheel.insert(4, std::make_pair(fun, arg(2)), at_msec(40)));
+
+  TimerWheel::FunArgPair event;
+  EXPECT_TRUE(wheel.erase(2, &event));
+  EXPECT_EQ(arg(2), event.second);
+  EXPECT_FALSE(wheel.erase(2));
+  EXPECT_FALSE(wheel.contains(2));
+  EXPECT_EQ(2u, wheel.erase(std::make_pair(fun, arg(1))));
+  EXPECT_EQ(1u, wheel.size());
+
+  TimerWheel::EventQueue expired;
+  wheel.expire(at_msec(100), expired);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(arg(2), expired[0].second);
+}
+
+TEST(dds_DCPS_TimerWheel, PastEndOfWheel)
+{
+  TimerWheel wheel(start);
+  // More than the 64^4 ms the wheel holds
+  const ACE_UINT64 far = 20000000;
+  EXPECT_TRUE(wheel.insert(1, std::make_pair(fun, arg(1)), at_msec(far)));
+  EXPECT_TRUE(wheel.insert(2, std::make_pair(fun, arg(2)), at_msec(0)));
+
+  TimerWheel::EventQueue expired;
+  wheel.expire(at_msec(0), expired);
+  EXPECT_EQ(1u, expired.size());
+  wheel.expire(at_msec(far - 1), expired);
+  EXPECT_EQ(1u, expired.size());
+  wheel.expire(at_msec(far), expired);
+  EXPECT_EQ(2u, expired.size());
+}
+
+TEST(dds_DCPS_TimerWheel, Clear)
+{
+  TimerWheel wheel(start);
+  EXPECT_TRUE(wheel.insert(1, std::make_pair(fun, arg(1)), at_msec(10)));
+  EXPECT_TRUE(wheel.insert(2, std::make_pair(fun, arg(2)), at_msec(100000)));
+
+  TimerWheel::EventQueue events;
+  wheel.clear(&events);
+  EXPECT_EQ(2u, events.size());
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_TRUE(wheel.insert(1, std::make_pair(fun, arg(1)), at_msec(10)));
+}
@@ -0,0 +1,77 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/Tracepoints.h>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  size_t count(const std::string& haystack, const std::string& needle)
+  {
+    size_t found = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string::npos;
+         pos = haystack.find(needle, pos + needle.size())) {
+      ++found;
+    }
+    return found;
+  }
+}
+
+TEST(dds_DCPS_Tracepoints, ChromeTrace)
+{
+  Tracepoints::clear();
+  {
+    const TraceScope scope(Tracepoints::DATA_RECEIVED, 7);
+    Tracepoints::record(Tracepoints::REASSEMBLE, Tracepoints::PHASE_INSTANT, 8);
+  }
+
+  std::ostringstream out;
+  Tracepoints::write_chrome_trace(out);
+  const std::string trace = out.str();
+
+  EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+  EXPECT_LE(1u, count(trace, "\"ph\":\"M\""));
+  EXPECT_EQ(2u, count(trace, "\"name\":\"DataReaderImpl::data_received\""));
+  EXPECT_EQ(1u, count(trace, "\"ph\":\"B\""));
+  EXPECT_EQ(1u, count(trace, "\"ph\":\"E\""));
+  EXPECT_EQ(1u, count(trace, "\"ph\":\"i\",\"s\":\"t\""));
+  EXPECT_EQ(2u, count(trace, "\"args\":{\"arg\":7}"));
+  EXPECT_EQ(1u, count(trace, "\"args\":{\"arg\":8}"));
+  EXPECT_LT(trace.find("\"ph\":\"B\""), trace.find("\"ph\":\"i\""));
+  EXPECT_LT(trace.find("\"ph\":\"i\""), trace.find("\"ph\":\"E\""));
+}
+
+TEST(dds_DCPS_Tracepoints, KeepsMostRecent)
+{
+  Tracepoints::clear();
+  for (size_t i = 0; i < Tracepoints::capacity + 10; ++i) {
+    Tracepoints::record(Tracepoints::WRITE, Tracepoints::PHASE_INSTANT, static_cast<ACE_INT64>(i));
+  }
+
+  std::ostringstream out;
+  Tracepoints::write_chrome_trace(out);
+  const std::string trace = out.str();
+
+  // The oldest record in a full buffer is the next one to be overwritten, so
+  // it's left out.
+  EXPECT_EQ(Tracepoints::capacity - 1, count(trace, "\"ph\":\"i\""));
+  EXPECT_EQ(0u, count(trace, "\"args\":{\"arg\":10}"));
+  EXPECT_EQ(1u, count(trace, "\"args\":{\"arg\":11}"));
+}
+
+TEST(dds_DCPS_Tracepoints, Clear)
+{
+  Tracepoints::record(Tracepoints::WRITE, Tracepoints::PHASE_INSTANT, 1);
+  Tracepoints::clear();
+
+  std::ostringstream out;
+  Tracepoints::write_chrome_trace(out);
+  EXPECT_EQ(0u, count(out.str(), "\"ph\":\"i\""));
+}
@@ -310,6 +310,32 @@ void verify_single_value_struct(DDS::DynamicType_var type, const DataView& expec
 
   assert_serialized_data(512, data, expected_cdr);
 
+  // Setting the members in reverse order of ID gives the same result.
+  XTypes::DynamicDataImpl reversed(type);
+#ifdef DDS_HAS_WCHAR
+  EXPECT_EQ(reversed.set_wstring_value(18, input.wstr), DDS::RETCODE_OK);
+#endif
+  EXPECT_EQ(reversed.set_string_value(17, input.str), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_complex_value(16, nested_data), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_boolean_value(15, input._cxx_bool), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_byte_value(14, input.byte), DDS::RETCODE_OK);
+#ifdef DDS_HAS_WCHAR
+  EXPECT_EQ(reversed.set_char16_value(13, input.char_16), DDS::RETCODE_OK);
+#endif
+  EXPECT_EQ(reversed.set_char8_value(12, input.char_8), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_float64_value(10, input.float_64), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_float32_value(9, input.float_32), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_uint64_value(8, input.uint_64), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_int64_value(7, input.int_64), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_uint16_value(6, input.uint_16), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_int16_value(5, input.int_16), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_uint8_value(4, input.uint_8), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_int8_value(3, input.int_8), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_uint32_value(2, input.uint_32), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_int32_value(1, input.int_32), DDS::RETCODE_OK);
+  EXPECT_EQ(reversed.set_int32_value(0, input.my_enum), DDS::RETCODE_OK);
+  assert_serialized_data(512, reversed, expected_cdr);
+
   // Rewrite a member (of type short)
   const DDS::MemberId rewrite_id = 5;
   ret = type->get_member(dtm, rewrite_id);
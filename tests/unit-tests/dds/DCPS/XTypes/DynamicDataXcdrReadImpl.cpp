@@ -381,6 +381,42 @@ void verify_single_value_struct(DDS::DynamicData_ptr data)
   EXPECT_EQ(expected.my_enum, my_enum);
 }
 
+template<typename StructType>
+void verify_out_of_order_reads(DDS::DynamicData_ptr data)
+{
+  StructType expected;
+  set_single_value_struct(expected);
+
+  // Members are located through positions recorded by earlier reads, so
+  // reading backwards and then forwards again must give the same values.
+  CORBA::String_var str;
+  ASSERT_RC_OK(data->get_string_value(str.out(), 17));
+  EXPECT_STREQ(expected.str.in(), str.in());
+
+  ACE_CDR::LongLong int_64;
+  ASSERT_RC_OK(data->get_int64_value(int_64, 7));
+  EXPECT_EQ(expected.int_64, int_64);
+
+  ACE_CDR::Long my_enum;
+  ASSERT_RC_OK(data->get_int32_value(my_enum, 0));
+  EXPECT_EQ(expected.my_enum, my_enum);
+
+  ACE_CDR::UShort uint_16;
+  ASSERT_RC_OK(data->get_uint16_value(uint_16, 6));
+  EXPECT_EQ(expected.uint_16, uint_16);
+
+  ACE_CDR::Boolean bool_value;
+  ASSERT_RC_OK(data->get_boolean_value(bool_value, 15));
+  EXPECT_EQ(expected._cxx_bool, bool_value);
+
+  ASSERT_RC_OK(data->get_string_value(str.out(), 17));
+  EXPECT_STREQ(expected.str.in(), str.in());
+
+  ACE_CDR::Long int_32;
+  ASSERT_RC_OK(data->get_int32_value(int_32, 1));
+  EXPECT_EQ(expected.int_32, int_32);
+}
+
 void verify_index_mapping(DDS::DynamicData_ptr data)
 {
   ACE_CDR::ULong count = data->get_item_count();
@@ -880,6 +916,10 @@ TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Mutable_ReadValueFromStruct)
   XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
 
   verify_single_value_struct<MutableSingleValueStruct>(&data);
+
+  XTypes::DynamicDataXcdrReadImpl fresh_data(&msg, xcdr2, dt);
+  verify_out_of_order_reads<MutableSingleValueStruct>(&fresh_data);
+  verify_out_of_order_reads<MutableSingleValueStruct>(&data);
 }
 
 TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Mutable_StructWithOptionalMembers)
@@ -1461,6 +1501,10 @@ TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Appendable_ReadValueFromStruct)
   XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
 
   verify_single_value_struct<AppendableSingleValueStruct>(&data);
+
+  XTypes::DynamicDataXcdrReadImpl fresh_data(&msg, xcdr2, dt);
+  verify_out_of_order_reads<AppendableSingleValueStruct>(&fresh_data);
+  verify_out_of_order_reads<AppendableSingleValueStruct>(&data);
 }
 
 TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Appendable_ReadValueFromStructXCDR1)
@@ -2342,6 +2386,10 @@ TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Final_ReadValueFromStruct)
   XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
 
   verify_single_value_struct<FinalSingleValueStruct>(&data);
+
+  XTypes::DynamicDataXcdrReadImpl fresh_data(&msg, xcdr2, dt);
+  verify_out_of_order_reads<FinalSingleValueStruct>(&fresh_data);
+  verify_out_of_order_reads<FinalSingleValueStruct>(&data);
 }
 
 TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Final_ReadValueFromStructXCDR1)
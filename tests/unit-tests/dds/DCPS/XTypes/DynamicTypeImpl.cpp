@@ -659,6 +659,39 @@ TEST_F(dds_DCPS_XTypes_DynamicTypeImpl, CompleteToDynamicType_CircularStruct)
   struct_expected_dt_var->clear();
 }
 
+TEST_F(dds_DCPS_XTypes_DynamicTypeImpl, SerializationPlan)
+{
+  const XTypes::TypeIdentifier& com_ti = DCPS::getCompleteTypeIdentifier<DCPS::MyModCompleteToDynamic_MyAnonStruct_xtag>();
+  const XTypes::TypeMap& com_map = DCPS::getCompleteTypeMap<DCPS::MyModCompleteToDynamic_MyAnonStruct_xtag>();
+  const XTypes::TypeMap::const_iterator pos = com_map.find(com_ti);
+  ASSERT_TRUE(pos != com_map.end());
+  DCPS::GUID_t fake_guid = OpenDDS::DCPS::GUID_UNKNOWN;
+  DDS::DynamicType_var dt = tls_->complete_to_dynamic(pos->second.complete, fake_guid);
+
+  const XTypes::SerializationPlan_rch plan = XTypes::get_serialization_plan(dt);
+  ASSERT_TRUE(plan);
+  EXPECT_EQ(DDS::APPENDABLE, plan->extensibility);
+  EXPECT_FALSE(plan->has_explicit_keys);
+  ASSERT_EQ(2u, plan->members.size());
+  EXPECT_EQ(0u, plan->members[0].id);
+  EXPECT_EQ(XTypes::TK_SEQUENCE, plan->members[0].kind);
+  EXPECT_FALSE(plan->members[0].is_optional);
+  EXPECT_EQ(1u, plan->members[1].id);
+  EXPECT_EQ(XTypes::TK_ARRAY, plan->members[1].treat_as);
+
+  // The plan is computed once and then shared
+  EXPECT_EQ(plan.in(), XTypes::get_serialization_plan(dt).in());
+
+  // Only structures have a plan
+  DDS::DynamicTypeMember_var dtm;
+  ASSERT_EQ(DDS::RETCODE_OK, dt->get_member_by_index(dtm, 0));
+  DDS::MemberDescriptor_var md;
+  ASSERT_EQ(DDS::RETCODE_OK, dtm->get_descriptor(md));
+  EXPECT_FALSE(XTypes::get_serialization_plan(md->type()));
+
+  dt->clear();
+}
+
 void dds_DCPS_XTypes_DynamicTypeImpl::MoreSetup()
 {
   XTypes::TypeIdentifierPairSeq tid_pairs;
@@ -0,0 +1,105 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <CompleteToMinimalTypeObjectTypeSupportImpl.h>
+
+#include <dds/DCPS/XTypes/TypeObjectCache.h>
+
+#include <gtest/gtest.h>
+
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <fstream>
+
+using namespace OpenDDS;
+using namespace OpenDDS::XTypes;
+
+namespace {
+  const char directory[] = "TypeObjectCache_test_dir";
+
+  const TypeIdentifier& struct_ti()
+  {
+    return DCPS::getMinimalTypeIdentifier<DCPS::MyModCompleteToMinimal_MyStruct_xtag>();
+  }
+
+  const TypeObject& struct_to()
+  {
+    const TypeMap& type_map = DCPS::getMinimalTypeMap<DCPS::MyModCompleteToMinimal_MyStruct_xtag>();
+    return type_map.find(struct_ti())->second;
+  }
+
+  DCPS::String struct_path()
+  {
+    return DCPS::String(directory) + "/minimal_" + equivalence_hash_to_string(struct_ti().equivalence_hash());
+  }
+
+  void remove_directory()
+  {
+    ACE_OS::unlink(ACE_TEXT_CHAR_TO_TCHAR(struct_path().c_str()));
+    ACE_OS::rmdir(ACE_TEXT_CHAR_TO_TCHAR(directory));
+  }
+}
+
+TEST(dds_DCPS_XTypes_TypeObjectCache, InMemory)
+{
+  const TypeObjectCache_rch cache = DCPS::make_rch<TypeObjectCache>();
+  EXPECT_FALSE(cache->find(struct_ti()));
+
+  cache->add(struct_ti(), struct_to());
+  const TypeObject* const to = cache->find(struct_ti());
+  ASSERT_TRUE(to);
+  EXPECT_EQ(struct_to(), *to);
+
+  // Fully descriptive TypeIdentifiers aren't cached
+  const TypeIdentifier long_ti(TK_INT32);
+  cache->add(long_ti, struct_to());
+  EXPECT_FALSE(cache->find(long_ti));
+}
+
+TEST(dds_DCPS_XTypes_TypeObjectCache, IgnoreMismatchedTypeObject)
+{
+  remove_directory();
+  const TypeObjectCache_rch cache = DCPS::make_rch<TypeObjectCache>(directory);
+  const TypeIdentifier& union_ti = DCPS::getMinimalTypeIdentifier<DCPS::MyModCompleteToMinimal_MyUnion_xtag>();
+  const TypeMap& union_map = DCPS::getMinimalTypeMap<DCPS::MyModCompleteToMinimal_MyUnion_xtag>();
+  cache->add(struct_ti(), union_map.find(union_ti)->second);
+  EXPECT_FALSE(cache->find(struct_ti()));
+
+  // and nothing was written for later runs
+  ACE_stat st;
+  EXPECT_EQ(-1, ACE_OS::stat(ACE_TEXT_CHAR_TO_TCHAR(struct_path().c_str()), &st));
+  remove_directory();
+}
+
+TEST(dds_DCPS_XTypes_TypeObjectCache, OnDisk)
+{
+  remove_directory();
+  {
+    const TypeObjectCache_rch cache = DCPS::make_rch<TypeObjectCache>(directory);
+    EXPECT_FALSE(cache->find(struct_ti()));
+    cache->add(struct_ti(), struct_to());
+  }
+
+  // A new cache, like one in a later run, reads it back
+  const TypeObjectCache_rch cache = DCPS::make_rch<TypeObjectCache>(directory);
+  const TypeObject* const to = cache->find(struct_ti());
+  ASSERT_TRUE(to);
+  EXPECT_EQ(struct_to(), *to);
+  remove_directory();
+}
+
+TEST(dds_DCPS_XTypes_TypeObjectCache, IgnoreInvalidFile)
+{
+  remove_directory();
+  const TypeObjectCache_rch cache = DCPS::make_rch<TypeObjectCache>(directory);
+  {
+    std::ofstream out(struct_path().c_str(), std::ios::binary);
+    out << "not a TypeObject";
+  }
+  EXPECT_FALSE(cache->find(struct_ti()));
+  remove_directory();
+}
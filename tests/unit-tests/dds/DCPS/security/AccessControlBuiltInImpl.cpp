@@ -41,6 +41,21 @@ static const char* mock_1_cert_file = "../security/certs/identity/test_participa
 static const char* perm_mock_1_join_p7s_file = "../security/permissions/permissions_test_participant_01_JoinDomain_signed.p7s";
 static const char* remote_subject_name = "/C=US/ST=CO/O=Object Computing/CN=CN_TEST_DDS-SECURITY_OCI_OPENDDS/emailAddress=support@objectcomputing.com";
 
+class DDS_TEST {
+public:
+  static size_t decisions(const AccessControlBuiltInImpl& impl, DDS::Security::PermissionsHandle handle)
+  {
+    size_t count = 0;
+    for (AccessControlBuiltInImpl::DecisionCache::const_iterator pos = impl.decision_cache_.begin();
+         pos != impl.decision_cache_.end(); ++pos) {
+      if (pos->first.handle == handle) {
+        ++count;
+      }
+    }
+    return count;
+  }
+};
+
 namespace {
 
 // Mock classes for the AccessControl interface
@@ -474,6 +489,30 @@ public:
     return test_class_;
   }
 
+  void make_remote_tokens(::DDS::Security::PermissionsToken& remote_perm_token,
+                          ::DDS::Security::AuthenticatedPeerCredentialToken& remote_apc_token)
+  {
+    remote_perm_token.class_id = Expected_Permissions_Token_Class_Id;
+    remote_perm_token.properties.length(1);
+    remote_perm_token.properties[0].name = "dds.perm.ca.sn";
+    remote_perm_token.properties[0].value = remote_subject_name;
+
+    std::string id(get_file_contents(mock_1_cert_file));
+    std::string pf(get_file_contents(perm_mock_1_join_p7s_file));
+
+    remote_apc_token.class_id = Expected_Permissions_Cred_Token_Class_Id;
+    remote_apc_token.binary_properties.length(2);
+    remote_apc_token.binary_properties[0].name = "c.id";
+    remote_apc_token.binary_properties[0].value.length(static_cast<CORBA::ULong>(id.size()));
+    memcpy(remote_apc_token.binary_properties[0].value.get_buffer(), id.c_str(), id.size());
+    remote_apc_token.binary_properties[0].propagate = true;
+
+    remote_apc_token.binary_properties[1].name = "c.perm";
+    remote_apc_token.binary_properties[1].value.length(static_cast<CORBA::ULong>(pf.size()));
+    memcpy(remote_apc_token.binary_properties[1].value.get_buffer(), pf.c_str(), pf.size());
+    remote_apc_token.binary_properties[1].propagate = true;
+  }
+
   DomainParticipantQos domain_participant_qos_;
   MockAuthentication::SmartPtr auth_plugin_;
 
@@ -535,25 +574,7 @@ TEST_F(dds_DCPS_security_AccessControlBuiltInImpl, validate_remote_permissions_S
   ::DDS::Security::AuthenticatedPeerCredentialToken remote_apc_token;
   ::DDS::Security::SecurityException ex;
 
-  remote_perm_token.class_id = Expected_Permissions_Token_Class_Id;
-  remote_perm_token.properties.length(1);
-  remote_perm_token.properties[0].name = "dds.perm.ca.sn";
-  remote_perm_token.properties[0].value = remote_subject_name;
-
-  std::string id(get_file_contents(mock_1_cert_file));
-  std::string pf(get_file_contents(perm_mock_1_join_p7s_file));
-
-  remote_apc_token.class_id = Expected_Permissions_Cred_Token_Class_Id;
-  remote_apc_token.binary_properties.length(2);
-  remote_apc_token.binary_properties[0].name = "c.id";
-  remote_apc_token.binary_properties[0].value.length(static_cast<CORBA::ULong>(id.size()));
-  memcpy(remote_apc_token.binary_properties[0].value.get_buffer(), id.c_str(), id.size());
-  remote_apc_token.binary_properties[0].propagate = true;
-
-  remote_apc_token.binary_properties[1].name = "c.perm";
-  remote_apc_token.binary_properties[1].value.length(static_cast<CORBA::ULong>(pf.size()));
-  memcpy(remote_apc_token.binary_properties[1].value.get_buffer(), pf.c_str(), pf.size());
-  remote_apc_token.binary_properties[1].propagate = true;
+  make_remote_tokens(remote_perm_token, remote_apc_token);
 
   get_inst().validate_local_permissions(auth_plugin_.get(), 1, 1, domain_participant_qos_, ex);
 
@@ -721,6 +742,82 @@ TEST_F(dds_DCPS_security_AccessControlBuiltInImpl, check_create_datawriter_actio
         ex));
 }
 
+TEST_F(dds_DCPS_security_AccessControlBuiltInImpl, check_create_datawriter_Repeated)
+{
+  ::DDS::Security::DomainId_t domain_id = 0;
+  ::DDS::DataWriterQos qos;
+  ::DDS::PartitionQosPolicy partition;
+  ::DDS::Security::DataTags data_tag;
+  ::DDS::Security::SecurityException ex;
+
+  set_up_service_participant();
+  add_or_replace_property(dds_DCPS_security_AccessControlBuiltInImpl::gov_6_p7s_);
+  add_or_replace_property(dds_DCPS_security_AccessControlBuiltInImpl::perm_action_validity_p7s_);
+
+  ::DDS::Security::PermissionsHandle out_handle =
+    get_inst().validate_local_permissions(auth_plugin_.get(), 1, 0, domain_participant_qos_, ex);
+
+  // Repeated checks must give the same answer, including the exception
+  ::DDS::Security::SecurityException first_ex, second_ex;
+  EXPECT_FALSE(get_inst().check_create_datawriter(
+    out_handle, domain_id, "Triangle", qos, partition, data_tag, first_ex));
+  EXPECT_FALSE(get_inst().check_create_datawriter(
+    out_handle, domain_id, "Triangle", qos, partition, data_tag, second_ex));
+  EXPECT_STRNE("", first_ex.message);
+  EXPECT_STREQ(first_ex.message, second_ex.message);
+  EXPECT_EQ(first_ex.code, second_ex.code);
+
+  // Returning the permissions handle discards what was cached for it
+  EXPECT_TRUE(get_inst().return_permissions_handle(out_handle, ex));
+  ::DDS::Security::SecurityException gone_ex;
+  EXPECT_FALSE(get_inst().check_create_datawriter(
+    out_handle, domain_id, "Triangle", qos, partition, data_tag, gone_ex));
+  EXPECT_STRNE("", gone_ex.message);
+}
+
+TEST_F(dds_DCPS_security_AccessControlBuiltInImpl, check_create_datawriter_KeepsOtherDecisions)
+{
+  ::DDS::Security::DomainId_t domain_id = 0;
+  ::DDS::DataWriterQos qos;
+  ::DDS::PartitionQosPolicy partition;
+  ::DDS::Security::DataTags data_tag;
+  ::DDS::Security::PermissionsToken remote_perm_token;
+  ::DDS::Security::AuthenticatedPeerCredentialToken remote_apc_token;
+  ::DDS::Security::SecurityException ex;
+
+  const AccessControlBuiltInImpl& impl = dynamic_cast<AccessControlBuiltInImpl&>(get_inst());
+
+  set_up_service_participant();
+  add_or_replace_property(dds_DCPS_security_AccessControlBuiltInImpl::gov_6_p7s_);
+  add_or_replace_property(dds_DCPS_security_AccessControlBuiltInImpl::perm_action_validity_p7s_);
+
+  const ::DDS::Security::PermissionsHandle out_handle =
+    get_inst().validate_local_permissions(auth_plugin_.get(), 1, 0, domain_participant_qos_, ex);
+  get_inst().check_create_datawriter(out_handle, domain_id, "Triangle", qos, partition, data_tag, ex);
+  EXPECT_EQ(1u, DDS_TEST::decisions(impl, out_handle));
+
+  // Adding and removing the permissions of other participants leaves the
+  // decisions made for this one.
+  make_remote_tokens(remote_perm_token, remote_apc_token);
+  const ::DDS::Security::PermissionsHandle remote_handle = get_inst().validate_remote_permissions(
+    auth_plugin_.get(), 1, 2, remote_perm_token, remote_apc_token, ex);
+  ASSERT_NE(DDS::HANDLE_NIL, remote_handle);
+  EXPECT_EQ(1u, DDS_TEST::decisions(impl, out_handle));
+
+  const ::DDS::Security::PermissionsHandle other_handle =
+    get_inst().validate_local_permissions(auth_plugin_.get(), 1, 0, domain_participant_qos_, ex);
+  get_inst().check_create_datawriter(other_handle, domain_id, "Triangle", qos, partition, data_tag, ex);
+  EXPECT_EQ(1u, DDS_TEST::decisions(impl, other_handle));
+
+  EXPECT_TRUE(get_inst().return_permissions_handle(remote_handle, ex));
+  EXPECT_TRUE(get_inst().return_permissions_handle(other_handle, ex));
+  EXPECT_EQ(0u, DDS_TEST::decisions(impl, other_handle));
+  EXPECT_EQ(1u, DDS_TEST::decisions(impl, out_handle));
+
+  EXPECT_TRUE(get_inst().return_permissions_handle(out_handle, ex));
+  EXPECT_EQ(0u, DDS_TEST::decisions(impl, out_handle));
+}
+
 TEST_F(dds_DCPS_security_AccessControlBuiltInImpl, check_create_datareader_InvalidInput)
 {
   ::DDS::Security::PermissionsHandle permissions_handle = 1;
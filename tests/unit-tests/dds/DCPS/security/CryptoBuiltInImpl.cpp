@@ -9,6 +9,13 @@
 
 #include "gtest/gtest.h"
 
+#ifdef ACE_HAS_CPP11
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+
 using namespace OpenDDS::Security;
 using namespace testing;
 
@@ -711,6 +718,51 @@ TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, encode_serialize
   EXPECT_EQ(get_buffer(), output);
 }
 
+#ifdef ACE_HAS_CPP11
+TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, encode_serialized_payload_Concurrent)
+{
+  using namespace DDS::Security;
+  CryptoKeyFactory& kef = dynamic_cast<CryptoKeyFactory&>(get_inst());
+
+  DDS::PropertySeq no_properties;
+  const EndpointSecurityAttributes esa = {{false, false, false, false}, false, true, false,
+    PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED, no_properties};
+  SecurityException ex;
+  const DatawriterCryptoHandle handle = kef.register_local_datawriter(0, no_properties, esa, ex);
+  init_buffer(100, 7);
+
+  // Encode from several threads at once, every message must get its own IV
+  static const size_t THREADS = 4, MESSAGES = 250, IV_OFFSET = 8, IV_LENGTH = 12;
+  std::vector<std::vector<std::string> > ivs(THREADS);
+  std::vector<int> ok(THREADS, 1);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < THREADS; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      for (size_t i = 0; i < MESSAGES; ++i) {
+        DDS::OctetSeq inline_qos, output;
+        SecurityException tex;
+        if (!get_inst().encode_serialized_payload(output, inline_qos, get_buffer(), handle, tex)
+            || output.length() < IV_OFFSET + IV_LENGTH) {
+          ok[t] = 0;
+          return;
+        }
+        ivs[t].push_back(std::string(reinterpret_cast<const char*>(output.get_buffer()) + IV_OFFSET, IV_LENGTH));
+      }
+    }));
+  }
+  for (size_t t = 0; t < THREADS; ++t) {
+    threads[t].join();
+  }
+
+  std::set<std::string> unique;
+  for (size_t t = 0; t < THREADS; ++t) {
+    EXPECT_EQ(1, ok[t]);
+    unique.insert(ivs[t].begin(), ivs[t].end());
+  }
+  EXPECT_EQ(THREADS * MESSAGES, unique.size());
+}
+#endif
+
 TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, encode_datawriter_submessage_NullSendingHandle)
 {
   DDS::OctetSeq output;
@@ -0,0 +1,70 @@
+#include <dds/DCPS/transport/framework/TransportCounters.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_transport_framework_TransportCounters, starts_at_zero)
+{
+  TransportCounters uut;
+  const TransportCounters::Values values = uut.values();
+  for (int i = 0; i < TransportCounters::COUNTER_COUNT; ++i) {
+    EXPECT_EQ(0, values[static_cast<TransportCounters::Counter>(i)]);
+  }
+}
+
+TEST(dds_DCPS_transport_framework_TransportCounters, add)
+{
+  TransportCounters uut;
+  uut.add(TransportCounters::PACKETS_SENT);
+  uut.add(TransportCounters::PACKETS_SENT);
+  uut.add(TransportCounters::BYTES_SENT, 1500);
+  uut.add(TransportCounters::BYTES_SENT, 0x100000000LL);
+
+  const TransportCounters::Values values = uut.values();
+  EXPECT_EQ(2, values[TransportCounters::PACKETS_SENT]);
+  EXPECT_EQ(0x100000000LL + 1500, values[TransportCounters::BYTES_SENT]);
+  EXPECT_EQ(0, values[TransportCounters::BYTES_RECEIVED]);
+}
+
+TEST(dds_DCPS_transport_framework_TransportCounters, gauge)
+{
+  TransportCounters uut;
+  uut.add(TransportCounters::QUEUE_DEPTH, 3);
+  uut.add(TransportCounters::QUEUE_DEPTH, -2);
+  EXPECT_EQ(1, uut.values()[TransportCounters::QUEUE_DEPTH]);
+
+  uut.add(TransportCounters::QUEUE_DEPTH, -1);
+  EXPECT_EQ(0, uut.values()[TransportCounters::QUEUE_DEPTH]);
+}
+
+TEST(dds_DCPS_transport_framework_TransportCounters, name)
+{
+  EXPECT_STREQ("bytes_sent", TransportCounters::name(TransportCounters::BYTES_SENT));
+  EXPECT_STREQ("direct_mode_usec", TransportCounters::name(TransportCounters::DIRECT_MODE_USEC));
+  for (int i = 0; i < TransportCounters::COUNTER_COUNT; ++i) {
+    EXPECT_STRNE("unknown", TransportCounters::name(static_cast<TransportCounters::Counter>(i)));
+  }
+}
+
+TEST(dds_DCPS_transport_framework_TransportCounters, mode_time)
+{
+  TransportCounters uut;
+  const int owner = 0;
+  const MonotonicTimePoint start = MonotonicTimePoint::now() - TimeDuration(10);
+  uut.mode_changed(&owner, TransportCounters::QUEUE_MODE_USEC, start);
+
+  // The current mode is counted up to when the values are read
+  TransportCounters::Values values = uut.values();
+  EXPECT_GE(values[TransportCounters::QUEUE_MODE_USEC], 10000000);
+  EXPECT_EQ(0, values[TransportCounters::DIRECT_MODE_USEC]);
+
+  uut.mode_changed(&owner, TransportCounters::DIRECT_MODE_USEC, start + TimeDuration(4));
+  uut.mode_changed(&owner, TransportCounters::COUNTER_COUNT, start + TimeDuration(6));
+  values = uut.values();
+  EXPECT_EQ(4000000, values[TransportCounters::QUEUE_MODE_USEC]);
+  EXPECT_EQ(2000000, values[TransportCounters::DIRECT_MODE_USEC]);
+
+  // and not after it stops
+  EXPECT_EQ(2000000, uut.values()[TransportCounters::DIRECT_MODE_USEC]);
+}
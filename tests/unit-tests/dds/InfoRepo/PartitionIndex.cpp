@@ -0,0 +1,142 @@
+#include <dds/InfoRepo/PartitionIndex.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+  struct Entity {};
+
+  typedef PartitionIndex<Entity> Index;
+
+  DDS::PartitionQosPolicy partition(const char* a = 0, const char* b = 0)
+  {
+    DDS::PartitionQosPolicy policy;
+    policy.name.length((a ? 1 : 0) + (b ? 1 : 0));
+    if (a) {
+      policy.name[0] = a;
+    }
+    if (b) {
+      policy.name[1] = b;
+    }
+    return policy;
+  }
+}
+
+TEST(dds_InfoRepo_PartitionIndex, Named)
+{
+  Entity a, b, c;
+  Index uut;
+  uut.insert(&a, partition("A"), "");
+  uut.insert(&b, partition("B"), "");
+  uut.insert(&c, partition("A", "C"), "");
+
+  Index::Entities candidates;
+  EXPECT_TRUE(uut.candidates(partition("A"), candidates));
+  EXPECT_EQ(2u, candidates.size());
+  EXPECT_TRUE(candidates.count(&a));
+  EXPECT_TRUE(candidates.count(&c));
+
+  candidates.clear();
+  EXPECT_TRUE(uut.candidates(partition("B", "C"), candidates));
+  EXPECT_EQ(2u, candidates.size());
+  EXPECT_TRUE(candidates.count(&b));
+  EXPECT_TRUE(candidates.count(&c));
+
+  candidates.clear();
+  EXPECT_TRUE(uut.candidates(partition("D"), candidates));
+  EXPECT_TRUE(candidates.empty());
+}
+
+TEST(dds_InfoRepo_PartitionIndex, DefaultPartition)
+{
+  Entity empty, blank, named;
+  Index uut;
+  uut.insert(&empty, partition(), "");
+  uut.insert(&blank, partition(""), "");
+  uut.insert(&named, partition("A"), "");
+
+  // No names and the name "" are both the default partition
+  Index::Entities candidates;
+  EXPECT_TRUE(uut.candidates(partition(), candidates));
+  EXPECT_EQ(2u, candidates.size());
+  EXPECT_TRUE(candidates.count(&empty));
+  EXPECT_TRUE(candidates.count(&blank));
+
+  candidates.clear();
+  EXPECT_TRUE(uut.candidates(partition(""), candidates));
+  EXPECT_EQ(2u, candidates.size());
+  EXPECT_FALSE(candidates.count(&named));
+}
+
+TEST(dds_InfoRepo_PartitionIndex, Wildcards)
+{
+  Entity wildcard, empty, named;
+  Index uut;
+  uut.insert(&wildcard, partition("A*"), "");
+  uut.insert(&empty, partition(), "");
+  uut.insert(&named, partition("B"), "");
+
+  // Entities with a wildcard are candidates for every partition
+  Index::Entities candidates;
+  EXPECT_TRUE(uut.candidates(partition("B"), candidates));
+  EXPECT_EQ(2u, candidates.size());
+  EXPECT_TRUE(candidates.count(&wildcard));
+  EXPECT_TRUE(candidates.count(&named));
+
+  candidates.clear();
+  EXPECT_TRUE(uut.candidates(partition(), candidates));
+  EXPECT_EQ(2u, candidates.size());
+  EXPECT_TRUE(candidates.count(&wildcard));
+  EXPECT_TRUE(candidates.count(&empty));
+
+  // and a wildcard on the other side has to be checked against everything
+  candidates.clear();
+  EXPECT_FALSE(uut.candidates(partition("?"), candidates));
+  EXPECT_FALSE(uut.candidates(partition("C", "[AB]"), candidates));
+}
+
+TEST(dds_InfoRepo_PartitionIndex, InsertReplacesAndRemove)
+{
+  Entity a;
+  Index uut;
+  uut.insert(&a, partition("A"), "");
+  uut.insert(&a, partition("B"), "");
+
+  Index::Entities candidates;
+  EXPECT_TRUE(uut.candidates(partition("A"), candidates));
+  EXPECT_TRUE(candidates.empty());
+  EXPECT_TRUE(uut.candidates(partition("B"), candidates));
+  EXPECT_EQ(1u, candidates.size());
+
+  uut.insert(&a, partition("*"), "");
+  uut.remove(&a);
+  candidates.clear();
+  EXPECT_TRUE(uut.candidates(partition("B"), candidates));
+  EXPECT_TRUE(candidates.empty());
+
+  // Removing what isn't indexed is harmless
+  uut.remove(&a);
+}
+
+TEST(dds_InfoRepo_PartitionIndex, QosGroups)
+{
+  Entity a, b, c;
+  Index uut;
+  uut.insert(&a, partition("A"), "reliable");
+  uut.insert(&b, partition("B"), "reliable");
+  uut.insert(&c, partition("*"), "best effort");
+
+  const Index::QosGroups& groups = uut.qos_groups();
+  ASSERT_EQ(2u, groups.size());
+  EXPECT_EQ(2u, groups.find("reliable")->second.size());
+  EXPECT_EQ(1u, groups.find("best effort")->second.count(&c));
+
+  // A changed QoS moves the entity to another group
+  uut.insert(&b, partition("B"), "best effort");
+  EXPECT_EQ(1u, groups.find("reliable")->second.size());
+  EXPECT_EQ(2u, groups.find("best effort")->second.size());
+
+  // and empty groups go away
+  uut.remove(&a);
+  EXPECT_EQ(1u, groups.size());
+  EXPECT_EQ(0u, groups.count("reliable"));
+}
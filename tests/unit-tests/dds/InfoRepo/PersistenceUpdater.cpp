@@ -0,0 +1,294 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_SAFETY_PROFILE
+
+#include <dds/InfoRepo/PersistenceUpdater.h>
+
+#include <gtest/gtest.h>
+
+#include <ace/OS_NS_unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using Update::PersistenceUpdater;
+
+class DDS_TEST {
+public:
+  static bool recover(PersistenceUpdater& updater, const char* file,
+                      size_t snapshot_records = 10000)
+  {
+    updater.persistence_file_ = ACE_TEXT_CHAR_TO_TCHAR(file);
+    updater.snapshot_records_ = snapshot_records;
+    return updater.recover();
+  }
+
+  static void commit(PersistenceUpdater& updater)
+  {
+    updater.commit();
+  }
+
+  /// Start a snapshot the way commit() does, but return before writing it.
+  static std::vector<char> begin_snapshot(PersistenceUpdater& updater)
+  {
+    std::vector<char> snapshot;
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, updater.lock_, snapshot);
+    updater.encode_snapshot(snapshot, updater.generation_ + 1);
+    updater.snapshotting_ = true;
+    return snapshot;
+  }
+
+  static bool write_snapshot(PersistenceUpdater& updater, const std::vector<char>& snapshot)
+  {
+    return updater.write_snapshot(snapshot);
+  }
+
+  static bool has_participant(const PersistenceUpdater& updater, const Update::IdType& id)
+  {
+    return updater.participants_.count(id) != 0;
+  }
+
+  static bool has_topic(const PersistenceUpdater& updater, const Update::IdType& id)
+  {
+    return updater.topics_.count(id) != 0;
+  }
+
+  static Update::PartIdType last_part_id(const PersistenceUpdater& updater)
+  {
+    return updater.last_part_id_;
+  }
+
+  static ACE_UINT64 generation(const PersistenceUpdater& updater)
+  {
+    return updater.generation_;
+  }
+};
+
+namespace {
+  const char file[] = "PersistenceUpdater_test.pr";
+  const char log_file[] = "PersistenceUpdater_test.pr.log";
+  const Update::DomainIdType domain = 11;
+
+  typedef std::vector<char> Bytes;
+
+  void remove_files()
+  {
+    ACE_OS::unlink(file);
+    ACE_OS::unlink(log_file);
+    ACE_OS::unlink((std::string(file) + ".tmp").c_str());
+  }
+
+  Bytes read_file(const char* path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    return Bytes(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  void write_file(const char* path, const Bytes& data)
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(data.empty() ? 0 : &data[0], data.size());
+  }
+
+  Update::IdType make_id(unsigned char key)
+  {
+    Update::IdType id = OpenDDS::DCPS::GUID_UNKNOWN;
+    id.guidPrefix[0] = 1;
+    id.entityId.entityKey[2] = key;
+    return id;
+  }
+
+  void create_participant(PersistenceUpdater& updater, const Update::IdType& id)
+  {
+    DDS::DomainParticipantQos qos;
+    updater.create(Update::UParticipant(domain, 0, id, qos));
+  }
+
+  void create_topic(PersistenceUpdater& updater, const Update::IdType& id,
+                    const Update::IdType& participant)
+  {
+    DDS::TopicQos qos;
+    updater.create(Update::UTopic(domain, id, participant, "Topic", "Type", qos));
+  }
+
+  void destroy_participant(PersistenceUpdater& updater, const Update::IdType& id)
+  {
+    updater.destroy(Update::IdPath(domain, id, id), Update::Participant, Update::DataWriter);
+  }
+}
+
+TEST(dds_InfoRepo_PersistenceUpdater, RecoverLog)
+{
+  remove_files();
+  const Update::IdType participant = make_id(1);
+  const Update::IdType topic = make_id(2);
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file));
+    create_participant(updater, participant);
+    create_topic(updater, topic, participant);
+    updater.updateLastPartId(7);
+  }
+
+  // Records are written as they're made, so they're recovered without a commit
+  PersistenceUpdater updater;
+  ASSERT_TRUE(DDS_TEST::recover(updater, file));
+  EXPECT_TRUE(DDS_TEST::has_participant(updater, participant));
+  EXPECT_TRUE(DDS_TEST::has_topic(updater, topic));
+  EXPECT_EQ(7, DDS_TEST::last_part_id(updater));
+  remove_files();
+}
+
+TEST(dds_InfoRepo_PersistenceUpdater, TruncatedLogTail)
+{
+  remove_files();
+  const Update::IdType participant = make_id(1);
+  const Update::IdType topic = make_id(2);
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file));
+    create_participant(updater, participant);
+    create_topic(updater, topic, participant);
+  }
+
+  // Cut the topic record short, as if the InfoRepo crashed while writing it
+  Bytes log = read_file(log_file);
+  ASSERT_GT(log.size(), 3u);
+  log.resize(log.size() - 3);
+  write_file(log_file, log);
+
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file));
+    EXPECT_TRUE(DDS_TEST::has_participant(updater, participant));
+    EXPECT_FALSE(DDS_TEST::has_topic(updater, topic));
+  }
+
+  // What was recovered is in the new snapshot
+  PersistenceUpdater updater;
+  ASSERT_TRUE(DDS_TEST::recover(updater, file));
+  EXPECT_TRUE(DDS_TEST::has_participant(updater, participant));
+  EXPECT_FALSE(DDS_TEST::has_topic(updater, topic));
+  remove_files();
+}
+
+TEST(dds_InfoRepo_PersistenceUpdater, CorruptLogTail)
+{
+  remove_files();
+  const Update::IdType participant = make_id(1);
+  const Update::IdType topic = make_id(2);
+  const Update::IdType topic2 = make_id(3);
+  Bytes log;
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file));
+    create_participant(updater, participant);
+    log = read_file(log_file);
+    create_topic(updater, topic, participant);
+    create_topic(updater, topic2, participant);
+  }
+
+  // Corrupt the first topic record, so it and everything after it is ignored
+  const size_t topic_record = log.size();
+  log = read_file(log_file);
+  ASSERT_GT(log.size(), topic_record + 20);
+  log[topic_record + 20] ^= 0xff;
+  write_file(log_file, log);
+
+  PersistenceUpdater updater;
+  ASSERT_TRUE(DDS_TEST::recover(updater, file));
+  EXPECT_TRUE(DDS_TEST::has_participant(updater, participant));
+  EXPECT_FALSE(DDS_TEST::has_topic(updater, topic));
+  EXPECT_FALSE(DDS_TEST::has_topic(updater, topic2));
+  remove_files();
+}
+
+TEST(dds_InfoRepo_PersistenceUpdater, IgnoreLogFromOtherGeneration)
+{
+  remove_files();
+  const Update::IdType participant = make_id(1);
+  Bytes old_log;
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file));
+    create_participant(updater, participant);
+    old_log = read_file(log_file);
+  }
+
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file, 1));
+    ASSERT_TRUE(DDS_TEST::has_participant(updater, participant));
+    destroy_participant(updater, participant);
+    DDS_TEST::commit(updater);
+    EXPECT_EQ(3u, DDS_TEST::generation(updater));
+  }
+
+  // The old log still creates the participant, but it was written before the
+  // snapshot, which has it destroyed.
+  write_file(log_file, old_log);
+
+  PersistenceUpdater updater;
+  ASSERT_TRUE(DDS_TEST::recover(updater, file));
+  EXPECT_FALSE(DDS_TEST::has_participant(updater, participant));
+  remove_files();
+}
+
+TEST(dds_InfoRepo_PersistenceUpdater, RecoverSnapshotAndLog)
+{
+  remove_files();
+  const Update::IdType participant = make_id(1);
+  const Update::IdType participant2 = make_id(2);
+  const Update::IdType topic = make_id(3);
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file, 2));
+    create_participant(updater, participant);
+    create_participant(updater, participant2);
+    updater.updateLastPartId(2);
+    DDS_TEST::commit(updater);
+    EXPECT_EQ(2u, DDS_TEST::generation(updater));
+
+    // These are only in the log after the snapshot
+    create_topic(updater, topic, participant2);
+    destroy_participant(updater, participant);
+    updater.updateLastPartId(3);
+  }
+
+  PersistenceUpdater updater;
+  ASSERT_TRUE(DDS_TEST::recover(updater, file));
+  EXPECT_FALSE(DDS_TEST::has_participant(updater, participant));
+  EXPECT_TRUE(DDS_TEST::has_participant(updater, participant2));
+  EXPECT_TRUE(DDS_TEST::has_topic(updater, topic));
+  EXPECT_EQ(3, DDS_TEST::last_part_id(updater));
+  remove_files();
+}
+
+TEST(dds_InfoRepo_PersistenceUpdater, LoggedDuringSnapshot)
+{
+  remove_files();
+  const Update::IdType participant = make_id(1);
+  const Update::IdType participant2 = make_id(2);
+  {
+    PersistenceUpdater updater;
+    ASSERT_TRUE(DDS_TEST::recover(updater, file));
+    create_participant(updater, participant);
+    const Bytes snapshot = DDS_TEST::begin_snapshot(updater);
+    create_participant(updater, participant2);
+    ASSERT_TRUE(DDS_TEST::write_snapshot(updater, snapshot));
+  }
+
+  // The new log is empty, so the second participant has to be in the snapshot
+  PersistenceUpdater updater;
+  ASSERT_TRUE(DDS_TEST::recover(updater, file));
+  EXPECT_TRUE(DDS_TEST::has_participant(updater, participant));
+  EXPECT_TRUE(DDS_TEST::has_participant(updater, participant2));
+  remove_files();
+}
+
+#endif
@@ -797,7 +797,7 @@ MonitorDataStorage::update<OpenDDS::DCPS::DataReaderPeriodicReport>(
   // struct DataReaderAssociationPeriodic {
   //   GUID_t        dw_id;
   //   unsigned long samples_available;
-  //   // Stats      latency_stats;
+  //   LatencyPercentiles latency;
   // };
   // typedef sequence<DataReaderAssociationPeriodic> DRAssociationsPeriodic;
   // struct DataReaderPeriodicReport {
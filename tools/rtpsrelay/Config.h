@@ -39,6 +39,8 @@ public:
     , admission_max_participants_low_water_(0)
     , handler_threads_(1)
     , synchronous_output_(false)
+    , event_loops_(1)
+    , receive_batch_size_(1)
   {}
 
   void relay_id(const std::string& value)
@@ -371,6 +373,26 @@ public:
     return synchronous_output_;
   }
 
+  void event_loops(size_t count)
+  {
+    event_loops_ = count;
+  }
+
+  size_t event_loops() const
+  {
+    return event_loops_;
+  }
+
+  void receive_batch_size(size_t count)
+  {
+    receive_batch_size_ = count;
+  }
+
+  size_t receive_batch_size() const
+  {
+    return receive_batch_size_;
+  }
+
 private:
   std::string relay_id_;
   OpenDDS::DCPS::GUID_t application_participant_guid_;
@@ -405,6 +427,8 @@ private:
   size_t admission_max_participants_low_water_;
   size_t handler_threads_;
   bool synchronous_output_;
+  size_t event_loops_;
+  size_t receive_batch_size_;
 };
 
 }
@@ -14,7 +14,7 @@ GuidPartitionTable::Result GuidPartitionTable::insert(const OpenDDS::DCPS::GUID_
   SpdpReplay spdp_replay;
 
   {
-    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, NO_CHANGE);
+    ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, g, mutex_, NO_CHANGE);
 
     StringSet parts;
     for (CORBA::ULong idx = 0; idx != partitions.length(); ++idx) {
@@ -99,7 +99,7 @@ void GuidPartitionTable::remove(const OpenDDS::DCPS::GUID_t& guid)
 {
   std::vector<RelayPartitions> relay_partitions;
   {
-    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+    ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, g, mutex_);
 
     StringSet defunct;
 
@@ -134,15 +134,18 @@ void GuidPartitionTable::remove(const OpenDDS::DCPS::GUID_t& guid)
 
 void GuidPartitionTable::lookup(StringSet& partitions, const OpenDDS::DCPS::GUID_t& from) const
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+  ACE_READ_GUARD(ACE_RW_Thread_Mutex, g, mutex_);
 
   // Match on the prefix.
   const auto prefix = make_unknown_guid(from);
 
-  const auto p = guid_to_partitions_cache_.find(prefix);
-  if (p != guid_to_partitions_cache_.end()) {
-    partitions.insert(p->second.begin(), p->second.end());
-    return;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, cg, cache_mutex_);
+    const auto p = guid_to_partitions_cache_.find(prefix);
+    if (p != guid_to_partitions_cache_.end()) {
+      partitions.insert(p->second.begin(), p->second.end());
+      return;
+    }
   }
 
   StringSet c;
@@ -160,6 +163,7 @@ void GuidPartitionTable::lookup(StringSet& partitions, const OpenDDS::DCPS::GUID
 
   // Only create a cache entry if there is something to cache.
   if (!c.empty()) {
+    ACE_GUARD(ACE_Thread_Mutex, cg, cache_mutex_);
     guid_to_partitions_cache_[prefix] = c;
     relay_stats_reporter_.partition_guids(guid_to_partitions_.size(), guid_to_partitions_cache_.size());
   }
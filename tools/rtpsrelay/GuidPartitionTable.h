@@ -11,6 +11,7 @@
 #include <dds/DCPS/GuidConverter.h>
 #include <dds/DCPS/LogAddr.h>
 
+#include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
 
 namespace RtpsRelay {
@@ -53,7 +54,8 @@ public:
   void lookup(GuidSet& guids, const T& partitions, const GuidSet& allowed) const
   {
     const auto limits = allowed.empty() ? nullptr : &allowed;
-    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+    ACE_READ_GUARD(ACE_RW_Thread_Mutex, g, mutex_);
+    ACE_GUARD(ACE_Thread_Mutex, cg, cache_mutex_);
 
     for (const auto& part : partitions) {
       if (config_.allow_empty_partition() || !part.empty()) {
@@ -193,7 +195,10 @@ private:
   PartitionToGuid partition_to_guid_;
   PartitionIndex<GuidSet, GuidToParticipantGuid> partition_index_;
 
-  mutable ACE_Thread_Mutex mutex_;
+  // Lookups share mutex_ and serialize on cache_mutex_ only to update the caches.
+  // Inserts and removes hold mutex_ exclusively and don't need cache_mutex_.
+  mutable ACE_RW_Thread_Mutex mutex_;
+  mutable ACE_Thread_Mutex cache_mutex_;
   mutable ACE_Thread_Mutex write_mutex_;
 };
 
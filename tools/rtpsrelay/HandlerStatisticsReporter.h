@@ -9,6 +9,8 @@
 
 #include <dds/DCPS/JsonValueWriter.h>
 
+#include <ace/Thread_Mutex.h>
+
 namespace RtpsRelay {
 
 class HandlerStatisticsReporter {
@@ -35,6 +37,7 @@ public:
                      MessageType type)
   {
     relay_statistics_reporter_.input_message(byte_count, time, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.input_message(log_handler_statistics_, byte_count, time, type);
     publish_helper_.input_message(publish_handler_statistics_, byte_count, time, type);
     report(now);
@@ -45,6 +48,7 @@ public:
                        MessageType type)
   {
     relay_statistics_reporter_.ignored_message(byte_count, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.ignored_message(log_handler_statistics_, byte_count, type);
     publish_helper_.ignored_message(publish_handler_statistics_, byte_count, type);
     report(now);
@@ -57,6 +61,7 @@ public:
                       MessageType type)
   {
     relay_statistics_reporter_.output_message(byte_count, time, queue_latency, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.output_message(log_handler_statistics_, byte_count, time, queue_latency, type);
     publish_helper_.output_message(publish_handler_statistics_, byte_count, time, queue_latency, type);
     report(now);
@@ -69,6 +74,7 @@ public:
                        MessageType type)
   {
     relay_statistics_reporter_.dropped_message(byte_count, time, queue_latency, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.dropped_message(log_handler_statistics_, byte_count, time, queue_latency, type);
     publish_helper_.dropped_message(publish_handler_statistics_, byte_count, time, queue_latency, type);
     report(now);
@@ -77,6 +83,7 @@ public:
   void max_gain(size_t value, const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
     relay_statistics_reporter_.max_gain(value, now);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.max_gain(log_handler_statistics_, value);
     publish_helper_.max_gain(publish_handler_statistics_, value);
     report(now);
@@ -85,6 +92,7 @@ public:
   void error(const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
     relay_statistics_reporter_.error(now);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.error(log_handler_statistics_);
     publish_helper_.error(publish_handler_statistics_);
     report(now);
@@ -93,6 +101,7 @@ public:
   void max_queue_size(size_t size, const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
     relay_statistics_reporter_.max_queue_size(size, now);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.max_queue_size(log_handler_statistics_, size);
     publish_helper_.max_queue_size(publish_handler_statistics_, size);
     report(now);
@@ -100,6 +109,7 @@ public:
 
   void report()
   {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     report(OpenDDS::DCPS::MonotonicTimePoint::now(), true);
   }
 
@@ -154,6 +164,9 @@ private:
   HandlerStatisticsDataWriter_var writer_;
   CORBA::String_var topic_name_;
   RelayStatisticsReporter& relay_statistics_reporter_;
+
+  // Input may be processed by several event loops concurrently.
+  mutable ACE_Thread_Mutex mutex_;
 };
 
 }
@@ -15,18 +15,22 @@ namespace RtpsRelay {
 
 struct ThreadPool : ACE_Task_Base {
 
-  ThreadPool(const Config& config, ACE_Reactor& reactor, RelayThreadMonitor& monitor)
+  ThreadPool(const Config& config, ACE_Reactor& reactor, RelayThreadMonitor& monitor,
+             const char* name = "RtpsRelay Event Loop")
     : config_(config)
     , reactor_(reactor)
     , monitor_(monitor)
+    , name_(name)
   {}
 
   int svc() override;
-  int run();
+  int run(const RelayEventLoop::ReceiveReactors& receive_reactors);
+  int run_i();
 
   const Config& config_;
   ACE_Reactor& reactor_;
   RelayThreadMonitor& monitor_;
+  const char* const name_;
   OpenDDS::DCPS::ThreadStatusManager& thread_status_manager_ = TheServiceParticipant->get_thread_status_manager();
 };
 
@@ -50,7 +54,7 @@ struct RunThreadMonitor {
   const int status_;
 };
 
-int ThreadPool::run()
+int ThreadPool::run(const RelayEventLoop::ReceiveReactors& receive_reactors)
 {
   RunThreadMonitor rtm{thread_status_manager_, monitor_};
   if (rtm.status_ != EXIT_SUCCESS) {
@@ -58,6 +62,35 @@ int ThreadPool::run()
     return EXIT_FAILURE;
   }
 
+  // Each receive reactor gets a dedicated thread.
+  std::vector<std::unique_ptr<ThreadPool>> receive_loops;
+  auto status = EXIT_SUCCESS;
+  for (const auto& receive_reactor : receive_reactors) {
+    std::unique_ptr<ThreadPool> loop(new ThreadPool(config_, *receive_reactor, monitor_, "RtpsRelay Receive Loop"));
+    if (loop->activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1) != EXIT_SUCCESS) {
+      ACE_ERROR((LM_ERROR, "(%P:%t) ERROR: RtpsRelay::ThreadPool::run: failed to start receive loop: %m\n"));
+      status = EXIT_FAILURE;
+      break;
+    }
+    receive_loops.push_back(std::move(loop));
+  }
+
+  if (status == EXIT_SUCCESS) {
+    status = run_i();
+  }
+
+  for (const auto& loop : receive_loops) {
+    loop->reactor_.end_reactor_event_loop();
+  }
+  for (const auto& loop : receive_loops) {
+    loop->wait();
+  }
+
+  return status;
+}
+
+int ThreadPool::run_i()
+{
   const auto threads = config_.handler_threads();
   if (threads == 1) {
     return svc();
@@ -78,9 +111,10 @@ int ThreadPool::svc()
   const auto end_time = OpenDDS::DCPS::MonotonicTimePoint::now() + config_.run_time();
 
   if (thread_status_manager_.update_thread_status()) {
-    OpenDDS::DCPS::ThreadStatusManager::Start thread_status_monitoring_active(thread_status_manager_, "RtpsRelay Event Loop");
+    OpenDDS::DCPS::ThreadStatusManager::Start thread_status_monitoring_active(thread_status_manager_, name_);
 
-    while (!has_run_time || OpenDDS::DCPS::MonotonicTimePoint::now() < end_time) {
+    while ((!has_run_time || OpenDDS::DCPS::MonotonicTimePoint::now() < end_time) &&
+           !reactor_.reactor_event_loop_done()) {
       auto t = thread_status_manager_.thread_status_interval().value();
       OpenDDS::DCPS::ThreadStatusManager::Sleeper s(thread_status_manager_);
       if (reactor_.run_reactor_event_loop(t, 0) != 0) {
@@ -89,7 +123,8 @@ int ThreadPool::svc()
     }
 
   } else if (has_run_time) {
-    while (OpenDDS::DCPS::MonotonicTimePoint::now() < end_time) {
+    while (OpenDDS::DCPS::MonotonicTimePoint::now() < end_time &&
+           !reactor_.reactor_event_loop_done()) {
       auto t = (end_time - OpenDDS::DCPS::MonotonicTimePoint::now()).value();
       if (reactor_.run_reactor_event_loop(t, 0) != 0) {
         break;
@@ -107,9 +142,22 @@ ACE_Reactor_Impl* RelayEventLoop::make_reactor_impl(const Config& config)
   return config.handler_threads() == 1 ? new ACE_Select_Reactor : new ACE_TP_Reactor;
 }
 
-int RelayEventLoop::run(const Config& config, ACE_Reactor& reactor, RelayThreadMonitor& monitor)
+RelayEventLoop::ReceiveReactors RelayEventLoop::make_receive_reactors(const Config& config)
+{
+  ReceiveReactors reactors;
+  for (size_t idx = 1; idx < config.event_loops(); ++idx) {
+    // Each receive loop is single-threaded.
+    reactors.emplace_back(new ACE_Reactor(new ACE_Select_Reactor, true));
+  }
+  return reactors;
+}
+
+int RelayEventLoop::run(const Config& config,
+                        ACE_Reactor& reactor,
+                        const ReceiveReactors& receive_reactors,
+                        RelayThreadMonitor& monitor)
 {
-  return ThreadPool{config, reactor, monitor}.run();
+  return ThreadPool{config, reactor, monitor}.run(receive_reactors);
 }
 
 }
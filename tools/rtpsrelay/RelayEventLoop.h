@@ -10,12 +10,24 @@
 
 #include <ace/Reactor.h>
 
+#include <memory>
+#include <vector>
+
 namespace RtpsRelay {
 namespace RelayEventLoop {
 
+using ReceiveReactors = std::vector<std::unique_ptr<ACE_Reactor>>;
+
 ACE_Reactor_Impl* make_reactor_impl(const Config& config);
 
-int run(const Config& config, ACE_Reactor& reactor, RelayThreadMonitor& monitor);
+// Make the reactors for the additional event loops (Config::event_loops - 1)
+// that only receive and process input.
+ReceiveReactors make_receive_reactors(const Config& config);
+
+int run(const Config& config,
+        ACE_Reactor& reactor,
+        const ReceiveReactors& receive_reactors,
+        RelayThreadMonitor& monitor);
 
 }
 }
@@ -29,6 +29,8 @@ namespace RtpsRelay {
 #define HANDLER_WARNING(X) { if (config_.log_warnings()) { ACE_ERROR (X); }; stats_reporter_.error(now); }
 
 namespace {
+  const int MAX_DATAGRAM_SIZE = 65536;
+
   OpenDDS::STUN::Message make_bad_request_error_response(const OpenDDS::STUN::Message& a_message,
                                                          const std::string& a_reason)
   {
@@ -62,6 +64,7 @@ RelayHandler::RelayHandler(const Config& config,
                            HandlerStatisticsReporter& stats_reporter,
                            OpenDDS::DCPS::Lockable_Message_Block_Ptr::Lock_Policy message_block_locking)
   : ACE_Event_Handler(reactor)
+  , batch_(config.receive_batch_size())
   , config_(config)
   , name_(name)
   , port_(port)
@@ -70,99 +73,280 @@ RelayHandler::RelayHandler(const Config& config,
 {
 }
 
-int RelayHandler::open(const ACE_INET_Addr& address)
+RelayHandler::ReceiveBatch::ReceiveBatch(size_t size)
+  : size_(std::max(size, size_t(1)))
+{
+  if (size_ == 1) {
+    // Single datagrams are received directly into a buffer of the right size.
+    return;
+  }
+
+#ifdef ACE_LINUX
+  // recvmmsg needs a buffer per datagram.  Elsewhere each datagram is
+  // received on its own like a batch size of 1.
+  storage_.resize(size_ * MAX_DATAGRAM_SIZE);
+  headers_.resize(size_);
+  iovecs_.resize(size_);
+  addresses_.resize(size_);
+  for (size_t idx = 0; idx != size_; ++idx) {
+    iovecs_[idx].iov_base = &storage_[idx * MAX_DATAGRAM_SIZE];
+    iovecs_[idx].iov_len = MAX_DATAGRAM_SIZE;
+    std::memset(&headers_[idx], 0, sizeof(headers_[idx]));
+    headers_[idx].msg_hdr.msg_iov = &iovecs_[idx];
+    headers_[idx].msg_hdr.msg_iovlen = 1;
+    headers_[idx].msg_hdr.msg_name = &addresses_[idx];
+  }
+#endif
+}
+
+RelayHandler::Receiver::Receiver(RelayHandler& owner, ACE_Reactor* reactor)
+  : ACE_Event_Handler(reactor)
+  , owner_(owner)
+  , batch_(owner.config_.receive_batch_size())
+{
+}
+
+RelayHandler::Receiver::~Receiver()
+{
+  if (socket_.get_handle() != ACE_INVALID_HANDLE) {
+    reactor()->remove_handler(this, ALL_EVENTS_MASK | DONT_CALL);
+    socket_.close();
+  }
+}
+
+int RelayHandler::Receiver::open(const ACE_INET_Addr& address)
+{
+  if (owner_.open_socket(socket_, address, true) != 0) {
+    return -1;
+  }
+
+  if (reactor()->register_handler(this, READ_MASK) != 0) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::Receiver::open %C failed to register READ_MASK handler\n", owner_.name_.c_str()));
+    return -1;
+  }
+
+  return 0;
+}
+
+int RelayHandler::open(const ACE_INET_Addr& address,
+                       const RelayEventLoop::ReceiveReactors& receive_reactors)
 {
-  if (socket_.open(address) != 0) {
+  if (open_socket(socket_, address, !receive_reactors.empty()) != 0) {
+    return -1;
+  }
+
+  if (reactor()->register_handler(this, READ_MASK) != 0) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to register READ_MASK handler\n", name_.c_str()));
+    return -1;
+  }
+
+  // Bind to the actual address in case an ephemeral port was requested.
+  ACE_INET_Addr local_address;
+  if (!receive_reactors.empty() && socket_.get_local_addr(local_address) != 0) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to get local address: %m\n", name_.c_str()));
+    return -1;
+  }
+
+  for (const auto& receive_reactor : receive_reactors) {
+    std::unique_ptr<Receiver> receiver(new Receiver(*this, receive_reactor.get()));
+    if (receiver->open(local_address) != 0) {
+      return -1;
+    }
+    receivers_.push_back(std::move(receiver));
+  }
+
+  return 0;
+}
+
+int RelayHandler::open_socket(ACE_SOCK_Dgram& socket, const ACE_INET_Addr& address, bool reuse_port)
+{
+  if (reuse_port) {
+#ifdef SO_REUSEPORT
+    const ACE_HANDLE handle = ACE_OS::socket(address.get_type(), SOCK_DGRAM, 0);
+    if (handle == ACE_INVALID_HANDLE) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open_socket %C failed to create socket: %m\n", name_.c_str()));
+      return -1;
+    }
+    socket.set_handle(handle);
+
+    int one = 1;
+    if (socket.set_option(SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open_socket %C failed to set SO_REUSEPORT: %m\n", name_.c_str()));
+      socket.close();
+      return -1;
+    }
+
+    if (ACE_OS::bind(handle, static_cast<sockaddr*>(address.get_addr()), address.get_size()) != 0) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open_socket %C failed to bind socket on '%C': %m\n",
+                 name_.c_str(), OpenDDS::DCPS::LogAddr(address).c_str()));
+      socket.close();
+      return -1;
+    }
+#else
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open_socket %C multiple event loops require SO_REUSEPORT\n", name_.c_str()));
+    return -1;
+#endif
+  } else if (socket.open(address) != 0) {
     ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to open socket on '%C'\n",
                name_.c_str(), OpenDDS::DCPS::LogAddr(address).c_str()));
     return -1;
   }
-  if (socket_.enable(ACE_NONBLOCK) != 0) {
+
+  if (socket.enable(ACE_NONBLOCK) != 0) {
     ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to enable ACE_NONBLOCK\n", name_.c_str()));
     return -1;
   }
 
   const int buffer_size = config_.buffer_size();
 
-  if (socket_.set_option(SOL_SOCKET,
-                         SO_SNDBUF,
-                         (void *) &buffer_size,
-                         sizeof(buffer_size)) < 0
+  if (socket.set_option(SOL_SOCKET,
+                        SO_SNDBUF,
+                        (void *) &buffer_size,
+                        sizeof(buffer_size)) < 0
       && errno != ENOTSUP) {
     ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to set the send buffer size to %d errno %m\n", name_.c_str(), buffer_size));
     return -1;
   }
 
-  if (socket_.set_option(SOL_SOCKET,
-                         SO_RCVBUF,
-                         (void *) &buffer_size,
-                         sizeof(buffer_size)) < 0
+  if (socket.set_option(SOL_SOCKET,
+                        SO_RCVBUF,
+                        (void *) &buffer_size,
+                        sizeof(buffer_size)) < 0
       && errno != ENOTSUP) {
     ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to set the receive buffer size to %d errno %m\n", name_.c_str(), buffer_size));
     return -1;
   }
 
-  if (reactor()->register_handler(this, READ_MASK) != 0) {
-    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to register READ_MASK handler\n", name_.c_str()));
-    return -1;
-  }
-
   return 0;
 }
 
-int RelayHandler::handle_input(ACE_HANDLE handle)
+int RelayHandler::handle_input(ACE_HANDLE)
+{
+  return receive(socket_, batch_);
+}
+
+int RelayHandler::receive(ACE_SOCK_Dgram& socket, ReceiveBatch& batch)
 {
   OpenDDS::DCPS::ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
 
+  if (batch.size() == 1) {
+    receive_one(socket);
+    return 0;
+  }
+
+#ifdef ACE_LINUX
+  receive_many(socket, batch);
+#else
+  for (size_t count = 0; count != batch.size() && receive_one(socket); ++count) {}
+#endif
+
+  return 0;
+}
+
+bool RelayHandler::receive_one(ACE_SOCK_Dgram& socket)
+{
   const auto now = OpenDDS::DCPS::MonotonicTimePoint::now();
 
   ACE_INET_Addr remote;
-  int inlen = 65536; // Default to maximum datagram size.
+  int inlen = MAX_DATAGRAM_SIZE; // Default to maximum datagram size.
 
 #ifdef FIONREAD
-  if (ACE_OS::ioctl (handle,
+  if (ACE_OS::ioctl (socket.get_handle(),
                      FIONREAD,
                      &inlen) == -1) {
     HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::handle_input %C failed to get available byte count: %m\n", name_.c_str()));
-    return 0;
+    return false;
   }
-#else
-  ACE_UNUSED_ARG(handle);
 #endif
 
   if (inlen < 0) {
     HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::handle_input %C available byte count is negative\n", name_.c_str()));
-    return 0;
+    return false;
   }
 
   // Allocate at least one byte so that recv cannot return early.
   OpenDDS::DCPS::Lockable_Message_Block_Ptr buffer(new ACE_Message_Block(std::max(inlen, 1)), message_block_locking_);
 
-  const auto bytes = socket_.recv(buffer->wr_ptr(), buffer->space(), remote);
+  const auto bytes = socket.recv(buffer->wr_ptr(), buffer->space(), remote);
 
   if (bytes < 0) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN) {
+      // Drained.
+      return false;
+    }
+
     if (errno == ECONNRESET) {
       // Sending to a non-existent client may result in an ICMP message that is delievered as connection reset.
-      return 0;
+      return true;
     }
 
     HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::handle_input %C failed to recv: %m\n", name_.c_str()));
-    return 0;
+    return false;
   } else if (bytes == 0) {
     // Okay.  Empty datagram.
     HANDLER_WARNING((LM_WARNING, "(%P|%t) WARNING: RelayHandler::handle_input %C received an empty datagram from %C\n",
                      name_.c_str(), OpenDDS::DCPS::LogAddr(remote).c_str()));
-    return 0;
+    return true;
   }
 
   buffer->length(bytes);
+  process_input(remote, now, buffer);
+  return true;
+}
+
+#ifdef ACE_LINUX
+void RelayHandler::receive_many(ACE_SOCK_Dgram& socket, ReceiveBatch& batch)
+{
+  for (auto& header : batch.headers_) {
+    header.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    header.msg_hdr.msg_flags = 0;
+  }
+
+  const int count = recvmmsg(socket.get_handle(), batch.headers_.data(), static_cast<unsigned int>(batch.size()), MSG_DONTWAIT, 0);
+
+  if (count < 0) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN || errno == ECONNRESET) {
+      return;
+    }
+
+    const auto now = OpenDDS::DCPS::MonotonicTimePoint::now();
+    HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::handle_input %C failed to recvmmsg: %m\n", name_.c_str()));
+    return;
+  }
+
+  for (int idx = 0; idx != count; ++idx) {
+    const auto now = OpenDDS::DCPS::MonotonicTimePoint::now();
+    const auto& header = batch.headers_[idx];
+
+    ACE_INET_Addr remote;
+    remote.set_addr(header.msg_hdr.msg_name, static_cast<int>(header.msg_hdr.msg_namelen));
+
+    const size_t bytes = header.msg_len;
+    if (bytes == 0) {
+      // Okay.  Empty datagram.
+      HANDLER_WARNING((LM_WARNING, "(%P|%t) WARNING: RelayHandler::handle_input %C received an empty datagram from %C\n",
+                       name_.c_str(), OpenDDS::DCPS::LogAddr(remote).c_str()));
+      continue;
+    }
+
+    // Copy out of the scratch space so the buffer is sized to the datagram.
+    OpenDDS::DCPS::Lockable_Message_Block_Ptr buffer(new ACE_Message_Block(bytes), message_block_locking_);
+    buffer->copy(static_cast<const char*>(batch.iovecs_[idx].iov_base), bytes);
+    process_input(remote, now, buffer);
+  }
+}
+#endif
+
+void RelayHandler::process_input(const ACE_INET_Addr& remote,
+                                 const OpenDDS::DCPS::MonotonicTimePoint& now,
+                                 const OpenDDS::DCPS::Lockable_Message_Block_Ptr& buffer)
+{
+  const size_t bytes = buffer->length();
   MessageType type = MessageType::Unknown;
   const CORBA::ULong generated_messages = process_message(remote, now, buffer, type);
   stats_reporter_.max_gain(generated_messages, now);
-  stats_reporter_.input_message(static_cast<size_t>(bytes),
+  stats_reporter_.input_message(bytes,
     OpenDDS::DCPS::MonotonicTimePoint::now() - now, now, type);
-
-  return 0;
 }
 
 int RelayHandler::handle_output(ACE_HANDLE)
@@ -6,6 +6,7 @@
 #include "GuidPartitionTable.h"
 #include "HandlerStatisticsReporter.h"
 #include "ParticipantStatisticsReporter.h"
+#include "RelayEventLoop.h"
 #include "RelayPartitionTable.h"
 #include "RelayStatisticsReporter.h"
 
@@ -18,16 +19,23 @@
 #include <ace/Time_Value.h>
 
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace RtpsRelay {
 
 class RelayHandler : public ACE_Event_Handler {
 public:
-  int open(const ACE_INET_Addr& address);
+  // Open the socket on 'address' and register it with this handler's reactor.
+  // One additional socket bound to the same address with SO_REUSEPORT is
+  // registered with each of 'receive_reactors' so that input can be
+  // processed by several event loops.
+  int open(const ACE_INET_Addr& address,
+           const RelayEventLoop::ReceiveReactors& receive_reactors);
 
   const std::string& name() const { return name_; }
 
@@ -57,7 +65,53 @@ protected:
                                        MessageType& type) = 0;
 
 private:
+  // Scratch space used to drain up to Config::receive_batch_size datagrams per upcall.
+  struct ReceiveBatch {
+    explicit ReceiveBatch(size_t size);
+
+    size_t size() const { return size_; }
+
+    const size_t size_;
+#ifdef ACE_LINUX
+    std::vector<char> storage_;
+    std::vector<mmsghdr> headers_;
+    std::vector<iovec> iovecs_;
+    std::vector<sockaddr_storage> addresses_;
+#endif
+  };
+
+  // Receives on an additional socket that shares the port of the primary socket.
+  class Receiver : public ACE_Event_Handler {
+  public:
+    Receiver(RelayHandler& owner, ACE_Reactor* reactor);
+    ~Receiver();
+
+    int open(const ACE_INET_Addr& address);
+
+    ACE_HANDLE get_handle() const override { return socket_.get_handle(); }
+
+    int handle_input(ACE_HANDLE) override { return owner_.receive(socket_, batch_); }
+
+  private:
+    RelayHandler& owner_;
+    ACE_SOCK_Dgram socket_;
+    ReceiveBatch batch_;
+  };
+
+  int open_socket(ACE_SOCK_Dgram& socket, const ACE_INET_Addr& address, bool reuse_port);
+
+  int receive(ACE_SOCK_Dgram& socket, ReceiveBatch& batch);
+  bool receive_one(ACE_SOCK_Dgram& socket);
+#ifdef ACE_LINUX
+  void receive_many(ACE_SOCK_Dgram& socket, ReceiveBatch& batch);
+#endif
+  void process_input(const ACE_INET_Addr& remote,
+                     const OpenDDS::DCPS::MonotonicTimePoint& now,
+                     const OpenDDS::DCPS::Lockable_Message_Block_Ptr& buffer);
+
   ACE_SOCK_Dgram socket_;
+  ReceiveBatch batch_;
+  std::vector<std::unique_ptr<Receiver>> receivers_;
 
   struct Element {
     ACE_INET_Addr address;
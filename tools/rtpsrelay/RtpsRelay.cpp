@@ -238,6 +238,22 @@ int run(int argc, ACE_TCHAR* argv[])
     } else if ((arg = args.get_the_parameter("-SynchronousOutput"))) {
       config.synchronous_output(ACE_OS::atoi(arg));
       args.consume_arg();
+    } else if ((arg = args.get_the_parameter("-EventLoops"))) {
+      const int conv = ACE_OS::atoi(arg);
+      if (conv < 1) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: Value for -EventLoops option must be at least 1\n"));
+        return EXIT_FAILURE;
+      }
+      config.event_loops(conv);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter("-ReceiveBatchSize"))) {
+      const int conv = ACE_OS::atoi(arg);
+      if (conv < 1) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: Value for -ReceiveBatchSize option must be at least 1\n"));
+        return EXIT_FAILURE;
+      }
+      config.receive_batch_size(conv);
+      args.consume_arg();
     } else if ((arg = args.get_the_parameter("-MaxIpsPerClient"))) {
       config.max_ips_per_client(ACE_OS::atoi(arg));
       args.consume_arg();
@@ -749,6 +765,7 @@ int run(int argc, ACE_TCHAR* argv[])
   GuidAddrSet guid_addr_set(config, rtps_discovery, relay_participant_status_reporter, relay_statistics_reporter, *relay_thread_monitor);
   ACE_Reactor reactor_(RelayEventLoop::make_reactor_impl(config), true);
   const auto reactor = &reactor_;
+  const auto receive_reactors = RelayEventLoop::make_receive_reactors(config);
   GuidPartitionTable guid_partition_table(config, spdp_horizontal_addr, relay_partitions_writer, spdp_replay_writer, relay_statistics_reporter);
   RelayPartitionTable relay_partition_table(relay_statistics_reporter);
   relay_statistics_reporter.report();
@@ -880,12 +897,12 @@ int run(int argc, ACE_TCHAR* argv[])
   }
   // Don't need to invoke listener for existing samples because no remote participants could be discovered yet.
 
-  if (spdp_horizontal_handler.open(spdp_horizontal_addr) == -1 ||
-      sedp_horizontal_handler.open(sedp_horizontal_addr) == -1 ||
-      data_horizontal_handler.open(data_horizontal_addr) == -1 ||
-      spdp_vertical_handler.open(spdp_vertical_addr) == -1 ||
-      sedp_vertical_handler.open(sedp_vertical_addr) == -1 ||
-      data_vertical_handler.open(data_vertical_addr) == -1) {
+  if (spdp_horizontal_handler.open(spdp_horizontal_addr, receive_reactors) == -1 ||
+      sedp_horizontal_handler.open(sedp_horizontal_addr, receive_reactors) == -1 ||
+      data_horizontal_handler.open(data_horizontal_addr, receive_reactors) == -1 ||
+      spdp_vertical_handler.open(spdp_vertical_addr, receive_reactors) == -1 ||
+      sedp_vertical_handler.open(sedp_vertical_addr, receive_reactors) == -1 ||
+      data_vertical_handler.open(data_vertical_addr, receive_reactors) == -1) {
     return EXIT_FAILURE;
   }
 
@@ -971,7 +988,7 @@ int run(int argc, ACE_TCHAR* argv[])
   }
   ACE_DEBUG((LM_INFO, "(%P|%t) INFO: Meta Discovery listening on %C\n", OpenDDS::DCPS::LogAddr(meta_discovery_addr).c_str()));
 
-  const auto status = RelayEventLoop::run(config, *reactor, *relay_thread_monitor);
+  const auto status = RelayEventLoop::run(config, *reactor, receive_reactors, *relay_thread_monitor);
   if (status != EXIT_SUCCESS) {
     return status;
   }